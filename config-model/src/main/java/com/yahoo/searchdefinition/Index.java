@@ -66,6 +66,12 @@ public class Index implements Cloneable, Serializable {
     /** Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream. */
     private boolean interleavedFeatures = false;
 
+    /** Whether the posting lists of this index field should use the block bit packed format. */
+    private boolean blockPostingFormat = false;
+
+    /** The number of shards the memory index dictionary of this index field is split into. */
+    private int memoryIndexShards = 1;
+
     public Index(String name) {
         this(name, false);
     }
@@ -128,6 +134,8 @@ public class Index implements Cloneable, Serializable {
         return prefix == index.prefix &&
                 normalized == index.normalized &&
                 interleavedFeatures == index.interleavedFeatures &&
+                blockPostingFormat == index.blockPostingFormat &&
+                memoryIndexShards == index.memoryIndexShards &&
                 Objects.equals(name, index.name) &&
                 rankType == index.rankType &&
                 Objects.equals(aliases, index.aliases) &&
@@ -139,7 +147,7 @@ public class Index implements Cloneable, Serializable {
 
     @Override
     public int hashCode() {
-        return Objects.hash(name, rankType, prefix, aliases, stemming, normalized, type, boolIndex, hnswIndexParams, interleavedFeatures);
+        return Objects.hash(name, rankType, prefix, aliases, stemming, normalized, type, boolIndex, hnswIndexParams, interleavedFeatures, blockPostingFormat, memoryIndexShards);
     }
 
     public String toString() {
@@ -203,4 +211,23 @@ public class Index implements Cloneable, Serializable {
         return interleavedFeatures;
     }
 
+    public void setBlockPostingFormat(boolean value) {
+        blockPostingFormat = value;
+    }
+
+    public boolean useBlockPostingFormat() {
+        return blockPostingFormat;
+    }
+
+    public void setMemoryIndexShards(int value) {
+        if (value < 1) {
+            throw new IllegalArgumentException("memory-index-shards for index '" + name + "' must be at least 1, was " + value);
+        }
+        memoryIndexShards = value;
+    }
+
+    public int getMemoryIndexShards() {
+        return memoryIndexShards;
+    }
+
 }
@@ -120,7 +120,9 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
                 .prefix(f.hasPrefix())
                 .phrases(f.hasPhrases())
                 .positions(f.hasPositions())
-                .interleavedfeatures(f.useInterleavedFeatures());
+                .interleavedfeatures(f.useInterleavedFeatures())
+                .blockpostingformat(f.useBlockPostingFormat())
+                .memoryindexshards(f.getMemoryIndexShards());
             if (!f.getCollectionType().equals("SINGLE")) {
                 ifB.collectiontype(IndexschemaConfig.Indexfield.Collectiontype.Enum.valueOf(f.getCollectionType()));
             }
@@ -182,6 +184,10 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
         private BooleanIndexDefinition boolIndex = null;
         // Whether the posting lists of this index field should have interleaved features (num occs, field length) in document id stream.
         private boolean interleavedFeatures = false;
+        // Whether the posting lists of this index field should use the block bit packed format.
+        private boolean blockPostingFormat = false;
+        // The number of shards the memory index dictionary of this index field is split into.
+        private int memoryIndexShards = 1;
 
         public IndexField(String name, Index.Type type, DataType sdFieldType) {
             this.name = name;
@@ -192,6 +198,8 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
             if (type.equals(Index.Type.TEXT)) {
                 prefix = index.isPrefix();
                 interleavedFeatures = index.useInterleavedFeatures();
+                blockPostingFormat = index.useBlockPostingFormat();
+                memoryIndexShards = index.getMemoryIndexShards();
             }
             sdType = index.getType();
             boolIndex = index.getBooleanIndexDefiniton();
@@ -215,6 +223,8 @@ public class IndexSchema extends Derived implements IndexschemaConfig.Producer {
         public boolean hasPhrases() { return phrases; }
         public boolean hasPositions() { return positions; }
         public boolean useInterleavedFeatures() { return interleavedFeatures; }
+        public boolean useBlockPostingFormat() { return blockPostingFormat; }
+        public int getMemoryIndexShards() { return memoryIndexShards; }
 
         public BooleanIndexDefinition getBooleanIndexDefinition() {
             return boolIndex;
@@ -31,6 +31,8 @@ public class IndexOperation implements FieldOperation {
     private OptionalLong upperBound = OptionalLong.empty();
     private OptionalDouble densePostingListThreshold = OptionalDouble.empty();
     private Optional<Boolean> enableBm25 = Optional.empty();
+    private Optional<Boolean> blockPostingFormat = Optional.empty();
+    private OptionalInt memoryIndexShards = OptionalInt.empty();
 
     private Optional<HnswIndexParams.Builder> hnswIndexParams = Optional.empty();
 
@@ -94,6 +96,12 @@ public class IndexOperation implements FieldOperation {
         if (enableBm25.isPresent()) {
             index.setInterleavedFeatures(enableBm25.get());
         }
+        if (blockPostingFormat.isPresent()) {
+            index.setBlockPostingFormat(blockPostingFormat.get());
+        }
+        if (memoryIndexShards.isPresent()) {
+            index.setMemoryIndexShards(memoryIndexShards.getAsInt());
+        }
         if (hnswIndexParams.isPresent()) {
             index.setHnswIndexParams(hnswIndexParams.get().build());
         }
@@ -127,6 +135,14 @@ public class IndexOperation implements FieldOperation {
         enableBm25 = Optional.of(value);
     }
 
+    public void setBlockPostingFormat(boolean value) {
+        blockPostingFormat = Optional.of(value);
+    }
+
+    public void setMemoryIndexShards(int value) {
+        memoryIndexShards = OptionalInt.of(value);
+    }
+
     public void setHnswIndexParams(HnswIndexParams.Builder params) {
         this.hnswIndexParams = Optional.of(params);
     }
@@ -399,6 +399,13 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.resource_usage.transient_memory.average"));
         metrics.add(new Metric("content.proton.resource_usage.memory_mappings.max"));
         metrics.add(new Metric("content.proton.resource_usage.open_file_descriptors.max"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.explicit_huge_pages_allocated_bytes.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.explicit_huge_pages_fallbacks.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.transparent_huge_pages_allocated_bytes.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.no_huge_pages_allocated_bytes.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.numa_interleaved_allocated_bytes.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.numa_local_allocated_bytes.rate"));
+        metrics.add(new Metric("content.proton.resource_usage.mmap_policy.failed_advices.rate"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.enum_store.average"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.multi_value.average"));
         metrics.add(new Metric("content.proton.documentdb.attribute.resource_usage.feeding_blocked.last"));
@@ -17,6 +17,7 @@
 #include <vespa/vdslib/distribution/distribution.h>
 #include <vespa/config-stor-distribution.h>
 #include <algorithm>
+#include <future>
 #include <limits>
 #include <gtest/gtest.h>
 
@@ -40,6 +41,14 @@ PersistenceProvider::UP getSpi(ConformanceTest::PersistenceFactory &factory,
     return result;
 }
 
+class PromisedResult : public OperationComplete {
+    std::promise<Result::UP> _promise;
+public:
+    std::future<Result::UP> future_result() { return _promise.get_future(); }
+    void onComplete(Result::UP result) override { _promise.set_value(std::move(result)); }
+    void addResultHandler(const ResultHandler *) override { }
+};
+
 enum SELECTION_FIELDS
 {
     METADATA_ONLY = 0,
@@ -585,6 +594,41 @@ TEST_F(ConformanceTest, testPut)
     }
 }
 
+TEST_F(ConformanceTest, testPutBatch)
+{
+    document::TestDocMan testDocMan;
+    _factory->clear();
+    PersistenceProvider::UP spi(getSpi(*_factory, testDocMan));
+    Context context(defaultLoadType, Priority(0), Trace::TraceLevel(0));
+
+    Bucket bucket(makeSpiBucket(BucketId(8, 0x01)));
+    spi->createBucket(bucket, context);
+
+    std::vector<Document::SP> docs;
+    std::vector<PersistenceProvider::BatchedPut> puts;
+    std::vector<std::future<Result::UP>> results;
+    for (uint32_t i = 0; i < 3; ++i) {
+        docs.push_back(testDocMan.createRandomDocumentAtLocation(0x01, i + 1));
+        auto onComplete = std::make_unique<PromisedResult>();
+        results.push_back(onComplete->future_result());
+        puts.push_back({Timestamp(3 + i), docs.back(), std::move(onComplete)});
+    }
+    spi->putBatchAsync(bucket, std::move(puts), context);
+    for (auto &result : results) {
+        EXPECT_FALSE(result.get()->hasError());
+    }
+
+    const BucketInfo info = spi->getBucketInfo(bucket).getBucketInfo();
+    EXPECT_EQ(3, (int)info.getDocumentCount());
+    for (uint32_t i = 0; i < docs.size(); ++i) {
+        GetResult gr = spi->get(bucket, document::AllFields(), docs[i]->getId(), context);
+        EXPECT_EQ(Result::ErrorType::NONE, gr.getErrorCode());
+        EXPECT_EQ(Timestamp(3 + i), gr.getTimestamp());
+        EXPECT_TRUE(gr.hasDocument());
+        EXPECT_EQ(*docs[i], gr.getDocument());
+    }
+}
+
 TEST_F(ConformanceTest, testPutNewDocumentVersion)
 {
     document::TestDocMan testDocMan;
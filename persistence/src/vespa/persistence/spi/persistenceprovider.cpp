@@ -42,6 +42,14 @@ PersistenceProvider::putAsync(const Bucket &bucket, Timestamp timestamp, Documen
     onComplete->onComplete(std::make_unique<Result>(result));
 }
 
+void
+PersistenceProvider::putBatchAsync(const Bucket &bucket, std::vector<BatchedPut> puts, Context &context)
+{
+    for (auto &put : puts) {
+        putAsync(bucket, put.timestamp, std::move(put.doc), context, std::move(put.onComplete));
+    }
+}
+
 RemoveResult
 PersistenceProvider::remove(const Bucket& bucket, Timestamp timestamp, const DocumentId & docId, Context& context) {
     auto catcher = std::make_unique<CatchResult>();
@@ -115,6 +115,24 @@ struct PersistenceProvider
     virtual Result put(const Bucket&, Timestamp, DocumentSP, Context&);
     virtual void putAsync(const Bucket &, Timestamp , DocumentSP , Context &, OperationComplete::UP );
 
+    /**
+     * A document to store with putBatchAsync, completed through its own
+     * onComplete.
+     */
+    struct BatchedPut {
+        Timestamp             timestamp;
+        DocumentSP            doc;
+        OperationComplete::UP onComplete;
+    };
+
+    /**
+     * Store a batch of documents in the given bucket. Each put gets its own
+     * result, as if putAsync was called for the documents in order. The
+     * default implementation does exactly that, a provider may override it
+     * to amortize the per operation overhead over the batch.
+     */
+    virtual void putBatchAsync(const Bucket &, std::vector<BatchedPut> puts, Context &);
+
     /**
      * This remove function assumes that there exist something to be removed.
      * The data to be removed may not exist on this node though, so all remove
@@ -11,11 +11,16 @@ Config::Config() :
     _huge(false),
     _enableBitVectors(false),
     _enableOnlyBitVector(false),
+    _enableCompressedPostingLists(false),
+    _enableZoneMaps(false),
+    _enableMemoryMappedLoad(false),
+    _writerShards(1),
     _isFilter(false),
     _fastAccess(false),
     _mutable(false),
     _growStrategy(),
     _compactionStrategy(),
+    _dictionary(),
     _predicateParams(),
     _tensorType(vespalib::eval::ValueType::error_type()),
     _distance_metric(DistanceMetric::Euclidean),
@@ -30,11 +35,16 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_, bool huge_)
       _huge(huge_),
       _enableBitVectors(false),
       _enableOnlyBitVector(false),
+      _enableCompressedPostingLists(false),
+      _enableZoneMaps(false),
+      _enableMemoryMappedLoad(false),
+      _writerShards(1),
       _isFilter(false),
       _fastAccess(false),
       _mutable(false),
       _growStrategy(),
       _compactionStrategy(),
+      _dictionary(),
       _predicateParams(),
       _tensorType(vespalib::eval::ValueType::error_type()),
       _distance_metric(DistanceMetric::Euclidean),
@@ -57,11 +67,16 @@ Config::operator==(const Config &b) const
            _fastSearch == b._fastSearch &&
            _enableBitVectors == b._enableBitVectors &&
            _enableOnlyBitVector == b._enableOnlyBitVector &&
+           _enableCompressedPostingLists == b._enableCompressedPostingLists &&
+           _enableZoneMaps == b._enableZoneMaps &&
+           _enableMemoryMappedLoad == b._enableMemoryMappedLoad &&
+           _writerShards == b._writerShards &&
            _isFilter == b._isFilter &&
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _growStrategy == b._growStrategy &&
            _compactionStrategy == b._compactionStrategy &&
+           _dictionary == b._dictionary &&
            _predicateParams == b._predicateParams &&
            (_basicType.type() != BasicType::Type::TENSOR ||
             _tensorType == b._tensorType) &&
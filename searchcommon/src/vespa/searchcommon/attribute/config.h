@@ -7,6 +7,7 @@
 #include "hnsw_index_params.h"
 #include "predicate_params.h"
 #include <vespa/searchcommon/common/compaction_strategy.h>
+#include <vespa/searchcommon/common/dictionary_config.h>
 #include <vespa/searchcommon/common/growstrategy.h>
 #include <vespa/eval/eval/value_type.h>
 #include <cassert>
@@ -51,6 +52,33 @@ public:
      */
     bool getEnableOnlyBitVector() const { return _enableOnlyBitVector; }
 
+    /**
+     * Check if posting lists that have not been modified for a while
+     * can be converted to a compressed representation.
+     */
+    bool getEnableCompressedPostingLists() const { return _enableCompressedPostingLists; }
+
+    /**
+     * Check if per block min/max values should be maintained for
+     * single value numeric attributes without fast-search, allowing
+     * range searches to skip blocks of documents.
+     */
+    bool getEnableZoneMaps() const { return _enableZoneMaps; }
+
+    /**
+     * Check if the save file of a single value numeric attribute
+     * should be memory mapped on load instead of read, letting
+     * pages be copied on first write. The mapped file keeps using
+     * disk space until the attribute is saved again.
+     */
+    bool getEnableMemoryMappedLoad() const { return _enableMemoryMappedLoad; }
+
+    /**
+     * Number of threads applying partial updates to disjoint lid ranges
+     * of a single value numeric attribute without fast-search.
+     */
+    uint32_t getWriterShards() const { return _writerShards; }
+
     bool getIsFilter() const { return _isFilter; }
     bool isMutable() const { return _mutable; }
 
@@ -62,6 +90,7 @@ public:
 
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
+    const DictionaryConfig & get_dictionary_config() const { return _dictionary; }
     Config & setHuge(bool v)                         { _huge = v; return *this;}
     Config & setFastSearch(bool v)                   { _fastSearch = v; return *this; }
     Config & setPredicateParams(const PredicateParams &v) { _predicateParams = v; return *this; }
@@ -103,6 +132,41 @@ public:
         return *this;
     }
 
+    /**
+     * Enable conversion of posting lists without weight information that
+     * have not been modified for a while to a compressed representation.
+     */
+    Config & setEnableCompressedPostingLists(bool enableCompressedPostingLists) {
+        _enableCompressedPostingLists = enableCompressedPostingLists;
+        return *this;
+    }
+
+    /**
+     * Enable per block min/max values for single value numeric
+     * attributes without fast-search.
+     */
+    Config & setEnableZoneMaps(bool enableZoneMaps) {
+        _enableZoneMaps = enableZoneMaps;
+        return *this;
+    }
+
+    /**
+     * Enable memory mapped load of single value numeric attributes.
+     */
+    Config & setEnableMemoryMappedLoad(bool enableMemoryMappedLoad) {
+        _enableMemoryMappedLoad = enableMemoryMappedLoad;
+        return *this;
+    }
+
+    /**
+     * Set number of threads applying partial updates to disjoint lid
+     * ranges of this attribute.
+     */
+    Config & setWriterShards(uint32_t writerShards) {
+        _writerShards = writerShards;
+        return *this;
+    }
+
     /**
      * Hide weight information when searching in attributes.
      */
@@ -112,6 +176,7 @@ public:
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
+    Config & set_dictionary_config(const DictionaryConfig & cfg) { _dictionary = cfg; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
     bool operator==(const Config &b) const;
 
@@ -122,11 +187,16 @@ private:
     bool           _huge;
     bool           _enableBitVectors;
     bool           _enableOnlyBitVector;
+    bool           _enableCompressedPostingLists;
+    bool           _enableZoneMaps;
+    bool           _enableMemoryMappedLoad;
+    uint32_t       _writerShards;
     bool           _isFilter;
     bool           _fastAccess;
     bool           _mutable;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
+    DictionaryConfig   _dictionary;
     PredicateParams    _predicateParams;
     vespalib::eval::ValueType _tensorType;
     DistanceMetric _distance_metric;
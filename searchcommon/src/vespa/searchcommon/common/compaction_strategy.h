@@ -14,22 +14,28 @@ class CompactionStrategy
 private:
     double _maxDeadBytesRatio; // Max ratio of dead bytes before compaction
     double _maxDeadAddressSpaceRatio; // Max ratio of dead address space before compaction
+    uint32_t _maxCompactLidsPerCommit; // Max lids visited by incremental compaction per commit, 0 means compact all at once
 public:
     CompactionStrategy()
         : _maxDeadBytesRatio(0.2),
-          _maxDeadAddressSpaceRatio(0.2)
+          _maxDeadAddressSpaceRatio(0.2),
+          _maxCompactLidsPerCommit(0)
     {
     }
-    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio)
+    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio, uint32_t maxCompactLidsPerCommit = 0)
         : _maxDeadBytesRatio(maxDeadBytesRatio),
-          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio)
+          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
+          _maxCompactLidsPerCommit(maxCompactLidsPerCommit)
     {
     }
     double getMaxDeadBytesRatio() const { return _maxDeadBytesRatio; }
     double getMaxDeadAddressSpaceRatio() const { return _maxDeadAddressSpaceRatio; }
+    uint32_t getMaxCompactLidsPerCommit() const { return _maxCompactLidsPerCommit; }
+    bool incrementalCompaction() const { return _maxCompactLidsPerCommit != 0; }
     bool operator==(const CompactionStrategy & rhs) const {
         return _maxDeadBytesRatio == rhs._maxDeadBytesRatio &&
-            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio;
+            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio &&
+            _maxCompactLidsPerCommit == rhs._maxCompactLidsPerCommit;
     }
     bool operator!=(const CompactionStrategy & rhs) const { return !(operator==(rhs)); }
 };
@@ -0,0 +1,29 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+namespace search {
+
+/*
+ * Class describing the type of dictionary used for the unique values of a
+ * fast-search attribute.
+ *
+ * BTREE: Ordered dictionary only, used for all lookups.
+ * BTREE_AND_HASH: Ordered dictionary for range, prefix and folded searches
+ *                 and posting lists, and a hash dictionary for exact lookups
+ *                 during feeding and term search.
+ */
+class DictionaryConfig {
+public:
+    enum class Type { BTREE, BTREE_AND_HASH };
+    DictionaryConfig() noexcept : _type(Type::BTREE) { }
+    DictionaryConfig(Type type) noexcept : _type(type) { }
+    Type getType() const { return _type; }
+    bool has_hash() const { return _type == Type::BTREE_AND_HASH; }
+    bool operator==(const DictionaryConfig& rhs) const { return _type == rhs._type; }
+    bool operator!=(const DictionaryConfig& rhs) const { return !(operator==(rhs)); }
+private:
+    Type _type;
+};
+
+}
@@ -128,7 +128,9 @@ Schema::Field::operator!=(const Field &rhs) const
 Schema::IndexField::IndexField(vespalib::stringref name, DataType dt)
     : Field(name, dt),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _block_posting_format(false),
+      _memory_index_shards(1)
 {
 }
 
@@ -136,14 +138,18 @@ Schema::IndexField::IndexField(vespalib::stringref name, DataType dt,
                                CollectionType ct)
     : Field(name, dt, ct),
       _avgElemLen(512),
-      _interleaved_features(false)
+      _interleaved_features(false),
+      _block_posting_format(false),
+      _memory_index_shards(1)
 {
 }
 
 Schema::IndexField::IndexField(const std::vector<vespalib::string> &lines)
     : Field(lines),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines, 512)),
-      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false))
+      _interleaved_features(ConfigParser::parse<bool>("interleavedfeatures", lines, false)),
+      _block_posting_format(ConfigParser::parse<bool>("blockpostingformat", lines, false)),
+      _memory_index_shards(1)
 {
 }
 
@@ -158,6 +164,7 @@ Schema::IndexField::write(vespalib::asciistream & os, vespalib::stringref prefix
     Field::write(os, prefix);
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
     os << prefix << "interleavedfeatures " << (_interleaved_features ? "true" : "false") << "\n";
+    os << prefix << "blockpostingformat " << (_block_posting_format ? "true" : "false") << "\n";
 
     // TODO: Remove prefix, phrases and positions when breaking downgrade is no longer an issue.
     os << prefix << "prefix false" << "\n";
@@ -170,7 +177,8 @@ Schema::IndexField::operator==(const IndexField &rhs) const
 {
     return Field::operator==(rhs) &&
             _avgElemLen == rhs._avgElemLen &&
-            _interleaved_features == rhs._interleaved_features;
+            _interleaved_features == rhs._interleaved_features &&
+            _block_posting_format == rhs._block_posting_format;
 }
 
 bool
@@ -178,7 +186,8 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
 {
     return Field::operator!=(rhs) ||
             _avgElemLen != rhs._avgElemLen ||
-            _interleaved_features != rhs._interleaved_features;
+            _interleaved_features != rhs._interleaved_features ||
+            _block_posting_format != rhs._block_posting_format;
 }
 
 Schema::FieldSet::FieldSet(const std::vector<vespalib::string> & lines) :
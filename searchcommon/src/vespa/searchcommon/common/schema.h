@@ -81,6 +81,9 @@ public:
         uint32_t _avgElemLen;
         // TODO: Remove when posting list format with interleaved features is made default
         bool _interleaved_features;
+        bool _block_posting_format;
+        // Only used by memory index, not persisted and not part of equality.
+        uint32_t _memory_index_shards;
 
     public:
         IndexField(vespalib::stringref name, DataType dt);
@@ -99,12 +102,22 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_block_posting_format(bool value) {
+            _block_posting_format = value;
+            return *this;
+        }
+        IndexField &set_memory_index_shards(uint32_t value) {
+            _memory_index_shards = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    vespalib::stringref prefix) const override;
 
         uint32_t getAvgElemLen() const { return _avgElemLen; }
         bool use_interleaved_features() const { return _interleaved_features; }
+        bool use_block_posting_format() const { return _block_posting_format; }
+        uint32_t get_memory_index_shards() const { return _memory_index_shards; }
 
         bool operator==(const IndexField &rhs) const;
         bool operator!=(const IndexField &rhs) const;
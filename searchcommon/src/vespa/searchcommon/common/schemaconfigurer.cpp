@@ -10,6 +10,7 @@
 #include <vespa/searchcommon/attribute/basictype.h>
 
 #include <vespa/searchcommon/config/subscriptionproxyng.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".index.schemaconfigurer");
@@ -145,7 +146,9 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
         schema.addIndexField(Schema::IndexField(f.name, convertIndexDataType(f.datatype),
                                                 convertIndexCollectionType(f.collectiontype)).
                 setAvgElemLen(f.averageelementlen).
-                set_interleaved_features(f.interleavedfeatures));
+                set_interleaved_features(f.interleavedfeatures).
+                set_block_posting_format(f.blockpostingformat).
+                set_memory_index_shards(std::max(1, f.memoryindexshards)));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset &fs = cfg.fieldset[i];
@@ -139,6 +139,7 @@ public:
                         schema,
                         std::make_shared<DocumentDBMaintenanceConfig>(),
                         search::LogDocumentStore::Config(),
+                        0,
                         "client",
                         docTypeName.getName()));
     }
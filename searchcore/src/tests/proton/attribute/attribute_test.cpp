@@ -3,9 +3,12 @@
 #include <vespa/config-attributes.h>
 #include <vespa/document/datatype/tensor_data_type.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/predicate/predicate_slime_builder.h>
+#include <vespa/document/update/addvalueupdate.h>
 #include <vespa/document/update/arithmeticvalueupdate.h>
 #include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/clearvalueupdate.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/eval/tensor/tensor.h>
@@ -487,6 +490,106 @@ TEST_F(AttributeWriterTest, handles_update)
     }
 }
 
+TEST_F(AttributeWriterTest, handles_sharded_update)
+{
+    AVConfig cfg(AVBasicType::INT32);
+    cfg.setWriterShards(4);
+    auto a1 = addAttribute({"a1", cfg});
+    ASSERT_TRUE(a1->supportsInPlaceWrites());
+    uint32_t numDocs = 3 * AttributeVector::inPlaceWriteLidAlignment + 10;
+    fillAttribute(a1, numDocs, 10, 1);
+
+    Schema schema;
+    schema.addAttributeField(Schema::AttributeField("a1", schema::DataType::INT32, CollectionType::SINGLE));
+    DocBuilder idb(schema);
+    const document::DocumentType &dt(idb.getDocumentType());
+    DocumentUpdate upd(*idb.getDocumentTypeRepo(), dt, DocumentId("id:ns:searchdocument::1"));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a1"))
+                  .addUpdate(ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 5)));
+    DocumentUpdate clearUpd(*idb.getDocumentTypeRepo(), dt, DocumentId("id:ns:searchdocument::2"));
+    clearUpd.addUpdate(FieldUpdate(clearUpd.getType().getField("a1")).addUpdate(ClearValueUpdate()));
+
+    DummyFieldUpdateCallback onUpdate;
+    SerialNum serialNum = 2;
+    for (uint32_t lid = 1; lid < numDocs; lid += 7) {
+        update(serialNum++, upd, lid, false, onUpdate);
+        update(serialNum++, upd, lid, false, onUpdate);
+    }
+    update(serialNum++, clearUpd, 3, false, onUpdate);
+    commit(serialNum);
+
+    EXPECT_EQ(serialNum, a1->getStatus().getLastSyncToken());
+    for (uint32_t lid = 1; lid < numDocs; ++lid) {
+        int64_t expected = ((lid - 1) % 7 == 0) ? 20 : 10;
+        if (lid == 3) {
+            expected = search::attribute::getUndefined<int32_t>();
+        }
+        EXPECT_EQ(expected, a1->getInt(lid)) << "lid " << lid;
+    }
+}
+
+TEST_F(AttributeWriterTest, sharded_update_falls_back_to_executor_for_attributes_without_in_place_writes)
+{
+    AVConfig cfg(AVBasicType::INT32);
+    cfg.setWriterShards(4);
+    AVConfig arrayCfg(AVBasicType::INT32, AVCollectionType::ARRAY);
+    arrayCfg.setWriterShards(4);
+    AVConfig stringCfg(AVBasicType::STRING);
+    stringCfg.setWriterShards(4);
+    auto a1 = addAttribute({"a1", cfg});
+    auto a2 = addAttribute({"a2", arrayCfg});
+    auto a3 = addAttribute({"a3", stringCfg});
+    ASSERT_TRUE(a1->supportsInPlaceWrites());
+    EXPECT_FALSE(a2->supportsInPlaceWrites());
+    EXPECT_FALSE(a3->supportsInPlaceWrites());
+    uint32_t numDocs = 2 * AttributeVector::inPlaceWriteLidAlignment + 10;
+    fillAttribute(a1, numDocs, 10, 1);
+    a2->addDocs(numDocs);
+    a2->commit(1, 1);
+    a3->addDocs(numDocs);
+    a3->commit(1, 1);
+
+    Schema schema;
+    schema.addAttributeField(Schema::AttributeField("a1", schema::DataType::INT32, CollectionType::SINGLE));
+    schema.addAttributeField(Schema::AttributeField("a2", schema::DataType::INT32, CollectionType::ARRAY));
+    schema.addAttributeField(Schema::AttributeField("a3", schema::DataType::STRING, CollectionType::SINGLE));
+    DocBuilder idb(schema);
+    const document::DocumentType &dt(idb.getDocumentType());
+    DocumentUpdate upd(*idb.getDocumentTypeRepo(), dt, DocumentId("id:ns:searchdocument::1"));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a1"))
+                  .addUpdate(ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 5)));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a2")).addUpdate(AddValueUpdate(IntFieldValue(7))));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a3")).addUpdate(AssignValueUpdate(StringFieldValue("foo"))));
+    DocumentUpdate shardedOnlyUpd(*idb.getDocumentTypeRepo(), dt, DocumentId("id:ns:searchdocument::2"));
+    shardedOnlyUpd.addUpdate(FieldUpdate(shardedOnlyUpd.getType().getField("a1"))
+                             .addUpdate(ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 5)));
+
+    DummyFieldUpdateCallback onUpdate;
+    SerialNum serialNum = 2;
+    for (uint32_t lid = 1; lid < numDocs; lid += 5) {
+        update(serialNum++, upd, lid, false, onUpdate);
+        update(serialNum++, shardedOnlyUpd, lid, false, onUpdate);
+    }
+    commit(serialNum);
+
+    EXPECT_EQ(serialNum, a1->getStatus().getLastSyncToken());
+    EXPECT_EQ(serialNum, a2->getStatus().getLastSyncToken());
+    EXPECT_EQ(serialNum, a3->getStatus().getLastSyncToken());
+    attribute::IntegerContent ibuf;
+    for (uint32_t lid = 1; lid < numDocs; ++lid) {
+        bool updated = ((lid - 1) % 5 == 0);
+        EXPECT_EQ(updated ? 20 : 10, a1->getInt(lid)) << "lid " << lid;
+        ibuf.fill(*a2, lid);
+        if (updated) {
+            ASSERT_EQ(1u, ibuf.size()) << "lid " << lid;
+            EXPECT_EQ(7, ibuf[0]) << "lid " << lid;
+        } else {
+            EXPECT_EQ(0u, ibuf.size()) << "lid " << lid;
+        }
+        EXPECT_EQ(vespalib::string(updated ? "foo" : ""), vespalib::string(a3->getString(lid, nullptr, 0))) << "lid " << lid;
+    }
+}
+
 TEST_F(AttributeWriterTest, handles_predicate_update)
 {
     auto a1 = addAttribute({"a1", AVConfig(AVBasicType::PREDICATE)});
@@ -524,7 +627,7 @@ public:
     AttributeCollectionSpecFactory _factory;
     AttributeCollectionSpecTest(bool fastAccessOnly)
         : _builder(),
-          _factory(search::GrowStrategy(), 100, fastAccessOnly)
+          _factory(search::GrowStrategy(), 100, 1000, fastAccessOnly)
     {
         addAttribute("a1", false);
         addAttribute("a2", true);
@@ -561,6 +664,16 @@ TEST_F(NormalAttributeCollectionSpecTest, spec_can_be_created)
     EXPECT_EQ(20u, spec->getCurrentSerialNum());
 }
 
+TEST_F(NormalAttributeCollectionSpecTest, max_compact_lids_per_commit_is_propagated_to_attribute_config)
+{
+    AttributeCollectionSpec::UP spec = create(10, 20);
+    for (const auto &attr : spec->getAttributes()) {
+        const auto &compaction = attr.getConfig().getCompactionStrategy();
+        EXPECT_EQ(1000u, compaction.getMaxCompactLidsPerCommit());
+        EXPECT_EQ(search::CompactionStrategy().getMaxDeadBytesRatio(), compaction.getMaxDeadBytesRatio());
+    }
+}
+
 TEST_F(FastAccessAttributeCollectionSpecTest, spec_can_be_created)
 {
     AttributeCollectionSpec::UP spec = create(10, 20);
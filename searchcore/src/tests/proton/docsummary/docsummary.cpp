@@ -32,6 +32,7 @@
 #include <vespa/searchlib/transactionlog/translogserver.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/config-bucketspaces.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <regex>
@@ -55,6 +56,7 @@ using search::index::DummyFileHeaderContext;
 using search::index::schema::CollectionType;
 using storage::spi::Timestamp;
 using vespa::config::search::core::ProtonConfig;
+using vespa::config::search::core::ProtonConfigBuilder;
 using vespa::config::content::core::BucketspacesConfig;
 using vespalib::eval::TensorSpec;
 using vespalib::tensor::Tensor;
@@ -186,7 +188,8 @@ public:
     AttributeWriter::UP _aw;
     ISummaryAdapter::SP _sa;
 
-    DBContext(const std::shared_ptr<const DocumentTypeRepo> &repo, const char *docTypeName)
+    DBContext(const std::shared_ptr<const DocumentTypeRepo> &repo, const char *docTypeName,
+              std::shared_ptr<ProtonConfig> protonCfg = std::make_shared<ProtonConfig>())
         : _dmk(docTypeName),
           _fileHeaderContext(),
           _tls("tmp", 9013, ".", _fileHeaderContext),
@@ -207,7 +210,7 @@ public:
     {
         assert(_mkdirOk);
         auto b = std::make_shared<BootstrapConfig>(1, _documenttypesConfig, _repo,
-                                                   std::make_shared<ProtonConfig>(),
+                                                   std::move(protonCfg),
                                                    std::make_shared<FiledistributorrpcConfig>(),
                                                    std::make_shared<BucketspacesConfig>(),
                                                    _tuneFileDocumentDB, _hwInfo);
@@ -300,6 +303,7 @@ private:
 
     void requireThatAdapterHandlesAllFieldTypes();
     void requireThatAdapterHandlesMultipleDocuments();
+    void requireThatAdapterCanPrefetchDocuments();
     void requireThatAdapterHandlesDocumentIdField();
     void requireThatDocsumRequestIsProcessed();
     void requireThatRewritersAreUsed();
@@ -311,6 +315,7 @@ private:
     void requireThatRawFieldsWorks();
     void requireThatFieldCacheRepoCanReturnDefaultFieldCache();
     void requireThatSummariesTimeout();
+    void requireThatLargeDocsumRequestsArePrefetched();
 
 public:
     Test();
@@ -513,6 +518,60 @@ Test::requireThatAdapterHandlesMultipleDocuments()
 }
 
 
+void
+Test::requireThatAdapterCanPrefetchDocuments()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+
+    BuildContext bc(s);
+    bc._bld.startDocument("id:ns:searchdocument::0").
+        startSummaryField("a").
+        addInt(1000).
+        endField();
+    bc.endDocument(0);
+    bc._bld.startDocument("id:ns:searchdocument::1").
+        startSummaryField("a").
+        addInt(2000).endField();
+    bc.endDocument(1);
+
+    DocumentStoreAdapter dsa(bc._str, *bc._repo, getResultConfig(), "class1",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class1"),
+                             getMarkupFields());
+    dsa.prefetch({1, 2, 0, 1});
+    EXPECT_EQUAL(2u, dsa.getNumPrefetched()); // doc 2 does not exist
+    {
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(2000u, res->GetEntry("a")->_intval);
+        EXPECT_EQUAL(1u, dsa.getNumPrefetched());
+    }
+    {
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+        EXPECT_EQUAL(0u, dsa.getNumPrefetched());
+    }
+    { // not prefetched
+        GeneralResultPtr res = getResult(dsa, 1);
+        EXPECT_EQUAL(2000u, res->GetEntry("a")->_intval);
+    }
+    {
+        DocsumStoreValue docsum = dsa.getMappedDocsum(2);
+        EXPECT_TRUE(docsum.pt() == nullptr);
+    }
+    EXPECT_TRUE(bc._str.isCached(1));
+    EXPECT_FALSE(bc._str.isCached(0));
+    dsa.prefetch({0, 1});
+    EXPECT_EQUAL(1u, dsa.getNumPrefetched()); // doc 1 is in the summary cache
+    dsa.prefetch({0});
+    EXPECT_EQUAL(1u, dsa.getNumPrefetched());
+    {
+        GeneralResultPtr res = getResult(dsa, 0);
+        EXPECT_EQUAL(1000u, res->GetEntry("a")->_intval);
+        EXPECT_EQUAL(0u, dsa.getNumPrefetched());
+    }
+}
+
+
 void
 Test::requireThatAdapterHandlesDocumentIdField()
 {
@@ -658,6 +717,68 @@ Test::requireThatSummariesTimeout()
     EXPECT_TRUE(std::regex_search(bufstring.data(), bufstring.data() + bufstring.size(), std::regex("Timed out with -[0-9]+us left.")));
 }
 
+namespace {
+
+constexpr uint32_t NUM_PREFETCH_DOCS = 100; // more than one prefetch batch
+
+std::shared_ptr<ProtonConfig>
+makePrefetchProtonConfig(int32_t prefetchMinHits)
+{
+    ProtonConfigBuilder builder;
+    builder.summary.read.prefetch.minhits = prefetchMinHits;
+    builder.summary.write.coalesce.maxbytes = 0;
+    return std::make_shared<ProtonConfig>(builder);
+}
+
+/**
+ * Returns the number of document store reads not served by prefetching
+ * when getting docsums for NUM_PREFETCH_DOCS documents.
+ */
+size_t
+getDocsumsAndCountStoreReads(BuildContext &bc, int32_t prefetchMinHits)
+{
+    DBContext dc(bc._repo, getDocTypeName(), makePrefetchProtonConfig(prefetchMinHits));
+    DocsumRequest req;
+    req.resultClassName = "class1";
+    for (uint32_t lid = 1; lid <= NUM_PREFETCH_DOCS; ++lid) {
+        vespalib::string docId = vespalib::make_string("id:ns:searchdocument::%u", lid);
+        dc.put(*bc._bld.startDocument(docId).
+               startSummaryField("a").
+               addInt(lid * 10).
+               endField().
+               endDocument(),
+               lid);
+        req.hits.push_back(DocsumRequest::Hit(DocumentId(docId).getGlobalId()));
+    }
+    const search::IDocumentStore &store = dc._ddb->getReadySubDB()->getSummaryManager()->getBackingStore();
+    size_t missesBefore = store.getCacheStats().misses;
+    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    size_t misses = store.getCacheStats().misses - missesBefore;
+    EXPECT_EQUAL(NUM_PREFETCH_DOCS, rep->docsums.size());
+    for (uint32_t i = 0; i < rep->docsums.size(); ++i) {
+        EXPECT_EQUAL(i + 1, rep->docsums[i].docid);
+        EXPECT_TRUE(rep->docsums[i].data.get() != nullptr);
+    }
+    return misses;
+}
+
+}
+
+void
+Test::requireThatLargeDocsumRequestsArePrefetched()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT32));
+    BuildContext bc(s);
+
+    // Prefetch disabled
+    EXPECT_EQUAL(NUM_PREFETCH_DOCS, getDocsumsAndCountStoreReads(bc, 0));
+    // Hit count below the threshold
+    EXPECT_EQUAL(NUM_PREFETCH_DOCS, getDocsumsAndCountStoreReads(bc, NUM_PREFETCH_DOCS + 1));
+    // All hits are prefetched, in several batches
+    EXPECT_EQUAL(0u, getDocsumsAndCountStoreReads(bc, NUM_PREFETCH_DOCS));
+}
+
 void
 addField(Schema & s,
          const std::string &name,
@@ -1257,6 +1378,7 @@ Test::Main()
     TEST_DO(requireThatSummaryAdapterHandlesPutAndRemove());
     TEST_DO(requireThatAdapterHandlesAllFieldTypes());
     TEST_DO(requireThatAdapterHandlesMultipleDocuments());
+    TEST_DO(requireThatAdapterCanPrefetchDocuments());
     TEST_DO(requireThatAdapterHandlesDocumentIdField());
     TEST_DO(requireThatDocsumRequestIsProcessed());
     TEST_DO(requireThatRewritersAreUsed());
@@ -1267,6 +1389,7 @@ Test::Main()
     TEST_DO(requireThatRawFieldsWorks());
     TEST_DO(requireThatFieldCacheRepoCanReturnDefaultFieldCache());
     TEST_DO(requireThatSummariesTimeout());
+    TEST_DO(requireThatLargeDocsumRequestsArePrefetched());
 
     TEST_DONE();
 }
@@ -188,7 +188,7 @@ Fixture::initViewSet(ViewSet &views)
     using IndexManager = proton::index::IndexManager;
     using IndexConfig = proton::index::IndexConfig;
     auto matchers = std::make_shared<Matchers>(_clock, _queryLimiter, _constantValueRepo);
-    auto indexMgr = make_shared<IndexManager>(BASE_DIR, IndexConfig(searchcorespi::index::WarmupConfig(), 2, 0), Schema(), 1,
+    auto indexMgr = make_shared<IndexManager>(BASE_DIR, IndexConfig(searchcorespi::index::WarmupConfig(), 2, 0, 0), Schema(), 1,
                                               views._reconfigurer, views._writeService, _summaryExecutor,
                                               TuneFileIndexManager(), TuneFileAttributes(), views._fileHeaderContext);
     auto attrMgr = make_shared<AttributeManager>(BASE_DIR, "test.subdb", TuneFileAttributes(), views._fileHeaderContext,
@@ -210,7 +210,7 @@ Fixture::initViewSet(ViewSet &views)
     MatchView::SP matchView(new MatchView(matchers, indexSearchable, attrMgr, sesMgr, metaStore, views._docIdLimit));
     views.searchView.set(SearchView::create
                                  (summaryMgr->createSummarySetup(SummaryConfig(), SummarymapConfig(),
-                                                                 JuniperrcConfig(), views.repo, attrMgr),
+                                                                 JuniperrcConfig(), views.repo, attrMgr, 0),
                                   std::move(matchView)));
     views.feedView.set(
             make_shared<SearchableFeedView>(StoreOnlyFeedView::Context(summaryAdapter,
@@ -692,6 +692,7 @@ TEST("require that subdbs should change if relevant config changed")
     EXPECT_FALSE(ReconfigParams(CCR().setMaintenanceChanged(true)).shouldSubDbsChange());
     TEST_DO(assertSubDbsShouldChange(CCR().setFlushChanged(true)));
     TEST_DO(assertSubDbsShouldChange(CCR().setStoreChanged(true)));
+    TEST_DO(assertSubDbsShouldChange(CCR().setSummaryPrefetchChanged(true)));
     TEST_DO(assertSubDbsShouldChange(CCR().setDocumenttypesChanged(true)));
     TEST_DO(assertSubDbsShouldChange(CCR().setDocumentTypeRepoChanged(true)));
     TEST_DO(assertSubDbsShouldChange(CCR().setSummaryChanged(true)));
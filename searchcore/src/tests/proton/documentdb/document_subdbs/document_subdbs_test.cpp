@@ -129,7 +129,7 @@ struct MyStoreOnlyConfig
               SUB_NAME,
               BASE_DIR,
               search::GrowStrategy(),
-              0, 0, SubDbType::READY)
+              0, 0, 0, SubDbType::READY, false)
     {
     }
 };
@@ -0,0 +1,235 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/searchcore/proton/feedoperation/putoperation.h>
+#include <vespa/searchcore/proton/feedoperation/updateoperation.h>
+#include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
+#include <vespa/searchcore/proton/persistenceengine/transport_latch.h>
+#include <vespa/searchcore/proton/server/ddbstate.h>
+#include <vespa/searchcore/proton/server/executorthreadingservice.h>
+#include <vespa/searchcore/proton/server/feedhandler.h>
+#include <vespa/searchcore/proton/server/i_feed_handler_owner.h>
+#include <vespa/searchcore/proton/server/ireplayconfig.h>
+#include <vespa/searchcore/proton/test/bucketfactory.h>
+#include <vespa/searchcore/proton/test/dummy_feed_view.h>
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/time.h>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("feedhandler_bench");
+
+using document::BucketId;
+using document::Document;
+using document::DocumentId;
+using document::DocumentUpdate;
+using document::GlobalId;
+using search::SerialNum;
+using search::index::DocBuilder;
+using search::index::DummyFileHeaderContext;
+using search::index::Schema;
+using search::index::schema::CollectionType;
+using search::index::schema::DataType;
+using search::transactionlog::TransLogServer;
+using storage::spi::Timestamp;
+
+using namespace proton;
+
+namespace {
+
+const vespalib::string tlsDir("feedhandler_bench_tls");
+
+struct MyOwner : public IFeedHandlerOwner
+{
+    void onTransactionLogReplayDone() override { }
+    void enterRedoReprocessState() override { }
+    void onPerformPrune(SerialNum) override { }
+    bool getAllowPrune() const override { return false; }
+};
+
+struct MyResourceWriteFilter : public IResourceWriteFilter
+{
+    bool acceptWriteOperation() const override { return true; }
+    State getAcceptState() const override { return State(); }
+};
+
+struct MyReplayConfig : public IReplayConfig {
+    void replayConfig(SerialNum) override { }
+};
+
+/*
+ * Assigns lids like the document meta store would, in the master write thread.
+ */
+struct LidAssigningFeedView : public test::DummyFeedView {
+    vespalib::hash_map<GlobalId, uint32_t, GlobalId::hash> _lids;
+    uint32_t _nextLid;
+
+    LidAssigningFeedView(const std::shared_ptr<const document::DocumentTypeRepo> &repo)
+        : test::DummyFeedView(repo),
+          _lids(),
+          _nextLid(1)
+    { }
+    ~LidAssigningFeedView() override;
+    void prepareDocumentOperation(DocumentOperation &op, const GlobalId &gid, bool allocate) {
+        auto itr = _lids.find(gid);
+        if (itr != _lids.end()) {
+            op.setPrevDbDocumentId(DbDocumentId(0, itr->second));
+            op.setDbDocumentId(DbDocumentId(0, itr->second));
+        } else if (allocate) {
+            _lids[gid] = _nextLid;
+            op.setDbDocumentId(DbDocumentId(0, _nextLid++));
+        }
+    }
+    void preparePut(PutOperation &op) override {
+        prepareDocumentOperation(op, op.getDocument()->getId().getGlobalId(), true);
+    }
+    void prepareUpdate(UpdateOperation &op) override {
+        prepareDocumentOperation(op, op.getUpdate()->getId().getGlobalId(), false);
+    }
+};
+
+LidAssigningFeedView::~LidAssigningFeedView() = default;
+
+Schema
+makeSchema()
+{
+    Schema schema;
+    schema.addIndexField(Schema::IndexField("body", DataType::STRING, CollectionType::SINGLE));
+    return schema;
+}
+
+vespalib::string
+makeBody()
+{
+    vespalib::string body;
+    while (body.size() < 1000) {
+        body.append("lorem ipsum dolor sit amet ");
+    }
+    return body;
+}
+
+struct Fixture
+{
+    DummyFileHeaderContext          _fileHeaderContext;
+    TransLogServer                  _tls;
+    vespalib::ThreadStackExecutor   _sharedExecutor;
+    ExecutorThreadingService        _writeService;
+    Schema                          _schema;
+    DocBuilder                      _builder;
+    MyOwner                         _owner;
+    MyResourceWriteFilter           _writeFilter;
+    DDBState                        _state;
+    MyReplayConfig                  _replayConfig;
+    LidAssigningFeedView            _feedView;
+    FeedHandler                     _handler;
+
+    Fixture();
+    ~Fixture();
+    void feed(uint32_t numThreads, uint32_t opsPerThread, bool updates);
+};
+
+Fixture::Fixture()
+    : _fileHeaderContext(),
+      _tls("benchtls", 9017, tlsDir, _fileHeaderContext, 0x1000000),
+      _sharedExecutor(1, 0x10000),
+      _writeService(_sharedExecutor),
+      _schema(makeSchema()),
+      _builder(_schema),
+      _owner(),
+      _writeFilter(),
+      _state(),
+      _replayConfig(),
+      _feedView(_builder.getDocumentTypeRepo()),
+      _handler(_writeService, "tcp/localhost:9017", DocTypeName(_builder.getDocumentType().getName()), _state,
+               _owner, _writeFilter, _replayConfig, _tls)
+{
+    _state.enterLoadState();
+    _state.enterReplayTransactionLogState();
+    _handler.setActiveFeedView(&_feedView);
+    _handler.init(1);
+    _handler.changeToNormalFeedState();
+}
+
+Fixture::~Fixture()
+{
+    _writeService.sync();
+    _handler.close();
+}
+
+void
+Fixture::feed(uint32_t numThreads, uint32_t opsPerThread, bool updates)
+{
+    // Build documents and updates up front, the document builder is not thread safe
+    std::vector<std::vector<std::unique_ptr<FeedOperation>>> ops(numThreads);
+    vespalib::string body = makeBody();
+    for (uint32_t thread = 0; thread < numThreads; ++thread) {
+        for (uint32_t i = 0; i < opsPerThread; ++i) {
+            vespalib::string id = vespalib::make_string("id:ns:%s::%u-%u", _builder.getDocumentType().getName().c_str(),
+                                                        thread, i);
+            DocumentId docId(id);
+            BucketId bucketId = test::BucketFactory::getBucketId(docId);
+            Timestamp timestamp(updates ? 2 : 1);
+            if (updates) {
+                auto upd = std::make_shared<DocumentUpdate>(*_builder.getDocumentTypeRepo(), _builder.getDocumentType(), docId);
+                upd->addUpdate(document::FieldUpdate(upd->getType().getField("body"))
+                               .addUpdate(document::AssignValueUpdate(document::StringFieldValue(body))));
+                ops[thread].push_back(std::make_unique<UpdateOperation>(bucketId, timestamp, upd));
+            } else {
+                std::shared_ptr<Document> doc(_builder.startDocument(id).startIndexField("body").addStr(body).endField().endDocument().release());
+                ops[thread].push_back(std::make_unique<PutOperation>(bucketId, timestamp, std::move(doc)));
+            }
+        }
+    }
+    vespalib::Timer timer;
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back([this, &ops, thread, opsPerThread]()
+                             {
+                                 TransportLatch latch(opsPerThread);
+                                 for (auto &op : ops[thread]) {
+                                     _handler.handleOperation(feedtoken::make(latch), std::move(op));
+                                 }
+                                 latch.await();
+                             });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double elapsed = vespalib::to_s(timer.elapsed());
+    uint32_t numOps = numThreads * opsPerThread;
+    fprintf(stderr, "%s: %u threads, %u ops in %8.3f s, %10.0f ops/s\n", updates ? "update" : "put",
+            numThreads, numOps, elapsed, numOps / elapsed);
+}
+
+}
+
+/*
+ * Measures the number of puts and updates per second passing through the
+ * feed handler (master write thread and transaction log) when fed from a
+ * varying number of threads. The feed view only assigns lids, thus
+ * attribute, index and summary writes are not part of the measurement.
+ */
+TEST("measure feed throughput for varying number of feeding threads")
+{
+    vespalib::rmdir(tlsDir, true);
+    {
+        Fixture f;
+        uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (uint32_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            f.feed(numThreads, 20000, false);
+            f.feed(numThreads, 20000, true);
+        }
+    }
+    vespalib::rmdir(tlsDir, true);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
+#include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/feedoperation/pruneremoveddocumentsoperation.h>
 #include <vespa/searchcore/proton/feedoperation/putoperation.h>
 #include <vespa/searchcore/proton/feedoperation/removeoperation.h>
@@ -22,6 +23,8 @@
 #include <vespa/searchcore/proton/server/feedhandler.h>
 #include <vespa/searchcore/proton/server/i_feed_handler_owner.h>
 #include <vespa/searchcore/proton/server/ireplayconfig.h>
+#include <vespa/searchcore/proton/server/tls_mgr_writer.h>
+#include <vespa/searchcore/proton/server/transactionlogmanager.h>
 #include <vespa/searchcore/proton/test/dummy_feed_view.h>
 #include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/searchlib/index/docbuilder.h>
@@ -30,7 +33,10 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <atomic>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP("feedhandler_test");
@@ -189,6 +195,9 @@ struct MyFeedView : public test::DummyFeedView {
     int prune_removed_count;
     int update_count;
     SerialNum update_serial;
+    int end_batch_count;
+    SerialNum end_batch_serial;
+    IDestructorCallback::SP batch_done;
     const DocumentType *documentType;
     MyFeedView(const std::shared_ptr<const DocumentTypeRepo> &dtr,
                const DocTypeName &docTypeName);
@@ -239,6 +248,11 @@ struct MyFeedView : public test::DummyFeedView {
     void handleMove(const MoveOperation &, IDestructorCallback::SP) override { ++move_count; }
     void heartBeat(SerialNum) override { ++heartbeat_count; }
     void handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation &) override { ++prune_removed_count; }
+    void endBatch(SerialNum serialNum, IDestructorCallback::SP onDone) override {
+        ++end_batch_count;
+        end_batch_serial = serialNum;
+        batch_done = std::move(onDone);
+    }
     const ISimpleDocumentMetaStore *getDocumentMetaStorePtr() const override {
         return NULL;
     }
@@ -264,6 +278,9 @@ MyFeedView::MyFeedView(const std::shared_ptr<const DocumentTypeRepo> &dtr, const
       prune_removed_count(0),
       update_count(0),
       update_serial(0),
+      end_batch_count(0),
+      end_batch_serial(0),
+      batch_done(),
       documentType(dtr->getDocumentType(docTypeName.getName()))
 {}
 MyFeedView::~MyFeedView() {}
@@ -434,10 +451,12 @@ struct PutHandler {
 struct MyTlsWriter : TlsWriter {
     int store_count;
     int erase_count;
+    int commit_batch_count;
     bool erase_return;
 
-    MyTlsWriter() : store_count(0), erase_count(0), erase_return(true) {}
+    MyTlsWriter() : store_count(0), erase_count(0), commit_batch_count(0), erase_return(true) {}
     void storeOperation(const FeedOperation &, DoneCallback) override { ++store_count; }
+    void commitBatch() override { ++commit_batch_count; }
     bool erase(SerialNum) override { ++erase_count; return erase_return; }
 
     SerialNum sync(SerialNum syncTo) override {
@@ -602,6 +621,35 @@ TEST_F("require that flush done calls prune", FeedHandlerFixture)
     EXPECT_EQUAL(10u, f.handler.getPrunedSerialNum());
 }
 
+TEST_F("require that batched puts are stored and made visible as one batch", FeedHandlerFixture)
+{
+    f.handler.changeToNormalFeedState();
+    std::vector<std::unique_ptr<FeedTokenContext>> tokens;
+    FeedHandler::OperationBatch ops;
+    for (uint32_t i = 0; i < 3; ++i) {
+        DocumentContext docCtx(vespalib::make_string("id:ns:searchdocument::%u", i), *f.schema.builder);
+        tokens.push_back(std::make_unique<FeedTokenContext>());
+        ops.emplace_back(std::move(tokens.back()->token),
+                         std::make_unique<PutOperation>(docCtx.bucketId, Timestamp(10), std::move(docCtx.doc)));
+    }
+    f.handler.handleOperations(std::move(ops));
+    f.syncMaster();
+    EXPECT_EQUAL(3, f.feedView.put_count);
+    EXPECT_EQUAL(3, f.tls_writer.store_count);
+    EXPECT_EQUAL(1, f.tls_writer.commit_batch_count);
+    EXPECT_EQUAL(1, f.feedView.end_batch_count);
+    EXPECT_EQUAL(f.feedView.put_serial, f.feedView.end_batch_serial);
+    // Not acked before the batch is visible
+    for (const auto &token : tokens) {
+        EXPECT_FALSE(token->await(0));
+    }
+    f.feedView.batch_done.reset();
+    for (const auto &token : tokens) {
+        EXPECT_TRUE(token->await());
+        EXPECT_FALSE(token->getResult()->hasError());
+    }
+}
+
 TEST_F("require that flush in init state delays pruning", FeedHandlerFixture)
 {
     f.handler.flushDone(10);
@@ -811,6 +859,161 @@ TEST_F("require that put with different document type repo is ok", FeedHandlerFi
     EXPECT_EQUAL(1, f.tls_writer.store_count);
 }
 
+/*
+ * Transaction log writer that holds back commits until the gate is opened,
+ * recording the last serial number of each committed packet.
+ */
+struct GatedTlsWriter : search::transactionlog::Writer {
+    search::transactionlog::Writer &_writer;
+    vespalib::Gate                  _gate;
+    std::mutex                      _lock;
+    std::vector<SerialNum>          _committed;
+
+    GatedTlsWriter(search::transactionlog::Writer &writer)
+        : _writer(writer),
+          _gate(),
+          _lock(),
+          _committed()
+    {
+    }
+    void commit(const vespalib::string &domainName, const search::transactionlog::Packet &packet,
+                DoneCallback done) override {
+        _gate.await();
+        _writer.commit(domainName, packet, std::move(done));
+        std::lock_guard<std::mutex> guard(_lock);
+        _committed.push_back(packet.range().to());
+    }
+    void open() { _gate.countDown(); }
+    std::vector<SerialNum> committed() {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _committed;
+    }
+};
+
+std::vector<SerialNum>
+serialNums(SerialNum first, SerialNum last)
+{
+    std::vector<SerialNum> result;
+    for (SerialNum serialNum = first; serialNum <= last; ++serialNum) {
+        result.push_back(serialNum);
+    }
+    return result;
+}
+
+void
+assertCommitted(const std::vector<SerialNum> &exp, const std::vector<SerialNum> &act)
+{
+    ASSERT_EQUAL(exp.size(), act.size());
+    for (size_t i = 0; i < exp.size(); ++i) {
+        EXPECT_EQUAL(exp[i], act[i]);
+    }
+}
+
+struct TlsMgrWriterFixture
+{
+    DummyFileHeaderContext _fileHeaderContext;
+    TransLogServer         tls;
+    TransactionLogManager  tls_mgr;
+    GatedTlsWriter         gated_writer;
+    TlsMgrWriter           writer;
+
+    static vespalib::string nextDomainName() {
+        static int domainId = 0;
+        return vespalib::make_string("tlsmgrwriter%d", ++domainId);
+    }
+    TlsMgrWriterFixture(uint32_t appendTaskLimit = TlsMgrWriter::defaultAppendTaskLimit)
+        : _fileHeaderContext(),
+          tls("mytls", 9016, "mytlsdir", _fileHeaderContext, 0x10000),
+          tls_mgr("tcp/localhost:9016", nextDomainName()),
+          gated_writer(tls),
+          writer(tls_mgr, &gated_writer, appendTaskLimit)
+    {
+        SerialNum prunedSerialNum = 0;
+        SerialNum serialNum = 0;
+        tls_mgr.init(0, prunedSerialNum, serialNum);
+    }
+    ~TlsMgrWriterFixture() {
+        gated_writer.open();
+    }
+    void store(SerialNum serialNum) {
+        writer.storeOperation(NoopOperation(serialNum), IDestructorCallback::SP());
+    }
+    void store(SerialNum first, SerialNum last) {
+        for (SerialNum serialNum = first; serialNum <= last; ++serialNum) {
+            store(serialNum);
+        }
+    }
+};
+
+struct SmallQueueTlsMgrWriterFixture : public TlsMgrWriterFixture
+{
+    SmallQueueTlsMgrWriterFixture() : TlsMgrWriterFixture(2) {}
+};
+
+TEST_F("require that tls mgr writer appends operations in the order they are stored", TlsMgrWriterFixture)
+{
+    f.gated_writer.open();
+    f.store(1, 100);
+    f.writer.startBatch();
+    f.store(101, 110);
+    f.writer.commitBatch();
+    f.store(111, 120);
+    EXPECT_EQUAL(120u, f.writer.sync(120));
+    auto exp = serialNums(1, 100);
+    exp.push_back(110);
+    for (SerialNum serialNum : serialNums(111, 120)) {
+        exp.push_back(serialNum);
+    }
+    TEST_DO(assertCommitted(exp, f.gated_writer.committed()));
+}
+
+TEST_F("require that tls mgr writer sync waits for queued appends", TlsMgrWriterFixture)
+{
+    f.store(1, 5);
+    std::atomic<bool> synced(false);
+    std::thread syncThread([&]() { f.writer.sync(5); synced = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(synced);
+    EXPECT_EQUAL(0u, f.gated_writer.committed().size());
+    f.gated_writer.open();
+    syncThread.join();
+    EXPECT_TRUE(synced);
+    TEST_DO(assertCommitted(serialNums(1, 5), f.gated_writer.committed()));
+}
+
+TEST_F("require that tls mgr writer erase waits for queued appends", TlsMgrWriterFixture)
+{
+    f.store(1, 5);
+    std::atomic<bool> erased(false);
+    std::thread eraseThread([&]() { EXPECT_TRUE(f.writer.erase(3)); erased = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(erased);
+    EXPECT_EQUAL(0u, f.gated_writer.committed().size());
+    f.gated_writer.open();
+    eraseThread.join();
+    EXPECT_TRUE(erased);
+    TEST_DO(assertCommitted(serialNums(1, 5), f.gated_writer.committed()));
+}
+
+TEST_F("require that tls mgr writer blocks instead of dropping operations when append queue is full",
+       SmallQueueTlsMgrWriterFixture)
+{
+    std::atomic<SerialNum> stored(0);
+    std::thread storeThread([&]() {
+        for (SerialNum serialNum = 1; serialNum <= 10; ++serialNum) {
+            f.store(serialNum);
+            stored = serialNum;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_LESS(stored.load(), 10u);
+    f.gated_writer.open();
+    storeThread.join();
+    EXPECT_EQUAL(10u, stored.load());
+    EXPECT_EQUAL(10u, f.writer.sync(10));
+    TEST_DO(assertCommitted(serialNums(1, 10), f.gated_writer.committed()));
+}
+
 }  // namespace
 
 TEST_MAIN()
@@ -223,12 +223,14 @@ struct MyDocumentStore : public test::DummyDocumentStore
     DocMap           _docs;
     uint64_t         _lastSyncToken;
     uint32_t         _compactLidSpaceLidLimit;
+    uint32_t         _serializedWrites;
     MyDocumentStore(const document::DocumentTypeRepo & repo)
         : test::DummyDocumentStore("."),
           _repo(repo),
           _docs(),
           _lastSyncToken(0),
-          _compactLidSpaceLidLimit(0)
+          _compactLidSpaceLidLimit(0),
+          _serializedWrites(0)
     {}
     ~MyDocumentStore() override;
     Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &) const override {
@@ -245,6 +247,7 @@ struct MyDocumentStore : public test::DummyDocumentStore
     }
     void write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostream & os) override {
         _lastSyncToken = syncToken;
+        ++_serializedWrites;
         _docs[lid] = std::make_shared<Document>(_repo, const_cast<vespalib::nbostream &>(os));
     }
     void remove(uint64_t syncToken, DocumentIdT lid) override {
@@ -827,6 +830,19 @@ TEST_F("require that put() calls attribute adapter", SearchableFeedViewFixture)
     EXPECT_EQUAL(2u, f._docIdLimit.get());
 }
 
+TEST_F("require that put() writes preserialized document to document store", SearchableFeedViewFixture)
+{
+    DocumentContext dc = f.doc1();
+    FeedTokenContext token(f._tracer);
+    PutOperation op(dc.bid, dc.ts, dc.doc);
+    op.preSerialize();
+    f.runInMaster([&] () { f.performPut(token.ft, op); });
+
+    EXPECT_EQUAL(1u, f.msa._store._serializedWrites);
+    ASSERT_EQUAL(1u, f.msa._store._docs.size());
+    EXPECT_TRUE(*dc.doc == *f.msa._store._docs[1]);
+}
+
 TEST_F("require that put() notifies gid to lid change handler", SearchableFeedViewFixture)
 {
     DocumentContext dc1 = f.doc1(10);
@@ -284,14 +284,17 @@ struct JobTestBase : public ::testing::Test {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t moveBatchSize = 1,
+              uint32_t incrementalShrinkStep = 0)
     {
         _handler = std::make_unique<MyHandler>(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS);
         _job = std::make_unique<LidSpaceCompactionJob>(DocumentDBLidSpaceCompactionConfig(interval, allowedLidBloat,
                                                                                           allowedLidBloatFactor,
                                                                                           REMOVE_BATCH_BLOCK_RATE,
                                                                                           REMOVE_BLOCK_RATE,
-                                                                                          false, maxDocsToScan),
+                                                                                          false, maxDocsToScan,
+                                                                                          moveBatchSize, incrementalShrinkStep),
                                                        *_handler, _storer, _frozenHandler, _diskMemUsageNotifier,
                                                        BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps),
                                                        _clusterStateHandler, nodeRetired);
@@ -391,8 +394,11 @@ struct JobTest : public JobTestBase {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS) {
-        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired, maxOutstandingMoveOps);
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t moveBatchSize = 1,
+              uint32_t incrementalShrinkStep = 0) {
+        JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor, interval, nodeRetired,
+                          maxOutstandingMoveOps, moveBatchSize, incrementalShrinkStep);
         _jobRunner = std::make_unique<MyDirectJobRunner>(*_job);
     }
     void init_with_interval(vespalib::duration interval) {
@@ -401,6 +407,11 @@ struct JobTest : public JobTestBase {
     void init_with_node_retired(bool retired) {
         init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, JOB_DELAY, retired);
     }
+    void init_with_move_batch(uint32_t moveBatchSize, uint32_t incrementalShrinkStep = 0,
+                              vespalib::duration interval = JOB_DELAY) {
+        init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR, interval, false,
+             MAX_OUTSTANDING_MOVE_OPS, moveBatchSize, incrementalShrinkStep);
+    }
 };
 
 struct HandlerTest : public ::testing::Test {
@@ -472,6 +483,52 @@ TEST_F(JobTest, job_returns_false_when_multiple_move_operations_or_compaction_ar
     assertJobContext(4, 7, 3, 7, 1);
 }
 
+TEST_F(JobTest, multiple_move_operations_are_created_in_one_run_when_move_batch_size_allows_it)
+{
+    init_with_move_batch(3);
+    setupThreeDocumentsToCompact();
+    EXPECT_FALSE(run()); // move 9 -> 2, 8 -> 3, 7 -> 4
+    assertJobContext(4, 7, 3, 0, 0);
+    endScan().compact();
+    assertJobContext(4, 7, 3, 7, 1);
+}
+
+TEST_F(JobTest, lid_space_is_compacted_incrementally_when_shrink_step_is_reached)
+{
+    init_with_move_batch(1, 2);
+    _handler->_lids = {{1,5,6,9,8,7}};
+    addStats(10, 6, 2, 9);  // 30% bloat: move 9 -> 2
+    addStats(10, 6, 3, 8);  // move 8 -> 3
+    addStats(10, 6, 4, 7);  // move 7 -> 4, and lid limit (10) >= 7 + 1 + 2
+    addStats(8, 6, 7, 6);   // no documents to move
+    EXPECT_FALSE(run());
+    assertJobContext(2, 9, 1, 0, 0);
+    EXPECT_FALSE(run());
+    assertJobContext(3, 8, 2, 8, 1);
+    EXPECT_FALSE(run());
+    assertJobContext(4, 7, 3, 8, 1);
+    endScan().compact();
+    assertJobContext(4, 7, 3, 7, 2);
+}
+
+TEST_F(JobTest, lid_space_is_compacted_incrementally_at_most_once_per_job_interval)
+{
+    init_with_move_batch(1, 1, 1h);
+    _handler->_lids = {{1,5,6,9,8,7}};
+    addStats(10, 6, 2, 9);  // 30% bloat: move 9 -> 2
+    addStats(10, 6, 3, 8);  // move 8 -> 3, and lid limit (10) >= 8 + 1 + 1
+    addStats(10, 6, 4, 7);  // move 7 -> 4
+    addStats(10, 6, 7, 6);  // no documents to move
+    EXPECT_FALSE(run());
+    assertJobContext(2, 9, 1, 9, 1);
+    EXPECT_FALSE(run());
+    assertJobContext(3, 8, 2, 9, 1);
+    EXPECT_FALSE(run());
+    assertJobContext(4, 7, 3, 9, 1);
+    endScan().compact();
+    assertJobContext(4, 7, 3, 7, 2);
+}
+
 TEST_F(JobTest, job_is_blocked_if_trying_to_move_document_for_frozen_bucket)
 {
     _frozenHandler._bucket = BUCKET_ID_1;
@@ -720,9 +777,10 @@ struct MaxOutstandingJobTest : public JobTest {
         : JobTest(),
           runner()
     {}
-    void init(uint32_t maxOutstandingMoveOps) {
+    void init(uint32_t maxOutstandingMoveOps, uint32_t moveBatchSize = 1, uint32_t incrementalShrinkStep = 0) {
         JobTest::init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN,
-                      RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, maxOutstandingMoveOps);
+                      RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, maxOutstandingMoveOps, moveBatchSize,
+                      incrementalShrinkStep);
         runner = std::make_unique<MyCountJobRunner>(*_job);
     }
     void assertRunToBlocked() {
@@ -781,4 +839,34 @@ TEST_F(MaxOutstandingJobTest, job_is_blocked_if_it_has_too_many_outstanding_move
     assertJobContext(4, 7, 3, 7, 1);
 }
 
+TEST_F(MaxOutstandingJobTest, move_batch_is_limited_by_max_outstanding_move_operations)
+{
+    init(2, 3);
+    setupThreeDocumentsToCompact();
+
+    assertRunToBlocked();
+    assertJobContext(3, 8, 2, 0, 0);
+
+    unblockJob(1);
+    assertRunToNotBlocked(); // move 7 -> 4 and end scan
+    assertJobContext(4, 7, 3, 0, 0);
+    compact();
+    assertJobContext(4, 7, 3, 7, 1);
+}
+
+TEST_F(MaxOutstandingJobTest, lid_space_is_not_compacted_incrementally_when_move_batch_is_blocked)
+{
+    init(2, 3, 1);
+    setupThreeDocumentsToCompact();
+
+    assertRunToBlocked(); // move 9 -> 2, 8 -> 3
+    assertJobContext(3, 8, 2, 0, 0);
+
+    unblockJob(1);
+    assertRunToNotBlocked(); // move 7 -> 4, compact lid space and end scan
+    assertJobContext(4, 7, 3, 7, 1);
+    compact();
+    assertJobContext(4, 7, 3, 7, 2);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -644,6 +644,137 @@ TEST(DocumentMetaStoreTest, gids_can_be_saved_and_loaded)
     }
 }
 
+DocumentMetaStore::SP
+makeGidHashIndexedDms()
+{
+    return std::make_shared<DocumentMetaStore>(createBucketDB(), DocumentMetaStore::getFixedName(), GrowStrategy(),
+                                               std::make_shared<DocumentMetaStore::DefaultGidCompare>(),
+                                               SubDbType::READY, true);
+}
+
+TEST(DocumentMetaStoreTest, gid_hash_index_follows_put_remove_and_move)
+{
+    auto dmsSP = makeGidHashIndexedDms();
+    DocumentMetaStore &dms = *dmsSP;
+    EXPECT_TRUE(dms.hasGidHashIndex());
+    dms.constructFreeList();
+    assertPut(bucketId1, time1, 1u, gid1, dms);
+    assertPut(bucketId2, time2, 2u, gid2, dms);
+    assertPut(bucketId3, time3, 3u, gid3, dms);
+    assertLid(1u, gid1, dms);
+    assertLid(2u, gid2, dms);
+    assertLid(3u, gid3, dms);
+    uint32_t lid = 0u;
+    EXPECT_FALSE(dms.getLid(gid4, lid));
+    EXPECT_EQ(2u, dms.inspectExisting(gid2).getLid());
+    EXPECT_FALSE(dms.inspectExisting(gid4).ok());
+    EXPECT_TRUE(dms.remove(1u));
+    dms.removeComplete(1u);
+    EXPECT_FALSE(dms.getLid(gid1, lid));
+    dms.move(3u, 1u);
+    dms.removeComplete(3u);
+    assertLid(1u, gid3, dms);
+    assertLid(2u, gid2, dms);
+    dms.removeAllOldGenerations();
+    assertPut(bucketId4, time4, 3u, gid4, dms);
+    assertLid(3u, gid4, dms);
+    EXPECT_FALSE(dms.getLid(gid1, lid));
+}
+
+TEST(DocumentMetaStoreTest, gid_hash_index_is_built_on_load)
+{
+    DocumentMetaStore dms1(createBucketDB(), "documentmetastore_gidhash");
+    dms1.constructFreeList();
+    uint32_t numLids = 1000;
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        GlobalId gid = createGid(lid);
+        BucketId bucketId(gid.convertToBucketId());
+        bucketId.setUsedBits(numBucketBits);
+        EXPECT_EQ(lid, addGid(dms1, gid, bucketId, Timestamp(lid + timestampBias)));
+    }
+    TuneFileAttributes tuneFileAttributes;
+    DummyFileHeaderContext fileHeaderContext;
+    AttributeFileSaveTarget saveTarget(tuneFileAttributes, fileHeaderContext);
+    EXPECT_TRUE(dms1.save(saveTarget, "documentmetastore_gidhash"));
+
+    DocumentMetaStore dms2(createBucketDB(), "documentmetastore_gidhash", GrowStrategy(),
+                           std::make_shared<DocumentMetaStore::DefaultGidCompare>(), SubDbType::READY, true);
+    EXPECT_TRUE(dms2.load());
+    dms2.constructFreeList();
+    for (uint32_t lid = 1; lid <= numLids; ++lid) {
+        assertLid(lid, createGid(lid), dms2);
+    }
+}
+
+namespace {
+
+/**
+ * Returns gid lookups per second per thread, with each thread looking up all gids loops times.
+ */
+double
+measureGidLookups(const DocumentMetaStore &dms, const std::vector<GlobalId> &gids, uint32_t loops, uint32_t numThreads)
+{
+    std::atomic<size_t> found(0);
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&dms, &gids, &found, loops]() {
+            size_t threadFound = 0;
+            uint32_t lid = 0;
+            for (uint32_t loop = 0; loop < loops; ++loop) {
+                for (const GlobalId &gid : gids) {
+                    if (dms.getLid(gid, lid)) {
+                        ++threadFound;
+                    }
+                }
+            }
+            found += threadFound;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double seconds = vespalib::to_s(vespalib::steady_clock::now() - start);
+    EXPECT_EQ(gids.size() * loops * numThreads, found.load());
+    return (gids.size() * loops) / seconds;
+}
+
+void
+fillGids(DocumentMetaStore &dms, const std::vector<GlobalId> &gids)
+{
+    dms.constructFreeList();
+    for (uint32_t i = 0; i < gids.size(); ++i) {
+        BucketId bucketId(gids[i].convertToBucketId());
+        bucketId.setUsedBits(numBucketBits);
+        addGid(dms, gids[i], bucketId, Timestamp(i + 1 + timestampBias));
+    }
+}
+
+}
+
+// Run with --gtest_also_run_disabled_tests to compare gets/sec per core.
+TEST(DocumentMetaStoreTest, DISABLED_benchmark_btree_and_gid_hash_index_lookups)
+{
+    constexpr uint32_t numDocs = 1000000;
+    constexpr uint32_t loops = 5;
+    std::vector<GlobalId> gids;
+    gids.reserve(numDocs);
+    for (uint32_t i = 1; i <= numDocs; ++i) {
+        gids.push_back(createGid(i));
+    }
+    DocumentMetaStore btreeDms(createBucketDB());
+    fillGids(btreeDms, gids);
+    auto hashDms = makeGidHashIndexedDms();
+    fillGids(*hashDms, gids);
+    uint32_t maxThreads = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    for (uint32_t numThreads : {1u, maxThreads}) {
+        double btreeRate = measureGidLookups(btreeDms, gids, loops, numThreads);
+        double hashRate = measureGidLookups(*hashDms, gids, loops, numThreads);
+        LOG(info, "%u docs, %u threads: btree %10.0f gets/sec/core, gid hash index %10.0f gets/sec/core",
+            numDocs, numThreads, btreeRate, hashRate);
+    }
+}
+
 TEST(DocumentMetaStore, stats_are_updated)
 {
     DocumentMetaStore dms(createBucketDB());
@@ -192,7 +192,8 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                               false /* dynamicKPosOccFormat */,
                               tuneFileIndexing,
                               fileHeaderContext,
-                              sharedExecutor);
+                              sharedExecutor,
+                              0 /* maxConcurrentFields */);
     ASSERT_TRUE(fret2);
 
     // Fusion test with all docs removed in output (doesn't affect word list)
@@ -210,7 +211,8 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                               false /* dynamicKPosOccFormat */,
                               tuneFileIndexing,
                               fileHeaderContext,
-                              sharedExecutor);
+                              sharedExecutor,
+                              0 /* maxConcurrentFields */);
     ASSERT_TRUE(fret4);
 
     // Fusion test with all docs removed in input (affects word list)
@@ -228,7 +230,8 @@ void Test::requireThatMemoryIndexCanBeDumpedAndSearched() {
                               false /* dynamicKPosOccFormat */,
                               tuneFileIndexing,
                               fileHeaderContext,
-                              sharedExecutor);
+                              sharedExecutor,
+                              0 /* maxConcurrentFields */);
     ASSERT_TRUE(fret6);
 
     DiskIndex disk_index(index_dir);
@@ -282,6 +282,38 @@ TEST_F("require that we can serialize and deserialize put operations", Fixture)
     }
 }
 
+TEST_F("require that pre-serialized put and update operations serialize to the same bytes", Fixture)
+{
+    BucketId bucket(toBucket(docId.getGlobalId()));
+    auto doc(f.makeDoc());
+    auto upd(f.makeUpdate());
+    {
+        vespalib::nbostream expStream;
+        vespalib::nbostream stream;
+        PutOperation expOp(bucket, Timestamp(10), doc);
+        expOp.serialize(expStream);
+        PutOperation op(bucket, Timestamp(10), doc);
+        op.preSerialize();
+        op.serialize(stream);
+        ASSERT_EQUAL(expStream.size(), stream.size());
+        EXPECT_EQUAL(0, memcmp(expStream.peek(), stream.peek(), stream.size()));
+        EXPECT_EQUAL(expOp.getSerializedDocSize(), op.getSerializedDocSize());
+        op.deserializeDocument(*f._repo);
+        EXPECT_EQUAL(*doc, *op.getDocument());
+    }
+    {
+        vespalib::nbostream expStream;
+        vespalib::nbostream stream;
+        UpdateOperation expOp(bucket, Timestamp(10), upd);
+        expOp.serialize(expStream);
+        UpdateOperation op(bucket, Timestamp(10), upd);
+        op.preSerialize();
+        op.serialize(stream);
+        ASSERT_EQUAL(expStream.size(), stream.size());
+        EXPECT_EQUAL(0, memcmp(expStream.peek(), stream.peek(), stream.size()));
+    }
+}
+
 TEST_F("require that we can serialize and deserialize move operations", Fixture)
 {
     vespalib::nbostream stream;
@@ -9,6 +9,7 @@
 #include <vespa/searchcore/proton/server/igetserialnum.h>
 #include <vespa/searchcore/proton/test/dummy_flush_handler.h>
 #include <vespa/searchcore/proton/test/dummy_flush_target.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -417,6 +418,32 @@ public:
     vespalib::string    _name;
 };
 
+using search::common::FlushIoThrottle;
+
+class IoPriorityTask : public FlushTask
+{
+public:
+    IoPriorityTask(FlushIoThrottle::Priority & priority, vespalib::Gate & done) :
+        _priority(priority),
+        _done(done)
+    { }
+    void run() override {
+        _priority = FlushIoThrottle::currentPriority();
+        _done.countDown();
+    }
+    search::SerialNum getFlushSerial() const override { return 0u; }
+    FlushIoThrottle::Priority & _priority;
+    vespalib::Gate            & _done;
+};
+
+class UrgentTarget : public SimpleTarget {
+public:
+    UrgentTarget(Task::UP task, const std::string &name)
+        : SimpleTarget(std::move(task), name)
+    { }
+    bool needUrgentFlush() const override { return true; }
+};
+
 
 struct Fixture
 {
@@ -486,6 +513,26 @@ TEST_F("require that strategy controls flush target", Fixture(1, IINTERVAL))
     EXPECT_EQUAL("bar", order[1]);
 }
 
+TEST_F("require that urgent targets are flushed with urgent io priority", Fixture(1, IINTERVAL))
+{
+    vespalib::Gate urgentG, normalG;
+    FlushIoThrottle::Priority urgentPriority(FlushIoThrottle::Priority::BACKGROUND);
+    FlushIoThrottle::Priority normalPriority(FlushIoThrottle::Priority::URGENT);
+    auto urgent = std::make_shared<UrgentTarget>(std::make_unique<IoPriorityTask>(urgentPriority, urgentG), "urgent");
+    auto normal = std::make_shared<SimpleTarget>(std::make_unique<IoPriorityTask>(normalPriority, normalG), "normal");
+    f.addTargetToStrategy(urgent);
+    f.addTargetToStrategy(normal);
+
+    auto handler = std::make_shared<SimpleHandler>(Targets({normal, urgent}), "anon");
+    f.putFlushHandler("anon", handler);
+    f.engine.start();
+
+    EXPECT_TRUE(urgentG.await(LONG_TIMEOUT));
+    EXPECT_TRUE(normalG.await(LONG_TIMEOUT));
+    EXPECT_TRUE(urgentPriority == FlushIoThrottle::Priority::URGENT);
+    EXPECT_TRUE(normalPriority == FlushIoThrottle::Priority::BACKGROUND);
+}
+
 TEST_F("require that zero handlers does not core", Fixture(2, 50))
 {
     f.engine.start();
@@ -89,7 +89,7 @@ public:
           _sharedExecutor(1, 0x10000),
           _threadingService(_sharedExecutor),
           _ops(_fileHeaderContext,
-               TuneFileIndexManager(), 0,
+               TuneFileIndexManager(), 0, 1,
                _threadingService)
     {}
     ~Test() {}
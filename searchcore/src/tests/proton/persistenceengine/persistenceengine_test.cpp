@@ -155,6 +155,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
     Result                       _splitResult;
     Result                       _joinResult;
     Result                       _createBucketResult;
+    uint32_t                     putBatches;
     const Document *document;
     std::multiset<uint64_t> frozen;
     std::multiset<uint64_t> was_frozen;
@@ -175,6 +176,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
           _splitResult(),
           _joinResult(),
           _createBucketResult(),
+          putBatches(0),
           document(0),
           frozen(),
           was_frozen()
@@ -203,6 +205,13 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
         handle(token, bucket, timestamp, doc->getId());
     }
 
+    void handlePutBatch(const Bucket& bucket, std::vector<BatchedPut> puts) override {
+        ++putBatches;
+        for (auto &put : puts) {
+            handlePut(std::move(put.token), bucket, put.timestamp, std::move(put.doc));
+        }
+    }
+
     void handleUpdate(FeedToken token, const Bucket& bucket,
                       Timestamp timestamp, const document::DocumentUpdate::SP& upd) override {
         token->setResult(ResultUP(new storage::spi::UpdateResult(existingTimestamp)), existingTimestamp > 0);
@@ -393,6 +402,13 @@ struct SimpleResourceWriteFilter : public IResourceWriteFilter
 };
 
 
+struct MyOperationComplete : public storage::spi::OperationComplete {
+    Result &_result;
+    MyOperationComplete(Result &result) : _result(result) {}
+    void onComplete(std::unique_ptr<Result> result) override { _result = *result; }
+    void addResultHandler(const storage::spi::ResultHandler *) override { }
+};
+
 struct SimpleFixture {
     SimplePersistenceEngineOwner _owner;
     SimpleResourceWriteFilter _writeFilter;
@@ -470,6 +486,25 @@ TEST_F("require that puts are routed to handler", SimpleFixture)
 }
 
 
+TEST_F("require that put batches are routed to handlers by document type", SimpleFixture)
+{
+    storage::spi::LoadType loadType(0, "default");
+    Context context(loadType, storage::spi::Priority(0), storage::spi::Trace::TraceLevel(0));
+    std::vector<Result> results(3, Result(Result::ErrorType::TRANSIENT_ERROR, "not completed"));
+    std::vector<PersistenceProvider::BatchedPut> puts;
+    puts.push_back({tstamp1, doc1, std::make_unique<MyOperationComplete>(results[0])});
+    puts.push_back({tstamp1, doc2, std::make_unique<MyOperationComplete>(results[1])});
+    puts.push_back({tstamp1, doc3, std::make_unique<MyOperationComplete>(results[2])});
+    f.engine.putBatchAsync(bucket1, std::move(puts), context);
+    TEST_DO(assertHandler(bucket1, tstamp1, docId1, f.hset.handler1));
+    TEST_DO(assertHandler(bucket1, tstamp1, docId2, f.hset.handler2));
+    EXPECT_EQUAL(1u, f.hset.handler1.putBatches);
+    EXPECT_EQUAL(1u, f.hset.handler2.putBatches);
+    EXPECT_EQUAL(Result(), results[0]);
+    EXPECT_EQUAL(Result(), results[1]);
+    EXPECT_EQUAL(Result(Result::ErrorType::PERMANENT_ERROR, "No handler for document type 'type3'"), results[2]);
+}
+
 TEST_F("require that put is rejected if resource limit is reached", SimpleFixture)
 {
     f._writeFilter._acceptWriteOperation = false;
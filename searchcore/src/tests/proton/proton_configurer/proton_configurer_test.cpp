@@ -92,6 +92,7 @@ struct DBConfigFixture {
              buildSchema(),
              std::make_shared<DocumentDBMaintenanceConfig>(),
              search::LogDocumentStore::Config(),
+             0,
              configId,
              docTypeName);
     }
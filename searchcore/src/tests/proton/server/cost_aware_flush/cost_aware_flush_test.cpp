@@ -0,0 +1,216 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchcore/proton/flushengine/flushcontext.h>
+#include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
+#include <vespa/searchcore/proton/server/cost_aware_flush.h>
+#include <vespa/searchcore/proton/test/dummy_flush_target.h>
+#include <vespa/vespalib/data/slime/slime.h>
+
+using vespalib::steady_time;
+using vespalib::system_time;
+using search::SerialNum;
+using namespace proton;
+using namespace searchcorespi;
+
+using MemoryGain = IFlushTarget::MemoryGain;
+using DiskGain = IFlushTarget::DiskGain;
+using StringList = std::vector<vespalib::string>;
+
+namespace {
+
+constexpr uint64_t gibi = UINT64_C(1024) * UINT64_C(1024) * UINT64_C(1024);
+const system_time startTime = system_time();
+const system_time now = startTime + std::chrono::hours(2);
+const steady_time budgetStart = steady_time();
+
+}
+
+class MyFlushHandler : public IFlushHandler {
+public:
+    MyFlushHandler(const vespalib::string &name) : IFlushHandler(name) {}
+    std::vector<IFlushTarget::SP> getFlushTargets() override { return std::vector<IFlushTarget::SP>(); }
+    SerialNum getCurrentSerialNumber() const override { return 0; }
+    void flushDone(SerialNum) override { }
+    void syncTls(SerialNum) override { }
+};
+
+class MyFlushTarget : public test::DummyFlushTarget {
+public:
+    MemoryGain    _memoryGain;
+    SerialNum     _flushedSerial;
+    system_time   _lastFlushTime;
+    uint64_t      _bytesToWrite;
+    double        _replayOperationCost;
+    bool          _urgentFlush;
+
+    MyFlushTarget(const vespalib::string &name, MemoryGain memoryGain, SerialNum flushedSerial, uint64_t bytesToWrite)
+        : test::DummyFlushTarget(name),
+          _memoryGain(memoryGain),
+          _flushedSerial(flushedSerial),
+          _lastFlushTime(),
+          _bytesToWrite(bytesToWrite),
+          _replayOperationCost(0.0),
+          _urgentFlush(false)
+    { }
+    MemoryGain getApproxMemoryGain() const override { return _memoryGain; }
+    SerialNum getFlushedSerialNum() const override { return _flushedSerial; }
+    system_time getLastFlushTime() const override { return _lastFlushTime; }
+    bool needUrgentFlush() const override { return _urgentFlush; }
+    uint64_t getApproxBytesToWriteToDisk() const override { return _bytesToWrite; }
+    double get_replay_operation_cost() const override { return _replayOperationCost; }
+};
+
+struct Fixture {
+    IFlushHandler::SP             _handler;
+    FlushContext::List            _list;
+    flushengine::TlsStatsMap::Map _tlsStats;
+
+    Fixture()
+        : _handler(std::make_shared<MyFlushHandler>("myhandler")),
+          _list(),
+          _tlsStats()
+    {
+        _tlsStats[_handler->getName()] = flushengine::TlsStats(0, 0, 0);
+    }
+    std::shared_ptr<MyFlushTarget> add(const vespalib::string &name, MemoryGain memoryGain, SerialNum flushedSerial,
+                                       uint64_t bytesToWrite, SerialNum lastSerial = 0) {
+        auto target = std::make_shared<MyFlushTarget>(name, memoryGain, flushedSerial, bytesToWrite);
+        _list.push_back(std::make_shared<FlushContext>(_handler, target, lastSerial));
+        return target;
+    }
+    flushengine::TlsStatsMap tlsStats() const {
+        flushengine::TlsStatsMap::Map map(_tlsStats);
+        return flushengine::TlsStatsMap(std::move(map));
+    }
+    FlushContext::List getFlushTargets(const CostAwareFlush &flush, steady_time budgetNow = budgetStart) const {
+        return flush.getFlushTargets(_list, tlsStats(), now, budgetNow);
+    }
+};
+
+bool
+assertOrder(const StringList &exp, const FlushContext::List &act)
+{
+    if (!EXPECT_EQUAL(exp.size(), act.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < exp.size(); ++i) {
+        if (!EXPECT_EQUAL(exp[i], act[i]->getTarget()->getName())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CostAwareFlush::Config
+limits(uint64_t maxGlobalMemory, uint64_t maxGlobalTlsSize, vespalib::duration maxTimeGain)
+{
+    return CostAwareFlush::Config(maxGlobalMemory, maxGlobalTlsSize, 10.0, 1000000, 10.0, maxTimeGain);
+}
+
+CostAwareFlush::CostConfig
+costs(double writeBudgetRate, uint64_t writeBudgetBurst)
+{
+    return CostAwareFlush::CostConfig(8.0, 3000.0, 1.0, writeBudgetRate, writeBudgetBurst);
+}
+
+TEST_F("require that nothing is flushed when no limits are reached", Fixture)
+{
+    f.add("t1", MemoryGain(100, 0), 0, 100);
+    CostAwareFlush flush(limits(1000, 20 * gibi, std::chrono::hours(24)), costs(0.0, 0), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({}, f.getFlushTargets(flush)));
+}
+
+TEST_F("require that memory forced targets are ordered by benefit per written byte", Fixture)
+{
+    f.add("t1", MemoryGain(100, 0), 0, 1000);
+    f.add("t2", MemoryGain(100, 0), 0, 100);
+    f.add("t3", MemoryGain(50, 0), 0, 10);
+    CostAwareFlush flush(limits(200, 20 * gibi, std::chrono::hours(24)), costs(1.0, 1), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t3", "t2", "t1"}, f.getFlushTargets(flush)));
+}
+
+TEST_F("require that urgent targets are ordered first", Fixture)
+{
+    f.add("t1", MemoryGain(100, 0), 0, 10);
+    f.add("t2", MemoryGain(0, 0), 0, 1000)->_urgentFlush = true;
+    CostAwareFlush flush(limits(50, 20 * gibi, std::chrono::hours(24)), costs(0.0, 0), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t2", "t1"}, f.getFlushTargets(flush)));
+}
+
+TEST_F("require that tls size forced targets are ordered by saved replay cost per written byte", Fixture)
+{
+    f._tlsStats["myhandler"] = flushengine::TlsStats(1000, 11, 110);
+    f.add("t1", MemoryGain(), 10, 1000, 110); // needs all 1000 bytes of tls
+    f.add("t2", MemoryGain(), 60, 100, 110);  // needs 500 bytes of tls
+    CostAwareFlush flush(limits(1000, 500, std::chrono::hours(24)), costs(1.0, 1), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t2", "t1"}, f.getFlushTargets(flush)));
+}
+
+TEST_F("require that replay operation cost is part of the benefit", Fixture)
+{
+    f._tlsStats["myhandler"] = flushengine::TlsStats(1000, 11, 110);
+    f.add("t1", MemoryGain(), 60, 100, 110);
+    f.add("t2", MemoryGain(), 60, 100, 110)->_replayOperationCost = 1.0;
+    CostAwareFlush flush(limits(1000, 500, std::chrono::hours(24)), costs(1.0, 1), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t2", "t1"}, f.getFlushTargets(flush)));
+    auto decision = flush.getLastDecision();
+    ASSERT_EQUAL(2u, decision.size());
+    EXPECT_EQUAL(500u, decision[0].tlsReplayBytes);
+    EXPECT_EQUAL(50u, decision[0].replayOperations);
+    EXPECT_EQUAL(8.0 * 500, decision[0].benefit);
+    EXPECT_EQUAL(8.0 * 500 + 3000.0 * 50, decision[1].benefit);
+}
+
+TEST_F("require that age triggered targets are limited by write budget", Fixture)
+{
+    f.add("t1", MemoryGain(10, 0), 0, 600);
+    f.add("t2", MemoryGain(5, 0), 0, 600);
+    f.add("t3", MemoryGain(1, 0), 0, 300);
+    CostAwareFlush flush(limits(1000, 20 * gibi, std::chrono::hours(1)), costs(10.0, 1000), startTime, budgetStart);
+    // Full budget admits t1, remaining budget of 400 admits t3 but not t2
+    EXPECT_TRUE(assertOrder({"t1", "t3"}, f.getFlushTargets(flush)));
+    EXPECT_EQUAL(1000.0, flush.getWriteBudget());
+}
+
+TEST_F("require that write budget is charged when targets have been flushed and refilled over time", Fixture)
+{
+    auto t1 = f.add("t1", MemoryGain(10, 0), 0, 600);
+    f.add("t2", MemoryGain(5, 0), 0, 600);
+    CostAwareFlush flush(limits(1000, 20 * gibi, std::chrono::hours(1)), costs(10.0, 1000), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t1"}, f.getFlushTargets(flush)));
+    t1->_flushedSerial = 10;
+    t1->_lastFlushTime = now;
+    EXPECT_TRUE(assertOrder({}, f.getFlushTargets(flush)));
+    EXPECT_EQUAL(400.0, flush.getWriteBudget());
+    EXPECT_TRUE(assertOrder({"t2"}, f.getFlushTargets(flush, budgetStart + std::chrono::seconds(20))));
+    EXPECT_EQUAL(600.0, flush.getWriteBudget());
+    EXPECT_TRUE(assertOrder({"t2"}, f.getFlushTargets(flush, budgetStart + std::chrono::seconds(1000))));
+    EXPECT_EQUAL(1000.0, flush.getWriteBudget());
+}
+
+TEST_F("require that zero write budget rate means unlimited budget", Fixture)
+{
+    f.add("t1", MemoryGain(10, 0), 0, 600);
+    f.add("t2", MemoryGain(5, 0), 0, 600);
+    CostAwareFlush flush(limits(1000, 20 * gibi, std::chrono::hours(1)), costs(0.0, 0), startTime, budgetStart);
+    EXPECT_TRUE(assertOrder({"t1", "t2"}, f.getFlushTargets(flush)));
+}
+
+TEST_F("require that last decision is exposed through state explorer", Fixture)
+{
+    f.add("t1", MemoryGain(10, 0), 0, 600);
+    f.add("t2", MemoryGain(5, 0), 0, 600);
+    CostAwareFlush flush(limits(1000, 20 * gibi, std::chrono::hours(1)), costs(10.0, 1000), startTime, budgetStart);
+    f.getFlushTargets(flush);
+    vespalib::Slime state;
+    flush.get_state(vespalib::slime::SlimeInserter(state), true);
+    EXPECT_EQUAL(1000.0, state.get()["writeBudget"].asDouble());
+    EXPECT_EQUAL(2u, state.get()["lastDecision"].entries());
+    EXPECT_EQUAL("t1", state.get()["lastDecision"][0]["name"].asString().make_string());
+    EXPECT_EQUAL("AGE", state.get()["lastDecision"][0]["reason"].asString().make_string());
+    EXPECT_TRUE(state.get()["lastDecision"][0]["selected"].asBool());
+    EXPECT_FALSE(state.get()["lastDecision"][1]["selected"].asBool());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
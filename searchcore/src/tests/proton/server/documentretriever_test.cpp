@@ -7,6 +7,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/datatype/positiondatatype.h>
 #include <vespa/document/datatype/tensor_data_type.h>
+#include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/document/fieldvalue/arrayfieldvalue.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/fieldvalue/doublefieldvalue.h>
@@ -483,6 +484,31 @@ TEST_F("require that attributes are patched into stored document unless also ind
     checkFieldValue<StringFieldValue>(doc->getValue(dyn_field_s), static_value_s);
 }
 
+TEST_F("require that partial document only contains fields in field set", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    const DocumentType &doc_type = *f.repo.getDocumentType(doc_type_name);
+    document::FieldCollection fields(doc_type);
+    fields.insert(doc_type.getField(static_field));
+    fields.insert(doc_type.getField(dyn_field_i));
+    Document::UP doc = f._retriever->getPartialDocument(meta_data.lid, fields);
+    ASSERT_TRUE(doc.get());
+    EXPECT_EQUAL(doc_id, doc->getId());
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(static_field), static_value));
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(dyn_field_i), dyn_value_i));
+    EXPECT_FALSE(doc->getValue(dyn_field_d));
+    EXPECT_FALSE(doc->getValue(dyn_arr_field_i));
+    EXPECT_FALSE(doc->getValue(position_field));
+}
+
+TEST_F("require that partial document with document id only has no fields", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    Document::UP doc = f._retriever->getPartialDocument(meta_data.lid, document::DocIdOnly());
+    ASSERT_TRUE(doc.get());
+    EXPECT_EQUAL(doc_id, doc->getId());
+    EXPECT_FALSE(doc->getValue(static_field));
+    EXPECT_FALSE(doc->getValue(dyn_field_i));
+}
+
 void verify_position_field_has_expected_values(Fixture& f) {
     DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
     Document::UP doc = f._retriever->getDocument(meta_data.lid);
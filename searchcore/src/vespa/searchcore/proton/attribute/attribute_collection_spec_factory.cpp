@@ -4,6 +4,7 @@
 #include <vespa/searchlib/attribute/configconverter.h>
 
 using search::attribute::ConfigConverter;
+using search::CompactionStrategy;
 using search::GrowStrategy;
 
 namespace proton {
@@ -11,9 +12,11 @@ namespace proton {
 AttributeCollectionSpecFactory::AttributeCollectionSpecFactory(
         const search::GrowStrategy &growStrategy,
         size_t growNumDocs,
+        uint32_t maxCompactLidsPerCommit,
         bool fastAccessOnly)
     : _growStrategy(growStrategy),
       _growNumDocs(growNumDocs),
+      _maxCompactLidsPerCommit(maxCompactLidsPerCommit),
       _fastAccessOnly(fastAccessOnly)
 {
 }
@@ -35,6 +38,10 @@ AttributeCollectionSpecFactory::create(const AttributesConfig &attrCfg,
         }
         grow.setDocsGrowDelta(grow.getDocsGrowDelta() + skew);
         cfg.setGrowStrategy(grow);
+        const CompactionStrategy &compaction = cfg.getCompactionStrategy();
+        cfg.setCompactionStrategy(CompactionStrategy(compaction.getMaxDeadBytesRatio(),
+                                                     compaction.getMaxDeadAddressSpaceRatio(),
+                                                     _maxCompactLidsPerCommit));
         attrs.push_back(AttributeSpec(attr.name, cfg));
     }
     return std::make_unique<AttributeCollectionSpec>(attrs, docIdLimit, serialNum);
@@ -21,11 +21,13 @@ private:
 
     const search::GrowStrategy _growStrategy;
     const size_t               _growNumDocs;
+    const uint32_t             _maxCompactLidsPerCommit;
     const bool                 _fastAccessOnly;
 
 public:
     AttributeCollectionSpecFactory(const search::GrowStrategy &growStrategy,
                                    size_t growNumDocs,
+                                   uint32_t maxCompactLidsPerCommit,
                                    bool fastAccessOnly);
 
     AttributeCollectionSpec::UP create(const AttributesConfig &attrCfg,
@@ -26,6 +26,7 @@ private:
     vespa::config::search::AttributesConfig _attrCfg;
     search::GrowStrategy _attributeGrow;
     size_t _attributeGrowNumDocs;
+    uint32_t _attributeMaxCompactLidsPerCommit;
     bool _fastAccessAttributesOnly;
     searchcorespi::index::IThreadService &_master;
     InitializedAttributesResult _attributesResult;
@@ -41,6 +42,7 @@ public:
                                 const vespa::config::search::AttributesConfig &attrCfg,
                                 const search::GrowStrategy &attributeGrow,
                                 size_t attributeGrowNumDocs,
+                                uint32_t attributeMaxCompactLidsPerCommit,
                                 bool fastAccessAttributesOnly,
                                 searchcorespi::index::IThreadService &master,
                                 std::shared_ptr<AttributeManager::SP> attrMgrResult);
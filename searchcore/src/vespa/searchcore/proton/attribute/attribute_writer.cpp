@@ -15,6 +15,8 @@
 #include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/searchlib/tensor/prepare_result.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <future>
 
@@ -520,6 +522,97 @@ public:
     }
 };
 
+struct ShardedUpdateEntry {
+    SerialNum          serialNum;
+    DocumentIdT        lid;
+    const FieldUpdate *update;
+};
+
+using ShardedUpdateEntries = std::vector<ShardedUpdateEntry>;
+using OnWriteDoneVector = std::vector<std::shared_ptr<IDestructorCallback>>;
+
+class ShardedUpdateTask : public vespalib::Executor::Task
+{
+    AttributeVector              &_attr;
+    const uint32_t                _numShards;
+    ShardedUpdateEntries          _entries;
+    const bool                    _immediateCommit;
+    OnWriteDoneVector             _onWriteDone;
+    vespalib::ThreadExecutor     &_sharedExecutor;
+
+    void applyShard(const std::vector<uint32_t> &entryIdxs);
+public:
+    ShardedUpdateTask(AttributeVector &attr, uint32_t numShards, ShardedUpdateEntries entries,
+                      bool immediateCommit, OnWriteDoneVector onWriteDone, vespalib::ThreadExecutor &sharedExecutor);
+    ~ShardedUpdateTask() override;
+    void run() override;
+};
+
+ShardedUpdateTask::ShardedUpdateTask(AttributeVector &attr, uint32_t numShards, ShardedUpdateEntries entries,
+                                     bool immediateCommit, OnWriteDoneVector onWriteDone,
+                                     vespalib::ThreadExecutor &sharedExecutor)
+    : _attr(attr),
+      _numShards(numShards),
+      _entries(std::move(entries)),
+      _immediateCommit(immediateCommit),
+      _onWriteDone(std::move(onWriteDone)),
+      _sharedExecutor(sharedExecutor)
+{
+}
+
+ShardedUpdateTask::~ShardedUpdateTask() = default;
+
+void
+ShardedUpdateTask::applyShard(const std::vector<uint32_t> &entryIdxs)
+{
+    for (uint32_t idx : entryIdxs) {
+        const auto &entry = _entries[idx];
+        AttributeUpdater::handleUpdateInPlace(_attr, entry.lid, *entry.update);
+    }
+}
+
+void
+ShardedUpdateTask::run()
+{
+    SerialNum lastSerialNum = _entries.back().serialNum;
+    uint32_t docIdLimit = 0;
+    std::vector<std::vector<uint32_t>> shards(_numShards);
+    for (uint32_t idx = 0; idx < _entries.size(); ++idx) {
+        DocumentIdT lid = _entries[idx].lid;
+        docIdLimit = std::max(docIdLimit, lid + 1);
+        shards[(lid / AttributeVector::inPlaceWriteLidAlignment) % _numShards].push_back(idx);
+    }
+    if (_attr.getStatus().getLastSyncToken() < lastSerialNum) {
+        AttributeManager::padAttribute(_attr, docIdLimit);
+    }
+    // Changes from earlier operations must be applied before writing in place
+    _attr.commit();
+    uint32_t numOtherShards = 0;
+    for (uint32_t shard = 1; shard < _numShards; ++shard) {
+        if (!shards[shard].empty()) {
+            ++numOtherShards;
+        }
+    }
+    vespalib::CountDownLatch latch(numOtherShards);
+    for (uint32_t shard = 1; shard < _numShards; ++shard) {
+        if (!shards[shard].empty()) {
+            auto rejected = _sharedExecutor.execute(vespalib::makeLambdaTask([this, &shards, shard, &latch]()
+                                                                             {
+                                                                                 applyShard(shards[shard]);
+                                                                                 latch.countDown();
+                                                                             }));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+    }
+    applyShard(shards[0]);
+    latch.await();
+    if (_immediateCommit) {
+        _attr.commit(lastSerialNum, lastSerialNum);
+    }
+}
+
 class CommitTask : public vespalib::Executor::Task
 {
     const AttributeWriter::WriteContext  &_wc;
@@ -553,6 +646,49 @@ CommitTask::run()
 
 }
 
+class AttributeWriter::ShardedUpdateBatch
+{
+    AttributeVector     &_attr;
+    ExecutorId           _executorId;
+    uint32_t             _numShards;
+    ShardedUpdateEntries _entries;
+    OnWriteDoneVector    _onWriteDone;
+    bool                 _immediateCommit;
+public:
+    // Number of updates in a batch before it is scheduled even without a commit
+    static constexpr size_t maxEntries = 1024;
+
+    ShardedUpdateBatch(AttributeVector &attr, ExecutorId executorId, uint32_t numShards)
+        : _attr(attr),
+          _executorId(executorId),
+          _numShards(numShards),
+          _entries(),
+          _onWriteDone(),
+          _immediateCommit(false)
+    { }
+    AttributeVector &getAttribute() const { return _attr; }
+    ExecutorId getExecutorId() const { return _executorId; }
+    bool empty() const { return _entries.empty(); }
+    bool full() const { return _immediateCommit || (_entries.size() >= maxEntries); }
+    void add(SerialNum serialNum, DocumentIdT lid, const FieldUpdate &update, bool immediateCommit,
+             OnWriteDoneType onWriteDone)
+    {
+        _entries.push_back(ShardedUpdateEntry{serialNum, lid, &update});
+        if (onWriteDone && (_onWriteDone.empty() || _onWriteDone.back() != onWriteDone)) {
+            _onWriteDone.push_back(onWriteDone);
+        }
+        _immediateCommit = _immediateCommit || immediateCommit;
+    }
+    std::unique_ptr<vespalib::Executor::Task> makeTask(vespalib::ThreadExecutor &sharedExecutor) {
+        auto task = std::make_unique<ShardedUpdateTask>(_attr, _numShards, std::move(_entries), _immediateCommit,
+                                                        std::move(_onWriteDone), sharedExecutor);
+        _entries.clear();
+        _onWriteDone.clear();
+        _immediateCommit = false;
+        return task;
+    }
+};
+
 void
 AttributeWriter::setupWriteContexts()
 {
@@ -598,6 +734,7 @@ void
 AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
                              bool immediateCommit, bool allAttributes, OnWriteDoneType onWriteDone)
 {
+    scheduleAllShardedUpdates();
     const DataType *dataType(doc.getDataType());
     if (_dataType != dataType) {
         buildFieldPaths(doc.getType(), dataType);
@@ -624,6 +761,7 @@ void
 AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid, bool immediateCommit,
                                 OnWriteDoneType onWriteDone)
 {
+    scheduleAllShardedUpdates();
     for (const auto &wc : _writeContexts) {
         auto removeTask = std::make_unique<RemoveTask>(wc, serialNum, lid, immediateCommit, onWriteDone);
         _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(removeTask));
@@ -637,10 +775,12 @@ AttributeWriter::AttributeWriter(proton::IAttributeManager::SP mgr)
       _writeContexts(),
       _dataType(nullptr),
       _hasStructFieldAttribute(false),
-      _attrMap()
+      _attrMap(),
+      _shardedUpdates()
 {
     setupWriteContexts();
     setupAttriuteMapping();
+    setupShardedUpdates();
 }
 
 void AttributeWriter::setupAttriuteMapping() {
@@ -651,8 +791,48 @@ void AttributeWriter::setupAttriuteMapping() {
 }
 
 
+void
+AttributeWriter::setupShardedUpdates()
+{
+    for (auto attr : getWritableAttributes()) {
+        uint32_t numShards = attr->getConfig().getWriterShards();
+        if (numShards > 1 && attr->supportsInPlaceWrites()) {
+            ExecutorId executorId = _attributeFieldWriter.getExecutorIdFromName(attr->getNamePrefix());
+            _shardedUpdates.push_back(std::make_unique<ShardedUpdateBatch>(*attr, executorId, numShards));
+        }
+    }
+}
+
+AttributeWriter::ShardedUpdateBatch *
+AttributeWriter::findShardedUpdates(const AttributeVector *attr) const
+{
+    for (const auto &batch : _shardedUpdates) {
+        if (&batch->getAttribute() == attr) {
+            return batch.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+AttributeWriter::scheduleShardedUpdates(ShardedUpdateBatch &batch)
+{
+    if (!batch.empty()) {
+        _attributeFieldWriter.executeTask(batch.getExecutorId(), batch.makeTask(_shared_executor));
+    }
+}
+
+void
+AttributeWriter::scheduleAllShardedUpdates()
+{
+    for (const auto &batch : _shardedUpdates) {
+        scheduleShardedUpdates(*batch);
+    }
+}
+
 AttributeWriter::~AttributeWriter()
 {
+    scheduleAllShardedUpdates();
     _attributeFieldWriter.sync();
 }
 
@@ -698,6 +878,7 @@ void
 AttributeWriter::remove(const LidVector &lidsToRemove, SerialNum serialNum,
                         bool immediateCommit, OnWriteDoneType onWriteDone)
 {
+    scheduleAllShardedUpdates();
     for (const auto &writeCtx : _writeContexts) {
         auto removeTask = std::make_unique<BatchRemoveTask>(writeCtx, serialNum, lidsToRemove, immediateCommit, onWriteDone);
         _attributeFieldWriter.executeTask(writeCtx.getExecutorId(), std::move(removeTask));
@@ -730,6 +911,16 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
         // document and attribute.
         if (attrp->getStatus().getLastSyncToken() >= serialNum)
             continue;
+        if (!_shardedUpdates.empty()) {
+            ShardedUpdateBatch *batch = findShardedUpdates(attrp);
+            if (batch != nullptr) {
+                batch->add(serialNum, lid, fupd, immediateCommit, onWriteDone);
+                if (batch->full()) {
+                    scheduleShardedUpdates(*batch);
+                }
+                continue;
+            }
+        }
         args[found->second.second.getId()]->_updates.emplace_back(attrp, &fupd);
         LOG(debug, "About to apply update for docId %u in attribute vector '%s'.", lid, attrp->getName().c_str());
     }
@@ -747,6 +938,7 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
 void
 AttributeWriter::heartBeat(SerialNum serialNum)
 {
+    scheduleAllShardedUpdates();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.second,
                                       [serialNum, attr=entry.second.first]()
@@ -758,6 +950,7 @@ AttributeWriter::heartBeat(SerialNum serialNum)
 void
 AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
 {
+    scheduleAllShardedUpdates();
     if (_mgr->getImportedAttributes() != nullptr) {
         std::vector<std::shared_ptr<ImportedAttributeVector>> importedAttrs;
         _mgr->getImportedAttributes()->getAll(importedAttrs);
@@ -775,6 +968,7 @@ AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
 void
 AttributeWriter::onReplayDone(uint32_t docIdLimit)
 {
+    scheduleAllShardedUpdates();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.execute(entry.second.second,
                                       [docIdLimit, attr = entry.second.first]()
@@ -787,6 +981,7 @@ AttributeWriter::onReplayDone(uint32_t docIdLimit)
 void
 AttributeWriter::compactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum)
 {
+    scheduleAllShardedUpdates();
     for (auto entry : _attrMap) {
         _attributeFieldWriter.
             execute(entry.second.second,
@@ -68,6 +68,16 @@ public:
         bool hasStructFieldAttribute() const { return _hasStructFieldAttribute; }
         bool use_two_phase_put() const { return _use_two_phase_put; }
     };
+
+    /**
+     * Batch of partial updates to a single value numeric attribute that
+     * is updated by several threads (writer shards), each owning every
+     * n'th range of lids. The batch is applied by one task on the
+     * executor owning the attribute, which applies the updates for the
+     * other shards in place using the shared executor, so all other writes
+     * to the attribute are still serialized by that executor.
+     */
+    class ShardedUpdateBatch;
 private:
     using AttrWithId = std::pair<search::AttributeVector *, ExecutorId>;
     using AttrMap = vespalib::hash_map<vespalib::string, AttrWithId>;
@@ -75,9 +85,14 @@ private:
     const DataType           *_dataType;
     bool                      _hasStructFieldAttribute;
     AttrMap                   _attrMap;
+    std::vector<std::unique_ptr<ShardedUpdateBatch>> _shardedUpdates;
 
     void setupWriteContexts();
     void setupAttriuteMapping();
+    void setupShardedUpdates();
+    ShardedUpdateBatch *findShardedUpdates(const search::AttributeVector *attr) const;
+    void scheduleShardedUpdates(ShardedUpdateBatch &batch);
+    void scheduleAllShardedUpdates();
     void buildFieldPaths(const DocumentType &docType, const DataType *dataType);
     void internalPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
                      bool immediateCommit, bool allAttributes, OnWriteDoneType onWriteDone);
@@ -26,8 +26,13 @@ AttributesConfigScout::adjust(AttributesConfig::Attribute &attr,
 {
     attr.enablebitvectors = liveAttr.enablebitvectors;
     attr.enableonlybitvector = liveAttr.enableonlybitvector;
+    attr.enablecompressedpostinglists = liveAttr.enablecompressedpostinglists;
+    attr.enablezonemaps = liveAttr.enablezonemaps;
+    attr.enablememorymappedload = liveAttr.enablememorymappedload;
+    attr.writershards = liveAttr.writershards;
     attr.fastsearch = liveAttr.fastsearch;
     attr.huge = liveAttr.huge;
+    attr.dictionary = liveAttr.dictionary;
     // Note: Predicate attributes only handle changes for the dense-posting-list-threshold config.
     attr.densepostinglistthreshold = liveAttr.densepostinglistthreshold;
     attr.distancemetric = liveAttr.distancemetric;
@@ -184,6 +184,26 @@ AttributeUpdater::handleUpdateT(V & vec, Accessor, uint32_t lid, const ValueUpda
     }
 }
 
+template <typename V, typename Accessor>
+void
+AttributeUpdater::handleUpdateInPlaceT(V & vec, Accessor ac, uint32_t lid, const ValueUpdate & upd)
+{
+    LOG(spam, "handleValueUpdateInPlace(%s, %u): %s", vec.getName().c_str(), lid, toString(upd).c_str());
+    ValueUpdate::ValueUpdateType op = upd.getType();
+    if (op == ValueUpdate::Assign) {
+        const AssignValueUpdate & assign(static_cast<const AssignValueUpdate &>(upd));
+        if (assign.hasValue()) {
+            vec.updateInPlace(lid, ac(assign.getValue()));
+        }
+    } else if (op == ValueUpdate::Arithmetic) {
+        vec.applyInPlace(lid, static_cast<const ArithmeticValueUpdate &>(upd));
+    } else if (op == ValueUpdate::Clear) {
+        vec.clearDocInPlace(lid);
+    } else {
+        LOG(warning, "Unsupported value update operation %s on singlevalue vector %s", upd.getClass().name(), vec.getName().c_str());
+    }
+}
+
 template <>
 void
 AttributeUpdater::handleUpdate(PredicateAttribute &vec, uint32_t lid, const ValueUpdate &upd)
@@ -312,6 +332,25 @@ AttributeUpdater::handleUpdate(AttributeVector & vec, uint32_t lid, const FieldU
     }
 }
 
+void
+AttributeUpdater::handleUpdateInPlace(AttributeVector & vec, uint32_t lid, const FieldUpdate & fUpdate)
+{
+    LOG(spam, "handleFieldUpdateInPlace(%s, %u): %s", vec.getName().c_str(), lid, toString(fUpdate).c_str());
+    assert(vec.supportsInPlaceWrites());
+    const vespalib::Identifiable::RuntimeClass &info = vec.getClass();
+    for (const auto & update : fUpdate.getUpdates()) {
+        const ValueUpdate & vUp(*update);
+        if (info.inherits(IntegerAttribute::classId)) {
+            handleUpdateInPlaceT(static_cast<IntegerAttribute &>(vec), GetLong(), lid, vUp);
+        } else if (info.inherits(FloatingPointAttribute::classId)) {
+            handleUpdateInPlaceT(static_cast<FloatingPointAttribute &>(vec), GetDouble(), lid, vUp);
+        } else {
+            LOG(warning, "Unsupported attribute vector '%s' for in place update (classname=%s)", vec.getName().c_str(), info.name());
+            return;
+        }
+    }
+}
+
 void
 AttributeUpdater::handleValue(AttributeVector & vec, uint32_t lid, const FieldValue & val)
 {
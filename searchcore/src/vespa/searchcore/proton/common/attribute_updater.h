@@ -30,6 +30,12 @@ class AttributeUpdater {
 public:
     static void handleUpdate(AttributeVector & vec, uint32_t lid, const FieldUpdate & upd);
     static void handleValue(AttributeVector & vec, uint32_t lid, const FieldValue & val);
+    /**
+     * Apply a field update directly to the committed values of a single
+     * value numeric attribute, bypassing the change vector. Only valid for
+     * attributes where supportsInPlaceWrites() is true.
+     */
+    static void handleUpdateInPlace(AttributeVector & vec, uint32_t lid, const FieldUpdate & upd);
 
     static std::unique_ptr<tensor::PrepareResult> prepare_set_value(AttributeVector& attr, uint32_t docid, const FieldValue& val);
     static void complete_set_value(AttributeVector& attr, uint32_t docid, const FieldValue& val,
@@ -43,6 +49,8 @@ private:
     template <typename V, typename Accessor>
     static void handleUpdateT(V & vec, Accessor ac, uint32_t lid, const ValueUpdate & val);
     template <typename V, typename Accessor>
+    static void handleUpdateInPlaceT(V & vec, Accessor ac, uint32_t lid, const ValueUpdate & upd);
+    template <typename V, typename Accessor>
     static void appendValue(V & vec, uint32_t lid, Accessor & ac);
     static void appendValue(IntegerAttribute & vec, uint32_t lid, const FieldValue & val, int weight=1);
     static void removeValue(IntegerAttribute & vec, uint32_t lid, const FieldValue & val);
@@ -7,7 +7,8 @@ namespace proton {
 CommitTimeTracker::CommitTimeTracker(vespalib::duration visibilityDelay)
     : _visibilityDelay(visibilityDelay),
       _nextCommit(vespalib::steady_clock::now()),
-      _replayDone(false)
+      _replayDone(false),
+      _batching(false)
 {
     _nextCommit = _nextCommit + visibilityDelay;
 }
@@ -15,6 +16,9 @@ CommitTimeTracker::CommitTimeTracker(vespalib::duration visibilityDelay)
 bool
 CommitTimeTracker::needCommit() const
 {
+    if (_batching) {
+        return false;
+    }
     if (hasVisibilityDelay()) {
         if (_replayDone) {
             return false; // maintenance job will do forced commits now
@@ -14,6 +14,7 @@ private:
     vespalib::duration             _visibilityDelay;
     mutable vespalib::steady_time  _nextCommit;
     bool                           _replayDone;
+    bool                           _batching;
 
 public:
     CommitTimeTracker(vespalib::duration visibilityDelay);
@@ -21,6 +22,13 @@ public:
     void setVisibilityDelay(vespalib::duration visibilityDelay);
     bool hasVisibilityDelay() const { return _visibilityDelay != vespalib::duration::zero(); }
     void setReplayDone() { _replayDone = true; }
+
+    /*
+     * Without visibility delay, commits are suppressed between startBatch()
+     * and endBatch(), both then return true and the caller commits the batch.
+     */
+    bool startBatch() { _batching = !hasVisibilityDelay(); return _batching; }
+    bool endBatch() { bool batching = _batching; _batching = false; return batching; }
 };
 
 } // namespace proton
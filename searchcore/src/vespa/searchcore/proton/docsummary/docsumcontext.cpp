@@ -43,6 +43,9 @@ Memory MESSAGE("message");
 Memory DETAILS("details");
 Memory TIMEOUT("timeout");
 
+// Number of documents read ahead per document store visit in prefetchDocsums.
+constexpr size_t PREFETCH_BATCH_SIZE = 64;
+
 }
 
 void
@@ -61,6 +64,34 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::prefetchDocsums(const IDocsumWriter::ResolveClassInfo &rci)
+{
+    if ((_prefetchMinHits == 0) || (_docsumState._docsumcnt < _prefetchMinHits) ||
+        rci.mustSkip || rci.allGenerated || _request.expired())
+    {
+        return;
+    }
+    std::vector<uint32_t> docIds;
+    docIds.reserve(std::min(size_t(_docsumState._docsumcnt), PREFETCH_BATCH_SIZE));
+    for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+        if (docIds.size() == PREFETCH_BATCH_SIZE) {
+            _docsumStore.prefetch(docIds);
+            docIds.clear();
+            if (_request.expired()) {
+                return;
+            }
+        }
+    }
+    if ( ! docIds.empty()) {
+        _docsumStore.prefetch(docIds);
+    }
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,6 +101,7 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -114,6 +146,7 @@ DocsumContext::createSlimeReply()
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
                                                                          _docsumStore.getSummaryClassId());
+    prefetchDocsums(rci);
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
         uint32_t docId = _docsumState._docsumbuf[i];
@@ -137,7 +170,8 @@ DocsumContext::createSlimeReply()
 DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docsumWriter,
                              IDocsumStore & docsumStore, std::shared_ptr<Matcher> matcher,
                              ISearchContext & searchCtx, IAttributeContext & attrCtx,
-                             IAttributeManager & attrMgr, SessionManager & sessionMgr) :
+                             IAttributeManager & attrMgr, SessionManager & sessionMgr,
+                             uint32_t prefetchMinHits) :
     _request(request),
     _docsumWriter(docsumWriter),
     _docsumStore(docsumStore),
@@ -146,7 +180,8 @@ DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docs
     _attrCtx(attrCtx),
     _attrMgr(attrMgr),
     _docsumState(*this),
-    _sessionMgr(sessionMgr)
+    _sessionMgr(sessionMgr),
+    _prefetchMinHits(prefetchMinHits)
 {
     initState();
 }
@@ -30,8 +30,10 @@ private:
     search::IAttributeManager            & _attrMgr;
     search::docsummary::GetDocsumsState    _docsumState;
     matching::SessionManager             & _sessionMgr;
+    uint32_t                               _prefetchMinHits;
 
     void initState();
+    void prefetchDocsums(const search::docsummary::IDocsumWriter::ResolveClassInfo &rci);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
@@ -45,7 +47,8 @@ public:
                   matching::ISearchContext & searchCtx,
                   search::attribute::IAttributeContext & attrCtx,
                   search::IAttributeManager & attrMgr,
-                  matching::SessionManager & sessionMgr);
+                  matching::SessionManager & sessionMgr,
+                  uint32_t prefetchMinHits);
 
     search::engine::DocsumReply::UP getDocsums();
 
@@ -7,6 +7,8 @@
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -23,6 +25,19 @@ const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
 }
 
+class DocumentStoreAdapter::PrefetchVisitor : public search::IDocumentVisitor
+{
+    PrefetchedDocs &_docs;
+public:
+    explicit PrefetchVisitor(PrefetchedDocs &docs) : _docs(docs) { }
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            _docs[lid] = std::move(doc);
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+};
+
 bool
 DocumentStoreAdapter::writeStringField(const char * buf, uint32_t buflen, ResType type)
 {
@@ -157,7 +172,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                    LookupResultClass(resultConfig.LookupResultClassId(resultClassName.c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _prefetched()
 {
 }
 
@@ -170,7 +186,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
         LOG(warning, "Error during init of result class '%s' with class id %u", _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto itr = _prefetched.find(docId);
+    if (itr != _prefetched.end()) {
+        document = std::move(itr->second);
+        _prefetched.erase(itr);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return DocsumStoreValue();
@@ -186,4 +209,24 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen, std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> &docIds)
+{
+    search::IDocumentStore::LidVector lids;
+    lids.reserve(docIds.size());
+    for (uint32_t docId : docIds) {
+        if ((_prefetched.find(docId) == _prefetched.end()) && !_docStore.isCached(docId)) {
+            lids.push_back(docId);
+        }
+    }
+    if (lids.empty()) {
+        return;
+    }
+    std::sort(lids.begin(), lids.end());
+    lids.erase(std::unique(lids.begin(), lids.end()), lids.end());
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.visit(lids, _repo, visitor);
+    LOG(spam, "prefetch(): %zu of %zu documents read ahead", _prefetched.size(), lids.size());
+}
+
 } // namespace proton
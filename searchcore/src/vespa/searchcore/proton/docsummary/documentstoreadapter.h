@@ -8,12 +8,24 @@
 #include <vespa/searchsummary/docsummary/resultpacker.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
+/**
+ * Docsum store reading documents from the document store.
+ *
+ * Documents given to prefetch that are not already cached by the document
+ * store are read up front with a single visit of the document store, where
+ * reads are ordered and grouped by file chunk, instead of one read per docsum.
+ * Prefetched documents are handed out (and released) by getMappedDocsum.
+ */
 class DocumentStoreAdapter : public search::docsummary::IDocsumStore
 {
 private:
+    using PrefetchedDocs = vespalib::hash_map<uint32_t, document::Document::UP>;
+    class PrefetchVisitor;
+
     const search::IDocumentStore           & _docStore;
     const document::DocumentTypeRepo       & _repo;
     const search::docsummary::ResultConfig & _resultConfig;
@@ -21,6 +33,7 @@ private:
     search::docsummary::ResultPacker         _resultPacker;
     FieldCache::CSP                          _fieldCache;
     const std::set<vespalib::string>       & _markupFields;
+    PrefetchedDocs                           _prefetched;
 
     bool
     writeStringField(const char * buf,
@@ -49,6 +62,8 @@ public:
 
     uint32_t getNumDocs() const override { return _docStore.getDocIdLimit(); }
     search::docsummary::DocsumStoreValue getMappedDocsum(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t> &docIds) override;
+    size_t getNumPrefetched() const { return _prefetched.size(); }
     uint32_t getSummaryClassId() const override { return _resultClass->GetClassID(); }
 
 };
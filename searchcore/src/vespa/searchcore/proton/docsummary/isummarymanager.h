@@ -36,6 +36,11 @@ public:
         virtual search::docsummary::IDocsumWriter &getDocsumWriter() const = 0;
         virtual search::docsummary::ResultConfig &getResultConfig() = 0;
         virtual search::docsummary::IDocsumStore::UP createDocsumStore(const vespalib::string &resultClassName) = 0;
+        /**
+         * Min number of hits in a docsum request before the documents are
+         * prefetched from the document store, 0 means never.
+         */
+        virtual uint32_t getPrefetchMinHits() const = 0;
 
         // Inherit doc from IDocsumEnvironment
         virtual search::IAttributeManager *getAttributeManager() override = 0;
@@ -53,7 +58,8 @@ public:
                        const vespa::config::search::SummarymapConfig &summarymapCfg,
                        const vespa::config::search::summary::JuniperrcConfig &juniperCfg,
                        const std::shared_ptr<const document::DocumentTypeRepo> &repo,
-                       const std::shared_ptr<search::IAttributeManager> &attributeMgr) = 0;
+                       const std::shared_ptr<search::IAttributeManager> &attributeMgr,
+                       uint32_t prefetchMinHits) = 0;
 
     virtual search::IDocumentStore &getBackingStore() = 0;
 protected:
@@ -83,7 +83,7 @@ SummaryManager::SummarySetup::
 SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName, const SummaryConfig & summaryCfg,
              const SummarymapConfig & summarymapCfg, const JuniperrcConfig & juniperCfg,
              search::IAttributeManager::SP attributeMgr, search::IDocumentStore::SP docStore,
-             std::shared_ptr<const DocumentTypeRepo> repo)
+             std::shared_ptr<const DocumentTypeRepo> repo, uint32_t prefetchMinHits)
     : _docsumWriter(),
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _juniperProps(juniperCfg),
@@ -92,7 +92,8 @@ SummarySetup(const vespalib::string & baseDir, const DocTypeName & docTypeName,
       _docStore(std::move(docStore)),
       _fieldCacheRepo(),
       _repo(repo),
-      _markupFields()
+      _markupFields(),
+      _prefetchMinHits(prefetchMinHits)
 {
     auto resultConfig = std::make_unique<ResultConfig>();
     if (!resultConfig->ReadConfig(summaryCfg, make_string("SummaryManager(%s)", baseDir.c_str()).c_str())) {
@@ -140,10 +141,10 @@ SummaryManager::SummarySetup::createDocsumStore(const vespalib::string &resultCl
 ISummaryManager::ISummarySetup::SP
 SummaryManager::createSummarySetup(const SummaryConfig & summaryCfg, const SummarymapConfig & summarymapCfg,
                                    const JuniperrcConfig & juniperCfg, const std::shared_ptr<const DocumentTypeRepo> &repo,
-                                   const search::IAttributeManager::SP &attributeMgr)
+                                   const search::IAttributeManager::SP &attributeMgr, uint32_t prefetchMinHits)
 {
     return std::make_shared<SummarySetup>(_baseDir, _docTypeName, summaryCfg, summarymapCfg,
-                                          juniperCfg, attributeMgr, _docStore, repo);
+                                          juniperCfg, attributeMgr, _docStore, repo, prefetchMinHits);
 }
 
 SummaryManager::SummaryManager(vespalib::ThreadExecutor & executor, const LogDocumentStore::Config & storeConfig,
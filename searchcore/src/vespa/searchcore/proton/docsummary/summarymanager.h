@@ -34,6 +34,7 @@ public:
         FieldCacheRepo::UP                    _fieldCacheRepo;
         const std::shared_ptr<const document::DocumentTypeRepo>  _repo;
         std::set<vespalib::string>            _markupFields;
+        uint32_t                              _prefetchMinHits;
     public:
         SummarySetup(const vespalib::string & baseDir,
                      const DocTypeName & docTypeName,
@@ -42,12 +43,14 @@ public:
                      const vespa::config::search::summary::JuniperrcConfig & juniperCfg,
                      search::IAttributeManager::SP attributeMgr,
                      search::IDocumentStore::SP docStore,
-                     std::shared_ptr<const document::DocumentTypeRepo> repo);
+                     std::shared_ptr<const document::DocumentTypeRepo> repo,
+                     uint32_t prefetchMinHits);
 
         search::docsummary::IDocsumWriter & getDocsumWriter() const override { return *_docsumWriter; }
         search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
 
         search::docsummary::IDocsumStore::UP createDocsumStore(const vespalib::string &resultClassName) override;
+        uint32_t getPrefetchMinHits() const override { return _prefetchMinHits; }
 
         search::IAttributeManager * getAttributeManager() override { return _attributeMgr.get(); }
         vespalib::string lookupIndex(const vespalib::string & s) const override { (void) s; return ""; }
@@ -84,7 +87,8 @@ public:
                        const vespa::config::search::SummarymapConfig &summarymapCfg,
                        const vespa::config::search::summary::JuniperrcConfig &juniperCfg,
                        const std::shared_ptr<const document::DocumentTypeRepo> &repo,
-                       const search::IAttributeManager::SP &attributeMgr) override;
+                       const search::IAttributeManager::SP &attributeMgr,
+                       uint32_t prefetchMinHits) override;
 
     search::IDocumentStore & getBackingStore() override { return *_docStore; }
     void reconfigure(const search::LogDocumentStore::Config & config);
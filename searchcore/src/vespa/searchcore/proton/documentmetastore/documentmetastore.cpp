@@ -2,6 +2,7 @@
 
 #include "documentmetastore.h"
 #include "documentmetastoresaver.h"
+#include "lid_gid_hash_comparator.h"
 #include "operation_listener.h"
 #include "search_context.h"
 #include <vespa/fastos/file.h>
@@ -18,6 +19,7 @@
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/datastore/simple_hash_map.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/rcuvector.hpp>
@@ -45,6 +47,8 @@ using vespalib::GenerationHandler;
 using vespalib::GenerationHeldBase;
 using vespalib::IllegalStateException;
 using vespalib::MemoryUsage;
+using vespalib::datastore::EntryRef;
+using proton::documentmetastore::LidGidHashComparator;
 using vespalib::make_string;
 
 namespace proton {
@@ -186,6 +190,9 @@ DocumentMetaStore::insert(DocId lid, const RawDocumentMetaData &metaData)
     // flush writes to meta store rcu vector before new entry is visible
     // from frozen root or lid based scan
     std::atomic_thread_fence(std::memory_order_release);
+    if (_gidHashIndex) {
+        _gidHashIndex->add(LidGidHashComparator::hash(metaData.getGid()), EntryRef(lid));
+    }
     _lidAlloc.registerLid(lid);
     updateUncommittedDocIdLimit(lid);
     incGeneration();
@@ -209,6 +216,9 @@ DocumentMetaStore::onUpdateStat()
     usage.incAllocatedBytes(bvSize);
     usage.incUsedBytes(bvSize);
     usage.merge(_gidToLidMap.getMemoryUsage());
+    if (_gidHashIndex) {
+        usage.merge(_gidHashIndex->get_memory_usage());
+    }
     // the free lists are not taken into account here
     updateStatistics(_metaDataStore.size(),
                      _metaDataStore.size(),
@@ -223,6 +233,9 @@ DocumentMetaStore::onGenerationChange(generation_t generation)
 {
     _gidToLidMap.getAllocator().freeze();
     _gidToLidMap.getAllocator().transferHoldLists(generation - 1);
+    if (_gidHashIndex) {
+        _gidHashIndex->transfer_hold_lists(generation - 1);
+    }
     getGenerationHolder().transferHoldLists(generation - 1);
     updateStat(false);
 }
@@ -231,6 +244,9 @@ void
 DocumentMetaStore::removeOldGenerations(generation_t firstUsed)
 {
     _gidToLidMap.getAllocator().trimHoldLists(firstUsed);
+    if (_gidHashIndex) {
+        _gidHashIndex->trim_hold_lists(firstUsed);
+    }
     _lidAlloc.trimHoldLists(firstUsed);
     getGenerationHolder().trimHoldLists(firstUsed);
 }
@@ -261,7 +277,7 @@ DocumentMetaStore::readNextDoc(documentmetastore::Reader & reader, TreeType::Bui
 }
 
 bool
-DocumentMetaStore::onLoad()
+DocumentMetaStore::onLoad(vespalib::Executor *)
 {
     documentmetastore::Reader reader(LoadUtils::openDAT(*this));
     unload();
@@ -296,6 +312,7 @@ DocumentMetaStore::onLoad()
     _gidToLidMap.getAllocator().freeze(); // create initial frozen tree
     generation_t generation = getGenerationHandler().getCurrentGeneration();
     _gidToLidMap.getAllocator().transferHoldLists(generation);
+    buildGidHashIndex();
 
     setNumDocs(_metaDataStore.size());
     setCommittedDocIdLimit(_metaDataStore.size());
@@ -411,6 +428,20 @@ unloadBucket(BucketDBOwner &db, const BucketId &id, const BucketState &delta)
 
 }
 
+void
+DocumentMetaStore::buildGidHashIndex()
+{
+    if (!_gidHashIndex) {
+        return;
+    }
+    _gidHashIndex->clear();
+    for (TreeType::Iterator itr = _gidToLidMap.begin(); itr.valid(); ++itr) {
+        DocId lid = itr.getKey();
+        _gidHashIndex->add(LidGidHashComparator::hash(getRawGid(lid)), EntryRef(lid));
+    }
+    _gidHashIndex->transfer_hold_lists(getGenerationHandler().getCurrentGeneration());
+}
+
 void
 DocumentMetaStore::unload()
 {
@@ -439,13 +470,15 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwner::SP bucketDB,
                                      const vespalib::string &name,
                                      const GrowStrategy &grow,
                                      const IGidCompare::SP &gidCompare,
-                                     SubDbType subDbType)
+                                     SubDbType subDbType,
+                                     bool useGidHashIndex)
     : DocumentMetaStoreAttribute(name),
       _metaDataStore(grow.getDocsInitialCapacity(),
                      grow.getDocsGrowPercent(),
                      grow.getDocsGrowDelta(),
                      getGenerationHolder()),
       _gidToLidMap(),
+      _gidHashIndex(useGidHashIndex ? std::make_unique<vespalib::datastore::SimpleHashMap>() : nullptr),
       _lidAlloc(_metaDataStore.size(),
                 _metaDataStore.capacity(),
                 getGenerationHolder()),
@@ -478,6 +511,15 @@ DocumentMetaStore::inspectExisting(const GlobalId &gid) const
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
+    if (_gidHashIndex) {
+        DocId lid = 0;
+        if (findLid(gid, lid)) {
+            res.setLid(lid);
+            res.fillPrev(_metaDataStore[lid].getTimestamp());
+            res.markSuccess();
+        }
+        return res;
+    }
     KeyComp comp(gid, _metaDataStore, *_gidCompare);
     TreeType::Iterator itr = _gidToLidMap.lowerBound(KeyComp::FIND_DOC_ID,
             comp);
@@ -607,6 +649,9 @@ DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
                         " document with lid '%u' and gid '%s'",
                         lid, gid.toString().c_str()));
     }
+    if (_gidHashIndex) {
+        _gidHashIndex->remove(LidGidHashComparator::hash(gid), EntryRef(lid));
+    }
     _lidAlloc.unregisterLid(lid);
     RawDocumentMetaData &oldMetaData = _metaDataStore[lid];
     bucketGuard->remove(oldMetaData.getGid(),
@@ -655,6 +700,9 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid)
     assert(it.getKey() == fromLid);
     _gidToLidMap.thaw(it);
     it.writeKey(toLid);
+    if (_gidHashIndex) {
+        _gidHashIndex->replace(LidGidHashComparator::hash(gid), EntryRef(fromLid), EntryRef(toLid));
+    }
     _lidAlloc.moveLidEnd(fromLid, toLid);
     incGeneration();
 }
@@ -710,9 +758,24 @@ DocumentMetaStore::getGidEvenIfMoved(DocId lid, GlobalId &gid) const
     return true;
 }
 
+bool
+DocumentMetaStore::findLid(const GlobalId &gid, DocId &lid) const
+{
+    LidGidHashComparator comp(gid, _metaDataStore);
+    EntryRef ref = _gidHashIndex->find(comp, LidGidHashComparator::hash(gid));
+    if (!ref.valid()) {
+        return false;
+    }
+    lid = ref.ref();
+    return true;
+}
+
 bool
 DocumentMetaStore::getLid(const GlobalId &gid, DocId &lid) const
 {
+    if (_gidHashIndex) {
+        return findLid(gid, lid);
+    }
     GlobalId value(gid);
     KeyComp comp(value, _metaDataStore, *_gidCompare);
     TreeType::ConstIterator itr =
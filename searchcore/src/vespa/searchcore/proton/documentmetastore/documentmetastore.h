@@ -26,12 +26,18 @@ class OperationListener;
 class Reader;
 }
 
+namespace vespalib::datastore { class SimpleHashMap; }
+
 namespace proton {
     
 /**
  * This class provides a storage of <lid, meta data> pairs (local
  * document id, meta data (including global document id)) and mapping
  * from lid -> meta data (including gid) and gid -> lid.
+ *
+ * The gid -> lid mapping is an ordered B-tree, used for bucket iteration.
+ * Optionally, a gid hash index is maintained alongside the B-tree, giving
+ * constant time lock-free gid -> lid lookups for readers.
  **/
 class DocumentMetaStore final : public DocumentMetaStoreAttribute,
                                 public DocumentMetaStoreAdapter,
@@ -68,6 +74,7 @@ private:
 
     MetaDataStore       _metaDataStore;
     TreeType            _gidToLidMap;
+    std::unique_ptr<vespalib::datastore::SimpleHashMap> _gidHashIndex;
     documentmetastore::LidAllocator _lidAlloc;
     IGidCompare::SP     _gidCompare;
     BucketDBOwner::SP   _bucketDB;
@@ -80,6 +87,8 @@ private:
     DocId peekFreeLid();
     VESPA_DLL_LOCAL void ensureSpace(DocId lid);
     bool insert(DocId lid, const RawDocumentMetaData &metaData);
+    bool findLid(const GlobalId &gid, DocId &lid) const;
+    void buildGidHashIndex();
 
     const GlobalId & getRawGid(DocId lid) const { return getRawMetaData(lid).getGid(); }
 
@@ -89,7 +98,7 @@ private:
     void onGenerationChange(generation_t generation) override;
     void removeOldGenerations(generation_t firstUsed) override;
     std::unique_ptr<search::AttributeSaver> onInitSave(vespalib::stringref fileName) override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool
     checkBuckets(const GlobalId &gid,
@@ -147,7 +156,8 @@ public:
                       const search::GrowStrategy & grow=search::GrowStrategy(),
                       const IGidCompare::SP &gidCompare =
                       IGidCompare::SP(new documentmetastore::DefaultGidCompare),
-                      SubDbType subDbType = SubDbType::READY);
+                      SubDbType subDbType = SubDbType::READY,
+                      bool useGidHashIndex = false);
     ~DocumentMetaStore();
 
     /**
@@ -268,6 +278,7 @@ public:
     uint64_t getEstimatedSaveByteSize() const override;
     uint32_t getVersion() const override;
     void setTrackDocumentSizes(bool trackDocumentSizes) { _trackDocumentSizes = trackDocumentSizes; }
+    bool hasGidHashIndex() const { return static_cast<bool>(_gidHashIndex); }
     void foreach(const search::IGidToLidMapperVisitor &visitor) const override;
 };
 
@@ -0,0 +1,13 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "lid_gid_hash_comparator.h"
+
+namespace proton::documentmetastore {
+
+LidGidHashComparator::LidGidHashComparator(const document::GlobalId &gid, const MetaDataStore &metaDataStore)
+    : _gid(gid),
+      _metaDataStore(metaDataStore)
+{
+}
+
+}
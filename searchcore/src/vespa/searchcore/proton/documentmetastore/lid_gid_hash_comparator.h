@@ -0,0 +1,49 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "raw_document_meta_data.h"
+#include <vespa/vespalib/datastore/entry_comparator.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+namespace proton::documentmetastore {
+
+/**
+ * Comparator class used by the gid -> lid hash index. Lids are stored
+ * as entry refs in the hash index, and the metadata store is used to map
+ * from lid -> metadata (including gid). An invalid entry ref is mapped
+ * to the gid given to the constructor.
+ **/
+class LidGidHashComparator : public vespalib::datastore::EntryComparator
+{
+    using EntryRef = vespalib::datastore::EntryRef;
+    using MetaDataStore = vespalib::RcuVectorBase<RawDocumentMetaData>;
+
+    const document::GlobalId &_gid;
+    const MetaDataStore      &_metaDataStore;
+
+    const document::GlobalId &getGid(EntryRef ref) const {
+        if (ref.valid()) {
+            return _metaDataStore[ref.ref()].getGid();
+        }
+        return _gid;
+    }
+
+public:
+    LidGidHashComparator(const document::GlobalId &gid, const MetaDataStore &metaDataStore);
+
+    bool operator()(const EntryRef lhs, const EntryRef rhs) const override {
+        return getGid(lhs) < getGid(rhs);
+    }
+    bool equal(const EntryRef lhs, const EntryRef rhs) const override {
+        return getGid(lhs) == getGid(rhs);
+    }
+    size_t hash(const EntryRef ref) const override {
+        return hash(getGid(ref));
+    }
+    static size_t hash(const document::GlobalId &gid) {
+        return document::GlobalId::hash()(gid);
+    }
+};
+
+}
@@ -52,6 +52,12 @@ public:
     SerialNum getSerialNum() const { return _serialNum; }
     virtual void serialize(vespalib::nbostream &os) const = 0;
     virtual void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) = 0;
+    /*
+     * Serialize the document or document update carried by the operation
+     * ahead of time, in the thread handing the operation over to the
+     * master write thread. serialize() then only appends the cached bytes.
+     */
+    virtual void preSerialize() { }
     virtual vespalib::string toString() const = 0;
 };
 
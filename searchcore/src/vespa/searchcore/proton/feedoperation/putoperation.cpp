@@ -13,13 +13,15 @@ namespace proton {
 
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
 PutOperation::PutOperation(BucketId bucketId, Timestamp timestamp, Document::SP doc)
     : DocumentOperation(FeedOperation::PUT, bucketId, timestamp),
-      _doc(std::move(doc))
+      _doc(std::move(doc)),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() = default;
@@ -30,7 +32,11 @@ PutOperation::serialize(vespalib::nbostream &os) const
     assertValidBucketId(_doc->getId());
     DocumentOperation::serialize(os);
     size_t oldSize = os.size();
-    _doc->serialize(os);
+    if (_serializedDoc) {
+        os.write(_serializedDoc->peek(), _serializedDoc->size());
+    } else {
+        _doc->serialize(os);
+    }
     _serializedDocSize = os.size() - oldSize;
 }
 
@@ -41,6 +47,7 @@ PutOperation::deserialize(vespalib::nbostream &is, const DocumentTypeRepo &repo)
     DocumentOperation::deserialize(is, repo);
     size_t oldSize = is.size();
     _doc.reset(new Document(repo, is));
+    _serializedDoc.reset();
     _serializedDocSize = oldSize - is.size();
 }
 
@@ -48,11 +55,25 @@ void
 PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
 {
     vespalib::nbostream stream;
-    _doc->serialize(stream);
+    if (_serializedDoc) {
+        // Consume the cached bytes, fields unknown to the new repo are dropped from the fixed document
+        stream = std::move(*_serializedDoc);
+        _serializedDoc.reset();
+    } else {
+        _doc->serialize(stream);
+    }
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
 }
 
+void
+PutOperation::preSerialize()
+{
+    auto stream = std::make_shared<vespalib::nbostream>();
+    _doc->serialize(*stream);
+    _serializedDoc = std::move(stream);
+}
+
 vespalib::string
 PutOperation::toString() const
 {
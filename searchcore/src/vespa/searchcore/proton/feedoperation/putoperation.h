@@ -2,6 +2,7 @@
 #pragma once
 
 #include "documentoperation.h"
+#include <vespa/vespalib/objects/nbostream.h>
 
 namespace proton {
 
@@ -9,6 +10,7 @@ class PutOperation : public DocumentOperation
 {
     using DocumentSP = std::shared_ptr<document::Document>;
     DocumentSP _doc;
+    std::shared_ptr<vespalib::nbostream> _serializedDoc; // Set by preSerialize()
 
 public:
     PutOperation();
@@ -17,10 +19,16 @@ public:
                  DocumentSP doc);
     ~PutOperation() override;
     const DocumentSP &getDocument() const { return _doc; }
+    /**
+     * The serialized document set by preSerialize(), or null. Can be written as is to the
+     * document store instead of serializing the document again.
+     */
+    std::shared_ptr<const vespalib::nbostream> getSerializedDocument() const { return _serializedDoc; }
     void assertValid() const;
     void serialize(vespalib::nbostream &os) const override;
     void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) override;
     void deserializeDocument(const document::DocumentTypeRepo &repo);
+    void preSerialize() override;
     vespalib::string toString() const override;
 };
 
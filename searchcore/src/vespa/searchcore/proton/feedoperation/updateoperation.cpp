@@ -25,7 +25,8 @@ UpdateOperation::UpdateOperation()
 
 UpdateOperation::UpdateOperation(Type type)
     : DocumentOperation(type),
-      _upd()
+      _upd(),
+      _serializedUpd()
 {
 }
 
@@ -33,7 +34,8 @@ UpdateOperation::UpdateOperation(Type type)
 UpdateOperation::UpdateOperation(Type type, const BucketId &bucketId,
                                  const Timestamp &timestamp, const DocumentUpdate::SP &upd)
     : DocumentOperation(type, bucketId, timestamp),
-      _upd(upd)
+      _upd(upd),
+      _serializedUpd()
 {
 }
 
@@ -47,13 +49,18 @@ void
 UpdateOperation::serializeUpdate(vespalib::nbostream &os) const
 {
     assert(getType() == UPDATE);
-     _upd->serializeHEAD(os);
+    if (_serializedUpd) {
+        os.write(_serializedUpd->peek(), _serializedUpd->size());
+    } else {
+        _upd->serializeHEAD(os);
+    }
 }
 
 void
 UpdateOperation::deserializeUpdate(vespalib::nbostream && is, const document::DocumentTypeRepo &repo)
 {
     _upd = DocumentUpdate::createHEAD(repo, std::move(is));
+    _serializedUpd.reset();
 }
 
 void
@@ -88,6 +95,16 @@ UpdateOperation::verifyUpdate(const DocumentTypeRepo &repo)
     _upd->eagerDeserialize();  // Will trigger exceptions if incompatible
 }
 
+void
+UpdateOperation::preSerialize()
+{
+    if (getType() == UPDATE) {
+        auto stream = std::make_unique<vespalib::nbostream>();
+        _upd->serializeHEAD(*stream);
+        _serializedUpd = std::move(stream);
+    }
+}
+
 vespalib::string
 UpdateOperation::toString() const {
     return make_string("%s(%s, %s)",
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "documentoperation.h"
+#include <vespa/vespalib/objects/nbostream.h>
 
 namespace document {
 class DocumentTypeRepo;
@@ -15,6 +16,7 @@ class UpdateOperation : public DocumentOperation
 private:
     using DocumentUpdateSP = std::shared_ptr<document::DocumentUpdate>;
     DocumentUpdateSP _upd;
+    std::unique_ptr<vespalib::nbostream> _serializedUpd; // Set by preSerialize()
     UpdateOperation(Type type, const document::BucketId &bucketId,
                     const storage::spi::Timestamp &timestamp,
                     const DocumentUpdateSP &upd);
@@ -31,6 +33,7 @@ public:
     void serialize(vespalib::nbostream &os) const override;
     void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) override;
     void verifyUpdate(const document::DocumentTypeRepo &repo);
+    void preSerialize() override;
     vespalib::string toString() const override;
 };
 
@@ -56,8 +56,9 @@ convertToSlime(const FlushContext::List &allTargets,
 
 }
 
-FlushEngineExplorer::FlushEngineExplorer(const FlushEngine &engine)
-    : _engine(engine)
+FlushEngineExplorer::FlushEngineExplorer(const FlushEngine &engine, const StateExplorer *strategyExplorer)
+    : _engine(engine),
+      _strategyExplorer(strategyExplorer)
 {
 }
 
@@ -72,6 +73,9 @@ FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
         sortTargetList(allTargets);
         convertToSlime(allTargets, now, object.setArray("allTargets"));
     }
+    if (_strategyExplorer != nullptr) {
+        _strategyExplorer->get_state(vespalib::slime::ObjectInserter(object, "strategy"), full);
+    }
 }
 
 } // namespace proton
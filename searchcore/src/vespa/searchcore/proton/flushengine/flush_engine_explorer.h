@@ -14,9 +14,10 @@ class FlushEngineExplorer : public vespalib::StateExplorer
 {
 private:
     const FlushEngine &_engine;
+    const vespalib::StateExplorer *_strategyExplorer;
 
 public:
-    FlushEngineExplorer(const FlushEngine &engine);
+    FlushEngineExplorer(const FlushEngine &engine, const vespalib::StateExplorer *strategyExplorer = nullptr);
 
     // Implements vespalib::StateExplorer
     virtual void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
@@ -293,7 +293,8 @@ FlushEngine::flushAll(const FlushContext::List &lst)
         if (wait(0)) {
             if (ctx->initFlush()) {
                 logTarget("initiated", *ctx);
-                _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx));
+                // Flushes requested through a priority strategy use the urgent io budget
+                _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx, true));
             } else {
                 logTarget("failed to initiate", *ctx);
             }
@@ -330,7 +331,7 @@ FlushEngine::flushNextTarget(const vespalib::string & name)
                   name.c_str(), lst.first.size());
         std::this_thread::sleep_for(100ms);
     }
-    _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx));
+    _executor.execute(std::make_unique<FlushTask>(initFlush(*ctx), *this, ctx, ctx->getTarget()->needUrgentFlush()));
     return ctx->getName();
 }
 
@@ -1,15 +1,18 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "flushtask.h"
+#include <vespa/searchlib/common/flush_io_throttle.h>
 
 namespace proton {
 
 FlushTask::FlushTask(uint32_t taskId,
                      FlushEngine &engine,
-                     const FlushContext::SP &ctx)
+                     const FlushContext::SP &ctx,
+                     bool urgent)
     : _taskId(taskId),
       _engine(engine),
-      _context(ctx)
+      _context(ctx),
+      _urgent(urgent)
 {
     assert(_context.get() != NULL);
 }
@@ -22,6 +25,9 @@ FlushTask::~FlushTask()
 void
 FlushTask::run()
 {
+    using search::common::FlushIoThrottle;
+    FlushIoThrottle::PriorityGuard priorityGuard(_urgent ? FlushIoThrottle::Priority::URGENT
+                                                         : FlushIoThrottle::Priority::BACKGROUND);
     searchcorespi::FlushTask::UP task(_context->getTask());
     search::SerialNum flushSerial(task->getFlushSerial());
     if (flushSerial != 0) {
@@ -15,6 +15,7 @@ private:
     uint32_t                          _taskId;
     FlushEngine                      &_engine;
     FlushContext::SP                  _context;
+    bool                              _urgent;
 
 public:
     FlushTask(const FlushTask &) = delete;
@@ -25,8 +26,9 @@ public:
      * @param taskId The identifier used by IFlushStrategy.
      * @param engine The running flush engine.
      * @param ctx    The context of the flush to perform.
+     * @param urgent Whether disk writes use the urgent flush io budget.
      */
-    FlushTask(uint32_t taskId, FlushEngine &engine, const FlushContext::SP &ctx);
+    FlushTask(uint32_t taskId, FlushEngine &engine, const FlushContext::SP &ctx, bool urgent);
 
     /**
      * Destructor. Notifies the engine that the flush is done to prevent the
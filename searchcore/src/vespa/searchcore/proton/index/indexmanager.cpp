@@ -27,8 +27,10 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t fusionThreads,
                                                          IThreadingService &threadingService)
     : _cacheSize(cacheSize),
+      _fusionThreads(fusionThreads),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -68,7 +70,7 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray, dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext, _threadingService.shared());
+                         _tuneFileIndexing, fileHeaderContext, _threadingService.shared(), _fusionThreads);
 }
 
 
@@ -82,7 +84,8 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, indexConfig.fusionThreads,
+                threadingService),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
@@ -11,16 +11,18 @@ namespace proton::index {
 
 struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
-    IndexConfig() : IndexConfig(WarmupConfig(), 2, 0) { }
-    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_)
+    IndexConfig() : IndexConfig(WarmupConfig(), 2, 0, 0) { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_, uint32_t fusionThreads_)
         : warmup(warmup_),
           maxFlushed(maxFlushed_),
-          cacheSize(cacheSize_)
+          cacheSize(cacheSize_),
+          fusionThreads(fusionThreads_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
     const size_t       cacheSize;
+    const uint32_t     fusionThreads;
 };
 
 /**
@@ -37,6 +39,7 @@ public:
         using IDiskIndex = searchcorespi::index::IDiskIndex;
         using IMemoryIndex = searchcorespi::index::IMemoryIndex;
         const size_t _cacheSize;
+        const uint32_t _fusionThreads;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -46,6 +49,7 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fusionThreads,
                              searchcorespi::index::IThreadingService &threadingService);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "executor_metrics.h"
+#include "flush_io_metrics.h"
 #include "resource_usage_metrics.h"
 #include "trans_log_server_metrics.h"
 #include <vespa/metrics/metrics.h>
@@ -35,6 +36,7 @@ struct ContentProtonMetrics : metrics::MetricSet
     TransLogServerMetrics transactionLog;
     ResourceUsageMetrics resourceUsage;
     ProtonExecutorMetrics executor;
+    FlushIoMetrics flushIo;
 
     ContentProtonMetrics();
     ~ContentProtonMetrics();
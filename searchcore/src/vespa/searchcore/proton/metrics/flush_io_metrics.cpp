@@ -0,0 +1,44 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_io_metrics.h"
+
+namespace proton {
+
+FlushIoMetrics::BudgetMetrics::BudgetMetrics(const vespalib::string &name, metrics::MetricSet *parent)
+    : metrics::MetricSet(name, {}, "Disk write metrics for flushes using this budget", parent),
+      writtenBytes("written_bytes", {}, "Number of bytes written", this),
+      throttledWrites("throttled_writes", {}, "Number of writes that had to wait for the budget", this),
+      throttledTime("throttled_time", {}, "Time (in seconds) writers waited for the budget since the last update", this)
+{
+}
+
+FlushIoMetrics::BudgetMetrics::~BudgetMetrics() = default;
+
+void
+FlushIoMetrics::BudgetMetrics::update(const FlushIoThrottle::BucketStats &stats,
+                                      const FlushIoThrottle::BucketStats &lastStats)
+{
+    writtenBytes.inc(stats.bytes - lastStats.bytes);
+    throttledWrites.inc(stats.throttledWrites - lastStats.throttledWrites);
+    throttledTime.set(stats.throttledTime - lastStats.throttledTime);
+}
+
+FlushIoMetrics::FlushIoMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("flush_io", {}, "Disk write metrics for flushes", parent),
+      urgent("urgent", this),
+      background("background", this),
+      lastStats()
+{
+}
+
+FlushIoMetrics::~FlushIoMetrics() = default;
+
+void
+FlushIoMetrics::update(const FlushIoThrottle::Stats &stats)
+{
+    urgent.update(stats.urgent, lastStats.urgent);
+    background.update(stats.background, lastStats.background);
+    lastStats = stats;
+}
+
+} // namespace proton
@@ -0,0 +1,39 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/metrics/metricset.h>
+#include <vespa/metrics/countmetric.h>
+#include <vespa/metrics/valuemetric.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
+
+namespace proton {
+
+/**
+ * Metrics for disk writes done by flushes, throttled by the urgent and
+ * background budgets of the flush io throttle.
+ */
+struct FlushIoMetrics : metrics::MetricSet
+{
+    using FlushIoThrottle = search::common::FlushIoThrottle;
+
+    struct BudgetMetrics : metrics::MetricSet {
+        metrics::LongCountMetric writtenBytes;
+        metrics::LongCountMetric throttledWrites;
+        metrics::DoubleValueMetric throttledTime;
+
+        BudgetMetrics(const vespalib::string &name, metrics::MetricSet *parent);
+        ~BudgetMetrics() override;
+        void update(const FlushIoThrottle::BucketStats &stats, const FlushIoThrottle::BucketStats &lastStats);
+    };
+
+    BudgetMetrics urgent;
+    BudgetMetrics background;
+    FlushIoThrottle::Stats lastStats;
+
+    FlushIoMetrics(metrics::MetricSet *parent);
+    ~FlushIoMetrics() override;
+    void update(const FlushIoThrottle::Stats &stats);
+};
+
+} // namespace proton
@@ -4,6 +4,34 @@
 
 namespace proton {
 
+ResourceUsageMetrics::MMapPolicyMetrics::MMapPolicyMetrics(metrics::MetricSet *parent)
+    : MetricSet("mmap_policy", {}, "Page size and NUMA placement of large memory mappings", parent),
+      explicitHugePagesAllocatedBytes("explicit_huge_pages_allocated_bytes", {}, "Total bytes mapped with explicit huge pages", this),
+      explicitHugePagesFallbacks("explicit_huge_pages_fallbacks", {}, "Number of mappings that wanted explicit huge pages but did not get them", this),
+      transparentHugePagesAllocatedBytes("transparent_huge_pages_allocated_bytes", {}, "Total bytes mapped with transparent huge pages advised", this),
+      noHugePagesAllocatedBytes("no_huge_pages_allocated_bytes", {}, "Total bytes mapped with huge pages disabled", this),
+      numaInterleavedAllocatedBytes("numa_interleaved_allocated_bytes", {}, "Total bytes mapped with pages interleaved across NUMA nodes", this),
+      numaLocalAllocatedBytes("numa_local_allocated_bytes", {}, "Total bytes mapped with pages bound to the local NUMA node", this),
+      failedAdvices("failed_advices", {}, "Number of times a page size or NUMA placement could not be applied", this),
+      lastStats()
+{
+}
+
+ResourceUsageMetrics::MMapPolicyMetrics::~MMapPolicyMetrics() = default;
+
+void
+ResourceUsageMetrics::MMapPolicyMetrics::update(const vespalib::alloc::MMapPolicyStats &stats)
+{
+    explicitHugePagesAllocatedBytes.inc(stats.explicitHugePagesAllocatedBytes - lastStats.explicitHugePagesAllocatedBytes);
+    explicitHugePagesFallbacks.inc(stats.explicitHugePagesFallbacks - lastStats.explicitHugePagesFallbacks);
+    transparentHugePagesAllocatedBytes.inc(stats.transparentHugePagesAllocatedBytes - lastStats.transparentHugePagesAllocatedBytes);
+    noHugePagesAllocatedBytes.inc(stats.noHugePagesAllocatedBytes - lastStats.noHugePagesAllocatedBytes);
+    numaInterleavedAllocatedBytes.inc(stats.numaInterleavedAllocatedBytes - lastStats.numaInterleavedAllocatedBytes);
+    numaLocalAllocatedBytes.inc(stats.numaLocalAllocatedBytes - lastStats.numaLocalAllocatedBytes);
+    failedAdvices.inc(stats.failedAdvices - lastStats.failedAdvices);
+    lastStats = stats;
+}
+
 ResourceUsageMetrics::ResourceUsageMetrics(metrics::MetricSet *parent)
     : MetricSet("resource_usage", {}, "Usage metrics for various resources in this search engine", parent),
       disk("disk", {}, "The relative amount of disk space used on this machine (value in the range [0, 1])", this),
@@ -13,7 +41,8 @@ ResourceUsageMetrics::ResourceUsageMetrics(metrics::MetricSet *parent)
       transient_memory("transient_memory", {}, "The relative amount of transient memory needed for load (value in the range [0, 1])", this),
       memoryMappings("memory_mappings", {}, "The number of mapped memory areas", this),
       openFileDescriptors("open_file_descriptors", {}, "The number of open files", this),
-      feedingBlocked("feeding_blocked", {}, "Whether feeding is blocked due to resource limits being reached (value is either 0 or 1)", this)
+      feedingBlocked("feeding_blocked", {}, "Whether feeding is blocked due to resource limits being reached (value is either 0 or 1)", this),
+      mmapPolicy(this)
 {
 }
 
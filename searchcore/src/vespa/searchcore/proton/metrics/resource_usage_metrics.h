@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/metrics/metrics.h>
+#include <vespa/vespalib/util/mmap_policy.h>
 
 namespace proton {
 
@@ -11,6 +12,25 @@ namespace proton {
  */
 struct ResourceUsageMetrics : metrics::MetricSet
 {
+    /**
+     * Page size and NUMA placement of large memory mappings, see vespalib::alloc::MMapPolicy.
+     * Bytes are counted when mapped, and not subtracted when unmapped.
+     */
+    struct MMapPolicyMetrics : metrics::MetricSet {
+        metrics::LongCountMetric explicitHugePagesAllocatedBytes;
+        metrics::LongCountMetric explicitHugePagesFallbacks;
+        metrics::LongCountMetric transparentHugePagesAllocatedBytes;
+        metrics::LongCountMetric noHugePagesAllocatedBytes;
+        metrics::LongCountMetric numaInterleavedAllocatedBytes;
+        metrics::LongCountMetric numaLocalAllocatedBytes;
+        metrics::LongCountMetric failedAdvices;
+        vespalib::alloc::MMapPolicyStats lastStats;
+
+        MMapPolicyMetrics(metrics::MetricSet *parent);
+        ~MMapPolicyMetrics() override;
+        void update(const vespalib::alloc::MMapPolicyStats &stats);
+    };
+
     metrics::DoubleValueMetric disk;
     metrics::DoubleValueMetric diskUtilization;
     metrics::DoubleValueMetric memory;
@@ -19,6 +39,7 @@ struct ResourceUsageMetrics : metrics::MetricSet
     metrics::LongValueMetric memoryMappings;
     metrics::LongValueMetric openFileDescriptors;
     metrics::LongValueMetric feedingBlocked;
+    MMapPolicyMetrics mmapPolicy;
 
     ResourceUsageMetrics(metrics::MetricSet *parent);
     ~ResourceUsageMetrics();
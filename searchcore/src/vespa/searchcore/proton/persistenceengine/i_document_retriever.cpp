@@ -3,9 +3,20 @@
 #include "i_document_retriever.h"
 #include <vespa/persistence/spi/read_consistency.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldset/fieldset.h>
 
 namespace proton {
 
+IDocumentRetriever::DocumentUP
+IDocumentRetriever::getPartialDocument(search::DocumentIdT lid, const document::FieldSet &fieldSet) const
+{
+    DocumentUP doc = getDocument(lid);
+    if (doc) {
+        document::FieldSet::stripFields(*doc, fieldSet);
+    }
+    return doc;
+}
+
 void DocumentRetrieverBaseForTest::visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const {
     (void) readConsistency;
     for (uint32_t lid : lids) {
@@ -10,7 +10,10 @@
 #include <vespa/searchcore/proton/common/cachedselect.h>
 #include <vespa/searchcore/proton/documentmetastore/i_document_meta_store_context.h>
 
-namespace document { class Document; }
+namespace document {
+    class Document;
+    class FieldSet;
+}
 
 namespace proton {
 
@@ -36,6 +39,12 @@ public:
     virtual void getBucketMetaData(const storage::spi::Bucket &bucket, search::DocumentMetaData::Vector &result) const = 0;
     virtual search::DocumentMetaData getDocumentMetaData(const document::DocumentId &id) const = 0;
     virtual DocumentUP getDocument(search::DocumentIdT lid) const = 0;
+    /**
+     * Get a document containing only the fields in the given field set.
+     * Implementations may skip materializing fields outside the field set.
+     * The default implementation strips the document returned by getDocument().
+     */
+    virtual DocumentUP getPartialDocument(search::DocumentIdT lid, const document::FieldSet &fieldSet) const;
     virtual ReadGuard getReadGuard() const = 0;
     virtual uint32_t getDocIdLimit() const = 0;
     /**
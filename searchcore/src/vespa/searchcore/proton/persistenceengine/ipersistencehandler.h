@@ -44,6 +44,18 @@ public:
     virtual void handlePut(FeedToken token, const storage::spi::Bucket &bucket,
                            storage::spi::Timestamp timestamp, DocumentSP doc) = 0;
 
+    struct BatchedPut {
+        FeedToken               token;
+        storage::spi::Timestamp timestamp;
+        DocumentSP              doc;
+    };
+
+    /**
+     * Handle puts to the given bucket as a batch, sharing transaction log
+     * write and visibility commit.
+     */
+    virtual void handlePutBatch(const storage::spi::Bucket &bucket, std::vector<BatchedPut> puts) = 0;
+
     virtual void handleUpdate(FeedToken token, const storage::spi::Bucket &bucket,
                               storage::spi::Timestamp timestamp, const DocumentUpdateSP &upd) = 0;
 
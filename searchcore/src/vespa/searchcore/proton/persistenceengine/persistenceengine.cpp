@@ -9,6 +9,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/base/exceptions.h>
+#include <algorithm>
 
 
 #include <vespa/log/log.h>
@@ -347,6 +348,51 @@ PersistenceEngine::putAsync(const Bucket &bucket, Timestamp ts, storage::spi::Do
     handler->handlePut(feedtoken::make(std::move(transportContext)), bucket, ts, std::move(doc));
 }
 
+void
+PersistenceEngine::putBatchAsync(const Bucket &bucket, std::vector<BatchedPut> puts, Context &)
+{
+    if (!_writeFilter.acceptWriteOperation()) {
+        IResourceWriteFilter::State state = _writeFilter.getAcceptState();
+        if (!state.acceptWriteOperation()) {
+            for (auto &put : puts) {
+                put.onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::RESOURCE_EXHAUSTED,
+                                           make_string("Put operation rejected for document '%s': '%s'",
+                                                       put.doc->getId().toString().c_str(), state.message().c_str())));
+            }
+            return;
+        }
+    }
+    std::shared_lock<std::shared_timed_mutex> rguard(_rwMutex);
+    LOG(spam, "putBatchAsync(%s, %zu puts)", bucket.toString().c_str(), puts.size());
+    // Group the puts by handler (document type), keeping their order
+    std::vector<std::pair<IPersistenceHandler *, std::vector<IPersistenceHandler::BatchedPut>>> batches;
+    for (auto &put : puts) {
+        if (!put.doc->getId().hasDocType()) {
+            put.onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+                                       make_string("Old id scheme not supported in elastic mode (%s)",
+                                                   put.doc->getId().toString().c_str())));
+            continue;
+        }
+        DocTypeName docType(put.doc->getType());
+        IPersistenceHandler * handler = getHandler(rguard, bucket.getBucketSpace(), docType);
+        if (!handler) {
+            put.onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+                                       make_string("No handler for document type '%s'", docType.toString().c_str())));
+            continue;
+        }
+        auto batch = std::find_if(batches.begin(), batches.end(), [handler](const auto &b) { return b.first == handler; });
+        if (batch == batches.end()) {
+            batches.emplace_back(handler, std::vector<IPersistenceHandler::BatchedPut>());
+            batch = batches.end() - 1;
+        }
+        auto transportContext = std::make_unique<AsyncTranportContext>(1, std::move(put.onComplete));
+        batch->second.push_back({feedtoken::make(std::move(transportContext)), put.timestamp, std::move(put.doc)});
+    }
+    for (auto &batch : batches) {
+        batch.first->handlePutBatch(bucket, std::move(batch.second));
+    }
+}
+
 void
 PersistenceEngine::removeAsync(const Bucket& b, Timestamp t, const DocumentId& did, Context&, OperationComplete::UP onComplete)
 {
@@ -436,11 +482,10 @@ PersistenceEngine::get(const Bucket& b, const document::FieldSet& fields, const
                 if (meta.removed) {
                     return GetResult::make_for_tombstone(meta.timestamp);
                 }
-                document::Document::UP doc = retriever.getDocument(meta.lid);
+                document::Document::UP doc = retriever.getPartialDocument(meta.lid, fields);
                 if (!doc || doc->getId().getGlobalId() != meta.gid) {
                     return GetResult();
                 }
-                document::FieldSet::stripFields(*doc, fields);
                 return GetResult(std::move(doc), meta.timestamp);
             }
         }
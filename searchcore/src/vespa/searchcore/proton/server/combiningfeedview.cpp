@@ -236,6 +236,22 @@ CombiningFeedView::forceCommit(search::SerialNum serialNum)
     }
 }
 
+void
+CombiningFeedView::startBatch()
+{
+    for (const auto &view : _views) {
+        view->startBatch();
+    }
+}
+
+void
+CombiningFeedView::endBatch(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone)
+{
+    for (const auto &view : _views) {
+        view->endBatch(serialNum, onDone);
+    }
+}
+
 void
 CombiningFeedView::
 handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation &pruneOp)
@@ -48,6 +48,8 @@ private:
 
     bool shouldBeReady(const document::BucketId &bucket) const;
     void forceCommit(search::SerialNum serialNum) override;
+    void startBatch() override;
+    void endBatch(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) override;
 public:
     typedef std::shared_ptr<CombiningFeedView> SP;
 
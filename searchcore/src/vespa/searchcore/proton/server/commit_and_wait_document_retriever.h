@@ -42,6 +42,12 @@ public:
         _commit.commitAndWait();
         return _retriever->getDocument(lid);
     }
+    document::Document::UP getPartialDocument(search::DocumentIdT lid,
+                                              const document::FieldSet &fieldSet) const override {
+        // Ensure that attribute vectors are committed
+        _commit.commitAndWait();
+        return _retriever->getPartialDocument(lid, fieldSet);
+    }
     void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor,
                         ReadConsistency readConsistency) const override
     {
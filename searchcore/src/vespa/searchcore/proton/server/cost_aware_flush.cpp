@@ -0,0 +1,302 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cost_aware_flush.h"
+#include <vespa/searchcore/proton/flushengine/tls_stats_map.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.server.cost_aware_flush");
+
+using search::SerialNum;
+using searchcorespi::IFlushTarget;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+namespace {
+
+bool
+isForced(CostAwareFlush::Reason reason)
+{
+    return (reason >= CostAwareFlush::Reason::TLSSIZE);
+}
+
+void
+raiseReason(CostAwareFlush::Reason &reason, CostAwareFlush::Reason newReason)
+{
+    if (reason < newReason) {
+        reason = newReason;
+    }
+}
+
+}
+
+CostAwareFlush::CostConfig::CostConfig()
+    : tlsReplayByteCost(8.0),
+      tlsReplayOperationCost(3000.0),
+      memoryGainWeight(1.0),
+      writeBudgetRate(100.0 * 1024 * 1024),
+      writeBudgetBurst(UINT64_C(4) * 1024 * 1024 * 1024)
+{ }
+
+CostAwareFlush::CostConfig::CostConfig(double tlsReplayByteCost_in,
+                                       double tlsReplayOperationCost_in,
+                                       double memoryGainWeight_in,
+                                       double writeBudgetRate_in,
+                                       uint64_t writeBudgetBurst_in)
+    : tlsReplayByteCost(tlsReplayByteCost_in),
+      tlsReplayOperationCost(tlsReplayOperationCost_in),
+      memoryGainWeight(memoryGainWeight_in),
+      writeBudgetRate(writeBudgetRate_in),
+      writeBudgetBurst(writeBudgetBurst_in)
+{ }
+
+CostAwareFlush::TargetEstimate::TargetEstimate()
+    : name(),
+      bytesToWrite(0),
+      memoryGain(0),
+      diskGain(0),
+      tlsReplayBytes(0),
+      replayOperations(0),
+      benefit(0.0),
+      benefitPerByte(0.0),
+      reason(Reason::NONE),
+      selected(false)
+{ }
+
+CostAwareFlush::CostAwareFlush(const Config &config, const CostConfig &costConfig,
+                               vespalib::system_time startTime, vespalib::steady_time budgetStartTime)
+    : MemoryFlush(config, startTime),
+      _costLock(),
+      _costConfig(costConfig),
+      _startTime(startTime),
+      _budget(costConfig.writeBudgetBurst),
+      _budgetTime(budgetStartTime),
+      _written(),
+      _lastDecision()
+{ }
+
+CostAwareFlush::~CostAwareFlush() = default;
+
+void
+CostAwareFlush::setCostConfig(const CostConfig &costConfig)
+{
+    std::lock_guard<std::mutex> guard(_costLock);
+    _costConfig = costConfig;
+    _budget = std::min(_budget, static_cast<double>(costConfig.writeBudgetBurst));
+}
+
+CostAwareFlush::CostConfig
+CostAwareFlush::getCostConfig() const
+{
+    std::lock_guard<std::mutex> guard(_costLock);
+    return _costConfig;
+}
+
+double
+CostAwareFlush::getWriteBudget() const
+{
+    std::lock_guard<std::mutex> guard(_costLock);
+    return _budget;
+}
+
+std::vector<CostAwareFlush::TargetEstimate>
+CostAwareFlush::getLastDecision() const
+{
+    std::lock_guard<std::mutex> guard(_costLock);
+    return _lastDecision;
+}
+
+const char *
+CostAwareFlush::getReasonName(Reason reason)
+{
+    switch (reason) {
+    case Reason::URGENT: return "URGENT";
+    case Reason::MEMORY: return "MEMORY";
+    case Reason::TLSSIZE: return "TLSSIZE";
+    case Reason::DISKBLOAT: return "DISKBLOAT";
+    case Reason::AGE: return "AGE";
+    case Reason::NONE: return "NONE";
+    }
+    return "NONE";
+}
+
+void
+CostAwareFlush::updateBudget(const CostConfig &config, const FlushContext::List &targetList,
+                             vespalib::steady_time now) const
+{
+    // Called with _costLock held
+    if (now > _budgetTime) {
+        _budget = std::min(_budget + config.writeBudgetRate * vespalib::to_s(now - _budgetTime),
+                           static_cast<double>(config.writeBudgetBurst));
+        _budgetTime = now;
+    }
+    WrittenMap written;
+    for (const auto &ctx : targetList) {
+        const IFlushTarget &target = *ctx->getTarget();
+        SerialNum flushedSerial = target.getFlushedSerialNum();
+        auto itr = _written.find(ctx->getName());
+        if (itr != _written.end() && itr->second.flushedSerial < flushedSerial) {
+            _budget -= itr->second.bytesToWrite;
+        }
+        written[ctx->getName()] = Written{flushedSerial, target.getApproxBytesToWriteToDisk()};
+    }
+    _written.swap(written);
+}
+
+FlushContext::List
+CostAwareFlush::getFlushTargets(const FlushContext::List &targetList,
+                                const flushengine::TlsStatsMap &tlsStatsMap) const
+{
+    return getFlushTargets(targetList, tlsStatsMap, vespalib::system_clock::now(), vespalib::steady_clock::now());
+}
+
+FlushContext::List
+CostAwareFlush::getFlushTargets(const FlushContext::List &targetList,
+                                const flushengine::TlsStatsMap &tlsStatsMap,
+                                vespalib::system_time now, vespalib::steady_time budgetNow) const
+{
+    const Config config(getConfig());
+    std::lock_guard<std::mutex> guard(_costLock);
+    const CostConfig &costConfig = _costConfig;
+    updateBudget(costConfig, targetList, budgetNow);
+
+    std::vector<TargetEstimate> estimates(targetList.size());
+    uint64_t totalMemory(0);
+    uint64_t totalTlsSize(0);
+    IFlushTarget::DiskGain totalDisk;
+    vespalib::hash_set<const void *> visitedHandlers;
+    for (size_t i = 0; i < targetList.size(); ++i) {
+        const IFlushTarget &target = *targetList[i]->getTarget();
+        const IFlushHandler &handler = *targetList[i]->getHandler();
+        const flushengine::TlsStats &tlsStats = tlsStatsMap.getTlsStats(handler.getName());
+        if (visitedHandlers.insert(&handler).second) {
+            totalTlsSize += tlsStats.getNumBytes();
+        }
+        TargetEstimate &est = estimates[i];
+        SerialNum flushedSerial = target.getFlushedSerialNum();
+        SerialNum lastSerial = targetList[i]->getLastSerial();
+        IFlushTarget::DiskGain dgain(target.getApproxDiskGain());
+        totalDisk += dgain;
+        est.name = targetList[i]->getName();
+        est.bytesToWrite = target.getApproxBytesToWriteToDisk();
+        est.memoryGain = std::max(INT64_C(0), target.getApproxMemoryGain().gain());
+        est.diskGain = std::max(INT64_C(0), dgain.gain());
+        est.tlsReplayBytes = estimateNeededTlsSizeForFlushTarget(tlsStats, flushedSerial);
+        est.replayOperations = (lastSerial > flushedSerial) ? (lastSerial - flushedSerial) : 0;
+        est.benefit = costConfig.memoryGainWeight * est.memoryGain +
+                      costConfig.tlsReplayByteCost * est.tlsReplayBytes +
+                      costConfig.tlsReplayOperationCost * target.get_replay_operation_cost() * est.replayOperations +
+                      est.diskGain;
+        est.benefitPerByte = est.benefit / std::max(UINT64_C(1), est.bytesToWrite);
+        totalMemory += est.memoryGain;
+        vespalib::system_time lastFlushTime = target.getLastFlushTime();
+        vespalib::duration timeDiff(now - (lastFlushTime > vespalib::system_time() ? lastFlushTime : _startTime));
+        if (target.needUrgentFlush()) {
+            raiseReason(est.reason, Reason::URGENT);
+        } else if (est.memoryGain >= static_cast<uint64_t>(std::max(INT64_C(0), config.maxMemoryGain))) {
+            raiseReason(est.reason, Reason::MEMORY);
+        } else if (dgain.gain() > config.diskBloatFactor * computeGain(dgain)) {
+            raiseReason(est.reason, Reason::DISKBLOAT);
+        } else if (timeDiff >= config.maxTimeGain) {
+            raiseReason(est.reason, Reason::AGE);
+        }
+    }
+    bool globalMemory = (totalMemory >= config.maxGlobalMemory);
+    bool globalTlsSize = (totalTlsSize > config.maxGlobalTlsSize);
+    bool globalDiskBloat = (totalDisk.gain() > config.globalDiskBloatFactor * computeGain(totalDisk));
+    for (auto &est : estimates) {
+        if (globalMemory && est.memoryGain > 0) {
+            raiseReason(est.reason, Reason::MEMORY);
+        } else if (globalTlsSize && est.tlsReplayBytes > 0) {
+            raiseReason(est.reason, Reason::TLSSIZE);
+        } else if (globalDiskBloat && est.diskGain > 0) {
+            raiseReason(est.reason, Reason::DISKBLOAT);
+        }
+    }
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < estimates.size(); ++i) {
+        if (estimates[i].reason != Reason::NONE) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&estimates](size_t lhs, size_t rhs) {
+        const TargetEstimate &l = estimates[lhs];
+        const TargetEstimate &r = estimates[rhs];
+        bool lhsUrgent = (l.reason == Reason::URGENT);
+        bool rhsUrgent = (r.reason == Reason::URGENT);
+        if (lhsUrgent != rhsUrgent) {
+            return lhsUrgent;
+        }
+        if (isForced(l.reason) != isForced(r.reason)) {
+            return isForced(l.reason);
+        }
+        return (l.benefitPerByte > r.benefitPerByte);
+    });
+    FlushContext::List result;
+    bool unlimited = (costConfig.writeBudgetRate <= 0.0);
+    // A full budget always admits one target, otherwise targets larger than the burst would never be flushed
+    bool fullBudget = (_budget >= costConfig.writeBudgetBurst);
+    double budget = _budget;
+    for (size_t i : order) {
+        TargetEstimate &est = estimates[i];
+        if (!isForced(est.reason) && !unlimited) {
+            if (est.bytesToWrite > budget && !fullBudget) {
+                continue;
+            }
+            fullBudget = false;
+            budget -= est.bytesToWrite;
+        }
+        est.selected = true;
+        result.push_back(targetList[i]);
+    }
+    if (LOG_WOULD_LOG(debug)) {
+        vespalib::asciistream oss;
+        for (size_t i = 0; i < result.size(); ++i) {
+            if (i > 0) {
+                oss << ",";
+            }
+            oss << result[i]->getName();
+        }
+        LOG(debug, "getFlushTargets(): writeBudget(%f), totalMemory(%" PRIu64 "), totalTlsSize(%" PRIu64 "), "
+            "%zu selected targets: [%s]", _budget, totalMemory, totalTlsSize, result.size(), oss.str().data());
+    }
+    _lastDecision = std::move(estimates);
+    return result;
+}
+
+void
+CostAwareFlush::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    CostConfig costConfig = getCostConfig();
+    object.setString("name", "costaware");
+    object.setDouble("writeBudget", getWriteBudget());
+    object.setDouble("writeBudgetRate", costConfig.writeBudgetRate);
+    object.setLong("writeBudgetBurst", costConfig.writeBudgetBurst);
+    if (full) {
+        Cursor &array = object.setArray("lastDecision");
+        for (const auto &est : getLastDecision()) {
+            Cursor &target = array.addObject();
+            target.setString("name", est.name);
+            target.setLong("bytesToWrite", est.bytesToWrite);
+            target.setLong("memoryGain", est.memoryGain);
+            target.setLong("diskGain", est.diskGain);
+            target.setLong("tlsReplayBytes", est.tlsReplayBytes);
+            target.setLong("replayOperations", est.replayOperations);
+            target.setDouble("benefit", est.benefit);
+            target.setDouble("benefitPerByte", est.benefitPerByte);
+            target.setString("reason", getReasonName(est.reason));
+            target.setBool("selected", est.selected);
+        }
+    }
+}
+
+} // namespace proton
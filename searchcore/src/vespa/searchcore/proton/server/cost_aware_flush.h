@@ -0,0 +1,108 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "memoryflush.h"
+#include <vespa/vespalib/net/state_explorer.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace proton {
+
+/**
+ * Flush strategy that estimates, for each flush target, the number of bytes
+ * to write, the memory released and the transaction log replay cost saved,
+ * and orders the targets by benefit per written byte.
+ *
+ * The memory, tls size and disk bloat limits are the same as for MemoryFlush.
+ * Targets needing urgent flush, or forced by memory or tls size limits, are
+ * always returned. Targets only wanting flush due to age or disk bloat are
+ * returned as long as a disk write budget (token bucket refilled at a fixed
+ * rate) allows it. The budget is charged with the estimated number of bytes
+ * written when a flush target reports a newer flushed serial number.
+ */
+class CostAwareFlush : public MemoryFlush,
+                       public vespalib::StateExplorer
+{
+public:
+    struct CostConfig
+    {
+        /// Cost of replaying a byte from the transaction log.
+        double   tlsReplayByteCost;
+        /// Cost of replaying an operation from the transaction log.
+        double   tlsReplayOperationCost;
+        /// Weight of a released byte of memory compared to a replayed byte.
+        double   memoryGainWeight;
+        /// Disk write budget (bytes per second) for flushes that are not forced, 0 means unlimited.
+        double   writeBudgetRate;
+        /// Maximum accumulated disk write budget (bytes).
+        uint64_t writeBudgetBurst;
+        CostConfig();
+        CostConfig(double tlsReplayByteCost_in,
+                   double tlsReplayOperationCost_in,
+                   double memoryGainWeight_in,
+                   double writeBudgetRate_in,
+                   uint64_t writeBudgetBurst_in);
+    };
+
+    enum class Reason { NONE, AGE, DISKBLOAT, TLSSIZE, MEMORY, URGENT };
+
+    struct TargetEstimate
+    {
+        vespalib::string name;
+        uint64_t         bytesToWrite;
+        uint64_t         memoryGain;
+        int64_t          diskGain;
+        uint64_t         tlsReplayBytes;
+        uint64_t         replayOperations;
+        double           benefit;
+        double           benefitPerByte;
+        Reason           reason;
+        bool             selected;
+        TargetEstimate();
+    };
+
+private:
+    struct Written
+    {
+        search::SerialNum flushedSerial;
+        uint64_t          bytesToWrite;
+    };
+    using WrittenMap = vespalib::hash_map<vespalib::string, Written>;
+
+    mutable std::mutex             _costLock;
+    CostConfig                     _costConfig;
+    vespalib::system_time          _startTime;
+    mutable double                 _budget;
+    mutable vespalib::steady_time  _budgetTime;
+    mutable WrittenMap             _written;
+    mutable std::vector<TargetEstimate> _lastDecision;
+
+    void updateBudget(const CostConfig &config, const FlushContext::List &targetList, vespalib::steady_time now) const;
+
+public:
+    using SP = std::shared_ptr<CostAwareFlush>;
+
+    CostAwareFlush(const Config &config, const CostConfig &costConfig,
+                   vespalib::system_time startTime, vespalib::steady_time budgetStartTime);
+    ~CostAwareFlush() override;
+
+    FlushContext::List
+    getFlushTargets(const FlushContext::List &targetList,
+                    const flushengine::TlsStatsMap &tlsStatsMap) const override;
+
+    FlushContext::List
+    getFlushTargets(const FlushContext::List &targetList,
+                    const flushengine::TlsStatsMap &tlsStatsMap,
+                    vespalib::system_time now, vespalib::steady_time budgetNow) const;
+
+    void setCostConfig(const CostConfig &costConfig);
+    CostConfig getCostConfig() const;
+    double getWriteBudget() const;
+    std::vector<TargetEstimate> getLastDecision() const;
+
+    static const char *getReasonName(Reason reason);
+
+    // Implements vespalib::StateExplorer
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
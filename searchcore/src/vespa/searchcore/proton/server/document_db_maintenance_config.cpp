@@ -56,7 +56,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig()
       _remove_batch_block_rate(0.5),
       _remove_block_rate(100),
       _disabled(false),
-      _maxDocsToScan(10000)
+      _maxDocsToScan(DEFAULT_MAX_DOCS_TO_SCAN),
+      _moveBatchSize(1),
+      _incrementalShrinkStep(0)
 {
 }
 
@@ -66,7 +68,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
                                                                        double remove_batch_block_rate,
                                                                        double remove_block_rate,
                                                                        bool disabled,
-                                                                       uint32_t maxDocsToScan)
+                                                                       uint32_t maxDocsToScan,
+                                                                       uint32_t moveBatchSize,
+                                                                       uint32_t incrementalShrinkStep)
     : _delay(std::min(MAX_DELAY_SEC, interval)),
       _interval(interval),
       _allowedLidBloat(allowedLidBloat),
@@ -74,7 +78,9 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
       _remove_batch_block_rate(remove_batch_block_rate),
       _remove_block_rate(remove_block_rate),
       _disabled(disabled),
-      _maxDocsToScan(maxDocsToScan)
+      _maxDocsToScan(maxDocsToScan),
+      _moveBatchSize(std::max(1u, moveBatchSize)),
+      _incrementalShrinkStep(incrementalShrinkStep)
 {
 }
 
@@ -93,7 +99,9 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
            _interval == rhs._interval &&
            _allowedLidBloat == rhs._allowedLidBloat &&
            _allowedLidBloatFactor == rhs._allowedLidBloatFactor &&
-           _disabled == rhs._disabled;
+           _disabled == rhs._disabled &&
+           _moveBatchSize == rhs._moveBatchSize &&
+           _incrementalShrinkStep == rhs._incrementalShrinkStep;
 }
 
 
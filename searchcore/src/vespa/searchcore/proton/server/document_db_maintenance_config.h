@@ -51,8 +51,12 @@ private:
     double               _remove_block_rate;
     bool                 _disabled;
     uint32_t             _maxDocsToScan;
+    uint32_t             _moveBatchSize;
+    uint32_t             _incrementalShrinkStep;
 
 public:
+    static constexpr uint32_t DEFAULT_MAX_DOCS_TO_SCAN = 10000;
+
     DocumentDBLidSpaceCompactionConfig();
     DocumentDBLidSpaceCompactionConfig(vespalib::duration interval,
                                        uint32_t allowedLidBloat,
@@ -60,7 +64,9 @@ public:
                                        double remove_batch_block_rate,
                                        double remove_block_rate,
                                        bool disabled,
-                                       uint32_t maxDocsToScan = 10000);
+                                       uint32_t maxDocsToScan = DEFAULT_MAX_DOCS_TO_SCAN,
+                                       uint32_t moveBatchSize = 1,
+                                       uint32_t incrementalShrinkStep = 0);
 
     static DocumentDBLidSpaceCompactionConfig createDisabled();
     bool operator==(const DocumentDBLidSpaceCompactionConfig &rhs) const;
@@ -72,6 +78,8 @@ public:
     double get_remove_block_rate() const { return _remove_block_rate; }
     bool isDisabled() const { return _disabled; }
     uint32_t getMaxDocsToScan() const { return _maxDocsToScan; }
+    uint32_t getMoveBatchSize() const { return _moveBatchSize; }
+    uint32_t getIncrementalShrinkStep() const { return _incrementalShrinkStep; }
 };
 
 class BlockableMaintenanceJobConfig {
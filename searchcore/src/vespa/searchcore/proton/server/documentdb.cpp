@@ -75,17 +75,22 @@ makeGrowStrategy(uint32_t docsInitialCapacity, const Allocation &allocCfg)
 }
 
 DocumentSubDBCollection::Config
-makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const Allocation & allocCfg, size_t numSearcherThreads) {
+makeSubDBConfig(const ProtonConfig::Distribution & distCfg, const ProtonConfig::Documentdb & docDbCfg,
+                size_t numSearcherThreads) {
+    const Allocation & allocCfg = docDbCfg.allocation;
     size_t initialNumDocs(allocCfg.initialnumdocs);
     GrowStrategy searchableGrowth = makeGrowStrategy(initialNumDocs * distCfg.searchablecopies, allocCfg);
     GrowStrategy removedGrowth = makeGrowStrategy(std::max(1024ul, initialNumDocs/100), allocCfg);
     GrowStrategy notReadyGrowth = makeGrowStrategy(initialNumDocs * (distCfg.redundancy - distCfg.searchablecopies), allocCfg);
-    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount, numSearcherThreads);
+    return DocumentSubDBCollection::Config(searchableGrowth, notReadyGrowth, removedGrowth, allocCfg.amortizecount,
+                                           allocCfg.maxcompactlidspercommit, numSearcherThreads,
+                                           docDbCfg.documentmetastore.gidhashindex);
 }
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed, cfg.cache.size);
+    return index::IndexConfig(WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), cfg.maxflushed, cfg.cache.size,
+                              cfg.fusion.threads);
 }
 
 ProtonConfig::Documentdb _G_defaultProtonDocumentDBConfig;
@@ -170,7 +175,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _subDBs(*this, *this, _feedHandler, _docTypeName, _writeService, warmupExecutor, fileHeaderContext,
               metricsWireService, getMetrics(), queryLimiter, clock, _configMutex, _baseDir,
               makeSubDBConfig(protonCfg.distribution,
-                              findDocumentDB(protonCfg.documentdb, docTypeName.getName())->allocation,
+                              *findDocumentDB(protonCfg.documentdb, docTypeName.getName()),
                               protonCfg.numsearcherthreads),
               hwInfo),
       _maintenanceController(_writeService.master(), sharedExecutor, _docTypeName),
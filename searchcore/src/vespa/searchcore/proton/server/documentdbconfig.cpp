@@ -43,6 +43,7 @@ DocumentDBConfig::ComparisonResult::ComparisonResult()
       schemaChanged(false),
       maintenanceChanged(false),
       storeChanged(false),
+      summaryPrefetchChanged(false),
       visibilityDelayChanged(false),
       flushChanged(false)
 { }
@@ -63,6 +64,7 @@ DocumentDBConfig::DocumentDBConfig(
                const Schema::SP &schema,
                const DocumentDBMaintenanceConfig::SP &maintenance,
                const search::LogDocumentStore::Config & storeConfig,
+               uint32_t summaryPrefetchMinHits,
                const vespalib::string &configId,
                const vespalib::string &docTypeName)
     : _configId(configId),
@@ -82,6 +84,7 @@ DocumentDBConfig::DocumentDBConfig(
       _schema(schema),
       _maintenance(maintenance),
       _storeConfig(storeConfig),
+      _summaryPrefetchMinHits(summaryPrefetchMinHits),
       _orig(),
       _delayedAttributeAspects(false)
 { }
@@ -106,6 +109,7 @@ DocumentDBConfig(const DocumentDBConfig &cfg)
       _schema(cfg._schema),
       _maintenance(cfg._maintenance),
       _storeConfig(cfg._storeConfig),
+      _summaryPrefetchMinHits(cfg._summaryPrefetchMinHits),
       _orig(cfg._orig),
       _delayedAttributeAspects(false)
 { }
@@ -128,7 +132,8 @@ DocumentDBConfig::operator==(const DocumentDBConfig & rhs) const
            equals<TuneFileDocumentDB>(_tuneFileDocumentDB.get(), rhs._tuneFileDocumentDB.get()) &&
            equals<Schema>(_schema.get(), rhs._schema.get()) &&
            equals<DocumentDBMaintenanceConfig>(_maintenance.get(), rhs._maintenance.get()) &&
-           _storeConfig == rhs._storeConfig;
+           _storeConfig == rhs._storeConfig &&
+           _summaryPrefetchMinHits == rhs._summaryPrefetchMinHits;
 }
 
 
@@ -150,6 +155,7 @@ DocumentDBConfig::compare(const DocumentDBConfig &rhs) const
     retval.schemaChanged = !equals<Schema>(_schema.get(), rhs._schema.get());
     retval.maintenanceChanged = !equals<DocumentDBMaintenanceConfig>(_maintenance.get(), rhs._maintenance.get());
     retval.storeChanged = (_storeConfig != rhs._storeConfig);
+    retval.summaryPrefetchChanged = (_summaryPrefetchMinHits != rhs._summaryPrefetchMinHits);
     retval.visibilityDelayChanged = (_maintenance->getVisibilityDelay() != rhs._maintenance->getVisibilityDelay());
     retval.flushChanged = !equals<DocumentDBMaintenanceConfig>(_maintenance.get(), rhs._maintenance.get(), [](const auto &l, const auto &r) { return l.getFlushConfig() == r.getFlushConfig(); });
     return retval;
@@ -213,6 +219,7 @@ DocumentDBConfig::makeReplayConfig(const SP & orig)
                 o._schema,
                 o._maintenance,
                 o._storeConfig,
+                o._summaryPrefetchMinHits,
                 o._configId,
                 o._docTypeName);
     ret->_orig = orig;
@@ -253,6 +260,7 @@ DocumentDBConfig::newFromAttributesConfig(const AttributesConfigSP &attributes)
             _schema,
             _maintenance,
             _storeConfig,
+            _summaryPrefetchMinHits,
             _configId,
             _docTypeName);
 }
@@ -288,6 +296,7 @@ DocumentDBConfig::makeDelayedAttributeAspectConfig(const SP &newCfg, const Docum
                    n._schema,
                    n._maintenance,
                    n._storeConfig,
+                   n._summaryPrefetchMinHits,
                    n._configId,
                    n._docTypeName);
     result->_delayedAttributeAspects = true;
@@ -48,6 +48,7 @@ public:
         bool schemaChanged;
         bool maintenanceChanged;
         bool storeChanged;
+        bool summaryPrefetchChanged;
         bool visibilityDelayChanged;
         bool flushChanged;
 
@@ -66,6 +67,7 @@ public:
         ComparisonResult &setSchemaChanged(bool val) { schemaChanged = val; return *this; }
         ComparisonResult &setMaintenanceChanged(bool val) { maintenanceChanged = val; return *this; }
         ComparisonResult &setStoreChanged(bool val) { storeChanged = val; return *this; }
+        ComparisonResult &setSummaryPrefetchChanged(bool val) { summaryPrefetchChanged = val; return *this; }
 
         ComparisonResult &setVisibilityDelayChanged(bool val) {
             visibilityDelayChanged = val;
@@ -121,6 +123,7 @@ private:
     search::index::Schema::SP        _schema;
     MaintenanceConfigSP              _maintenance;
     search::LogDocumentStore::Config _storeConfig;
+    uint32_t                         _summaryPrefetchMinHits;
     SP                               _orig;
     bool                             _delayedAttributeAspects;
 
@@ -157,6 +160,7 @@ public:
                      const search::index::Schema::SP &schema,
                      const DocumentDBMaintenanceConfig::SP &maintenance,
                      const search::LogDocumentStore::Config & storeConfig,
+                     uint32_t summaryPrefetchMinHits,
                      const vespalib::string &configId,
                      const vespalib::string &docTypeName);
 
@@ -228,6 +232,12 @@ public:
 
     const search::LogDocumentStore::Config & getStoreConfig() const { return _storeConfig; }
 
+    /**
+     * Minimum number of hits in a docsum request before the documents
+     * are prefetched from the document store. 0 disables prefetching.
+     */
+    uint32_t getSummaryPrefetchMinHits() const { return _summaryPrefetchMinHits; }
+
     /**
      * Create config with delayed attribute aspect changes if they require
      * reprocessing.
@@ -136,7 +136,10 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.allowedlidbloatfactor,
                     proton.lidspacecompaction.removebatchblockrate,
                     proton.lidspacecompaction.removeblockrate,
-                    isDocumentTypeGlobal),
+                    isDocumentTypeGlobal,
+                    DocumentDBLidSpaceCompactionConfig::DEFAULT_MAX_DOCS_TO_SCAN,
+                    std::max(1, proton.lidspacecompaction.movebatchsize),
+                    std::max(0, proton.lidspacecompaction.incrementalshrinkstep)),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.enumstorelimit,
                     proton.writefilter.attribute.multivaluelimit),
@@ -187,6 +190,7 @@ getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo
 LogDocumentStore::Config
 deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::Memory & flush, const HwInfo & hwInfo) {
     DocumentStore::Config config(getStoreConfig(summary.cache, hwInfo));
+    config.maxPendingWriteBytes(std::max(INT64_C(0), summary.write.coalesce.maxbytes));
     const ProtonConfig::Summary::Log & log(summary.log);
     const ProtonConfig::Summary::Log::Chunk & chunk(log.chunk);
     WriteableFileChunk::Config fileConfig(deriveCompression(chunk.compression), chunk.maxbytes);
@@ -330,6 +334,7 @@ DocumentDBConfigManager::update(const ConfigSnapshot &snapshot)
                                  schema,
                                  newMaintenanceConfig,
                                  storeConfig,
+                                 std::max(0, _bootstrapConfig->getProtonConfig().summary.read.prefetch.minhits),
                                  _configId,
                                  _docTypeName);
     assert(newSnapshot->valid());
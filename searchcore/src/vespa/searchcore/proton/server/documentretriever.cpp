@@ -5,6 +5,7 @@
 #include <vespa/document/datatype/positiondatatype.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/arrayfieldvalue.h>
+#include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/searchcommon/attribute/attributecontent.h>
 #include <vespa/searchcore/proton/attribute/document_field_retriever.h>
@@ -109,9 +110,13 @@ zcurve_array_attribute_to_field_value(const document::Field& field,
     return new_fv;
 }
 
-void fillInPositionFields(Document &doc, DocumentIdT lid, const DocumentRetriever::PositionFields & possiblePositionFields, const IAttributeManager & attr_manager)
+void fillInPositionFields(Document &doc, DocumentIdT lid, const DocumentRetriever::PositionFields & possiblePositionFields,
+                          const IAttributeManager & attr_manager, const document::FieldSet & fieldSet)
 {
     for (const auto & it : possiblePositionFields) {
+        if (!fieldSet.contains(*it.first)) {
+            continue;
+        }
         auto attr_guard = attr_manager.getAttribute(it.second);
         auto& attr = *attr_guard;
         if (!attr->isUndefined(lid)) {
@@ -161,6 +166,16 @@ Document::UP DocumentRetriever::getDocument(DocumentIdT lid) const
     return doc;
 }
 
+Document::UP DocumentRetriever::getPartialDocument(DocumentIdT lid, const document::FieldSet & fieldSet) const
+{
+    Document::UP doc = _doc_store.read(lid, getDocumentTypeRepo());
+    if (doc) {
+        populate(lid, *doc, fieldSet);
+        document::FieldSet::stripFields(*doc, fieldSet);
+    }
+    return doc;
+}
+
 void DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const
 {
     PopulateVisitor populater(*this, visitor);
@@ -169,11 +184,20 @@ void DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocument
 
 void DocumentRetriever::populate(DocumentIdT lid, Document & doc) const
 {
+    populate(lid, doc, document::AllFields());
+}
+
+void DocumentRetriever::populate(DocumentIdT lid, Document & doc, const document::FieldSet & fieldSet) const
+{
+    bool allFields = (fieldSet.getType() == document::FieldSet::ALL);
     for (const auto &field : _attributeFields) {
-        AttributeGuard::UP attr = _attr_manager.getAttribute(field);
-        DocumentFieldRetriever::populate(lid, doc, field, **attr, _schema.isIndexField(field));
+        // Attribute values outside the field set would only be stripped again
+        if (allFields || fieldSet.contains(doc.getField(field))) {
+            AttributeGuard::UP attr = _attr_manager.getAttribute(field);
+            DocumentFieldRetriever::populate(lid, doc, field, **attr, _schema.isIndexField(field));
+        }
     }
-    fillInPositionFields(doc, lid, _possiblePositionFields, _attr_manager);
+    fillInPositionFields(doc, lid, _possiblePositionFields, _attr_manager, fieldSet);
 }
 
 const IAttributeManager *
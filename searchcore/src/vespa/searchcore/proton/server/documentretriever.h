@@ -25,8 +25,10 @@ public:
                       const search::IDocumentStore &doc_store);
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
+    document::Document::UP getPartialDocument(search::DocumentIdT lid, const document::FieldSet &fieldSet) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
     void populate(search::DocumentIdT lid, document::Document & doc) const;
+    void populate(search::DocumentIdT lid, document::Document & doc, const document::FieldSet & fieldSet) const;
 private:
     const search::index::Schema     &_schema;
     const search::IAttributeManager &_attr_manager;
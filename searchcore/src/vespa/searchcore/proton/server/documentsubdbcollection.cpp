@@ -20,12 +20,15 @@ using vespalib::makeLambdaTask;
 namespace proton {
 
 DocumentSubDBCollection::Config::Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-                                        size_t fixedAttributeTotalSkew, size_t numSearchThreads)
+                                        size_t fixedAttributeTotalSkew, uint32_t attributeMaxCompactLidsPerCommit,
+                                        size_t numSearchThreads, bool useGidHashIndex)
     : _readyGrowth(ready),
       _notReadyGrowth(notReady),
       _removedGrowth(removed),
       _fixedAttributeTotalSkew(fixedAttributeTotalSkew),
-      _numSearchThreads(numSearchThreads)
+      _attributeMaxCompactLidsPerCommit(attributeMaxCompactLidsPerCommit),
+      _numSearchThreads(numSearchThreads),
+      _useGidHashIndex(useGidHashIndex)
 { }
 
 DocumentSubDBCollection::DocumentSubDBCollection(
@@ -67,7 +70,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                     FastAccessDocSubDB::Config(
                             StoreOnlyDocSubDB::Config(docTypeName, "0.ready", baseDir,
                                     cfg.getReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                    _readySubDbId, SubDbType::READY),
+                                    cfg.getAttributeMaxCompactLidsPerCommit(),
+                                    _readySubDbId, SubDbType::READY, cfg.useGidHashIndex()),
                             true, true, false),
                     cfg.getNumSearchThreads()),
                 SearchableDocSubDB::Context(
@@ -77,7 +81,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
     _subDBs.push_back
         (new StoreOnlyDocSubDB(
                 StoreOnlyDocSubDB::Config(docTypeName, "1.removed", baseDir, cfg.getRemovedGrowth(),
-                        cfg.getFixedAttributeTotalSkew(), _remSubDbId, SubDbType::REMOVED),
+                        cfg.getFixedAttributeTotalSkew(), cfg.getAttributeMaxCompactLidsPerCommit(),
+                        _remSubDbId, SubDbType::REMOVED, cfg.useGidHashIndex()),
                 context));
 
     _subDBs.push_back
@@ -85,7 +90,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                 FastAccessDocSubDB::Config(
                         StoreOnlyDocSubDB::Config(docTypeName, "2.notready", baseDir,
                                 cfg.getNotReadyGrowth(), cfg.getFixedAttributeTotalSkew(),
-                                _notReadySubDbId, SubDbType::NOTREADY),
+                                cfg.getAttributeMaxCompactLidsPerCommit(),
+                                _notReadySubDbId, SubDbType::NOTREADY, cfg.useGidHashIndex()),
                         true, true, true),
                 FastAccessDocSubDB::Context(context, metrics.notReady.attributes, metricsWireService)));
 }
@@ -63,18 +63,23 @@ public:
     public:
         using GrowStrategy = search::GrowStrategy;
         Config(GrowStrategy ready, GrowStrategy notReady, GrowStrategy removed,
-               size_t fixedAttributeTotalSkew, size_t numSearchThreads);
+               size_t fixedAttributeTotalSkew, uint32_t attributeMaxCompactLidsPerCommit,
+               size_t numSearchThreads, bool useGidHashIndex);
         GrowStrategy getReadyGrowth() const { return _readyGrowth; }
         GrowStrategy getNotReadyGrowth() const { return _notReadyGrowth; }
         GrowStrategy getRemovedGrowth() const { return _removedGrowth; }
         size_t getNumSearchThreads() const { return _numSearchThreads; }
         size_t getFixedAttributeTotalSkew() const { return _fixedAttributeTotalSkew; }
+        uint32_t getAttributeMaxCompactLidsPerCommit() const { return _attributeMaxCompactLidsPerCommit; }
+        bool useGidHashIndex() const { return _useGidHashIndex; }
     private:
         const GrowStrategy _readyGrowth;
         const GrowStrategy _notReadyGrowth;
         const GrowStrategy _removedGrowth;
         const size_t       _fixedAttributeTotalSkew;
+        const uint32_t     _attributeMaxCompactLidsPerCommit;
         const size_t       _numSearchThreads;
+        const bool         _useGidHashIndex;
     };
 
 private:
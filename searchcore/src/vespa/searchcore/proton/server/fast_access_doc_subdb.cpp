@@ -79,6 +79,7 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                          (_hasAttributes ? configSnapshot.getAttributesConfig() : AttributesConfig()),
                                                          _attributeGrow,
                                                          _attributeGrowNumDocs,
+                                                         _attributeMaxCompactLidsPerCommit,
                                                          _fastAccessAttributesOnly,
                                                          _writeService.master(),
                                                          attrMgrResult);
@@ -104,8 +105,8 @@ AttributeCollectionSpec::UP
 FastAccessDocSubDB::createAttributeSpec(const AttributesConfig &attrCfg, SerialNum serialNum) const
 {
     uint32_t docIdLimit(_dms->getCommittedDocIdLimit());
-    AttributeCollectionSpecFactory factory(_attributeGrow,
-            _attributeGrowNumDocs, _fastAccessAttributesOnly);
+    AttributeCollectionSpecFactory factory(_attributeGrow, _attributeGrowNumDocs,
+            _attributeMaxCompactLidsPerCommit, _fastAccessAttributesOnly);
     return factory.create(attrCfg, docIdLimit, serialNum);
 }
 
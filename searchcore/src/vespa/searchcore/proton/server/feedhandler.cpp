@@ -5,7 +5,6 @@
 #include "feedstates.h"
 #include "i_feed_handler_owner.h"
 #include "ifeedview.h"
-#include "tlcproxy.h"
 #include "configstore.h"
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
@@ -20,7 +19,6 @@
 #include <vespa/searchlib/common/gatecallback.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/lambdatask.h>
-#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedhandler");
@@ -50,42 +48,46 @@ ignoreOperation(const DocumentOperation &op) {
     return (op.getPrevTimestamp() != 0) && (op.getTimestamp() < op.getPrevTimestamp());
 }
 
-}  // namespace
+/*
+ * Keeps the callbacks for a batch of operations until the batch is done.
+ */
+class BatchDoneCallbacks : public search::IDestructorCallback {
+    std::vector<std::shared_ptr<search::IDestructorCallback>> _callbacks;
+public:
+    BatchDoneCallbacks(std::vector<std::shared_ptr<search::IDestructorCallback>> callbacks)
+        : _callbacks(std::move(callbacks))
+    { }
+    ~BatchDoneCallbacks() override = default;
+};
 
-void FeedHandler::TlsMgrWriter::storeOperation(const FeedOperation &op, DoneCallback onDone) {
-    TlcProxy(_tls_mgr.getDomainName(), *_tlsDirectWriter).storeOperation(op, std::move(onDone));
-}
-bool FeedHandler::TlsMgrWriter::erase(SerialNum oldest_to_keep) {
-    return _tls_mgr.getSession()->erase(oldest_to_keep);
-}
+}  // namespace
 
-search::SerialNum
-FeedHandler::TlsMgrWriter::sync(SerialNum syncTo)
+void
+FeedHandler::doHandleOperation(FeedToken token, FeedOperation::UP op)
 {
-    for (int retryCount = 0; retryCount < 10; ++retryCount) {
-        SerialNum syncedTo(0);
-        LOG(spam, "Trying tls sync(%" PRIu64 ")", syncTo);
-        bool res = _tls_mgr.getSession()->sync(syncTo, syncedTo);
-        if (!res) {
-            LOG(spam, "Tls sync failed, retrying");
-            sleep(1);
-            continue;
-        }
-        if (syncedTo >= syncTo) {
-            LOG(spam, "Tls sync complete, reached %" PRIu64", returning", syncedTo);
-            return syncedTo;
-        }
-        LOG(spam, "Tls sync incomplete, reached %" PRIu64 ", retrying", syncedTo);
-    }
-    throw IllegalStateException(make_string("Failed to sync TLS to token %" PRIu64 ".", syncTo));
+    assert(_writeService.master().isCurrentThread());
+    std::lock_guard<std::mutex> guard(_feedLock);
+    _feedState->handleOperation(std::move(token), std::move(op));
 }
 
 void
-FeedHandler::doHandleOperation(FeedToken token, FeedOperation::UP op)
+FeedHandler::doHandleOperations(OperationBatch ops)
 {
     assert(_writeService.master().isCurrentThread());
     std::lock_guard<std::mutex> guard(_feedLock);
-    _feedState->handleOperation(std::move(token), std::move(op));
+    // The tokens are kept until the batch is visible
+    std::vector<std::shared_ptr<search::IDestructorCallback>> tokens;
+    tokens.reserve(ops.size());
+    _tlsWriter.startBatch();
+    _activeFeedView->startBatch();
+    for (auto &op : ops) {
+        if (op.first) {
+            tokens.push_back(op.first);
+        }
+        _feedState->handleOperation(std::move(op.first), std::move(op.second));
+    }
+    _tlsWriter.commitBatch();
+    _activeFeedView->endBatch(_serialNum, std::make_shared<BatchDoneCallbacks>(std::move(tokens)));
 }
 
 void FeedHandler::performPut(FeedToken token, PutOperation &op) {
@@ -594,11 +596,24 @@ FeedHandler::performOperation(FeedToken token, FeedOperation::UP op)
 void
 FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
 {
+    // Serialize the payload in the calling thread, leaving less work for the master write thread
+    op->preSerialize();
     _writeService.master().execute(makeLambdaTask([this, token = std::move(token), op = std::move(op)]() mutable {
         doHandleOperation(std::move(token), std::move(op));
     }));
 }
 
+void
+FeedHandler::handleOperations(OperationBatch ops)
+{
+    for (auto &op : ops) {
+        op.second->preSerialize();
+    }
+    _writeService.master().execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        doHandleOperations(std::move(ops));
+    }));
+}
+
 void
 FeedHandler::handleMove(MoveOperation &op, std::shared_ptr<search::IDestructorCallback> moveDoneCtx)
 {
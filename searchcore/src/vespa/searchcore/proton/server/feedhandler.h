@@ -7,6 +7,7 @@
 #include "igetserialnum.h"
 #include "iheartbeathandler.h"
 #include "ipruneremoveddocumentshandler.h"
+#include "tls_mgr_writer.h"
 #include "tlswriter.h"
 #include "transactionlogmanager.h"
 #include <persistence/spi/types.h>
@@ -48,6 +49,8 @@ class FeedHandler: private search::transactionlog::TransLogClient::Session::Call
                    public IOperationStorer,
                    public IGetSerialNum
 {
+public:
+    using OperationBatch = std::vector<std::pair<FeedToken, std::unique_ptr<FeedOperation>>>;
 private:
     typedef search::transactionlog::Packet  Packet;
     typedef search::transactionlog::RPC     RPC;
@@ -57,19 +60,6 @@ private:
     using FeedStateSP = std::shared_ptr<FeedState>;
     using FeedOperationUP = std::unique_ptr<FeedOperation>;
 
-    class TlsMgrWriter : public TlsWriter {
-        TransactionLogManager &_tls_mgr;
-        search::transactionlog::Writer *_tlsDirectWriter;
-    public:
-        TlsMgrWriter(TransactionLogManager &tls_mgr,
-                     search::transactionlog::Writer * tlsDirectWriter) :
-            _tls_mgr(tls_mgr),
-            _tlsDirectWriter(tlsDirectWriter)
-        { }
-        void storeOperation(const FeedOperation &op, DoneCallback onDone) override;
-        bool erase(SerialNum oldest_to_keep) override;
-        SerialNum sync(SerialNum syncTo) override;
-    };
     typedef searchcorespi::index::IThreadingService IThreadingService;
 
     IThreadingService                     &_writeService;
@@ -101,6 +91,7 @@ private:
      * The current feed state is sampled here.
      */
     void doHandleOperation(FeedToken token, FeedOperationUP op);
+    void doHandleOperations(OperationBatch ops);
 
     bool considerWriteOperationForRejection(FeedToken & token, const FeedOperation &op);
     bool considerUpdateOperationForRejection(FeedToken &token, UpdateOperation &op);
@@ -226,6 +217,13 @@ public:
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
 
+    /**
+     * Handle the operations in one master write thread task, writing them
+     * to the transaction log as a single packet and making them visible by
+     * a single commit. The tokens are acked when the batch is visible.
+     */
+    void handleOperations(OperationBatch ops);
+
     void handleMove(MoveOperation &op, std::shared_ptr<search::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
 
@@ -28,10 +28,16 @@ class ForceCommitContext : public search::IDestructorCallback
     std::unique_ptr<ForceCommitDoneTask> _task;
     uint32_t    _committedDocIdLimit;
     DocIdLimit *_docIdLimit;
+    std::shared_ptr<search::IDestructorCallback> _onDone;
 
 public:
+    /*
+     * onDone is kept until the forced commit is done, e.g. to ack feed
+     * operations that should be visible before being acked.
+     */
     ForceCommitContext(vespalib::Executor &executor,
-                       IDocumentMetaStore &documentMetaStore);
+                       IDocumentMetaStore &documentMetaStore,
+                       std::shared_ptr<search::IDestructorCallback> onDone = {});
 
     ~ForceCommitContext() override;
 
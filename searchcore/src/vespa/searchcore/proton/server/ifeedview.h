@@ -59,6 +59,14 @@ public:
     virtual void heartBeat(search::SerialNum serialNum) = 0;
     virtual void sync() = 0;
     virtual void forceCommit(search::SerialNum serialNum) = 0;
+
+    /**
+     * Operations handled between startBatch() and endBatch() can be made
+     * visible by a single commit in endBatch(). onDone is kept until the
+     * operations in the batch are visible.
+     */
+    virtual void startBatch() = 0;
+    virtual void endBatch(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) = 0;
     virtual void handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation & pruneOp) = 0;
     virtual void handleCompactLidSpace(const CompactLidSpaceOperation &op) = 0;
 };
@@ -45,26 +45,33 @@ LidSpaceCompactionJob::getNextDocument(const LidUsageStats &stats)
 bool
 LidSpaceCompactionJob::scanDocuments(const LidUsageStats &stats)
 {
-    if (_scanItr->valid()) {
-        DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
-            IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
-            if ( ! bucketGuard ) {
-                // the job is blocked until the bucket for this document is thawed
-                setBlocked(BlockedReason::FROZEN_BUCKET);
-                _retryFrozenDocument = true;
-                return true;
-            } else {
-                MoveOperation::UP op = _handler.createMoveOperation(document, stats.getLowestFreeLid());
-                search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
-                _opStorer.storeOperation(*op, context);
-                _handler.handleMove(*op, std::move(context));
-                if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                    return true;
-                }
-            }
+    LidUsageStats currStats(stats);
+    for (uint32_t moved = 0; moved < _cfg.getMoveBatchSize() && _scanItr->valid(); ++moved) {
+        if (moved > 0) {
+            // The previous move changed the lid usage of the handler
+            currStats = _handler.getLidStatus();
+        }
+        DocumentMetaData document = getNextDocument(currStats);
+        if (!document.valid()) {
+            break;
+        }
+        IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
+        if ( ! bucketGuard ) {
+            // the job is blocked until the bucket for this document is thawed
+            setBlocked(BlockedReason::FROZEN_BUCKET);
+            _retryFrozenDocument = true;
+            return true;
+        }
+        MoveOperation::UP op = _handler.createMoveOperation(document, currStats.getLowestFreeLid());
+        search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
+        _opStorer.storeOperation(*op, context);
+        _handler.handleMove(*op, std::move(context));
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            // Compaction is considered again at the end of the next batch
+            return true;
         }
     }
+    considerCompactLidSpaceIncrementally();
     if (!_scanItr->valid()){
         if (shouldRestartScanDocuments(_handler.getLidStatus())) {
             _scanItr = _handler.getIterator();
@@ -89,6 +96,33 @@ LidSpaceCompactionJob::compactLidSpace(const LidUsageStats &stats)
     _shouldCompactLidSpace = false;
 }
 
+bool
+LidSpaceCompactionJob::shouldCompactLidSpaceIncrementally(const LidUsageStats &stats) const
+{
+    uint32_t shrinkStep = _cfg.getIncrementalShrinkStep();
+    return (shrinkStep > 0 &&
+            stats.getLidLimit() >= stats.getHighestUsedLid() + 1 + shrinkStep);
+}
+
+void
+LidSpaceCompactionJob::considerCompactLidSpaceIncrementally()
+{
+    if ((_cfg.getIncrementalShrinkStep() == 0) || isBlocked()) {
+        return;
+    }
+    // Storing the compact lid space operation waits for the transaction log, so limit it to once per interval
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    if (now < _lastIncrementalCompaction + _cfg.getInterval()) {
+        return;
+    }
+    LidUsageStats stats = _handler.getLidStatus();
+    if (shouldCompactLidSpaceIncrementally(stats)) {
+        // Documents are scanned in gid order, so the scan can continue with the compacted lid space
+        compactLidSpace(stats);
+        _lastIncrementalCompaction = now;
+    }
+}
+
 bool
 LidSpaceCompactionJob::remove_batch_is_ongoing() const
 {
@@ -122,7 +156,8 @@ LidSpaceCompactionJob::LidSpaceCompactionJob(const DocumentDBLidSpaceCompactionC
       _clusterStateChangedNotifier(clusterStateChangedNotifier),
       _ops_rate_tracker(std::make_shared<RemoveOperationsRateTracker>(config.get_remove_batch_block_rate(),
                                                                       config.get_remove_block_rate())),
-      _is_disabled(false)
+      _is_disabled(false),
+      _lastIncrementalCompaction(vespalib::steady_time::min())
 {
     _diskMemUsageNotifier.addDiskMemUsageListener(this);
     _clusterStateChangedNotifier.addClusterStateChangedHandler(this);
@@ -22,6 +22,11 @@ class IClusterStateChangedNotifier;
  * for the given handler.
  *
  * Compaction is handled by moving documents from high lids to low free lids.
+ * Up to a configured number of documents are moved each time the job is run.
+ * If an incremental shrink step is configured, the lid space is compacted as
+ * soon as the moves have freed that many lids at the end of the lid space,
+ * instead of waiting until all documents have been moved. This is done at
+ * the end of a batch that is not blocked, at most once per job interval.
  * A handler is typically working over a single document sub db.
  */
 class LidSpaceCompactionJob : public BlockableMaintenanceJob,
@@ -40,12 +45,15 @@ private:
     IClusterStateChangedNotifier &_clusterStateChangedNotifier;
     std::shared_ptr<RemoveOperationsRateTracker> _ops_rate_tracker;
     bool _is_disabled;
+    vespalib::steady_time         _lastIncrementalCompaction;
 
     bool hasTooMuchLidBloat(const search::LidUsageStats &stats) const;
     bool shouldRestartScanDocuments(const search::LidUsageStats &stats) const;
     search::DocumentMetaData getNextDocument(const search::LidUsageStats &stats);
     bool scanDocuments(const search::LidUsageStats &stats);
     void compactLidSpace(const search::LidUsageStats &stats);
+    bool shouldCompactLidSpaceIncrementally(const search::LidUsageStats &stats) const;
+    void considerCompactLidSpaceIncrementally();
     void refreshRunnable();
     void refreshAndConsiderRunnable();
     bool remove_batch_is_ongoing() const;
@@ -32,8 +32,10 @@ getName(const IFlushHandler & handler, const IFlushTarget & target)
 
 static constexpr uint64_t gibi = UINT64_C(1024) * UINT64_C(1024) * UINT64_C(1024);
 
+}
+
 uint64_t
-estimateNeededTlsSizeForFlushTarget(const TlsStats &tlsStats, SerialNum flushedSerialNum)
+MemoryFlush::estimateNeededTlsSizeForFlushTarget(const TlsStats &tlsStats, SerialNum flushedSerialNum)
 {
     if (flushedSerialNum < tlsStats.getFirstSerial()) {
         return tlsStats.getNumBytes();
@@ -49,8 +51,6 @@ estimateNeededTlsSizeForFlushTarget(const TlsStats &tlsStats, SerialNum flushedS
     return bytesPerEntry * (tlsStats.getLastSerial() - flushedSerialNum);
 }
 
-}
-
 MemoryFlush::Config::Config()
     : maxGlobalMemory(4000*1024*1024ul),
       maxGlobalTlsSize(20 * gibi),
@@ -117,11 +117,11 @@ getOrderName(MemoryFlush::OrderType &orderType)
     return "DEFAULT";
 }
 
-size_t
-computeGain(const IFlushTarget::DiskGain & gain) {
-    return std::max(INT64_C(100000000), std::max(gain.getBefore(), gain.getAfter()));
 }
 
+size_t
+MemoryFlush::computeGain(const IFlushTarget::DiskGain & gain) {
+    return std::max(INT64_C(100000000), std::max(gain.getBefore(), gain.getAfter()));
 }
 
 FlushContext::List
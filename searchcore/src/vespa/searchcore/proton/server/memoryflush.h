@@ -7,6 +7,8 @@
 
 namespace proton {
 
+namespace flushengine { class TlsStats; }
+
 class MemoryFlush : public IFlushStrategy
 {
 public:
@@ -59,6 +61,11 @@ private:
         const flushengine::TlsStatsMap &_tlsStatsMap;
     };
 
+protected:
+    static uint64_t estimateNeededTlsSizeForFlushTarget(const flushengine::TlsStats &tlsStats,
+                                                        search::SerialNum flushedSerialNum);
+    static size_t computeGain(const searchcorespi::IFlushTarget::DiskGain &gain);
+
 public:
     using SP = std::shared_ptr<MemoryFlush>;
 
@@ -45,6 +45,18 @@ PersistenceHandlerProxy::handlePut(FeedToken token, const Bucket &bucket, Timest
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handlePutBatch(const Bucket &bucket, std::vector<BatchedPut> puts)
+{
+    FeedHandler::OperationBatch ops;
+    ops.reserve(puts.size());
+    for (auto &put : puts) {
+        ops.emplace_back(std::move(put.token),
+                         std::make_unique<PutOperation>(bucket.getBucketId().stripUnused(), put.timestamp, std::move(put.doc)));
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleUpdate(FeedToken token, const Bucket &bucket, Timestamp timestamp, const DocumentUpdateSP &upd)
 {
@@ -26,6 +26,7 @@ public:
     void initialize() override;
     void handlePut(FeedToken token, const storage::spi::Bucket &bucket,
                    storage::spi::Timestamp timestamp, DocumentSP doc) override;
+    void handlePutBatch(const storage::spi::Bucket &bucket, std::vector<BatchedPut> puts) override;
 
     void handleUpdate(FeedToken token, const storage::spi::Bucket &bucket,
                       storage::spi::Timestamp timestamp, const DocumentUpdateSP &upd) override;
@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include "cost_aware_flush.h"
 #include "disk_mem_usage_sampler.h"
 #include "document_db_explorer.h"
 #include "fileconfigmanager.h"
@@ -23,6 +24,7 @@
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/util/fileheadertk.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
@@ -49,6 +51,7 @@ using vespalib::makeLambdaTask;
 using vespalib::slime::ArrayInserter;
 using vespalib::slime::Cursor;
 
+using search::common::FlushIoThrottle;
 using search::transactionlog::DomainStats;
 using vespa::config::search::core::ProtonConfig;
 using vespa::config::search::core::internal::InternalProtonType;
@@ -101,6 +104,23 @@ diskMemUsageSamplerConfig(const ProtonConfig &proton, const HwInfo &hwInfo)
             hwInfo);
 }
 
+CostAwareFlush::CostConfig
+costAwareFlushConfig(const ProtonConfig::Flush &flush)
+{
+    return CostAwareFlush::CostConfig(flush.preparerestart.replaycost,
+                                      flush.preparerestart.replayoperationcost,
+                                      flush.costaware.memorygainweight,
+                                      flush.costaware.writebudget,
+                                      flush.costaware.writeburst);
+}
+
+FlushIoThrottle::Config
+flushIoThrottleConfig(const ProtonConfig::Flush::Io &io)
+{
+    return FlushIoThrottle::Config(FlushIoThrottle::BucketConfig(io.urgent.rate, io.urgent.burst),
+                                   FlushIoThrottle::BucketConfig(io.background.rate, io.background.burst));
+}
+
 size_t
 derive_shared_threads(const ProtonConfig &proton,
                       const HwInfo::Cpu &cpuInfo) {
@@ -278,6 +298,15 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
         strategy = memoryFlush;
         break;
     }
+    case ProtonConfig::Flush::Strategy::COSTAWARE: {
+        _costAwareFlush = std::make_shared<CostAwareFlush>(
+                MemoryFlushConfigUpdater::convertConfig(flush.memory, hwInfo.memory()), costAwareFlushConfig(flush),
+                vespalib::system_clock::now(), vespalib::steady_clock::now());
+        _memoryFlushConfigUpdater = std::make_unique<MemoryFlushConfigUpdater>(_costAwareFlush, flush.memory, hwInfo.memory());
+        _diskMemUsageSampler->notifier().addDiskMemUsageListener(_memoryFlushConfigUpdater.get());
+        strategy = _costAwareFlush;
+        break;
+    }
     case ProtonConfig::Flush::Strategy::SIMPLE:
     default:
         strategy = std::make_shared<SimpleFlush>();
@@ -356,8 +385,12 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
     const std::shared_ptr<const DocumentTypeRepo> repo = configSnapshot->getDocumentTypeRepoSP();
 
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, configSnapshot->getHwInfo()));
+    FlushIoThrottle::instance().setConfig(flushIoThrottleConfig(protonConfig.flush.io));
     if (_memoryFlushConfigUpdater) {
         _memoryFlushConfigUpdater->setConfig(protonConfig.flush.memory);
+        if (_costAwareFlush) {
+            _costAwareFlush->setCostConfig(costAwareFlushConfig(protonConfig.flush));
+        }
         _flushEngine->kick();
     }
 }
@@ -719,6 +752,8 @@ Proton::updateMetrics(const vespalib::MonitorGuard &)
         metrics.resourceUsage.memoryMappings.set(usageFilter.getMemoryStats().getMappingsCount());
         metrics.resourceUsage.openFileDescriptors.set(FastOS_File::count_open_files());
         metrics.resourceUsage.feedingBlocked.set((usageFilter.acceptWriteOperation() ? 0.0 : 1.0));
+        metrics.resourceUsage.mmapPolicy.update(vespalib::alloc::MMapPolicyStats::get());
+        metrics.flushIo.update(FlushIoThrottle::instance().getStats());
     }
     {
         ContentProtonMetrics::ProtonExecutorMetrics &metrics = _metricsEngine->root().executor;
@@ -880,7 +915,7 @@ Proton::get_child(vespalib::stringref name) const
     } else if (name == DOCUMENT_DB) {
         return std::make_unique<DocumentDBMapExplorer>(_documentDBMap, _mutex);
     } else if (name == FLUSH_ENGINE && _flushEngine) {
-        return std::make_unique<FlushEngineExplorer>(*_flushEngine);
+        return std::make_unique<FlushEngineExplorer>(*_flushEngine, _costAwareFlush.get());
     } else if (name == TLS_NAME && _tls) {
         return std::make_unique<search::transactionlog::TransLogServerExplorer>(_tls->getTransLogServer());
     } else if (name == RESOURCE_USAGE && _diskMemUsageSampler) {
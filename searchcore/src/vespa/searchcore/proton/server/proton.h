@@ -4,6 +4,7 @@
 
 #include "bootstrapconfig.h"
 #include "bootstrapconfigmanager.h"
+#include "cost_aware_flush.h"
 #include "documentdb.h"
 #include "health_adapter.h"
 #include "i_proton_configurer_owner.h"
@@ -99,6 +100,7 @@ private:
     std::unique_ptr<SummaryEngine>  _summaryEngine;
     std::unique_ptr<DocsumBySlime>  _docsumBySlime;
     MemoryFlushConfigUpdater::UP    _memoryFlushConfigUpdater;
+    CostAwareFlush::SP              _costAwareFlush;
     std::unique_ptr<FlushEngine>    _flushEngine;
     std::unique_ptr<PrepareRestartHandler> _prepareRestartHandler;
     RPCHooks::UP                    _rpcHooks;
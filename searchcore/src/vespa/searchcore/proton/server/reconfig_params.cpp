@@ -26,7 +26,8 @@ ReconfigParams::configHasChanged() const
             _res.tuneFileDocumentDBChanged ||
             _res.schemaChanged ||
             _res.maintenanceChanged ||
-            _res.storeChanged;
+            _res.storeChanged ||
+            _res.summaryPrefetchChanged;
 }
 
 bool
@@ -57,7 +58,8 @@ bool
 ReconfigParams::shouldSummaryManagerChange() const
 {
     return  _res.summaryChanged || _res.summarymapChanged || _res.juniperrcChanged
-            || _res.documentTypeRepoChanged || _res.documenttypesChanged || _res.storeChanged;
+            || _res.documentTypeRepoChanged || _res.documenttypesChanged || _res.storeChanged
+            || _res.summaryPrefetchChanged;
 }
 
 bool
@@ -238,7 +238,8 @@ SearchableDocSubDBConfigurer::reconfigure(const DocumentDBConfig &newConfig,
                                        newConfig.getSummarymapConfig(),
                                        newConfig.getJuniperrcConfig(),
                                        newConfig.getDocumentTypeRepoSP(),
-                                       attrMgr);
+                                       attrMgr,
+                                       newConfig.getSummaryPrefetchMinHits());
         sumSetup = newSumSetup;
         shouldSearchViewChange = true;
     }
@@ -211,7 +211,8 @@ SearchableDocSubDB::initViews(const DocumentDBConfig &configSnapshot, const Sess
                                               configSnapshot.getSummarymapConfig(),
                                               configSnapshot.getJuniperrcConfig(),
                                               configSnapshot.getDocumentTypeRepoSP(),
-                                              attrMgr),
+                                              attrMgr,
+                                              configSnapshot.getSummaryPrefetchMinHits()),
                                       std::move(matchView)));
 
     auto attrWriter = std::make_shared<AttributeWriter>(attrMgr);
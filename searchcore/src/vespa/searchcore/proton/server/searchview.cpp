@@ -150,7 +150,8 @@ SearchView::getDocsumsInternal(const DocsumRequest & req)
     MatchContext::UP mctx = _matchView->createContext();
     auto ctx = std::make_unique<DocsumContext>(req, _summarySetup->getDocsumWriter(), *store, _matchView->getMatcher(req.ranking),
                                                mctx->getSearchContext(), mctx->getAttributeContext(),
-                                               *_summarySetup->getAttributeManager(), *getSessionManager());
+                                               *_summarySetup->getAttributeManager(), *getSessionManager(),
+                                               _summarySetup->getPrefetchMinHits());
     SearchView::InternalDocsumReply reply(ctx->getDocsums(), true);
     uint64_t endGeneration = readGuard->get().getCurrentGeneration();
     if (startGeneration != endGeneration) {
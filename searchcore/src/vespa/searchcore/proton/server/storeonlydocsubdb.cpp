@@ -59,14 +59,16 @@ IIndexWriter::SP nullIndexWriter;
 StoreOnlyDocSubDB::Config::Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                                   const vespalib::string &baseDir,
                                   const search::GrowStrategy &attributeGrow, size_t attributeGrowNumDocs,
-                                  uint32_t subDbId, SubDbType subDbType)
+                                  uint32_t attributeMaxCompactLidsPerCommit, uint32_t subDbId, SubDbType subDbType, bool useGidHashIndex)
     : _docTypeName(docTypeName),
       _subName(subName),
       _baseDir(baseDir + "/" + subName),
       _attributeGrow(attributeGrow),
       _attributeGrowNumDocs(attributeGrowNumDocs),
+      _attributeMaxCompactLidsPerCommit(attributeMaxCompactLidsPerCommit),
       _subDbId(subDbId),
-      _subDbType(subDbType)
+      _subDbType(subDbType),
+      _useGidHashIndex(useGidHashIndex)
 { }
 StoreOnlyDocSubDB::Config::~Config() = default;
 
@@ -103,6 +105,8 @@ StoreOnlyDocSubDB::StoreOnlyDocSubDB(const Config &cfg, const Context &ctx)
       _metaStoreCtx(),
       _attributeGrow(cfg._attributeGrow),
       _attributeGrowNumDocs(cfg._attributeGrowNumDocs),
+      _attributeMaxCompactLidsPerCommit(cfg._attributeMaxCompactLidsPerCommit),
+      _useGidHashIndex(cfg._useGidHashIndex),
       _flushedDocumentMetaStoreSerialNum(0u),
       _flushedDocumentStoreSerialNum(0u),
       _dms(),
@@ -260,7 +264,8 @@ createDocumentMetaStoreInitializer(const search::TuneFileAttributes &tuneFile,
     // initializers to get hold of document meta store instance in
     // their constructors.
     *result = std::make_shared<DocumentMetaStoreInitializerResult>
-              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, gidCompare, _subDbType), tuneFile);
+              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, gidCompare, _subDbType,
+                                                   _useGidHashIndex), tuneFile);
     return std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
         (baseDir, getSubDbName(), _docTypeName.toString(), (*result)->documentMetaStore());
 }
@@ -93,12 +93,15 @@ public:
         const vespalib::string _baseDir;
         const search::GrowStrategy _attributeGrow;
         const size_t _attributeGrowNumDocs;
+        const uint32_t _attributeMaxCompactLidsPerCommit;
         const uint32_t _subDbId;
         const SubDbType _subDbType;
+        const bool _useGidHashIndex;
 
         Config(const DocTypeName &docTypeName, const vespalib::string &subName,
                const vespalib::string &baseDir, const search::GrowStrategy &attributeGrow,
-               size_t attributeGrowNumDocs, uint32_t subDbId, SubDbType subDbType);
+               size_t attributeGrowNumDocs, uint32_t attributeMaxCompactLidsPerCommit,
+               uint32_t subDbId, SubDbType subDbType, bool useGidHashIndex);
         ~Config();
     };
 
@@ -138,6 +141,8 @@ protected:
     IDocumentMetaStoreContext::SP _metaStoreCtx;
     const search::GrowStrategy    _attributeGrow;
     const size_t                  _attributeGrowNumDocs;
+    const uint32_t                _attributeMaxCompactLidsPerCommit;
+    const bool                    _useGidHashIndex;
     // The following two serial numbers reflect state at program startup
     // and are used by replay logic.
     SerialNum                     _flushedDocumentMetaStoreSerialNum;
@@ -234,6 +234,24 @@ StoreOnlyFeedView::forceCommit(SerialNum serialNum, OnForceCommitDoneType onComm
     }
 }
 
+void
+StoreOnlyFeedView::startBatch()
+{
+    if (_commitTimeTracker.startBatch()) {
+        // Lids freed during the batch are reused when the batch commit is done
+        _lidReuseDelayer.setImmediateCommit(false);
+    }
+}
+
+void
+StoreOnlyFeedView::endBatch(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone)
+{
+    if (_commitTimeTracker.endBatch()) {
+        forceCommit(serialNum, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore, std::move(onDone)));
+        _lidReuseDelayer.setImmediateCommit(true);
+    }
+}
+
 void
 StoreOnlyFeedView::considerEarlyAck(FeedToken & token)
 {
@@ -293,7 +311,13 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
         std::shared_ptr<PutDoneContext> onWriteDone =
             createPutDoneContext(std::move(token), _gidToLidChangeHandler, doc, gid, putOp.getLid(), serialNum,
                                  putOp.changedDbdId() && useDocumentMetaStore(serialNum));
-        putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        // Reuse the bytes serialized for the transaction log if available
+        std::shared_ptr<const vespalib::nbostream> serializedDoc = putOp.getSerializedDocument();
+        if (serializedDoc) {
+            putSummary(serialNum, putOp.getLid(), std::move(serializedDoc), onWriteDone);
+        } else {
+            putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        }
         putAttributes(serialNum, putOp.getLid(), *doc, immediateCommit, onWriteDone);
         putIndexedFields(serialNum, putOp.getLid(), doc, immediateCommit, onWriteDone);
     }
@@ -378,6 +402,21 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP do
             }));
 #pragma GCC diagnostic pop
 }
+
+void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, std::shared_ptr<const vespalib::nbostream> doc,
+                                   OnOperationDoneType onDone)
+{
+    _pendingLidTracker.produce(lid);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winline" // Avoid spurious inlining warning from GCC related to lambda destructor.
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, doc = std::move(doc), onDone, lid, this] {
+                (void) onDone;
+                _summaryAdapter->put(serialNum, lid, *doc);
+                _pendingLidTracker.consume(lid);
+            }));
+#pragma GCC diagnostic pop
+}
 void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneType onDone) {
     _pendingLidTracker.produce(lid);
     summaryExecutor().execute(
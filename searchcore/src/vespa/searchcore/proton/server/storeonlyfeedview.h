@@ -161,6 +161,8 @@ private:
     }
     void putSummary(SerialNum serialNum,  Lid lid, FutureStream doc, OnOperationDoneType onDone);
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
+    void putSummary(SerialNum serialNum,  Lid lid, std::shared_ptr<const vespalib::nbostream> doc,
+                    OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
 
@@ -256,6 +258,8 @@ public:
     void sync() override;
     void forceCommit(SerialNum serialNum) override;
     virtual void forceCommit(SerialNum serialNum, OnForceCommitDoneType onCommitDone);
+    void startBatch() override;
+    void endBatch(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) override;
 
     /**
      * Prune lids present in operation.  Caller must call doneSegment()
@@ -2,6 +2,7 @@
 
 #include "tlcproxy.h"
 #include <vespa/searchcore/proton/feedoperation/feedoperation.h>
+#include <vespa/vespalib/util/lambdatask.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.tlcproxy");
@@ -15,10 +16,28 @@ void TlcProxy::commit(search::SerialNum serialNum, search::transactionlog::Type
                       const vespalib::nbostream &buf, DoneCallback onDone)
 {
     Packet::Entry entry(serialNum, type, vespalib::ConstBufferRef(buf.data(), buf.size()));
-    Packet packet;
+    Packet packet(entry.serializedSize());
     packet.add(entry);
     packet.close();
-    _tlsDirectWriter.commit(_domain, packet, std::move(onDone));
+    commitPacket(std::move(packet), std::move(onDone));
+}
+
+void
+TlcProxy::commitPacket(Packet packet, DoneCallback onDone)
+{
+    if (_appendExecutor == nullptr) {
+        _tlsDirectWriter.commit(_domain, packet, std::move(onDone));
+        return;
+    }
+    auto task = vespalib::makeLambdaTask([&writer = _tlsDirectWriter, domain = _domain, packet = std::move(packet),
+                                          onDone = std::move(onDone)]() mutable
+                                         {
+                                             writer.commit(domain, packet, std::move(onDone));
+                                         });
+    auto rejected = _appendExecutor->execute(std::move(task));
+    if (rejected) {
+        rejected->run();
+    }
 }
 
 void
@@ -31,4 +50,13 @@ TlcProxy::storeOperation(const FeedOperation &op, DoneCallback onDone)
     commit(op.getSerialNum(), (uint32_t)op.getType(), stream, std::move(onDone));
 }
 
+bool
+TlcProxy::addOperation(Packet &packet, const FeedOperation &op)
+{
+    nbostream stream;
+    op.serialize(stream);
+    Packet::Entry entry(op.getSerialNum(), (uint32_t)op.getType(), vespalib::ConstBufferRef(stream.data(), stream.size()));
+    return packet.add(entry);
+}
+
 }  // namespace proton
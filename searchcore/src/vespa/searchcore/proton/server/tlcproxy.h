@@ -3,6 +3,8 @@
 
 #include <vespa/searchlib/transactionlog/common.h>
 
+namespace vespalib { class Executor; }
+
 namespace proton {
 
 class FeedOperation;
@@ -12,16 +14,28 @@ class TlcProxy {
     using Writer = search::transactionlog::Writer;
     vespalib::string    _domain;
     Writer            & _tlsDirectWriter;
+    vespalib::Executor *_appendExecutor;
 
     void commit(search::SerialNum serialNum, search::transactionlog::Type type,
                 const vespalib::nbostream &buf, DoneCallback onDone);
 public:
+    using Packet = search::transactionlog::Packet;
     typedef std::unique_ptr<TlcProxy> UP;
 
-    TlcProxy(const vespalib::string & domain, Writer & writer)
-        : _domain(domain), _tlsDirectWriter(writer) {}
+    /**
+     * If an append executor is given, the serialized operation is
+     * committed to the transaction log by a task in that executor.
+     */
+    TlcProxy(const vespalib::string & domain, Writer & writer, vespalib::Executor *appendExecutor = nullptr)
+        : _domain(domain), _tlsDirectWriter(writer), _appendExecutor(appendExecutor) {}
 
     void storeOperation(const FeedOperation &op, DoneCallback onDone);
+
+    /**
+     * Serialize the operation into the packet. Returns false if the packet is full.
+     */
+    static bool addOperation(Packet &packet, const FeedOperation &op);
+    void commitPacket(Packet packet, DoneCallback onDone);
 };
 
 } // namespace proton
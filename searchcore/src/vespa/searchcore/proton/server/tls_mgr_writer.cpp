@@ -0,0 +1,124 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tls_mgr_writer.h"
+#include "tlcproxy.h"
+#include "transactionlogmanager.h"
+#include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.server.tls_mgr_writer");
+
+using search::SerialNum;
+using vespalib::IllegalStateException;
+using vespalib::make_string;
+
+namespace proton {
+
+namespace {
+
+/*
+ * Keeps the callbacks for a batch of operations until the batch is done.
+ */
+class BatchDoneCallbacks : public search::IDestructorCallback {
+    std::vector<std::shared_ptr<search::IDestructorCallback>> _callbacks;
+public:
+    BatchDoneCallbacks(std::vector<std::shared_ptr<search::IDestructorCallback>> callbacks)
+        : _callbacks(std::move(callbacks))
+    { }
+    ~BatchDoneCallbacks() override = default;
+};
+
+}
+
+TlsMgrWriter::TlsMgrWriter(TransactionLogManager &tls_mgr,
+                           search::transactionlog::Writer * tlsDirectWriter,
+                           uint32_t appendTaskLimit)
+    : _tls_mgr(tls_mgr),
+      _tlsDirectWriter(tlsDirectWriter),
+      _appendExecutor(1, 128 * 1024, appendTaskLimit),
+      _batchPacket(),
+      _batchDone()
+{ }
+
+TlsMgrWriter::~TlsMgrWriter()
+{
+    _appendExecutor.shutdown();
+    _appendExecutor.sync();
+}
+
+void
+TlsMgrWriter::storeOperation(const FeedOperation &op, DoneCallback onDone)
+{
+    if (_batchPacket) {
+        if (!TlcProxy::addOperation(*_batchPacket, op)) {
+            commitBatchPacket();
+            bool added = TlcProxy::addOperation(*_batchPacket, op);
+            assert(added);
+            (void) added;
+        }
+        if (onDone) {
+            _batchDone.push_back(std::move(onDone));
+        }
+        return;
+    }
+    TlcProxy(_tls_mgr.getDomainName(), *_tlsDirectWriter, &_appendExecutor).storeOperation(op, std::move(onDone));
+}
+
+void
+TlsMgrWriter::commitBatchPacket()
+{
+    auto onDone = std::make_shared<BatchDoneCallbacks>(std::move(_batchDone));
+    _batchDone.clear();
+    TlcProxy(_tls_mgr.getDomainName(), *_tlsDirectWriter, &_appendExecutor).commitPacket(std::move(*_batchPacket), std::move(onDone));
+    _batchPacket = std::make_unique<Packet>();
+}
+
+void
+TlsMgrWriter::startBatch()
+{
+    _batchPacket = std::make_unique<Packet>();
+}
+
+void
+TlsMgrWriter::commitBatch()
+{
+    if (_batchPacket && !_batchPacket->empty()) {
+        commitBatchPacket();
+    }
+    _batchPacket.reset();
+}
+
+bool
+TlsMgrWriter::erase(SerialNum oldest_to_keep)
+{
+    _appendExecutor.sync();
+    return _tls_mgr.getSession()->erase(oldest_to_keep);
+}
+
+SerialNum
+TlsMgrWriter::sync(SerialNum syncTo)
+{
+    _appendExecutor.sync();
+    for (int retryCount = 0; retryCount < 10; ++retryCount) {
+        SerialNum syncedTo(0);
+        LOG(spam, "Trying tls sync(%" PRIu64 ")", syncTo);
+        bool res = _tls_mgr.getSession()->sync(syncTo, syncedTo);
+        if (!res) {
+            LOG(spam, "Tls sync failed, retrying");
+            sleep(1);
+            continue;
+        }
+        if (syncedTo >= syncTo) {
+            LOG(spam, "Tls sync complete, reached %" PRIu64", returning", syncedTo);
+            return syncedTo;
+        }
+        LOG(spam, "Tls sync incomplete, reached %" PRIu64 ", retrying", syncedTo);
+    }
+    throw IllegalStateException(make_string("Failed to sync TLS to token %" PRIu64 ".", syncTo));
+}
+
+} // namespace proton
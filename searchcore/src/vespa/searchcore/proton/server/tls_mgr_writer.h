@@ -0,0 +1,51 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tlswriter.h"
+#include <vespa/searchlib/transactionlog/common.h>
+#include <vespa/vespalib/util/blockingthreadstackexecutor.h>
+#include <memory>
+#include <vector>
+
+namespace proton {
+
+class TransactionLogManager;
+
+/**
+ * Appends operations to the transaction log in a separate thread, taking
+ * the log write off the master write thread. Operations are appended in
+ * the order they are stored, and onDone is kept until the operation is
+ * written. sync() and erase() first wait for pending appends.
+ * Operations stored in a batch are appended as a single packet.
+ *
+ * At most appendTaskLimit appends are queued. Storing an operation blocks
+ * when the queue is full.
+ */
+class TlsMgrWriter : public TlsWriter {
+public:
+    // Max number of operations waiting to be appended to the transaction log before the master write thread blocks
+    static constexpr uint32_t defaultAppendTaskLimit = 1000;
+private:
+    using Packet = search::transactionlog::Packet;
+
+    TransactionLogManager &_tls_mgr;
+    search::transactionlog::Writer *_tlsDirectWriter;
+    vespalib::BlockingThreadStackExecutor _appendExecutor;
+    std::unique_ptr<Packet>   _batchPacket;
+    std::vector<DoneCallback> _batchDone;
+
+    void commitBatchPacket();
+public:
+    TlsMgrWriter(TransactionLogManager &tls_mgr,
+                 search::transactionlog::Writer * tlsDirectWriter,
+                 uint32_t appendTaskLimit = defaultAppendTaskLimit);
+    ~TlsMgrWriter() override;
+    void storeOperation(const FeedOperation &op, DoneCallback onDone) override;
+    bool erase(search::SerialNum oldest_to_keep) override;
+    search::SerialNum sync(search::SerialNum syncTo) override;
+    void startBatch() override;
+    void commitBatch() override;
+};
+
+} // namespace proton
@@ -15,6 +15,13 @@ struct TlsWriter : public IOperationStorer {
 
     virtual bool erase(search::SerialNum oldest_to_keep) = 0;
     virtual search::SerialNum sync(search::SerialNum syncTo) = 0;
+
+    /**
+     * Operations stored between startBatch() and commitBatch() may be
+     * written to the transaction log as a single packet.
+     */
+    virtual void startBatch() { }
+    virtual void commitBatch() { }
 };
 
 }
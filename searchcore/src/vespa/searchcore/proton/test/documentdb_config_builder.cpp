@@ -43,6 +43,7 @@ DocumentDBConfigBuilder::DocumentDBConfigBuilder(int64_t generation,
       _schema(schema),
       _maintenance(std::make_shared<DocumentDBMaintenanceConfig>()),
       _store(),
+      _summaryPrefetchMinHits(0),
       _configId(configId),
       _docTypeName(docTypeName)
 { }
@@ -64,6 +65,7 @@ DocumentDBConfigBuilder::DocumentDBConfigBuilder(const DocumentDBConfig &cfg)
       _schema(cfg.getSchemaSP()),
       _maintenance(cfg.getMaintenanceConfigSP()),
       _store(cfg.getStoreConfig()),
+      _summaryPrefetchMinHits(cfg.getSummaryPrefetchMinHits()),
       _configId(cfg.getConfigId()),
       _docTypeName(cfg.getDocTypeName())
 {}
@@ -89,6 +91,7 @@ DocumentDBConfigBuilder::build()
             _schema,
             _maintenance,
             _store,
+            _summaryPrefetchMinHits,
             _configId,
             _docTypeName);
 }
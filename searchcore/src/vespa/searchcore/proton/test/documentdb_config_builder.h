@@ -26,6 +26,7 @@ private:
     search::index::Schema::SP _schema;
     DocumentDBConfig::MaintenanceConfigSP _maintenance;
     search::LogDocumentStore::Config _store;
+    uint32_t _summaryPrefetchMinHits;
     vespalib::string _configId;
     vespalib::string _docTypeName;
 
@@ -66,6 +67,10 @@ public:
         _summarymap = summarymap_in;
         return *this;
     }
+    DocumentDBConfigBuilder &summaryPrefetchMinHits(uint32_t summaryPrefetchMinHits_in) {
+        _summaryPrefetchMinHits = summaryPrefetchMinHits_in;
+        return *this;
+    }
     DocumentDBConfig::SP build();
 };
 
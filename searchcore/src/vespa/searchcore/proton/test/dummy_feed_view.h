@@ -33,6 +33,8 @@ struct DummyFeedView : public IFeedView
     void handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation &) override {}
     void handleCompactLidSpace(const CompactLidSpaceOperation &) override {}
     void forceCommit(search::SerialNum) override { }
+    void startBatch() override { }
+    void endBatch(search::SerialNum, std::shared_ptr<search::IDestructorCallback>) override { }
 };
 
 }
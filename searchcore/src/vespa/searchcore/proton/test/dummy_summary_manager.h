@@ -14,7 +14,8 @@ struct DummySummaryManager : public ISummaryManager
                        const vespa::config::search::SummarymapConfig &,
                        const vespa::config::search::summary::JuniperrcConfig &,
                        const std::shared_ptr<const document::DocumentTypeRepo> &,
-                       const std::shared_ptr<search::IAttributeManager> &) override {
+                       const std::shared_ptr<search::IAttributeManager> &,
+                       uint32_t) override {
         return ISummarySetup::SP();
     }
 };
@@ -239,6 +239,7 @@ private:
     void testGeneration();
 
     void testCreateSerialNum();
+    void testMemoryMappedLoad();
 
     void testPredicateHeaderTags();
 
@@ -1895,6 +1896,59 @@ AttributeTest::testCreateSerialNum()
     EXPECT_EQUAL(42u, attr2->getCreateSerialNum());
 }
 
+void
+AttributeTest::testMemoryMappedLoad()
+{
+    Config cfg(BasicType::INT64);
+    cfg.setEnableMemoryMappedLoad(true);
+    AttributePtr attr = createAttribute("mmap_int64", cfg);
+    addDocs(attr, 1000);
+    auto &iattr = static_cast<IntegerAttribute &>(*attr);
+    for (uint32_t doc = 0; doc < 1000; ++doc) {
+        EXPECT_TRUE(iattr.update(doc, doc * 3));
+    }
+    attr->commit();
+    EXPECT_TRUE(attr->save());
+
+    AttributePtr attr2 = createAttribute("mmap_int64", cfg);
+    EXPECT_TRUE(attr2->load());
+    EXPECT_EQUAL(1000u, attr2->getNumDocs());
+    EXPECT_EQUAL(15, attr2->getInt(5));
+    EXPECT_EQUAL(2997, attr2->getInt(999));
+    auto &iattr2 = static_cast<IntegerAttribute &>(*attr2);
+    EXPECT_TRUE(iattr2.update(5, 42));
+    AttributeVector::DocId docId;
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(attr2->addDoc(docId)); // grows beyond the mapped file
+    }
+    EXPECT_TRUE(iattr2.update(docId, 7));
+    attr2->commit();
+    EXPECT_EQUAL(42, attr2->getInt(5));
+    EXPECT_EQUAL(2997, attr2->getInt(999));
+    EXPECT_EQUAL(7, attr2->getInt(docId));
+
+    // Writes to a mapped attribute are never written back to the save file
+    AttributePtr attr3 = createAttribute("mmap_int64", cfg);
+    EXPECT_TRUE(attr3->load());
+    EXPECT_EQUAL(1000u, attr3->getNumDocs());
+    EXPECT_EQUAL(15, attr3->getInt(5));
+
+    // Saving copies the values out of the mapped file, later writes go to the copy
+    auto &iattr3 = static_cast<IntegerAttribute &>(*attr3);
+    EXPECT_TRUE(iattr3.update(6, 43));
+    attr3->commit();
+    EXPECT_TRUE(attr3->save("mmap_int64_copy"));
+    EXPECT_TRUE(iattr3.update(7, 44));
+    attr3->commit();
+    EXPECT_EQUAL(43, attr3->getInt(6));
+    EXPECT_EQUAL(44, attr3->getInt(7));
+    EXPECT_EQUAL(2997, attr3->getInt(999));
+    AttributePtr attr4 = createAttribute("mmap_int64_copy", cfg);
+    EXPECT_TRUE(attr4->load());
+    EXPECT_EQUAL(43, attr4->getInt(6));
+    EXPECT_EQUAL(21, attr4->getInt(7));
+}
+
 void
 AttributeTest::testPredicateHeaderTags()
 {
@@ -2304,6 +2358,7 @@ int AttributeTest::Main()
     testNullProtection();
     testGeneration();
     testCreateSerialNum();
+    testMemoryMappedLoad();
     testPredicateHeaderTags();
     TEST_DO(testCompactLidSpace());
     TEST_DO(test_default_value_ref_count_is_updated_after_shrink_lid_space());
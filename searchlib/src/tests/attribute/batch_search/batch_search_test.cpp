@@ -0,0 +1,168 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("batch_search_test");
+
+using namespace search::attribute;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::BitVector;
+using search::FloatingPointAttribute;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+using search::queryeval::SearchIterator;
+
+namespace {
+
+constexpr uint32_t num_docs = 10000;
+
+/*
+ * Value for document, with a sparse set of documents in the 1000 range to
+ * get hits both within and across the 4096 document batches.
+ */
+int64_t
+value_for(uint32_t doc_id)
+{
+    return ((doc_id % 1009) == 0 || (doc_id % 4096) == 4095) ? 1000 + (doc_id % 7) : (doc_id % 100);
+}
+
+template <typename AttrType>
+AttributeVector::SP
+make_attribute(BasicType type, bool filter)
+{
+    Config cfg(type, CollectionType::SINGLE);
+    cfg.setIsFilter(filter);
+    auto attr = AttributeFactory::createAttribute("batch", cfg);
+    attr->addDocs(num_docs);
+    auto &typed_attr = dynamic_cast<AttrType &>(*attr);
+    for (uint32_t doc_id = 1; doc_id < num_docs; ++doc_id) {
+        typed_attr.update(doc_id, value_for(doc_id));
+    }
+    attr->commit();
+    return attr;
+}
+
+std::vector<uint32_t>
+expected_hits(int64_t low, int64_t high, uint32_t begin_id)
+{
+    std::vector<uint32_t> result;
+    for (uint32_t doc_id = begin_id; doc_id < num_docs; ++doc_id) {
+        int64_t value = value_for(doc_id);
+        if (low <= value && value <= high) {
+            result.push_back(doc_id);
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t>
+to_vector(const BitVector &bv, uint32_t begin_id)
+{
+    std::vector<uint32_t> result;
+    bv.foreach_truebit([&](uint32_t doc_id) { result.push_back(doc_id); }, begin_id);
+    return result;
+}
+
+class SearchFixture {
+    std::unique_ptr<AttributeVector::SearchContext> _sc;
+    TermFieldMatchData _md;
+public:
+    std::unique_ptr<SearchIterator> itr;
+
+    SearchFixture(AttributeVector &attr, const vespalib::string &term, bool strict)
+        : _sc(attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD), SearchContextParams())),
+          _md(),
+          itr()
+    {
+        _sc->fetchPostings(ExecuteInfo::create(strict));
+        itr = _sc->createIterator(&_md, strict);
+        itr->initRange(1, num_docs);
+    }
+    std::vector<uint32_t> strict_hits() {
+        std::vector<uint32_t> result;
+        for (itr->seek(1); !itr->isAtEnd(); itr->seek(itr->getDocId() + 1)) {
+            result.push_back(itr->getDocId());
+        }
+        return result;
+    }
+};
+
+}
+
+template <typename AttrType>
+void
+verify_batch_search(BasicType type, bool filter)
+{
+    SCOPED_TRACE(vespalib::make_string("type=%s, filter=%s", type.asString(), filter ? "true" : "false"));
+    auto attr = make_attribute<AttrType>(type, filter);
+    auto expected = expected_hits(1000, 1010, 1);
+    ASSERT_LT(5u, expected.size());
+    {
+        SearchFixture f(*attr, "[1000;1010]", true);
+        EXPECT_EQ(expected, f.strict_hits());
+    }
+    {
+        SearchFixture f(*attr, "[1000;1010]", true);
+        EXPECT_EQ(expected, to_vector(*f.itr->get_hits(1), 1));
+    }
+    {
+        SearchFixture f(*attr, "1003", true);
+        EXPECT_EQ(expected_hits(1003, 1003, 1), f.strict_hits());
+    }
+    {
+        // Bits in the result before begin_id are left untouched
+        SearchFixture f(*attr, "[1000;1010]", false);
+        auto result = BitVector::create(num_docs);
+        result->setInterval(1, num_docs);
+        f.itr->and_hits_into(*result, 2000);
+        auto expected_and = expected_hits(1000, 1010, 2000);
+        std::vector<uint32_t> prefix;
+        for (uint32_t doc_id = 1; doc_id < 2000; ++doc_id) {
+            prefix.push_back(doc_id);
+        }
+        expected_and.insert(expected_and.begin(), prefix.begin(), prefix.end());
+        EXPECT_EQ(expected_and, to_vector(*result, 1));
+    }
+    {
+        SearchFixture f(*attr, "[1000;1010]", false);
+        auto result = BitVector::create(num_docs);
+        result->setBit(3);
+        result->invalidateCachedCount();
+        f.itr->or_hits_into(*result, 1);
+        auto expected_or = expected_hits(1000, 1010, 1);
+        expected_or.insert(expected_or.begin(), 3);
+        EXPECT_EQ(expected_or, to_vector(*result, 1));
+    }
+}
+
+TEST(BatchSearchTest, integer_attributes_are_searched_in_batches)
+{
+    for (bool filter : {false, true}) {
+        verify_batch_search<IntegerAttribute>(BasicType::INT16, filter);
+        verify_batch_search<IntegerAttribute>(BasicType::INT32, filter);
+        verify_batch_search<IntegerAttribute>(BasicType::INT64, filter);
+    }
+}
+
+TEST(BatchSearchTest, float_attributes_are_searched_in_batches)
+{
+    for (bool filter : {false, true}) {
+        verify_batch_search<FloatingPointAttribute>(BasicType::FLOAT, filter);
+        verify_batch_search<FloatingPointAttribute>(BasicType::DOUBLE, filter);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,180 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/compressed_posting_list.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("compressed_posting_list_test");
+
+using namespace search::attribute;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+
+namespace {
+
+std::vector<uint32_t>
+make_doc_ids(uint32_t count, uint32_t max_gap)
+{
+    std::mt19937 rnd(count);
+    std::uniform_int_distribution<uint32_t> gap(1, max_gap);
+    std::vector<uint32_t> doc_ids;
+    uint32_t doc_id = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        doc_id += gap(rnd);
+        doc_ids.push_back(doc_id);
+    }
+    return doc_ids;
+}
+
+std::vector<uint32_t>
+decode(const CompressedPostingList& list)
+{
+    std::vector<uint32_t> result;
+    list.foreach_key([&result](uint32_t doc_id) { result.push_back(doc_id); });
+    return result;
+}
+
+}
+
+TEST(CompressedPostingListTest, doc_ids_are_preserved)
+{
+    for (uint32_t count : {1u, 127u, 128u, 129u, 1000u}) {
+        for (uint32_t max_gap : {1u, 100u, 1000000u}) {
+            auto doc_ids = make_doc_ids(count, max_gap);
+            CompressedPostingList list(doc_ids);
+            EXPECT_EQ(count, list.size());
+            EXPECT_EQ((count + 127) / 128, list.num_blocks());
+            EXPECT_EQ(doc_ids, decode(list));
+        }
+    }
+}
+
+TEST(CompressedPostingListTest, dense_list_uses_less_memory_than_plain_array)
+{
+    auto doc_ids = make_doc_ids(10000, 10);
+    CompressedPostingList list(doc_ids);
+    EXPECT_LT(list.memory_usage() * 4, doc_ids.size() * sizeof(uint32_t));
+}
+
+TEST(CompressedPostingListTest, iterator_seeks_match_plain_array)
+{
+    auto doc_ids = make_doc_ids(1000, 50);
+    CompressedPostingList list(doc_ids);
+    CompressedDocIdIterator itr(list);
+    std::vector<uint32_t> iterated;
+    for (; itr.valid(); ++itr) {
+        EXPECT_EQ(1, itr.getData());
+        iterated.push_back(itr.getKey());
+    }
+    EXPECT_EQ(doc_ids, iterated);
+    for (uint32_t step : {1u, 7u, 300u, 5000u}) {
+        CompressedDocIdIterator seek_itr(list);
+        for (uint32_t doc_id = 1; doc_id <= doc_ids.back() + 1; doc_id += step) {
+            auto exp = std::lower_bound(doc_ids.begin(), doc_ids.end(), doc_id);
+            seek_itr.linearSeek(doc_id);
+            ASSERT_EQ(exp != doc_ids.end(), seek_itr.valid());
+            if (seek_itr.valid()) {
+                EXPECT_EQ(*exp, seek_itr.getKey());
+            }
+        }
+    }
+    CompressedDocIdIterator bound_itr(list);
+    bound_itr.lower_bound(doc_ids[500]);
+    EXPECT_EQ(doc_ids[500], bound_itr.getKey());
+    bound_itr.lower_bound(doc_ids.back() + 1);
+    EXPECT_FALSE(bound_itr.valid());
+}
+
+struct CompressedPostingAttributeTest : public ::testing::Test {
+    AttributeVector::SP attr;
+
+    CompressedPostingAttributeTest()
+        : attr()
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE, true);
+        cfg.setEnableCompressedPostingLists(true);
+        attr = AttributeFactory::createAttribute("a", cfg);
+        attr->addDocs(10000);
+        auto& iattr = dynamic_cast<IntegerAttribute&>(*attr);
+        for (uint32_t doc_id = 1; doc_id < 10000; ++doc_id) {
+            iattr.update(doc_id, doc_id % 10);
+        }
+        attr->commit();
+    }
+    ~CompressedPostingAttributeTest() override;
+
+    void compress() {
+        // Compression passes are performed at regular intervals on commit
+        for (uint32_t i = 0; i < 512; ++i) {
+            attr->commit(true);
+        }
+    }
+
+    size_t live_bytes() const {
+        const auto& status = attr->getStatus();
+        return status.getUsed() - status.getDead();
+    }
+
+    std::vector<uint32_t> search(int32_t value) {
+        SearchContextParams params;
+        auto sc = attr->getSearch(std::make_unique<QueryTermSimple>(vespalib::make_string("%d", value), QueryTermSimple::WORD), params);
+        sc->fetchPostings(search::queryeval::ExecuteInfo::TRUE);
+        TermFieldMatchData md;
+        auto itr = sc->createIterator(&md, true);
+        itr->initFullRange();
+        std::vector<uint32_t> result;
+        for (uint32_t doc_id = itr->seekFirst(1); !itr->isAtEnd(); doc_id = itr->seekNext(doc_id + 1)) {
+            result.push_back(doc_id);
+        }
+        return result;
+    }
+
+    static std::vector<uint32_t> expected(int32_t value, uint32_t skip_doc_id = 0) {
+        std::vector<uint32_t> result;
+        for (uint32_t doc_id = 1; doc_id < 10000; ++doc_id) {
+            if (doc_id % 10 == uint32_t(value) && doc_id != skip_doc_id) {
+                result.push_back(doc_id);
+            }
+        }
+        return result;
+    }
+};
+
+CompressedPostingAttributeTest::~CompressedPostingAttributeTest() = default;
+
+TEST_F(CompressedPostingAttributeTest, unmodified_posting_lists_are_compressed)
+{
+    attr->commit(true);
+    size_t used_before = live_bytes();
+    compress();
+    size_t used_after = live_bytes();
+    LOG(info, "Memory used before compression %zu, after %zu", used_before, used_after);
+    EXPECT_LT(used_after, used_before);
+    EXPECT_EQ(expected(3), search(3));
+}
+
+TEST_F(CompressedPostingAttributeTest, compressed_posting_list_is_restored_when_modified)
+{
+    compress();
+    auto& iattr = dynamic_cast<IntegerAttribute&>(*attr);
+    iattr.update(13, 4);
+    attr->commit();
+    EXPECT_EQ(expected(3, 13), search(3));
+    auto exp = expected(4);
+    exp.insert(std::lower_bound(exp.begin(), exp.end(), 13u), 13u);
+    EXPECT_EQ(exp, search(4));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -14,6 +14,7 @@ LOG_SETUP("enum_attribute_compaction_test");
 using search::IntegerAttribute;
 using search::StringAttribute;
 using search::AttributeVector;
+using search::DictionaryConfig;
 using search::attribute::Config;
 using search::attribute::BasicType;
 using search::attribute::CollectionType;
@@ -28,6 +29,7 @@ struct TestData<IntegerAttribute> {
     static constexpr BasicType::Type basic_type = BasicType::INT32;
     static int32_t make_value(uint32_t doc_id, uint32_t idx) { return doc_id * 10 + idx; }
     static int32_t as_add(int32_t value) { return value; }
+    static std::string as_string(int32_t value) { return std::to_string(value); }
     static int32_t make_undefined_value() { return std::numeric_limits<int32_t>::min(); }
 };
 
@@ -48,10 +50,11 @@ struct TestData<StringAttribute> {
         return s.str();
     }
     static const char *as_add(const std::string &value) { return value.c_str(); }
+    static std::string as_string(const std::string &value) { return value; }
     static std::string make_undefined_value() { return std::string(); }
 };
 
-class CompactionTestBase : public ::testing::TestWithParam<CollectionType::Type> {
+class CompactionTestBase : public ::testing::TestWithParam<std::tuple<CollectionType::Type, DictionaryConfig::Type>> {
 public:
     std::shared_ptr<AttributeVector> _v;
 
@@ -61,7 +64,8 @@ public:
     }
     void SetUp() override;
     virtual BasicType get_basic_type() const = 0;
-    CollectionType get_collection_type() const noexcept { return GetParam(); }
+    CollectionType get_collection_type() const noexcept { return std::get<0>(GetParam()); }
+    DictionaryConfig get_dictionary_config() const noexcept { return std::get<1>(GetParam()); }
     void add_docs(uint32_t num_docs);
     uint32_t count_changed_enum_handles(const std::vector<EnumHandle> &handles, uint32_t stride);
 };
@@ -71,6 +75,7 @@ CompactionTestBase::SetUp()
 {
     Config cfg(get_basic_type(), get_collection_type());
     cfg.setFastSearch(true);
+    cfg.set_dictionary_config(get_dictionary_config());
     _v = search::AttributeFactory::createAttribute("test", cfg);
 }
 
@@ -105,6 +110,7 @@ public:
     CompactionTest();
     void set_values(uint32_t doc_id);
     void check_values(uint32_t doc_id);
+    void check_find_enum(uint32_t doc_id, uint32_t idx);
     void check_cleared_values(uint32_t doc_id);
     void test_enum_store_compaction();
     BasicType get_basic_type() const override { return TestData<VectorType>::basic_type; }
@@ -149,9 +155,24 @@ CompactionTest<VectorType>::check_values(uint32_t doc_id)
         }
         EXPECT_EQ(CheckType(buffer[i]), MyTestData::make_value(doc_id, 0));
         EXPECT_EQ(CheckType(buffer[j]), MyTestData::make_value(doc_id, 1));
+        check_find_enum(doc_id, 0);
+        check_find_enum(doc_id, 1);
     } else {
         EXPECT_EQ(1u, buffer.size());
         EXPECT_EQ(CheckType(buffer[0]), MyTestData::make_value(doc_id, 0));
+        check_find_enum(doc_id, 0);
+    }
+}
+
+template <typename VectorType>
+void
+CompactionTest<VectorType>::check_find_enum(uint32_t doc_id, uint32_t idx)
+{
+    using MyTestData = TestData<VectorType>;
+    EnumHandle handle = 0;
+    EXPECT_TRUE(_v->findEnum(MyTestData::as_string(MyTestData::make_value(doc_id, idx)).c_str(), handle));
+    if (!_v->hasMultiValue()) {
+        EXPECT_EQ(_v->getEnum(doc_id), handle);
     }
 }
 
@@ -221,7 +242,9 @@ TEST_P(IntegerCompactionTest, compact)
     test_enum_store_compaction();
 }
 
-VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(IntegerCompactionTestSet, IntegerCompactionTest, ::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET));
+VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(IntegerCompactionTestSet, IntegerCompactionTest,
+                                     ::testing::Combine(::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET),
+                                                        ::testing::Values(DictionaryConfig::Type::BTREE, DictionaryConfig::Type::BTREE_AND_HASH)));
 
 using StringCompactionTest = CompactionTest<StringAttribute>;
 
@@ -230,6 +253,8 @@ TEST_P(StringCompactionTest, compact)
     test_enum_store_compaction();
 }
 
-VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(StringCompactionTestSet, StringCompactionTest, ::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET));
+VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(StringCompactionTestSet, StringCompactionTest,
+                                     ::testing::Combine(::testing::Values(CollectionType::SINGLE, CollectionType::ARRAY, CollectionType::WSET),
+                                                        ::testing::Values(DictionaryConfig::Type::BTREE, DictionaryConfig::Type::BTREE_AND_HASH)));
 
 GTEST_MAIN_RUN_ALL_TESTS()
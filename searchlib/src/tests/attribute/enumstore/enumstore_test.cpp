@@ -150,13 +150,13 @@ testUniques(const StringEnumStore& ses, const std::vector<std::string>& unique)
 
 class StringEnumStoreTest : public ::testing::Test {
 public:
-    void testInsert(bool hasPostings);
+    void testInsert(bool hasPostings, const DictionaryConfig& dict_cfg = DictionaryConfig());
 };
 
 void
-StringEnumStoreTest::testInsert(bool hasPostings)
+StringEnumStoreTest::testInsert(bool hasPostings, const DictionaryConfig& dict_cfg)
 {
-    StringEnumStore ses(hasPostings);
+    StringEnumStore ses(hasPostings, dict_cfg);
 
     std::vector<EnumIndex> indices;
     std::vector<std::string> unique;
@@ -204,6 +204,16 @@ TEST_F(StringEnumStoreTest, test_insert_on_store_with_posting_lists)
     testInsert(true);
 }
 
+TEST_F(StringEnumStoreTest, test_insert_on_store_with_hash_dictionary_without_posting_lists)
+{
+    testInsert(false, DictionaryConfig::Type::BTREE_AND_HASH);
+}
+
+TEST_F(StringEnumStoreTest, test_insert_on_store_with_hash_dictionary_and_posting_lists)
+{
+    testInsert(true, DictionaryConfig::Type::BTREE_AND_HASH);
+}
+
 TEST(EnumStoreTest, test_hold_lists_and_generation)
 {
     StringEnumStore ses(false);
@@ -298,14 +308,14 @@ TEST(EnumStoreTest, address_space_usage_is_reported)
     EXPECT_EQ(AddressSpace(3, 3, ADDRESS_LIMIT + 2), store.get_address_space_usage());
 }
 
-class BatchUpdaterTest : public ::testing::Test {
+class BatchUpdaterTest : public ::testing::TestWithParam<DictionaryConfig::Type> {
 public:
     NumericEnumStore store;
     EnumIndex i3;
     EnumIndex i5;
 
     BatchUpdaterTest()
-        : store(false),
+        : store(false, GetParam()),
           i3(),
           i5()
     {
@@ -335,7 +345,7 @@ public:
     }
 };
 
-TEST_F(BatchUpdaterTest, ref_counts_can_be_changed)
+TEST_P(BatchUpdaterTest, ref_counts_can_be_changed)
 {
     auto updater = store.make_batch_updater();
     EXPECT_EQ(i3, updater.insert(3));
@@ -347,7 +357,7 @@ TEST_F(BatchUpdaterTest, ref_counts_can_be_changed)
     expect_value_in_store(5, 1, i5);
 }
 
-TEST_F(BatchUpdaterTest, new_value_can_be_inserted)
+TEST_P(BatchUpdaterTest, new_value_can_be_inserted)
 {
     auto updater = store.make_batch_updater();
     EnumIndex i7 = updater.insert(7);
@@ -357,7 +367,7 @@ TEST_F(BatchUpdaterTest, new_value_can_be_inserted)
     expect_value_in_store(7, 1, i7);
 }
 
-TEST_F(BatchUpdaterTest, value_with_ref_count_zero_is_removed)
+TEST_P(BatchUpdaterTest, value_with_ref_count_zero_is_removed)
 {
     auto updater = store.make_batch_updater();
     updater.dec_ref_count(i3);
@@ -366,7 +376,7 @@ TEST_F(BatchUpdaterTest, value_with_ref_count_zero_is_removed)
     expect_value_not_in_store(3, i3);
 }
 
-TEST_F(BatchUpdaterTest, unused_new_value_is_removed)
+TEST_P(BatchUpdaterTest, unused_new_value_is_removed)
 {
     auto updater = store.make_batch_updater();
     EnumIndex i7 = updater.insert(7);
@@ -375,6 +385,9 @@ TEST_F(BatchUpdaterTest, unused_new_value_is_removed)
     expect_value_not_in_store(7, i7);
 }
 
+VESPA_GTEST_INSTANTIATE_TEST_SUITE_P(BatchUpdaterTestSet, BatchUpdaterTest,
+                                     ::testing::Values(DictionaryConfig::Type::BTREE, DictionaryConfig::Type::BTREE_AND_HASH));
+
 template <typename EnumStoreT>
 class LoaderTest : public ::testing::Test {
 public:
@@ -382,8 +395,8 @@ public:
     EnumStoreT store;
     static std::vector<EntryType> values;
 
-    LoaderTest()
-        : store(true)
+    LoaderTest(const DictionaryConfig& dict_cfg = DictionaryConfig())
+        : store(true, dict_cfg)
     {}
 
     void load_values(enumstore::EnumeratedLoaderBase& loader) const {
@@ -425,6 +438,17 @@ public:
         EXPECT_EQ(exp_posting_idx, itr.getData());
     }
 
+    void test_enumerated_loader();
+    void test_enumerated_postings_loader();
+    void test_non_enumerated_loader();
+};
+
+template <typename EnumStoreT>
+class HashLoaderTest : public LoaderTest<EnumStoreT> {
+public:
+    HashLoaderTest()
+        : LoaderTest<EnumStoreT>(DictionaryConfig::Type::BTREE_AND_HASH)
+    {}
 };
 
 template <> std::vector<int32_t> LoaderTest<NumericEnumStore>::values{3, 5, 7, 9};
@@ -454,47 +478,85 @@ LoaderTest<StringEnumStore>::load_values(enumstore::EnumeratedLoaderBase& loader
 using LoaderTestTypes = ::testing::Types<NumericEnumStore, FloatEnumStore, StringEnumStore>;
 VESPA_GTEST_TYPED_TEST_SUITE(LoaderTest, LoaderTestTypes);
 
-TYPED_TEST(LoaderTest, store_is_instantiated_with_enumerated_loader)
+template <typename EnumStoreT>
+void
+LoaderTest<EnumStoreT>::test_enumerated_loader()
 {
-    auto loader = this->store.make_enumerated_loader();
-    this->load_values(loader);
+    auto loader = store.make_enumerated_loader();
+    load_values(loader);
     loader.allocate_enums_histogram();
     loader.get_enums_histogram()[0] = 1;
     loader.get_enums_histogram()[1] = 2;
     loader.get_enums_histogram()[3] = 4;
     loader.set_ref_counts();
 
-    this->expect_values_in_store();
+    expect_values_in_store();
 }
 
-TYPED_TEST(LoaderTest, store_is_instantiated_with_enumerated_postings_loader)
+template <typename EnumStoreT>
+void
+LoaderTest<EnumStoreT>::test_enumerated_postings_loader()
 {
-    auto loader = this->store.make_enumerated_postings_loader();
-    this->load_values(loader);
-    this->set_ref_count(0, 1, loader);
-    this->set_ref_count(1, 2, loader);
-    this->set_ref_count(3, 4, loader);
+    auto loader = store.make_enumerated_postings_loader(nullptr);
+    load_values(loader);
+    set_ref_count(0, 1, loader);
+    set_ref_count(1, 2, loader);
+    set_ref_count(3, 4, loader);
     loader.free_unused_values();
 
-    this->expect_values_in_store();
+    expect_values_in_store();
 }
 
-TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader)
+template <typename EnumStoreT>
+void
+LoaderTest<EnumStoreT>::test_non_enumerated_loader()
 {
-    auto loader = this->store.make_non_enumerated_loader();
-    loader.insert(this->values[0], 100);
+    auto loader = store.make_non_enumerated_loader();
+    loader.insert(values[0], 100);
     loader.set_ref_count_for_last_value(1);
-    loader.insert(this->values[1], 101);
+    loader.insert(values[1], 101);
     loader.set_ref_count_for_last_value(2);
-    loader.insert(this->values[3], 103);
+    loader.insert(values[3], 103);
     loader.set_ref_count_for_last_value(4);
     loader.build_dictionary();
 
-    this->expect_values_in_store();
+    expect_values_in_store();
 
-    this->expect_posting_idx(0, 100);
-    this->expect_posting_idx(1, 101);
-    this->expect_posting_idx(3, 103);
+    expect_posting_idx(0, 100);
+    expect_posting_idx(1, 101);
+    expect_posting_idx(3, 103);
+}
+
+TYPED_TEST(LoaderTest, store_is_instantiated_with_enumerated_loader)
+{
+    this->test_enumerated_loader();
+}
+
+TYPED_TEST(LoaderTest, store_is_instantiated_with_enumerated_postings_loader)
+{
+    this->test_enumerated_postings_loader();
+}
+
+TYPED_TEST(LoaderTest, store_is_instantiated_with_non_enumerated_loader)
+{
+    this->test_non_enumerated_loader();
+}
+
+VESPA_GTEST_TYPED_TEST_SUITE(HashLoaderTest, LoaderTestTypes);
+
+TYPED_TEST(HashLoaderTest, store_is_instantiated_with_enumerated_loader)
+{
+    this->test_enumerated_loader();
+}
+
+TYPED_TEST(HashLoaderTest, store_is_instantiated_with_enumerated_postings_loader)
+{
+    this->test_enumerated_postings_loader();
+}
+
+TYPED_TEST(HashLoaderTest, store_is_instantiated_with_non_enumerated_loader)
+{
+    this->test_non_enumerated_loader();
 }
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,100 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/loadedenumvalue.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using search::attribute::LoadedEnumAttribute;
+using search::attribute::LoadedEnumAttributeVector;
+using search::attribute::sortLoadedByEnum;
+
+namespace {
+
+LoadedEnumAttributeVector
+make_loaded(size_t size, uint32_t num_enums, uint32_t num_docs)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    LoadedEnumAttributeVector loaded;
+    for (size_t i = 0; i < size; ++i) {
+        uint32_t e = rnd.lrand48() % num_enums;
+        uint32_t doc_id = rnd.lrand48() % num_docs;
+        // Duplicate (enum, docid) pairs stem from array attributes and have the same weight.
+        loaded.push_back(LoadedEnumAttribute(e, doc_id, (e + doc_id) % 7));
+    }
+    return loaded;
+}
+
+void
+expect_sorted(const LoadedEnumAttributeVector& loaded)
+{
+    for (size_t i = 1; i < loaded.size(); ++i) {
+        ASSERT_FALSE(LoadedEnumAttribute::EnumCompare()(loaded[i], loaded[i - 1])) << "at index " << i;
+    }
+}
+
+void
+expect_equal(const LoadedEnumAttributeVector& exp, const LoadedEnumAttributeVector& act)
+{
+    ASSERT_EQ(exp.size(), act.size());
+    for (size_t i = 0; i < exp.size(); ++i) {
+        ASSERT_EQ(exp[i].getEnum(), act[i].getEnum()) << "at index " << i;
+        ASSERT_EQ(exp[i].getDocId(), act[i].getDocId()) << "at index " << i;
+        ASSERT_EQ(exp[i].getWeight(), act[i].getWeight()) << "at index " << i;
+    }
+}
+
+}
+
+class LoadedEnumValueTest : public ::testing::Test {
+protected:
+    vespalib::ThreadStackExecutor _executor;
+
+    LoadedEnumValueTest()
+        : _executor(4, 0x10000)
+    {
+    }
+
+    void assert_parallel_sort_matches_serial_sort(size_t size, uint32_t num_enums, uint32_t num_docs) {
+        auto serial = make_loaded(size, num_enums, num_docs);
+        auto parallel = make_loaded(size, num_enums, num_docs);
+        sortLoadedByEnum(serial, nullptr);
+        sortLoadedByEnum(parallel, &_executor, 0);
+        expect_sorted(serial);
+        expect_equal(serial, parallel);
+    }
+};
+
+TEST_F(LoadedEnumValueTest, parallel_sort_matches_serial_sort_with_many_duplicates)
+{
+    assert_parallel_sort_matches_serial_sort(100003, 3, 1000);
+}
+
+TEST_F(LoadedEnumValueTest, parallel_sort_matches_serial_sort_with_single_enum)
+{
+    assert_parallel_sort_matches_serial_sort(10007, 1, 50);
+}
+
+TEST_F(LoadedEnumValueTest, parallel_sort_matches_serial_sort_with_mostly_unique_values)
+{
+    assert_parallel_sort_matches_serial_sort(10007, 100000, 100000);
+}
+
+TEST_F(LoadedEnumValueTest, parallel_sort_handles_fewer_entries_than_chunks)
+{
+    assert_parallel_sort_matches_serial_sort(5, 2, 3);
+    assert_parallel_sort_matches_serial_sort(1, 1, 1);
+    assert_parallel_sort_matches_serial_sort(0, 1, 1);
+}
+
+TEST_F(LoadedEnumValueTest, small_vectors_are_sorted_by_calling_thread_below_limit)
+{
+    auto serial = make_loaded(1000, 10, 100);
+    auto parallel = make_loaded(1000, 10, 100);
+    sortLoadedByEnum(serial, nullptr);
+    sortLoadedByEnum(parallel, &_executor, 1001);
+    expect_equal(serial, parallel);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,7 @@
 #include <vespa/searchlib/attribute/multi_value_mapping.h>
 #include <vespa/searchlib/attribute/multi_value_mapping.hpp>
 #include <vespa/searchlib/attribute/not_implemented_attribute.h>
+#include <vespa/searchcommon/common/compaction_strategy.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/stllike/hash_set.h>
@@ -12,6 +13,7 @@
 #include <vespa/log/log.h>
 LOG_SETUP("multivaluemapping_test");
 
+using search::CompactionStrategy;
 using vespalib::datastore::ArrayStoreConfig;
 
 template <typename EntryT>
@@ -348,4 +350,61 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_incremental_compaction_works)
+{
+    setup(3, 64, 512, 129);
+    uint32_t addDocs = 10;
+    uint32_t bufferCountBefore = 0;
+    do {
+        addRandomDocs(addDocs);
+        addDocs *= 2;
+        bufferCountBefore = countBuffers();
+    } while (bufferCountBefore < 10);
+    uint32_t docIdLimit = size();
+    uint32_t clearLimit = docIdLimit / 2;
+    for (uint32_t docId = 0; docId < clearLimit; ++docId) {
+        clearDoc(docId);
+    }
+    _mvMapping->startCompactWorst(true, false);
+    EXPECT_TRUE(_mvMapping->isCompacting());
+    uint32_t maxLids = docIdLimit / 4 + 1;
+    uint32_t steps = 0;
+    bool done = false;
+    while (!done) {
+        done = _mvMapping->compactStep(maxLids);
+        ++steps;
+        // Changes interleaved with compaction are retained
+        addRandomDoc();
+        clearDoc(docIdLimit - steps);
+        checkRefMapping();
+    }
+    EXPECT_LT(1u, steps);
+    EXPECT_FALSE(_mvMapping->isCompacting());
+    _attr->commit();
+    _attr->incGeneration();
+    checkRefMapping();
+    EXPECT_LT(countBuffers(), bufferCountBefore);
+}
+
+TEST_F(CompactionIntMappingTest, test_that_consider_compact_compacts_incrementally)
+{
+    setup(3, 64, 512, 129);
+    addRandomDocs(20000);
+    uint32_t docIdLimit = size();
+    for (uint32_t docId = 0; docId < docIdLimit / 2; ++docId) {
+        clearDoc(docId);
+    }
+    _attr->commit();
+    _attr->incGeneration();
+    _attr->commit();
+    _mvMapping->updateStat();
+    CompactionStrategy strategy(0.05, 0.2, docIdLimit / 2);
+    EXPECT_TRUE(_mvMapping->considerCompact(strategy));
+    EXPECT_TRUE(_mvMapping->isCompacting());
+    checkRefMapping();
+    EXPECT_TRUE(_mvMapping->considerCompact(strategy));
+    EXPECT_FALSE(_mvMapping->isCompacting());
+    checkRefMapping();
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
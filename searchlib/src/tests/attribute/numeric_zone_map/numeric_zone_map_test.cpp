@@ -0,0 +1,172 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/numeric_zone_map.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cmath>
+
+#include <vespa/log/log.h>
+LOG_SETUP("numeric_zone_map_test");
+
+using namespace search::attribute;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::FloatingPointAttribute;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+using search::queryeval::ExecuteInfo;
+
+TEST(NumericZoneMapTest, zones_are_widened_by_defined_values)
+{
+    vespalib::GenerationHolder gen_holder;
+    NumericZoneMap<int32_t> zone_map(gen_holder);
+    zone_map.add_doc(0, getUndefined<int32_t>());
+    zone_map.add_doc(1, 10);
+    zone_map.add_doc(2, 5);
+    EXPECT_EQ(1u, zone_map.size());
+    zone_map.update(1, 20);
+    EXPECT_EQ(5, zone_map.get_zones()[0].get_min());
+    EXPECT_EQ(20, zone_map.get_zones()[0].get_max());
+    zone_map.add_doc(4096, 100);
+    EXPECT_EQ(2u, zone_map.size());
+    EXPECT_EQ(100, zone_map.get_zones()[1].get_min());
+    EXPECT_EQ(100, zone_map.get_zones()[1].get_max());
+    gen_holder.clearHoldLists();
+}
+
+TEST(NumericZoneMapTest, nan_values_are_ignored)
+{
+    vespalib::GenerationHolder gen_holder;
+    NumericZoneMap<double> zone_map(gen_holder);
+    zone_map.add_doc(0, NAN);
+    zone_map.add_doc(1, 1.5);
+    EXPECT_EQ(1.5, zone_map.get_zones()[0].get_min());
+    EXPECT_EQ(1.5, zone_map.get_zones()[0].get_max());
+    gen_holder.clearHoldLists();
+}
+
+namespace {
+
+constexpr uint32_t num_docs = 20000;
+
+AttributeVector::SP
+make_attribute(BasicType type, bool zone_maps)
+{
+    Config cfg(type, CollectionType::SINGLE);
+    cfg.setEnableZoneMaps(zone_maps);
+    auto attr = AttributeFactory::createAttribute(zone_maps ? "zoned" : "plain", cfg);
+    attr->addDocs(num_docs);
+    attr->commit();
+    return attr;
+}
+
+std::vector<uint32_t>
+find_hits(AttributeVector& attr, const vespalib::string& term, bool strict, unsigned int* approx_hits = nullptr)
+{
+    SearchContextParams params;
+    auto sc = attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD), params);
+    if (approx_hits != nullptr) {
+        *approx_hits = sc->approximateHits();
+    }
+    sc->fetchPostings(ExecuteInfo::create(strict));
+    TermFieldMatchData md;
+    auto itr = sc->createIterator(&md, strict);
+    itr->initFullRange();
+    std::vector<uint32_t> result;
+    for (uint32_t doc_id = 1; doc_id < attr.getCommittedDocIdLimit(); ++doc_id) {
+        if (itr->seek(doc_id)) {
+            result.push_back(doc_id);
+        }
+    }
+    return result;
+}
+
+}
+
+struct ZoneMapSearchTest : public ::testing::Test {
+    AttributeVector::SP plain;
+    AttributeVector::SP zoned;
+
+    ZoneMapSearchTest()
+        : plain(make_attribute(BasicType::INT64, false)),
+          zoned(make_attribute(BasicType::INT64, true))
+    {
+        // Increasing timestamps, with some documents lacking a value
+        for (uint32_t doc_id = 1; doc_id < num_docs; ++doc_id) {
+            if (doc_id % 7 != 0) {
+                update(doc_id, 1000 + doc_id);
+            }
+        }
+        commit();
+    }
+    ~ZoneMapSearchTest() override;
+
+    void update(uint32_t doc_id, int64_t value) {
+        dynamic_cast<IntegerAttribute&>(*plain).update(doc_id, value);
+        dynamic_cast<IntegerAttribute&>(*zoned).update(doc_id, value);
+    }
+    void commit() {
+        plain->commit();
+        zoned->commit();
+    }
+    void expect_same_hits(const vespalib::string& term) {
+        for (bool strict : {false, true}) {
+            SCOPED_TRACE(term + (strict ? " strict" : " non-strict"));
+            EXPECT_EQ(find_hits(*plain, term, strict), find_hits(*zoned, term, strict));
+        }
+    }
+};
+
+ZoneMapSearchTest::~ZoneMapSearchTest() = default;
+
+TEST_F(ZoneMapSearchTest, range_search_gives_same_hits_as_plain_scan)
+{
+    expect_same_hits("[5000;6000]");
+    expect_same_hits("<1500");
+    expect_same_hits(">20000");
+    expect_same_hits("[100000;200000]");
+    expect_same_hits("5001");
+    expect_same_hits("5005");
+}
+
+TEST_F(ZoneMapSearchTest, hits_estimate_only_covers_overlapping_zones)
+{
+    unsigned int plain_hits = 0;
+    unsigned int zoned_hits = 0;
+    find_hits(*plain, "[5000;6000]", true, &plain_hits);
+    find_hits(*zoned, "[5000;6000]", true, &zoned_hits);
+    EXPECT_EQ(num_docs, plain_hits);
+    EXPECT_EQ(2 * NumericZoneMap<int64_t>::block_size, zoned_hits);
+    find_hits(*zoned, "[100000;200000]", true, &zoned_hits);
+    EXPECT_EQ(0u, zoned_hits);
+}
+
+TEST_F(ZoneMapSearchTest, updated_values_are_found)
+{
+    update(10, 150000);
+    update(19000, 2);
+    commit();
+    expect_same_hits("[100000;200000]");
+    expect_same_hits("<10");
+    EXPECT_EQ(std::vector<uint32_t>({10}), find_hits(*zoned, "[100000;200000]", true));
+}
+
+TEST(ZoneMapFloatSearchTest, range_search_handles_undefined_values)
+{
+    auto attr = make_attribute(BasicType::DOUBLE, true);
+    auto& fattr = dynamic_cast<FloatingPointAttribute&>(*attr);
+    fattr.update(3, 2.5);
+    fattr.update(9000, 7.5);
+    attr->commit();
+    EXPECT_EQ(std::vector<uint32_t>({3, 9000}), find_hits(*attr, "[1;10]", true));
+    EXPECT_EQ(std::vector<uint32_t>({9000}), find_hits(*attr, ">5", true));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -22,6 +22,7 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 
@@ -170,6 +171,12 @@ public:
     void expect_complete_add(uint32_t exp_docid, const DoubleVector& exp_vector) const {
         expect_entry(exp_docid, exp_vector, _complete_adds);
     }
+    void expect_prepare_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _prepare_adds);
+    }
+    void expect_complete_adds(const EntryVector &exp_adds) const {
+        EXPECT_EQUAL(exp_adds, _complete_adds);
+    }
     generation_t get_transfer_gen() const { return _transfer_gen; }
     generation_t get_trim_gen() const { return _trim_gen; }
     size_t memory_usage_cnt() const { return _memory_usage_cnt; }
@@ -417,10 +424,10 @@ struct Fixture {
         EXPECT_TRUE(saveok);
     }
 
-    void load() {
+    void load(vespalib::Executor *executor = nullptr) {
         _tensorAttr = makeAttr();
         _attr = _tensorAttr;
-        bool loadok = _attr->load();
+        bool loadok = _attr->load(executor);
         EXPECT_TRUE(loadok);
     }
 
@@ -823,6 +830,19 @@ TEST_F("onLoad() reconstructs nearest neighbor index if save file does not exist
     index.expect_adds({{1, {3, 5}}, {2, {7, 9}}});
 }
 
+TEST_F("onLoad() reconstructs nearest neighbor index using two-phase adds when given an executor", DenseTensorAttributeMockIndex)
+{
+    f.set_example_tensors();
+    f.save();
+    vespalib::ThreadStackExecutor executor(1, 128 * 1024);
+    f.load(&executor);
+    f.assert_example_tensors();
+    auto& index = f.mock_index();
+    index.expect_adds({});
+    index.expect_prepare_adds({{1, {3, 5}}, {2, {7, 9}}});
+    index.expect_complete_adds({{1, {3, 5}}, {2, {7, 9}}});
+}
+
 TEST_F("onLoads() ignores saved nearest neighbor index if not enabled in config", DenseTensorAttributeMockIndex)
 {
     f.save_example_tensors_with_mock_index();
@@ -0,0 +1,107 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/bitcompression/block_bit_packing.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using search::bitcompression::BlockBitPacking;
+
+namespace {
+
+constexpr uint32_t block_size = BlockBitPacking::block_size;
+
+std::vector<uint32_t>
+make_values(uint32_t bits, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::vector<uint32_t> values(block_size);
+    uint32_t mask = (bits >= 32) ? ~0u : ((1u << bits) - 1);
+    for (auto &value : values) {
+        value = gen() & mask;
+    }
+    if (bits > 0) {
+        values[seed % block_size] = mask; // ensure full bit width is used
+    }
+    return values;
+}
+
+}
+
+TEST(BlockBitPackingTest, max_bits_is_calculated)
+{
+    std::vector<uint32_t> values(block_size, 0);
+    EXPECT_EQ(0u, BlockBitPacking::max_bits(values.data(), block_size));
+    values[17] = 1;
+    EXPECT_EQ(1u, BlockBitPacking::max_bits(values.data(), block_size));
+    values[100] = 255;
+    EXPECT_EQ(8u, BlockBitPacking::max_bits(values.data(), block_size));
+    values[3] = 0x80000000u;
+    EXPECT_EQ(32u, BlockBitPacking::max_bits(values.data(), block_size));
+}
+
+TEST(BlockBitPackingTest, values_survive_pack_and_unpack_for_all_bit_widths)
+{
+    for (uint32_t bits = 0; bits <= 32; ++bits) {
+        auto values = make_values(bits, bits + 42);
+        std::vector<uint32_t> packed(BlockBitPacking::packed_words(bits) + 1, 0xdeadbeefu);
+        uint32_t *packed_end = BlockBitPacking::pack(values.data(), bits, packed.data());
+        EXPECT_EQ(packed.data() + BlockBitPacking::packed_words(bits), packed_end);
+        EXPECT_EQ(0xdeadbeefu, packed.back()) << "bits=" << bits;
+        std::vector<uint32_t> unpacked(block_size, 1);
+        const uint32_t *unpacked_end = BlockBitPacking::unpack(packed.data(), bits, unpacked.data());
+        EXPECT_EQ(packed.data() + BlockBitPacking::packed_words(bits), unpacked_end);
+        EXPECT_EQ(values, unpacked) << "bits=" << bits;
+    }
+}
+
+TEST(BlockBitPackingTest, high_bits_are_ignored_when_packing)
+{
+    std::vector<uint32_t> values(block_size, 0xffffffffu);
+    std::vector<uint32_t> packed(BlockBitPacking::packed_words(3));
+    BlockBitPacking::pack(values.data(), 3, packed.data());
+    std::vector<uint32_t> unpacked(block_size);
+    BlockBitPacking::unpack(packed.data(), 3, unpacked.data());
+    EXPECT_EQ(std::vector<uint32_t>(block_size, 7u), unpacked);
+}
+
+TEST(BlockBitPackingTest, doc_id_blocks_can_be_encoded_decoded_and_skipped)
+{
+    std::vector<uint32_t> doc_ids;
+    for (uint32_t doc_id = 5; doc_ids.size() < 2 * block_size + 10; doc_id += 1 + (doc_id % 7)) {
+        doc_ids.push_back(doc_id);
+    }
+    std::vector<uint32_t> encoded(3 * (1 + BlockBitPacking::packed_words(32)));
+    uint32_t *pos = encoded.data();
+    uint32_t prev_doc_id = 0;
+    for (uint32_t i = 0; i < doc_ids.size(); i += block_size) {
+        uint32_t count = std::min(block_size, uint32_t(doc_ids.size()) - i);
+        pos = BlockBitPacking::encode_doc_ids(&doc_ids[i], count, prev_doc_id, pos);
+        prev_doc_id = doc_ids[i + count - 1];
+    }
+    EXPECT_EQ(3u, encoded[0]); // max delta is 7, stored as 6
+    const uint32_t *rpos = encoded.data();
+    uint32_t skipped = BlockBitPacking::encoded_doc_ids_words(rpos);
+    EXPECT_EQ(1u + BlockBitPacking::packed_words(3), skipped);
+    std::vector<uint32_t> decoded(block_size);
+    rpos = BlockBitPacking::decode_doc_ids(rpos + skipped, doc_ids[block_size - 1], decoded.data());
+    EXPECT_EQ(std::vector<uint32_t>(doc_ids.begin() + block_size, doc_ids.begin() + 2 * block_size), decoded);
+    BlockBitPacking::decode_doc_ids(rpos, doc_ids[2 * block_size - 1], decoded.data());
+    EXPECT_EQ(std::vector<uint32_t>(doc_ids.begin() + 2 * block_size, doc_ids.end()),
+              std::vector<uint32_t>(decoded.begin(), decoded.begin() + 10));
+}
+
+TEST(BlockBitPackingTest, partial_value_blocks_are_padded_with_zeros)
+{
+    std::vector<uint32_t> values({ 0, 4, 1, 9, 2 });
+    std::vector<uint32_t> encoded(1 + BlockBitPacking::packed_words(32));
+    uint32_t *end = BlockBitPacking::encode_values(values.data(), values.size(), encoded.data());
+    EXPECT_EQ(4u, encoded[0]);
+    EXPECT_EQ(BlockBitPacking::encoded_values_words(encoded.data()), uint32_t(end - encoded.data()));
+    std::vector<uint32_t> decoded(block_size, 1);
+    BlockBitPacking::decode_values(encoded.data(), decoded.data());
+    values.resize(block_size, 0);
+    EXPECT_EQ(values, decoded);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
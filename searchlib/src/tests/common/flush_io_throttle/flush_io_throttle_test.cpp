@@ -0,0 +1,89 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/flush_io_throttle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <thread>
+
+using search::common::FlushIoThrottle;
+using BucketConfig = FlushIoThrottle::BucketConfig;
+using Config = FlushIoThrottle::Config;
+using Priority = FlushIoThrottle::Priority;
+
+TEST(FlushIoThrottleTest, writes_are_not_throttled_by_default)
+{
+    FlushIoThrottle throttle;
+    throttle.acquire(1000000, Priority::URGENT);
+    throttle.acquire(1000000, Priority::BACKGROUND);
+    throttle.acquire(1000000, Priority::BACKGROUND);
+    auto stats = throttle.getStats();
+    EXPECT_EQ(1000000u, stats.urgent.bytes);
+    EXPECT_EQ(2000000u, stats.background.bytes);
+    EXPECT_EQ(0u, stats.urgent.throttledWrites);
+    EXPECT_EQ(0u, stats.background.throttledWrites);
+}
+
+TEST(FlushIoThrottleTest, writes_wait_while_bucket_is_in_debt)
+{
+    FlushIoThrottle throttle;
+    throttle.setConfig(Config(BucketConfig(), BucketConfig(1000000.0, 0)));
+    throttle.acquire(50000, Priority::BACKGROUND);
+    throttle.acquire(50000, Priority::URGENT);
+    auto stats = throttle.getStats();
+    EXPECT_EQ(0u, stats.background.throttledWrites);
+    EXPECT_EQ(0u, stats.urgent.throttledWrites);
+    throttle.acquire(50000, Priority::BACKGROUND);
+    stats = throttle.getStats();
+    EXPECT_EQ(100000u, stats.background.bytes);
+    EXPECT_EQ(1u, stats.background.throttledWrites);
+    EXPECT_GT(stats.background.throttledTime, 0.0);
+    EXPECT_EQ(0u, stats.urgent.throttledWrites);
+}
+
+TEST(FlushIoThrottleTest, burst_is_written_without_waiting)
+{
+    FlushIoThrottle throttle;
+    throttle.setConfig(Config(BucketConfig(1.0, 1000), BucketConfig()));
+    throttle.acquire(400, Priority::URGENT);
+    throttle.acquire(600, Priority::URGENT);
+    EXPECT_EQ(0u, throttle.getStats().urgent.throttledWrites);
+}
+
+TEST(FlushIoThrottleTest, config_change_wakes_up_waiting_writers)
+{
+    FlushIoThrottle throttle;
+    throttle.setConfig(Config(BucketConfig(), BucketConfig(1.0, 0)));
+    throttle.acquire(1000000, Priority::BACKGROUND);
+    std::thread writer([&throttle]() { throttle.acquire(1, Priority::BACKGROUND); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    throttle.setConfig(Config());
+    writer.join();
+    EXPECT_EQ(1000001u, throttle.getStats().background.bytes);
+    EXPECT_TRUE(throttle.getConfig() == Config());
+}
+
+TEST(FlushIoThrottleTest, priority_is_set_per_thread)
+{
+    EXPECT_EQ(Priority::BACKGROUND, FlushIoThrottle::currentPriority());
+    EXPECT_FALSE(FlushIoThrottle::inFlush());
+    {
+        FlushIoThrottle::PriorityGuard guard(Priority::URGENT);
+        EXPECT_EQ(Priority::URGENT, FlushIoThrottle::currentPriority());
+        EXPECT_TRUE(FlushIoThrottle::inFlush());
+        Priority otherThreadPriority = Priority::URGENT;
+        bool otherThreadInFlush = true;
+        std::thread other([&otherThreadPriority, &otherThreadInFlush]() {
+            otherThreadPriority = FlushIoThrottle::currentPriority();
+            otherThreadInFlush = FlushIoThrottle::inFlush();
+        });
+        other.join();
+        EXPECT_EQ(Priority::BACKGROUND, otherThreadPriority);
+        EXPECT_FALSE(otherThreadInFlush);
+        FlushIoThrottle throttle;
+        throttle.acquire(10);
+        EXPECT_EQ(10u, throttle.getStats().urgent.bytes);
+    }
+    EXPECT_EQ(Priority::BACKGROUND, FlushIoThrottle::currentPriority());
+    EXPECT_FALSE(FlushIoThrottle::inFlush());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,130 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/dictionary_bloom_filter.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/fastos/file.h>
+
+using search::index::DummyFileHeaderContext;
+using vespalib::make_string;
+
+namespace search::diskindex {
+
+namespace {
+
+vespalib::string
+present_word(uint32_t i)
+{
+    return make_string("word%u", i);
+}
+
+vespalib::string
+absent_word(uint32_t i)
+{
+    return make_string("absent%u", i);
+}
+
+}
+
+class DictionaryBloomFilterTest : public ::testing::Test
+{
+protected:
+    DictionaryBloomFilter _filter;
+
+    DictionaryBloomFilterTest()
+        : _filter()
+    {
+    }
+
+    void build(uint32_t num_words) {
+        std::vector<uint64_t> hashes;
+        for (uint32_t i = 0; i < num_words; ++i) {
+            hashes.push_back(DictionaryBloomFilter::hash_word(present_word(i)));
+        }
+        _filter.build(hashes);
+    }
+
+    uint32_t count_false_positives(const DictionaryBloomFilter &filter, uint32_t num_lookups) {
+        uint32_t false_positives = 0;
+        for (uint32_t i = 0; i < num_lookups; ++i) {
+            if (filter.may_contain(absent_word(i))) {
+                ++false_positives;
+            }
+        }
+        return false_positives;
+    }
+};
+
+TEST_F(DictionaryBloomFilterTest, empty_filter_contains_nothing)
+{
+    build(0);
+    EXPECT_EQ(0u, _filter.getNumWords());
+    EXPECT_FALSE(_filter.may_contain("foo"));
+    EXPECT_FALSE(_filter.may_contain(""));
+}
+
+TEST_F(DictionaryBloomFilterTest, all_added_words_may_be_present)
+{
+    build(10000);
+    EXPECT_EQ(10000u, _filter.getNumWords());
+    for (uint32_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(_filter.may_contain(present_word(i))) << present_word(i);
+    }
+}
+
+TEST_F(DictionaryBloomFilterTest, false_positive_rate_is_low)
+{
+    build(10000);
+    EXPECT_GE(_filter.getMemoryUsage(), 10000u * DictionaryBloomFilter::bits_per_word / 8);
+    EXPECT_LT(count_false_positives(_filter, 100000), 3000u);
+}
+
+TEST_F(DictionaryBloomFilterTest, filter_can_be_saved_and_loaded)
+{
+    build(1000);
+    DummyFileHeaderContext file_header_context;
+    vespalib::string name("dictionary.bloom");
+    ASSERT_TRUE(_filter.save(name, TuneFileSeqWrite(), file_header_context));
+    DictionaryBloomFilter loaded;
+    ASSERT_TRUE(loaded.load(name));
+    EXPECT_EQ(1000u, loaded.getNumWords());
+    EXPECT_EQ(_filter.getMemoryUsage(), loaded.getMemoryUsage());
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(loaded.may_contain(present_word(i)));
+    }
+    EXPECT_EQ(count_false_positives(_filter, 10000), count_false_positives(loaded, 10000));
+    FastOS_File::Delete(name.c_str());
+}
+
+TEST_F(DictionaryBloomFilterTest, filter_built_with_other_word_hash_is_not_loaded)
+{
+    vespalib::string name("other_hash.bloom");
+    {
+        FastOS_File file;
+        ASSERT_TRUE(file.OpenWriteOnlyTruncate(name.c_str()));
+        vespalib::FileHeader h(4096);
+        using Tag = vespalib::GenericHeader::Tag;
+        h.putTag(Tag("numWords", uint64_t(0)));
+        h.putTag(Tag("numBlocks", uint32_t(0)));
+        h.putTag(Tag("numHashes", DictionaryBloomFilter::num_hashes));
+        h.putTag(Tag("blockBits", DictionaryBloomFilter::block_bits));
+        h.putTag(Tag("bloom.hash", "murmur3"));
+        h.writeFile(file);
+        ASSERT_TRUE(file.Close());
+    }
+    DictionaryBloomFilter loaded;
+    EXPECT_FALSE(loaded.load(name));
+    FastOS_File::Delete(name.c_str());
+}
+
+TEST_F(DictionaryBloomFilterTest, loading_missing_file_fails)
+{
+    DictionaryBloomFilter loaded;
+    EXPECT_FALSE(loaded.load("no_such_file.bloom"));
+}
+
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
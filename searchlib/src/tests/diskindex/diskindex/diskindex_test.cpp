@@ -15,6 +15,7 @@
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <iostream>
 #include <set>
 
@@ -56,6 +57,7 @@ private:
     FakeRequestContext _requestContext;
 
     void requireThatLookupIsWorking(bool fieldEmpty, bool docEmpty, bool wordEmpty);
+    void requireThatLookupSkipsDictionaryForWordsRuledOutByFilter();
     void requireThatWeCanReadPostingList();
     void require_that_we_can_get_field_length_info();
     void requireThatWeCanReadBitVector();
@@ -179,6 +181,23 @@ Test::requireThatLookupIsWorking(bool fieldEmpty,
     }
 }
 
+void
+Test::requireThatLookupSkipsDictionaryForWordsRuledOutByFilter()
+{
+    uint32_t f1(_schema.getIndexFieldId("f1"));
+    uint64_t skipped = _index->getSkippedDictionaryLookups();
+    LookupResult::UP r = _index->lookup(f1, "w1");
+    ASSERT_TRUE(r);
+    EXPECT_EQUAL(2u, r->counts._numDocs);
+    EXPECT_EQUAL(skipped, _index->getSkippedDictionaryLookups());
+    for (uint32_t i = 0; i < 100; ++i) {
+        r = _index->lookup(f1, vespalib::make_string("absent%u", i));
+        EXPECT_TRUE(!r || r->counts._numDocs == 0);
+    }
+    // Only a false positive in the bloom filter gives a dictionary lookup.
+    EXPECT_LESS_EQUAL(skipped + 90, _index->getSkippedDictionaryLookups());
+}
+
 void
 Test::requireThatWeCanReadPostingList()
 {
@@ -334,6 +353,7 @@ Test::Main()
     TEST_DO(requireThatLookupIsWorking(false, false, true));
     TEST_DO(openIndex("index/1", false, false, false, false, false));
     TEST_DO(requireThatLookupIsWorking(false, false, false));
+    TEST_DO(requireThatLookupSkipsDictionaryForWordsRuledOutByFilter());
     TEST_DO(requireThatWeCanReadPostingList());
     TEST_DO(require_that_we_can_get_field_length_info());
     TEST_DO(requireThatWeCanReadBitVector());
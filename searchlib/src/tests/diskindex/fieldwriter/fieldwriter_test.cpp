@@ -56,6 +56,7 @@ namespace fieldwriter {
 
 uint32_t minSkipDocs = 64;
 uint32_t minChunkDocs = 262144;
+bool blockPostingFormat = false;
 
 vespalib::string dirprefix = "index/";
 
@@ -77,6 +78,11 @@ void enableSkipChunks()
     minChunkDocs = 9000;    // Unrealistic low for testing
 }
 
+void enableBlockPostingFormat(bool enable)
+{
+    blockPostingFormat = enable;
+}
+
 const char *bool_to_str(bool val) { return (val ? "true" : "false"); }
 
 vespalib::string
@@ -182,7 +188,7 @@ WrappedFieldWriter::WrappedFieldWriter(const vespalib::string &namepref,
       _indexId()
 {
     schema::CollectionType ct(CollectionType::SINGLE);
-    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct));
+    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct).set_block_posting_format(blockPostingFormat));
     _indexId = _schema.getIndexFieldId("field1");
 }
 
@@ -458,7 +464,9 @@ randReadField(FakeWordSet &wordSet,
     auto dictFile = std::make_unique<PageDict4RandRead>();
 
     search::index::PostingListFileRandRead *postingFile = nullptr;
-    if (dynamicK)
+    if (blockPostingFormat)
+        postingFile = new search::diskindex::BlockPosOccRandRead;
+    else if (dynamicK)
         postingFile = new search::diskindex::ZcPosOccRandRead;
     else
         postingFile = new search::diskindex::Zc4PosOccRandRead;
@@ -626,6 +634,10 @@ testFieldWriterVariants(FakeWordSet &wordSet,
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk5", false, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunkcf4", true, true, verbose);
+    enableBlockPostingFormat(true);
+    testFieldWriterVariant(wordSet, docIdLimit, "newblock", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newblockcf", false, true, verbose);
+    enableBlockPostingFormat(false);
 }
 
 
@@ -642,6 +654,9 @@ testFieldWriterVariantsWithHighLids(FakeWordSet &wordSet, uint32_t docIdLimit,
     enableSkipChunks();
     testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk5", false, false, verbose);
+    enableBlockPostingFormat(true);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidblock", false, false, verbose);
+    enableBlockPostingFormat(false);
 }
 
 int
@@ -17,7 +17,10 @@
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/time.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <gtest/gtest.h>
 
@@ -61,7 +64,8 @@ protected:
 
     void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap);
     void make_simple_index(const vespalib::string &dump_dir, const IFieldLengthInspector &field_length_inspector);
-    void merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources);
+    void merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources,
+                              uint32_t max_concurrent_fields = 0);
 public:
     FusionTest();
 };
@@ -388,7 +392,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         sources.push_back(prefix + "dump2");
         ASSERT_TRUE(Fusion::merge(schema, prefix + "dump3", sources, selector,
                                   dynamicKPosOcc,
-                                  tuneFileIndexing,fileHeaderContext, executor));
+                                  tuneFileIndexing, fileHeaderContext, executor, 0));
     } while (0);
     do {
         DiskIndex dw3(prefix + "dump3");
@@ -401,7 +405,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         sources.push_back(prefix + "dump3");
         ASSERT_TRUE(Fusion::merge(schema2, prefix + "dump4", sources, selector,
                                   dynamicKPosOcc,
-                                  tuneFileIndexing, fileHeaderContext, executor));
+                                  tuneFileIndexing, fileHeaderContext, executor, 0));
     } while (0);
     do {
         DiskIndex dw4(prefix + "dump4");
@@ -414,7 +418,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         sources.push_back(prefix + "dump3");
         ASSERT_TRUE(Fusion::merge(schema3, prefix + "dump5", sources, selector,
                                   dynamicKPosOcc,
-                                  tuneFileIndexing, fileHeaderContext, executor));
+                                  tuneFileIndexing, fileHeaderContext, executor, 0));
     } while (0);
     do {
         DiskIndex dw5(prefix + "dump5");
@@ -427,7 +431,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         sources.push_back(prefix + "dump3");
         ASSERT_TRUE(Fusion::merge(schema, prefix + "dump6", sources, selector,
                                   !dynamicKPosOcc,
-                                  tuneFileIndexing, fileHeaderContext, executor));
+                                  tuneFileIndexing, fileHeaderContext, executor, 0));
     } while (0);
     do {
         DiskIndex dw6(prefix + "dump6");
@@ -440,7 +444,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         sources.push_back(prefix + "dump2");
         ASSERT_TRUE(Fusion::merge(schema, prefix + "dump3", sources, selector,
                                   dynamicKPosOcc,
-                                  tuneFileIndexing, fileHeaderContext, executor));
+                                  tuneFileIndexing, fileHeaderContext, executor, 0));
     } while (0);
     do {
         DiskIndex dw3(prefix + "dump3");
@@ -475,7 +479,8 @@ FusionTest::make_simple_index(const vespalib::string &dump_dir, const IFieldLeng
 }
 
 void
-FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources)
+FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::vector<vespalib::string> &sources,
+                                 uint32_t max_concurrent_fields)
 {
     vespalib::ThreadStackExecutor executor(4, 0x10000);
     TuneFileIndexing tuneFileIndexing;
@@ -483,7 +488,7 @@ FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::ve
     SelectorArray selector(20, 0);
     ASSERT_TRUE(Fusion::merge(_schema, dump_dir, sources, selector,
                               false,
-                              tuneFileIndexing, fileHeaderContext, executor));
+                              tuneFileIndexing, fileHeaderContext, executor, max_concurrent_fields));
 }
 
 FusionTest::FusionTest()
@@ -551,6 +556,123 @@ TEST_F(FusionTest, require_that_interleaved_features_can_be_reconstructed)
     clean_field_length_testdirs();
 }
 
+TEST_F(FusionTest, require_that_fields_can_be_merged_one_at_a_time)
+{
+    clean_field_length_testdirs();
+    make_simple_index("fldump2", MockFieldLengthInspector());
+    make_simple_index("fldump3", MyMockFieldLengthInspector());
+    merge_simple_indexes("fldump4", {"fldump2", "fldump3"}, 1);
+    DiskIndex disk_index("fldump4");
+    ASSERT_TRUE(disk_index.setup(TuneFileSearch()));
+    EXPECT_EQ(3.5, disk_index.get_field_length_info("f0").get_average_field_length());
+    clean_field_length_testdirs();
+}
+
+namespace {
+
+constexpr uint32_t bench_num_fields = 6;
+constexpr uint32_t bench_num_docs = 50000;
+constexpr uint32_t bench_num_sources = 2;
+
+Schema
+make_benchmark_schema()
+{
+    Schema schema;
+    for (uint32_t field_id = 0; field_id < bench_num_fields; ++field_id) {
+        schema.addIndexField(make_index_field(vespalib::make_string("b%u", field_id), CollectionType::SINGLE, false));
+    }
+    return schema;
+}
+
+/*
+ * Makes a synthetic disk index with the documents selected for the given source.
+ * Field n has 4 * (n + 1) random words per document, so the fields differ in size.
+ */
+void
+make_benchmark_index(const Schema &schema, const vespalib::string &dump_dir, uint32_t source)
+{
+    MockFieldLengthInspector field_length_inspector;
+    FieldIndexCollection fic(schema, field_length_inspector);
+    DocBuilder b(schema);
+    auto invertThreads = SequencedTaskExecutor::create(2);
+    auto pushThreads = SequencedTaskExecutor::create(2);
+    DocumentInverter inv(schema, *invertThreads, *pushThreads, fic);
+    vespalib::Rand48 rnd;
+    rnd.srand48(42 + source);
+    for (uint32_t doc_id = 1; doc_id < bench_num_docs; ++doc_id) {
+        if ((doc_id % bench_num_sources) != source) {
+            continue;
+        }
+        b.startDocument(vespalib::make_string("id:ns:searchdocument::%u", doc_id));
+        for (uint32_t field_id = 0; field_id < bench_num_fields; ++field_id) {
+            b.startIndexField(vespalib::make_string("b%u", field_id));
+            for (uint32_t i = 0; i < 4 * (field_id + 1); ++i) {
+                b.addStr(vespalib::make_string("w%u", uint32_t(rnd.lrand48() % (5000 * (field_id + 1)))));
+            }
+            b.endField();
+        }
+        inv.invertDocument(doc_id, *b.endDocument());
+        if ((doc_id % 1000) < bench_num_sources) {
+            invertThreads->sync();
+            myPushDocument(inv);
+            pushThreads->sync();
+        }
+    }
+    invertThreads->sync();
+    myPushDocument(inv);
+    pushThreads->sync();
+
+    IndexBuilder ib(schema);
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    ib.setPrefix(dump_dir);
+    ib.open(bench_num_docs, fic.getNumUniqueWords(), field_length_inspector, tuneFileIndexing, fileHeaderContext);
+    fic.dump(ib);
+    ib.close();
+}
+
+double
+measure_fusion(const Schema &schema, const std::vector<vespalib::string> &sources, uint32_t num_threads,
+               uint32_t max_concurrent_fields)
+{
+    vespalib::rmdir("benchdump", true);
+    vespalib::ThreadStackExecutor executor(num_threads, 0x10000);
+    TuneFileIndexing tuneFileIndexing;
+    DummyFileHeaderContext fileHeaderContext;
+    SelectorArray selector(bench_num_docs, 0);
+    for (uint32_t doc_id = 0; doc_id < bench_num_docs; ++doc_id) {
+        selector[doc_id] = doc_id % bench_num_sources;
+    }
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    EXPECT_TRUE(Fusion::merge(schema, "benchdump", sources, selector, false,
+                              tuneFileIndexing, fileHeaderContext, executor, max_concurrent_fields));
+    double seconds = vespalib::to_s(vespalib::steady_clock::now() - start);
+    vespalib::rmdir("benchdump", true);
+    return seconds;
+}
+
+}
+
+// Run with --gtest_also_run_disabled_tests to compare fusion time with one and with all fields merged concurrently.
+TEST_F(FusionTest, DISABLED_benchmark_parallel_fusion_of_synthetic_indexes)
+{
+    Schema schema = make_benchmark_schema();
+    std::vector<vespalib::string> sources;
+    for (uint32_t source = 0; source < bench_num_sources; ++source) {
+        sources.push_back(vespalib::make_string("benchsource%u", source));
+        vespalib::rmdir(sources.back(), true);
+        make_benchmark_index(schema, sources.back(), source);
+    }
+    uint32_t num_threads = bench_num_fields;
+    double serial = measure_fusion(schema, sources, num_threads, 1);
+    double parallel = measure_fusion(schema, sources, num_threads, bench_num_fields);
+    LOG(info, "%u docs, %u fields: fusion %6.3f s with 1 field at a time, %6.3f s with %u concurrent fields",
+        bench_num_docs, bench_num_fields, serial, parallel, bench_num_fields);
+    for (const auto &source : sources) {
+        vespalib::rmdir(source, true);
+    }
+}
+
 }
 
 }
@@ -4,7 +4,9 @@
 #include <vespa/searchlib/docstore/value.h>
 #include <vespa/searchlib/docstore/cachestats.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <map>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -63,6 +65,146 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+struct MemoryDataStore : NullDataStore {
+    std::map<uint32_t, vespalib::string> _docs;
+    std::vector<uint64_t> _serials;
+    uint64_t _flushedSerial;
+    MemoryDataStore() : NullDataStore(), _docs(), _serials(), _flushedSerial(0) {}
+    ssize_t read(uint32_t lid, vespalib::DataBuffer & buf) const override {
+        auto itr = _docs.find(lid);
+        if (itr == _docs.end()) {
+            return 0;
+        }
+        buf.writeBytes(itr->second.data(), itr->second.size());
+        return itr->second.size();
+    }
+    void read(const LidVector & lids, IBufferVisitor & visitor) const override {
+        for (uint32_t lid : lids) {
+            auto itr = _docs.find(lid);
+            if (itr != _docs.end()) {
+                visitor.visit(lid, vespalib::ConstBufferRef(itr->second.data(), itr->second.size()));
+            }
+        }
+    }
+    void write(uint64_t serial, uint32_t lid, const void * buffer, size_t len) override {
+        _serials.push_back(serial);
+        _docs[lid] = vespalib::string(static_cast<const char *>(buffer), len);
+        updateDocIdLimit(lid + 1);
+    }
+    void remove(uint64_t serial, uint32_t lid) override {
+        _serials.push_back(serial);
+        _docs.erase(lid);
+        updateDocIdLimit(lid + 1);
+    }
+    void compactLidSpace(uint32_t wantedDocLidLimit) override { setDocIdLimit(wantedDocLidLimit); }
+    uint64_t initFlush(uint64_t syncToken) override {
+        _flushedSerial = syncToken;
+        return syncToken;
+    }
+};
+
+document::Document
+makeDoc(const vespalib::string & id) {
+    return document::Document(*repo.getDocumentType("document"), document::DocumentId(id));
+}
+
+vespalib::string
+readId(const DocumentStore & store, uint32_t lid) {
+    auto doc = store.read(lid, repo);
+    return doc ? doc->getId().toString() : vespalib::string("null");
+}
+
+using SerialVector = std::vector<uint64_t>;
+
+struct VisitedIds : IDocumentVisitor {
+    std::vector<vespalib::string> ids;
+    void visit(uint32_t, DocumentUP doc) override { ids.push_back(doc->getId().toString()); }
+    bool allowVisitCaching() const override { return false; }
+};
+
+struct CoalescingFixture {
+    DocumentStore::Config config;
+    MemoryDataStore backing;
+    DocumentStore store;
+    CoalescingFixture(size_t maxCacheBytes, size_t maxPendingWriteBytes)
+        : config(DocumentStore::Config(CompressionConfig::NONE, maxCacheBytes, maxCacheBytes / 1000)
+                         .maxPendingWriteBytes(maxPendingWriteBytes)),
+          backing(),
+          store(config, backing)
+    {}
+};
+
+TEST_F("require that repeated writes of same lid are coalesced until flush", CoalescingFixture(100000, 100000))
+{
+    f.store.write(1, 1, makeDoc("id:ns:document::1.1"));
+    f.store.write(2, 1, makeDoc("id:ns:document::1.2"));
+    f.store.write(3, 2, makeDoc("id:ns:document::2.1"));
+    f.store.write(4, 1, makeDoc("id:ns:document::1.3"));
+    EXPECT_TRUE(SerialVector() == f.backing._serials);
+    EXPECT_LESS(0u, f.store.getPendingWriteBytes());
+    EXPECT_EQUAL(f.store.getPendingWriteBytes(), f.store.memoryUsed());
+    EXPECT_EQUAL("id:ns:document::1.3", readId(f.store, 1));
+    EXPECT_EQUAL("id:ns:document::2.1", readId(f.store, 2));
+    EXPECT_EQUAL(4u, f.store.initFlush(4));
+    EXPECT_TRUE(SerialVector({3, 4}) == f.backing._serials);
+    EXPECT_EQUAL(0u, f.store.getPendingWriteBytes());
+    EXPECT_EQUAL("id:ns:document::1.3", readId(f.store, 1));
+    EXPECT_EQUAL("id:ns:document::2.1", readId(f.store, 2));
+}
+
+TEST_F("require that pending writes are written when exceeding max pending bytes", CoalescingFixture(0, 1))
+{
+    f.store.write(1, 1, makeDoc("id:ns:document::1.1"));
+    f.store.write(2, 1, makeDoc("id:ns:document::1.2"));
+    EXPECT_TRUE(SerialVector({1, 2}) == f.backing._serials);
+    EXPECT_EQUAL(0u, f.store.getPendingWriteBytes());
+}
+
+TEST_F("require that remove is kept pending and replaces pending write of same lid", CoalescingFixture(0, 100000))
+{
+    f.store.write(1, 1, makeDoc("id:ns:document::1.1"));
+    f.store.write(2, 2, makeDoc("id:ns:document::2.1"));
+    f.store.remove(3, 1);
+    EXPECT_TRUE(SerialVector() == f.backing._serials);
+    EXPECT_EQUAL("null", readId(f.store, 1));
+    EXPECT_EQUAL("id:ns:document::2.1", readId(f.store, 2));
+    f.store.write(4, 3, makeDoc("id:ns:document::3.1"));
+    f.store.remove(5, 3);
+    f.store.write(6, 3, makeDoc("id:ns:document::3.2"));
+    EXPECT_EQUAL("id:ns:document::3.2", readId(f.store, 3));
+    EXPECT_EQUAL(6u, f.store.initFlush(6));
+    EXPECT_TRUE(SerialVector({2, 3, 6}) == f.backing._serials);
+    EXPECT_EQUAL(0u, f.store.getPendingWriteBytes());
+    EXPECT_EQUAL("null", readId(f.store, 1));
+    EXPECT_EQUAL("id:ns:document::2.1", readId(f.store, 2));
+    EXPECT_EQUAL("id:ns:document::3.2", readId(f.store, 3));
+}
+
+TEST_F("require that doc id limit and sync token include pending writes", CoalescingFixture(0, 100000))
+{
+    f.store.write(1, 1, makeDoc("id:ns:document::1.1"));
+    f.store.write(2, 7, makeDoc("id:ns:document::7.1"));
+    f.store.remove(3, 9);
+    EXPECT_TRUE(SerialVector() == f.backing._serials);
+    EXPECT_EQUAL(10u, f.store.getDocIdLimit());
+    EXPECT_EQUAL(3u, f.store.tentativeLastSyncToken());
+    f.store.compactLidSpace(8);
+    EXPECT_TRUE(SerialVector({1, 2, 3}) == f.backing._serials);
+    EXPECT_EQUAL(0u, f.store.getPendingWriteBytes());
+    EXPECT_EQUAL(8u, f.store.getDocIdLimit());
+}
+
+TEST_F("require that pending remove hides stored document from visit", CoalescingFixture(0, 100000))
+{
+    f.store.write(1, 1, makeDoc("id:ns:document::1.1"));
+    f.store.write(2, 2, makeDoc("id:ns:document::2.1"));
+    f.store.initFlush(2);
+    f.store.remove(3, 1);
+    VisitedIds visited;
+    f.store.visit({1, 2}, repo, visited);
+    EXPECT_TRUE(std::vector<vespalib::string>({"id:ns:document::2.1"}) == visited.ids);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -70,6 +212,7 @@ TEST("require that DocumentStore::Config equality operator detects inequality")
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 99));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100001, 100));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::LZ4, 100000, 100));
+    EXPECT_FALSE(C().maxPendingWriteBytes(1000) == C());
 }
 
 TEST("require that LogDocumentStore::Config equality operator detects inequality") {
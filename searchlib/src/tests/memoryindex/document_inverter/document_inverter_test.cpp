@@ -105,10 +105,13 @@ public:
     {
     }
 
-    FieldIndexRemover &get_remover(uint32_t) override {
+    uint32_t get_num_shards(uint32_t) const override {
+        return 1;
+    }
+    FieldIndexRemover &get_remover(uint32_t, uint32_t) override {
         return _remover;
     }
-    IOrderedFieldIndexInserter &get_inserter(uint32_t) override {
+    IOrderedFieldIndexInserter &get_inserter(uint32_t, uint32_t) override {
         return _inserter;
     }
     index::FieldLengthCalculator &get_calculator(uint32_t) override {
@@ -13,12 +13,16 @@
 #include <vespa/searchlib/memoryindex/field_inverter.h>
 #include <vespa/searchlib/memoryindex/ordered_field_index_inserter.h>
 #include <vespa/searchlib/memoryindex/posting_iterator.h>
+#include <vespa/searchlib/memoryindex/sharded_field_index.h>
 #include <vespa/searchlib/queryeval/iterators.h>
 #include <vespa/searchlib/test/index/mock_field_length_inspector.h>
 #include <vespa/searchlib/test/memoryindex/wrap_inserter.h>
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -136,6 +140,59 @@ public:
     }
 };
 
+/**
+ * Index builder supporting concurrent building of fields, using a MyBuilder per field.
+ */
+class MyParallelBuilder : public IndexBuilder {
+private:
+    class FieldBuilder : public FieldIndexBuilder {
+        MyBuilder &_builder;
+    public:
+        FieldBuilder(MyBuilder &builder, uint32_t fieldId)
+            : _builder(builder)
+        {
+            _builder.startField(fieldId);
+        }
+        ~FieldBuilder() override { _builder.endField(); }
+        void startWord(vespalib::stringref word) override { _builder.startWord(word); }
+        void endWord() override { _builder.endWord(); }
+        void add_document(const DocIdAndFeatures &features) override { _builder.add_document(features); }
+    };
+
+    std::vector<std::unique_ptr<MyBuilder>> _fields;
+
+public:
+    MyParallelBuilder(const Schema &schema)
+        : IndexBuilder(schema),
+          _fields()
+    {
+        for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
+            _fields.push_back(std::make_unique<MyBuilder>(schema));
+        }
+    }
+
+    void startWord(vespalib::stringref) override { LOG_ABORT("should not be reached"); }
+    void endWord() override { LOG_ABORT("should not be reached"); }
+    void startField(uint32_t) override { LOG_ABORT("should not be reached"); }
+    void endField() override { LOG_ABORT("should not be reached"); }
+    void add_document(const DocIdAndFeatures &) override { LOG_ABORT("should not be reached"); }
+
+    std::unique_ptr<FieldIndexBuilder> startFieldBuilder(uint32_t fieldId) override {
+        return std::make_unique<FieldBuilder>(*_fields[fieldId], fieldId);
+    }
+
+    std::string toStr() const {
+        std::string result;
+        for (const auto &field : _fields) {
+            if (!result.empty()) {
+                result += ",";
+            }
+            result += field->toStr();
+        }
+        return result;
+    }
+};
+
 struct SimpleMatchData {
     TermFieldMatchData term;
     TermFieldMatchDataArray array;
@@ -463,9 +520,12 @@ getFeatureStoreMemStats(const FieldIndexCollection &fieldIndexes)
     DataStoreBase::MemStats res;
     uint32_t numFields = fieldIndexes.getNumFields();
     for (uint32_t fieldId = 0; fieldId < numFields; ++fieldId) {
-        DataStoreBase::MemStats stats =
-            fieldIndexes.getFieldIndex(fieldId)->getFeatureStore().getMemStats();
-        res += stats;
+        auto &fieldIndex = *fieldIndexes.getFieldIndex(fieldId);
+        for (uint32_t shard = 0; shard < fieldIndex.get_num_shards(); ++shard) {
+            DataStoreBase::MemStats stats =
+                fieldIndex.get_shard(shard).getFeatureStore().getMemStats();
+            res += stats;
+        }
     }
     return res;
 }
@@ -846,6 +906,31 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_of_multiple_fields_to_inde
               b.toStr());
 }
 
+TEST_F(FieldIndexCollectionTest, require_that_fields_can_be_dumped_concurrently)
+{
+    WrapInserter(fic, 0).word("a").add(5, getFeatures(2, 1)).
+            word("c").add(7, getFeatures(3, 2)).flush();
+    WrapInserter(fic, 1).word("a").add(5, getFeatures(2, 1)).
+            add(7, getFeatures(3, 2)).
+            word("b").add(5, getFeatures(12, 2)).flush();
+    WrapInserter(fic, 3).word("d").add(9, getFeatures(4, 1)).flush();
+    MyBuilder expected(schema);
+    fic.dump(expected);
+    MyParallelBuilder b(schema);
+    vespalib::ThreadStackExecutor executor(4, 0x10000);
+    fic.dump(b, executor);
+    EXPECT_EQ(expected.toStr(), b.toStr());
+}
+
+TEST_F(FieldIndexCollectionTest, require_that_dumping_falls_back_to_one_field_at_a_time)
+{
+    WrapInserter(fic, 1).word("a").add(5, getFeatures(2, 1)).flush();
+    MyBuilder b(schema);
+    vespalib::ThreadStackExecutor executor(4, 0x10000);
+    fic.dump(b, executor);
+    EXPECT_EQ("f=0[],f=1[w=a[d=5[e=0,w=1,l=2[0]]]],f=2[],f=3[]", b.toStr());
+}
+
 TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_index_builder_is_working)
 {
     WrapInserter(fic, 0).word("a").add(2, getFeatures(2, 1)).
@@ -1052,8 +1137,10 @@ TEST_F(BasicInverterTest, require_that_inversion_is_working)
     myCompactFeatures(_fic, *_pushThreads);
     std::vector<std::unique_ptr<GenerationHandler::Guard>> guards;
     for (auto &fieldIndex : _fic.getFieldIndexes()) {
-        guards.push_back(std::make_unique<GenerationHandler::Guard>
-                         (fieldIndex->takeGenerationGuard()));
+        for (uint32_t shard = 0; shard < fieldIndex->get_num_shards(); ++shard) {
+            guards.push_back(std::make_unique<GenerationHandler::Guard>
+                             (fieldIndex->get_shard(shard).takeGenerationGuard()));
+        }
     }
     myCommit(_fic, *_pushThreads);
     DataStoreBase::MemStats duringStats = getFeatureStoreMemStats(_fic);
@@ -1428,6 +1515,85 @@ TEST_F(CjkInverterTest, require_that_cjk_indexing_is_working)
     }
 }
 
+Schema
+make_sharded_field_schema()
+{
+    Schema result;
+    result.addIndexField(Schema::IndexField("f0", DataType::STRING));
+    Schema::IndexField sharded("f1", DataType::STRING);
+    sharded.set_memory_index_shards(4);
+    result.addIndexField(sharded);
+    return result;
+}
+
+class ShardedInverterTest : public InverterTest {
+public:
+    ShardedInverterTest() : InverterTest(make_sharded_field_schema()) {}
+
+    void invert_and_push(uint32_t docId, const std::vector<vespalib::string> &words) {
+        _b.startDocument(vespalib::make_string("id:ns:searchdocument::%u", docId));
+        for (const char *field : { "f0", "f1" }) {
+            _b.startIndexField(field);
+            for (const auto &word : words) {
+                _b.addStr(word);
+            }
+            _b.endField();
+        }
+        auto doc = _b.endDocument();
+        _inv.invertDocument(docId, *doc);
+        _invertThreads->sync();
+        myPushDocument(_inv);
+        _pushThreads->sync();
+    }
+};
+
+TEST_F(ShardedInverterTest, sharded_field_index_has_same_content_as_unsharded_field_index)
+{
+    expect_field_index_type<ShardedFieldIndex<false>>(_fic.getFieldIndex(1));
+    EXPECT_EQ(4u, _fic.get_num_shards(1));
+    invert_and_push(10, { "a", "b", "c", "d", "e", "f", "g", "h" });
+    invert_and_push(20, { "b", "d", "f", "h", "b" });
+    invert_and_push(30, { "c", "x", "y", "z" });
+    _inv.removeDocument(10);
+    _invertThreads->sync();
+    myPushDocument(_inv);
+    _pushThreads->sync();
+    EXPECT_EQ(_fic.getFieldIndex(0)->getNumUniqueWords(), _fic.getFieldIndex(1)->getNumUniqueWords());
+
+    MyBuilder b(_schema);
+    _fic.dump(b);
+    std::string dumped = b.toStr();
+    auto split = dumped.find(",f=1[");
+    ASSERT_NE(std::string::npos, split);
+    std::string f0 = dumped.substr(4, split - 4);
+    std::string f1 = dumped.substr(split + 5);
+    EXPECT_EQ(f0, f1);
+    EXPECT_EQ(0u, f0.find("w=b[d=20["));
+    EXPECT_EQ(std::string::npos, f0.find("d=10["));
+}
+
+TEST_F(ShardedInverterTest, per_shard_components_are_accessed_through_shards)
+{
+    invert_and_push(10, { "a", "b", "c", "d", "e", "f", "g", "h" });
+    auto &field_index = *_fic.getFieldIndex(1);
+    EXPECT_THROW(field_index.getFeatureStore(), vespalib::IllegalStateException);
+    EXPECT_THROW(field_index.getWordStore(), vespalib::IllegalStateException);
+    EXPECT_THROW(field_index.getDocumentRemover(), vespalib::IllegalStateException);
+    EXPECT_THROW(field_index.takeGenerationGuard(), vespalib::IllegalStateException);
+    uint64_t num_unique_words = 0;
+    size_t used_features = 0;
+    std::vector<GenerationHandler::Guard> guards;
+    for (uint32_t shard = 0; shard < field_index.get_num_shards(); ++shard) {
+        auto &shard_index = field_index.get_shard(shard);
+        num_unique_words += shard_index.getNumUniqueWords();
+        used_features += shard_index.getFeatureStore().getMemStats()._usedElems;
+        guards.push_back(shard_index.takeGenerationGuard());
+    }
+    EXPECT_EQ(8u, num_unique_words);
+    EXPECT_LT(0u, used_features);
+    EXPECT_EQ(4u, guards.size());
+}
+
 void
 insertAndAssertTuple(const vespalib::string &word, uint32_t fieldId, uint32_t docId,
                      FieldIndexCollection &dict)
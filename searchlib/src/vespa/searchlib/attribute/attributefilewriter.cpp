@@ -5,6 +5,7 @@
 #include "attribute_header.h"
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/fastos/file.h>
 
@@ -146,6 +147,7 @@ void
 AttributeFileWriter::writeBuf(Buffer buf)
 {
     size_t bufLen = buf->getDataLen();
+    common::FlushIoThrottle::instance().acquire(bufLen);
     // TODO: pad to DirectIO boundary when burning bridges
     writeDirectIOAligned(*_file, buf->getData(), bufLen);
     _fileBitSize += bufLen * 8;
@@ -8,6 +8,15 @@ namespace search {
 using queryeval::MinMaxPostingInfo;
 using fef::TermFieldMatchData;
 
+AttributeHitBatch::AttributeHitBatch()
+    : _hits(),
+      _begin(0),
+      _end(0)
+{
+}
+
+AttributeHitBatch::~AttributeHitBatch() = default;
+
 void
 AttributeIteratorBase::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
@@ -166,4 +175,26 @@ setupPostingInfo()
     }
 }
 
+template <>
+void
+AttributePostingListIteratorT<attribute::CompressedDocIdIterator>::
+setupPostingInfo()
+{
+    if (_iterator.valid()) {
+        _postingInfo = MinMaxPostingInfo(1, 1);
+        _postingInfoValid = true;
+    }
+}
+
+template <>
+void
+FilterAttributePostingListIteratorT<attribute::CompressedDocIdIterator>::
+setupPostingInfo()
+{
+    if (_iterator.valid()) {
+        _postingInfo = MinMaxPostingInfo(1, 1);
+        _postingInfoValid = true;
+    }
+}
+
 } // namespace search
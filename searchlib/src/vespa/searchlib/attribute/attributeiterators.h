@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "compressed_posting_list.h"
 #include "dociditerator.h"
 #include "postinglisttraits.h"
 #include <vespa/searchlib/queryeval/searchiterator.h>
@@ -121,6 +122,29 @@ public:
 };
 
 
+/**
+ * Window of hits evaluated with SC::find_batch(begin_lid, end_lid, result),
+ * used by strict iterators when the search context can evaluate many
+ * documents at a time.
+ */
+class AttributeHitBatch
+{
+    std::unique_ptr<BitVector> _hits;
+    uint32_t                   _begin;
+    uint32_t                   _end;
+public:
+    static constexpr uint32_t batch_size = 4096;
+
+    AttributeHitBatch();
+    ~AttributeHitBatch();
+
+    /*
+     * Returns the first hit >= docId, or endId if there are no more hits.
+     */
+    template <typename SC>
+    uint32_t next_hit(const SC &sc, uint32_t docId, uint32_t endId);
+};
+
 /**
  * This class acts as a strict iterator over documents that are
  * results for the subquery represented by the search context object
@@ -139,6 +163,7 @@ private:
     using AttributeIteratorT<SC>::isAtEnd;
     using AttributeIteratorT<SC>::_weight;
     using Trinary=vespalib::Trinary;
+    AttributeHitBatch _batch;
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::True; }
 public:
@@ -157,6 +182,7 @@ private:
     using FilterAttributeIteratorT<SC>::setAtEnd;
     using FilterAttributeIteratorT<SC>::isAtEnd;
     using Trinary=vespalib::Trinary;
+    AttributeHitBatch _batch;
     void doSeek(uint32_t docId) override;
     Trinary is_strict() const override { return Trinary::True; }
 public:
@@ -316,6 +342,15 @@ template <>
 void
 FilterAttributePostingListIteratorT<DocIdMinMaxIterator<AttributePosting> >::setupPostingInfo();
 
+template <>
+void
+AttributePostingListIteratorT<attribute::CompressedDocIdIterator>::setupPostingInfo();
+
+
+template <>
+void
+FilterAttributePostingListIteratorT<attribute::CompressedDocIdIterator>::setupPostingInfo();
+
 /**
  * This class acts as an iterator over a flag attribute.
  */
@@ -18,20 +18,73 @@ bool matches(const SC & sc, uint32_t doc) {
     return sc.find(doc, 0) >= 0;
 }
 
+/*
+ * Search contexts providing find_batch(begin_lid, end_lid, result) can
+ * evaluate a range of documents at a time instead of one by one.
+ */
+template <typename SC, typename = void>
+struct has_find_batch : std::false_type {};
+
+template <typename SC>
+struct has_find_batch<SC, std::void_t<decltype(std::declval<const SC &>().find_batch(0u, 0u, std::declval<BitVector &>()))>> : std::true_type {};
+
+template <typename SC>
+inline constexpr bool has_find_batch_v = has_find_batch<SC>::value;
+
+}
+
+template <typename SC>
+uint32_t
+AttributeHitBatch::next_hit(const SC &sc, uint32_t docId, uint32_t endId)
+{
+    while (docId < endId) {
+        if (!_hits || docId < _begin || docId >= _end) {
+            _begin = docId & ~(batch_size - 1);
+            _end = std::min(_begin + batch_size, endId);
+            _hits = BitVector::create(_begin, _end);
+            sc.find_batch(_begin, _end, *_hits);
+        }
+        uint32_t hit = _hits->getNextTrueBit(docId);
+        if (hit < _end) {
+            return hit;
+        }
+        docId = _end;
+    }
+    return endId;
 }
 
 template <typename SC>
 void
 AttributeIteratorBase::and_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
-    result.foreach_truebit([&](uint32_t key) { if ( ! matches(sc, key)) { result.clearBit(key); }}, begin_id);
-    result.invalidateCachedCount();
+    if constexpr (has_find_batch_v<SC>) {
+        uint32_t end_id = std::min(result.size(), getEndId());
+        if (begin_id < end_id) {
+            auto hits = BitVector::create(begin_id, end_id);
+            sc.find_batch(begin_id, end_id, *hits);
+            result.foreach_truebit([&](uint32_t key) { if ( ! hits->testBit(key)) { result.clearBit(key); }}, begin_id, end_id);
+            result.invalidateCachedCount();
+        }
+    } else {
+        result.foreach_truebit([&](uint32_t key) { if ( ! matches(sc, key)) { result.clearBit(key); }}, begin_id);
+        result.invalidateCachedCount();
+    }
 }
 
 template <typename SC>
 void
 AttributeIteratorBase::or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
-    result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
-    result.invalidateCachedCount();
+    if constexpr (has_find_batch_v<SC>) {
+        uint32_t end_id = std::min(result.size(), getEndId());
+        if (begin_id < end_id) {
+            auto hits = BitVector::create(begin_id, end_id);
+            sc.find_batch(begin_id, end_id, *hits);
+            hits->foreach_truebit([&](uint32_t key) { result.setBit(key); }, begin_id, end_id);
+            result.invalidateCachedCount();
+        }
+    } else {
+        result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
+        result.invalidateCachedCount();
+    }
 }
 
 
@@ -39,9 +92,16 @@ template <typename SC>
 std::unique_ptr<BitVector>
 AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
     BitVector::UP result = BitVector::create(begin_id, getEndId());
-    for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
-        if (matches(sc, docId)) {
-            result->setBit(docId);
+    uint32_t docId(std::max(begin_id, getDocId()));
+    if constexpr (has_find_batch_v<SC>) {
+        if (docId < getEndId()) {
+            sc.find_batch(docId, getEndId(), *result);
+        }
+    } else {
+        for (; docId < getEndId(); docId++) {
+            if (matches(sc, docId)) {
+                result->setBit(docId);
+            }
         }
     }
     result->invalidateCachedCount();
@@ -124,6 +184,11 @@ struct is_tree_iterator<DocIdMinMaxIterator<P>> {
     static constexpr bool value = false;
 };
 
+template <>
+struct is_tree_iterator<attribute::CompressedDocIdIterator> {
+    static constexpr bool value = false;
+};
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT, typename TraitsT>
 struct is_tree_iterator<vespalib::btree::BTreeConstIterator<KeyT, DataT, AggrT, CompareT, TraitsT>> {
     static constexpr bool value = true;
@@ -434,6 +499,16 @@ template <typename SC>
 void
 AttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
+    if constexpr (has_find_batch_v<SC>) {
+        uint32_t nextId = _batch.next_hit(_concreteSearchCtx, docId, this->getEndId());
+        if (isAtEnd(nextId)) {
+            setAtEnd();
+        } else {
+            this->matches(nextId, _weight);
+            setDocId(nextId);
+        }
+        return;
+    }
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
         if (this->matches(nextId, _weight)) {
             setDocId(nextId);
@@ -447,6 +522,15 @@ template <typename SC>
 void
 FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
+    if constexpr (has_find_batch_v<SC>) {
+        uint32_t nextId = _batch.next_hit(_concreteSearchCtx, docId, this->getEndId());
+        if (isAtEnd(nextId)) {
+            setAtEnd();
+        } else {
+            setDocId(nextId);
+        }
+        return;
+    }
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
         if (this->matches(nextId)) {
             setDocId(nextId);
@@ -372,8 +372,13 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor *executor) {
     assert(!_loaded);
-    bool loaded = onLoad();
+    bool loaded = onLoad(executor);
     if (loaded) {
         commit();
     }
@@ -381,7 +386,7 @@ AttributeVector::load() {
     return _loaded;
 }
 
-bool AttributeVector::onLoad() { return false; }
+bool AttributeVector::onLoad(vespalib::Executor *) { return false; }
 int32_t AttributeVector::getWeight(DocId, uint32_t) const { return 1; }
 
 bool AttributeVector::findEnum(const char *, EnumHandle &) const { return false; }
@@ -500,6 +505,28 @@ AttributeVector::divideByZeroWarning() {
 }
 
 
+ChangeBase::Type
+AttributeVector::getArithmeticChangeType(const ArithmeticValueUpdate &arithm)
+{
+    switch (arithm.getOperator()) {
+    case ArithmeticValueUpdate::Add:
+        return ChangeBase::ADD;
+    case ArithmeticValueUpdate::Sub:
+        return ChangeBase::SUB;
+    case ArithmeticValueUpdate::Mul:
+        return ChangeBase::MUL;
+    case ArithmeticValueUpdate::Div:
+        if (getClass().inherits(IntegerAttribute::classId) && arithm.getOperand() == 0) {
+            divideByZeroWarning();
+            return ChangeBase::NOOP;
+        }
+        return ChangeBase::DIV;
+    default:
+        return ChangeBase::NOOP;
+    }
+}
+
+
 void
 AttributeVector::performCompactionWarning()
 {
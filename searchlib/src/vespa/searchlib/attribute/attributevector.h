@@ -36,6 +36,7 @@ namespace document {
 }
 
 namespace vespalib {
+    class Executor;
     class GenericHeader;
 }
 
@@ -354,6 +355,12 @@ protected:
     template<typename T>
     bool applyArithmetic(ChangeVectorT< ChangeTemplate<T> > &changes, DocId doc, const T &v, const ArithmeticValueUpdate & arithm);
 
+    /**
+     * Returns the change type for the given arithmetic update, or NOOP
+     * if it should be ignored (unknown operator or integer division by zero).
+     */
+    ChangeBase::Type getArithmeticChangeType(const ArithmeticValueUpdate &arithm);
+
     static double round(double v, double & r) { return r = v; }
     static largeint_t round(double v, largeint_t &r) { return r = static_cast<largeint_t>(::floor(v+0.5)); }
 
@@ -447,8 +454,29 @@ public:
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Loads this attribute vector, using the given executor (if not nullptr)
+     * to overlap and split the more costly parts of the load across threads.
+     * The executor must not be the one running this load.
+     */
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
+
+    /**
+     * Lid alignment of the ranges written by different threads when
+     * applying changes in place, see supportsInPlaceWrites().
+     */
+    static constexpr uint32_t inPlaceWriteLidAlignment = 4096;
+
+    /**
+     * Check if single value changes can be applied in place, i.e.
+     * directly to committed data instead of through the change vector.
+     * Several threads can then apply changes at the same time, as long as
+     * they write disjoint lid ranges aligned to inPlaceWriteLidAlignment
+     * and nothing else writes to this attribute meanwhile.
+     */
+    virtual bool supportsInPlaceWrites() const { return false; }
     void setCreateSerialNum(uint64_t createSerialNum);
     uint64_t getCreateSerialNum() const;
     virtual uint32_t getVersion() const;
@@ -569,7 +597,7 @@ private:
     virtual bool applyWeight(DocId doc, const FieldValue &fv, const ArithmeticValueUpdate &wAdjust);
     virtual bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust);
     virtual void onSave(IAttributeSaveTarget & saveTarget);
-    virtual bool onLoad();
+    virtual bool onLoad(vespalib::Executor *executor);
 
 
     BaseName                              _baseFileName;
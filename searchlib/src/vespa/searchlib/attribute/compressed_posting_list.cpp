@@ -0,0 +1,41 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_posting_list.h"
+#include <algorithm>
+#include <cassert>
+
+namespace search::attribute {
+
+CompressedPostingList::CompressedPostingList(const std::vector<uint32_t>& doc_ids)
+    : _size(doc_ids.size()),
+      _skip(),
+      _data()
+{
+    uint32_t num_blocks = (_size + block_size - 1) / block_size;
+    _skip.reserve(num_blocks);
+    // Worst case is a header word and 32 bits per document id in each block.
+    std::vector<uint32_t> buf(num_blocks * (1 + BlockBitPacking::packed_words(32)));
+    uint32_t *out = buf.data();
+    uint32_t prev_doc_id = 0;
+    for (uint32_t start = 0; start < _size; start += block_size) {
+        uint32_t count = std::min(block_size, _size - start);
+        assert(doc_ids[start] > prev_doc_id);
+        uint32_t offset = out - buf.data();
+        out = BlockBitPacking::encode_doc_ids(&doc_ids[start], count, prev_doc_id, out);
+        prev_doc_id = doc_ids[start + count - 1];
+        _skip.emplace_back(prev_doc_id, offset);
+    }
+    _data.assign(buf.data(), out);
+}
+
+CompressedPostingList::~CompressedPostingList() = default;
+
+size_t
+CompressedPostingList::memory_usage() const
+{
+    return sizeof(CompressedPostingList) +
+        _skip.capacity() * sizeof(SkipEntry) +
+        _data.capacity() * sizeof(uint32_t);
+}
+
+}
@@ -0,0 +1,158 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/bitcompression/block_bit_packing.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Frozen posting list without weights, used by the posting store for
+ * posting lists that have not been modified for a while.
+ *
+ * Document ids are delta encoded and bit packed in blocks of 128 (see
+ * bitcompression::BlockBitPacking). The last document id and the data
+ * offset of each block are kept in a separate skip table, allowing seeks
+ * to skip whole blocks without decoding them.
+ */
+class CompressedPostingList
+{
+    using BlockBitPacking = search::bitcompression::BlockBitPacking;
+
+    struct SkipEntry {
+        uint32_t _last_doc_id;
+        uint32_t _offset;
+        SkipEntry(uint32_t last_doc_id, uint32_t offset) noexcept
+            : _last_doc_id(last_doc_id),
+              _offset(offset)
+        {
+        }
+    };
+
+    uint32_t               _size;
+    std::vector<SkipEntry> _skip;
+    std::vector<uint32_t>  _data;
+
+public:
+    static constexpr uint32_t block_size = BlockBitPacking::block_size;
+
+    /*
+     * Create compressed posting list from strictly increasing document ids.
+     * Document id 0 is reserved and cannot be present.
+     */
+    CompressedPostingList(const std::vector<uint32_t>& doc_ids);
+    ~CompressedPostingList();
+
+    uint32_t size() const { return _size; }
+    uint32_t num_blocks() const { return _skip.size(); }
+    size_t memory_usage() const;
+
+    uint32_t block_prev_doc_id(uint32_t block) const { return (block == 0) ? 0u : _skip[block - 1]._last_doc_id; }
+    uint32_t block_last_doc_id(uint32_t block) const { return _skip[block]._last_doc_id; }
+    uint32_t block_size_at(uint32_t block) const {
+        return (block + 1 < _skip.size()) ? block_size : (_size - block * block_size);
+    }
+
+    /*
+     * Decode a block of document ids. A full block is always written to out.
+     */
+    void decode_block(uint32_t block, uint32_t *out) const {
+        BlockBitPacking::decode_doc_ids(&_data[_skip[block]._offset], block_prev_doc_id(block), out);
+    }
+
+    /*
+     * Returns the first block that might contain document ids >= doc_id,
+     * starting the search at the given block.
+     */
+    uint32_t seek_block(uint32_t block, uint32_t doc_id) const {
+        while (block < _skip.size() && _skip[block]._last_doc_id < doc_id) {
+            ++block;
+        }
+        return block;
+    }
+
+    template <typename FunctionType>
+    void foreach_key(FunctionType func) const {
+        uint32_t buf[block_size];
+        for (uint32_t block = 0; block < _skip.size(); ++block) {
+            decode_block(block, buf);
+            uint32_t count = block_size_at(block);
+            for (uint32_t i = 0; i < count; ++i) {
+                func(buf[i]);
+            }
+        }
+    }
+};
+
+/**
+ * Inner attribute iterator used for compressed posting lists. Decodes
+ * one block at a time.
+ */
+class CompressedDocIdIterator
+{
+    const CompressedPostingList *_list;
+    uint32_t                     _block;
+    uint32_t                     _pos;
+    uint32_t                     _block_docs;
+    uint32_t                     _buf[CompressedPostingList::block_size];
+
+    void load_block() {
+        if (_block < _list->num_blocks()) {
+            _list->decode_block(_block, _buf);
+            _block_docs = _list->block_size_at(_block);
+        } else {
+            _block_docs = 0;
+        }
+        _pos = 0;
+    }
+public:
+    CompressedDocIdIterator(const CompressedPostingList &list)
+        : _list(&list),
+          _block(0),
+          _pos(0),
+          _block_docs(0)
+    {
+        load_block();
+    }
+
+    bool valid() const { return _pos < _block_docs; }
+    uint32_t getKey() const { return _buf[_pos]; }
+    int32_t getData() const { return 1; }
+
+    CompressedDocIdIterator & operator++() {
+        if (++_pos == _block_docs) {
+            ++_block;
+            load_block();
+        }
+        return *this;
+    }
+
+    void linearSeek(uint32_t doc_id) {
+        if (!valid() || _buf[_block_docs - 1] < doc_id) {
+            if (!valid()) {
+                return;
+            }
+            uint32_t block = _list->seek_block(_block + 1, doc_id);
+            if (block != _block) {
+                _block = block;
+                load_block();
+            }
+        }
+        while (valid() && _buf[_pos] < doc_id) {
+            ++_pos;
+        }
+    }
+
+    void lower_bound(uint32_t doc_id) {
+        _block = _list->seek_block(0, doc_id);
+        load_block();
+        while (valid() && _buf[_pos] < doc_id) {
+            ++_pos;
+        }
+    }
+};
+
+}
@@ -66,9 +66,17 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setHuge(cfg.huge);
     retval.setEnableBitVectors(cfg.enablebitvectors);
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
+    retval.setEnableCompressedPostingLists(cfg.enablecompressedpostinglists);
+    retval.setEnableZoneMaps(cfg.enablezonemaps);
+    retval.setEnableMemoryMappedLoad(cfg.enablememorymappedload);
+    retval.setWriterShards(cfg.writershards > 1 ? cfg.writershards : 1);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
+    using CfgDictType = AttributesConfig::Attribute::Dictionary::Type;
+    retval.set_dictionary_config(cfg.dictionary.type == CfgDictType::BTREE_AND_HASH ?
+                                 DictionaryConfig(DictionaryConfig::Type::BTREE_AND_HASH) :
+                                 DictionaryConfig(DictionaryConfig::Type::BTREE));
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
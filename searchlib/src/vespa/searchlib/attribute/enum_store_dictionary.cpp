@@ -36,8 +36,8 @@ EnumStoreDictionary<DictionaryT>::remove_unused_values(const IndexSet& unused,
 }
 
 template <typename DictionaryT>
-EnumStoreDictionary<DictionaryT>::EnumStoreDictionary(IEnumStore& enumStore)
-    : ParentUniqueStoreDictionary(),
+EnumStoreDictionary<DictionaryT>::EnumStoreDictionary(IEnumStore& enumStore, std::unique_ptr<EntryComparator> hash_compare)
+    : ParentUniqueStoreDictionary(std::move(hash_compare)),
       _enumStore(enumStore)
 {
 }
@@ -88,6 +88,7 @@ EnumStoreDictionary<DictionaryT>::remove(const EntryComparator &comp, EntryRef r
         assert(EntryRef(itr.getData()) == EntryRef());
     }
     this->_dict.remove(itr);
+    this->hash_remove(ref);
 }
 
 template <typename DictionaryT>
@@ -95,6 +96,14 @@ bool
 EnumStoreDictionary<DictionaryT>::find_index(const vespalib::datastore::EntryComparator& cmp,
                                              Index& idx) const
 {
+    if (this->_hash_dict) {
+        EntryRef ref = this->hash_find(cmp);
+        if (!ref.valid()) {
+            return false;
+        }
+        idx = ref;
+        return true;
+    }
     auto itr = this->_dict.find(Index(), cmp);
     if (!itr.valid()) {
         return false;
@@ -108,6 +117,16 @@ bool
 EnumStoreDictionary<DictionaryT>::find_frozen_index(const vespalib::datastore::EntryComparator& cmp,
                                                     Index& idx) const
 {
+    if (this->_hash_dict) {
+        // The hash dictionary is not frozen. It might already reflect values added or
+        // removed after the last freeze, but those values have no committed references.
+        EntryRef ref = this->hash_find(cmp);
+        if (!ref.valid()) {
+            return false;
+        }
+        idx = ref;
+        return true;
+    }
     auto itr = this->_dict.getFrozenView().find(Index(), cmp);
     if (!itr.valid()) {
         return false;
@@ -157,8 +176,9 @@ EnumStoreDictionary<EnumPostingTree>::get_posting_dictionary() const
     return _dict;
 }
 
-EnumStoreFoldedDictionary::EnumStoreFoldedDictionary(IEnumStore& enumStore, std::unique_ptr<EntryComparator> folded_compare)
-    : EnumStoreDictionary<EnumPostingTree>(enumStore),
+EnumStoreFoldedDictionary::EnumStoreFoldedDictionary(IEnumStore& enumStore, std::unique_ptr<EntryComparator> hash_compare,
+                                                     std::unique_ptr<EntryComparator> folded_compare)
+    : EnumStoreDictionary<EnumPostingTree>(enumStore, std::move(hash_compare)),
       _folded_compare(std::move(folded_compare))
 {
 }
@@ -168,6 +188,12 @@ EnumStoreFoldedDictionary::~EnumStoreFoldedDictionary() = default;
 UniqueStoreAddResult
 EnumStoreFoldedDictionary::add(const EntryComparator& comp, std::function<EntryRef(void)> insertEntry)
 {
+    if (_hash_dict) {
+        EntryRef ref = hash_find(comp);
+        if (ref.valid()) {
+            return UniqueStoreAddResult(ref, false);
+        }
+    }
     auto it = _dict.lowerBound(EntryRef(), comp);
     if (it.valid() && !comp(EntryRef(), it.getKey())) {
         // Entry already exists
@@ -175,6 +201,7 @@ EnumStoreFoldedDictionary::add(const EntryComparator& comp, std::function<EntryR
     }
     EntryRef newRef = insertEntry();
     _dict.insert(it, newRef, EntryRef().ref());
+    hash_add(newRef);
     // Maybe move posting list reference from next entry
     ++it;
     if (it.valid() && EntryRef(it.getData()).valid() && !(*_folded_compare)(newRef, it.getKey())) {
@@ -196,6 +223,7 @@ EnumStoreFoldedDictionary::remove(const EntryComparator& comp, EntryRef ref)
     assert(it.valid() && it.getKey() == ref);
     EntryRef posting_list_ref(it.getData());
     _dict.remove(it);
+    hash_remove(ref);
     // Maybe copy posting list reference to next entry
     if (posting_list_ref.valid()) {
         if (it.valid() && !EntryRef(it.getData()).valid() && !(*_folded_compare)(ref, it.getKey())) {
@@ -6,6 +6,7 @@
 #include "loadedenumvalue.h"
 
 namespace search { class IEnumStore; }
+namespace vespalib { class Executor; }
 
 namespace search::enumstore {
 
@@ -48,15 +49,16 @@ public:
 class EnumeratedPostingsLoader : public EnumeratedLoaderBase {
 private:
     attribute::LoadedEnumAttributeVector _loaded_enums;
+    vespalib::Executor*                  _executor;
 
 public:
-    EnumeratedPostingsLoader(IEnumStore& store);
+    EnumeratedPostingsLoader(IEnumStore& store, vespalib::Executor* executor);
     attribute::LoadedEnumAttributeVector& get_loaded_enums() { return _loaded_enums; }
     void reserve_loaded_enums(size_t num_values) {
         _loaded_enums.reserve(num_values);
     }
     void sort_loaded_enums() {
-        attribute::sortLoadedByEnum(_loaded_enums);
+        attribute::sortLoadedByEnum(_loaded_enums, _executor);
     }
     bool is_folded_change(Index lhs, Index rhs) const;
     void set_ref_count(Index idx, uint32_t ref_count);
@@ -41,16 +41,18 @@ EnumStoreT<const char*>::load_unique_value(const void* src,
 }
 
 std::unique_ptr<vespalib::datastore::IUniqueStoreDictionary>
-make_enum_store_dictionary(IEnumStore &store, bool has_postings, std::unique_ptr<vespalib::datastore::EntryComparator> folded_compare)
+make_enum_store_dictionary(IEnumStore &store, bool has_postings,
+                           std::unique_ptr<vespalib::datastore::EntryComparator> hash_compare,
+                           std::unique_ptr<vespalib::datastore::EntryComparator> folded_compare)
 {
     if (has_postings) {
         if (folded_compare) {
-            return std::make_unique<EnumStoreFoldedDictionary>(store, std::move(folded_compare));
+            return std::make_unique<EnumStoreFoldedDictionary>(store, std::move(hash_compare), std::move(folded_compare));
         } else {
-            return std::make_unique<EnumStoreDictionary<EnumPostingTree>>(store);
+            return std::make_unique<EnumStoreDictionary<EnumPostingTree>>(store, std::move(hash_compare));
         }
     } else {
-        return std::make_unique<EnumStoreDictionary<EnumTree>>(store);
+        return std::make_unique<EnumStoreDictionary<EnumTree>>(store, std::move(hash_compare));
     }
 }
 
@@ -91,6 +91,21 @@ bool FloatingPointAttribute::apply(DocId doc, const ArithmeticValueUpdate & op)
     return retval;
 }
 
+void FloatingPointAttribute::applyInPlace(DocId doc, const ArithmeticValueUpdate & op)
+{
+    ChangeBase::Type type = getArithmeticChangeType(op);
+    if (type != ChangeBase::NOOP) {
+        Change change(type, doc, NumericChangeData<double>(0), 0);
+        change._arithOperand = op.getOperand();
+        onApplyInPlace(change);
+    }
+}
+
+void FloatingPointAttribute::onApplyInPlace(const Change &)
+{
+    abort(); // Only called when supportsInPlaceWrites() returns true
+}
+
 const char *
 FloatingPointAttribute::getString(DocId doc, char * s, size_t sz) const {
     double v = getFloat(doc);
@@ -30,6 +30,18 @@ public:
     bool applyWeight(DocId doc, const FieldValue & fv, const ArithmeticValueUpdate & wAdjust) override;
     bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust) override;
     uint32_t clearDoc(DocId doc) override;
+
+    /**
+     * In place variants of update(), apply() and clearDoc() for documents
+     * below the committed doc id limit, see supportsInPlaceWrites().
+     */
+    void updateInPlace(DocId doc, double v) {
+        onApplyInPlace(Change(ChangeBase::UPDATE, doc, NumericChangeData<double>(v)));
+    }
+    void applyInPlace(DocId doc, const ArithmeticValueUpdate & op);
+    void clearDocInPlace(DocId doc) {
+        onApplyInPlace(Change(ChangeBase::CLEARDOC, doc, NumericChangeData<double>(0)));
+    }
 protected:
     const char * getString(DocId doc, char * s, size_t sz) const override;
     FloatingPointAttribute(const vespalib::string & name, const Config & c);
@@ -37,6 +49,8 @@ protected:
     using ChangeVector = ChangeVectorT<Change>;
     ChangeVector _changes;
 
+    virtual void onApplyInPlace(const Change &change);
+
     virtual vespalib::MemoryUsage getChangeVectorMemoryUsage() const override;
 private:
     uint32_t get(DocId doc, vespalib::string * v, uint32_t sz) const override;
@@ -75,8 +75,8 @@ public:
         return enumstore::EnumeratedLoader(*this);
     }
 
-    enumstore::EnumeratedPostingsLoader make_enumerated_postings_loader() {
-        return enumstore::EnumeratedPostingsLoader(*this);
+    enumstore::EnumeratedPostingsLoader make_enumerated_postings_loader(vespalib::Executor* executor) {
+        return enumstore::EnumeratedPostingsLoader(*this, executor);
     }
 
     virtual std::unique_ptr<Enumerator> make_enumerator() const = 0;
@@ -95,6 +95,21 @@ bool IntegerAttribute::apply(DocId doc, const ArithmeticValueUpdate & op)
     return retval;
 }
 
+void IntegerAttribute::applyInPlace(DocId doc, const ArithmeticValueUpdate & op)
+{
+    ChangeBase::Type type = getArithmeticChangeType(op);
+    if (type != ChangeBase::NOOP) {
+        Change change(type, doc, NumericChangeData<largeint_t>(0), 0);
+        change._arithOperand = op.getOperand();
+        onApplyInPlace(change);
+    }
+}
+
+void IntegerAttribute::onApplyInPlace(const Change &)
+{
+    abort(); // Only called when supportsInPlaceWrites() returns true
+}
+
 vespalib::MemoryUsage
 IntegerAttribute::getChangeVectorMemoryUsage() const
 {
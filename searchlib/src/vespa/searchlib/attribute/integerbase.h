@@ -30,12 +30,26 @@ public:
     bool applyWeight(DocId doc, const FieldValue & fv, const ArithmeticValueUpdate & wAdjust) override;
     bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust) override;
     uint32_t clearDoc(DocId doc) override;
+
+    /**
+     * In place variants of update(), apply() and clearDoc() for documents
+     * below the committed doc id limit, see supportsInPlaceWrites().
+     */
+    void updateInPlace(DocId doc, largeint_t v) {
+        onApplyInPlace(Change(ChangeBase::UPDATE, doc, NumericChangeData<largeint_t>(v)));
+    }
+    void applyInPlace(DocId doc, const ArithmeticValueUpdate & op);
+    void clearDocInPlace(DocId doc) {
+        onApplyInPlace(Change(ChangeBase::CLEARDOC, doc, NumericChangeData<largeint_t>(0)));
+    }
 protected:
     IntegerAttribute(const vespalib::string & name, const Config & c);
     using Change = ChangeTemplate<NumericChangeData<largeint_t>>;
     using ChangeVector = ChangeVectorT<Change>;
     ChangeVector _changes;
 
+    virtual void onApplyInPlace(const Change &change);
+
     vespalib::MemoryUsage getChangeVectorMemoryUsage() const override;
 private:
     const char * getString(DocId doc, char * s, size_t sz) const override;
@@ -80,6 +80,13 @@ LoadUtils::loadUDAT(const AttributeVector& attr)
     return loadFile(attr, "udat");
 }
 
+vespalib::alloc::Alloc
+LoadUtils::mapDAT(const AttributeVector& attr, size_t offset, size_t size)
+{
+    vespalib::string fileName = attr.getBaseFileName() + ".dat";
+    return vespalib::alloc::Alloc::allocMMapFile(fileName.c_str(), offset, size);
+}
+
 
 #define INSTANTIATE_ARRAY(ValueType, Saver) \
 template uint32_t loadFromEnumeratedMultiValue(MultiValueMapping<Value<ValueType>> &, ReaderBase &, vespalib::ConstArrayRef<ValueType>, Saver)
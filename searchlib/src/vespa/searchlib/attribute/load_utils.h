@@ -4,6 +4,7 @@
 
 #include "attributevector.h"
 #include "readerbase.h"
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/arrayref.h>
 
 namespace search::attribute {
@@ -31,6 +32,13 @@ public:
     static LoadedBufferUP loadIDX(const AttributeVector& attr);
     static LoadedBufferUP loadWeight(const AttributeVector& attr);
     static LoadedBufferUP loadUDAT(const AttributeVector& attr);
+
+    /**
+     * Memory maps size bytes of the data file, starting at offset, as a
+     * private copy-on-write mapping. Returns an empty allocation if the
+     * file could not be mapped, and the caller should then read the file.
+     */
+    static vespalib::alloc::Alloc mapDAT(const AttributeVector& attr, size_t offset, size_t size);
 };
 
 /**
@@ -2,21 +2,96 @@
 
 #include "loadedenumvalue.h"
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+constexpr size_t parallel_sort_chunks = 8;
+
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+radix_sort_by_enum(LoadedEnumAttribute *begin, size_t size)
 {
     ShiftBasedRadixSorter<LoadedEnumAttribute,
         LoadedEnumAttribute::EnumRadix,
         LoadedEnumAttribute::EnumCompare, 56>::
         radix_sort(LoadedEnumAttribute::EnumRadix(),
                    LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+                   begin, size, 16);
+}
+
+/*
+ * Runs the given tasks using the executor and waits for all of them to
+ * complete. Tasks rejected by the executor are run by the calling thread.
+ */
+template <typename Func>
+void
+run_and_wait(vespalib::Executor &executor, std::vector<Func> &tasks)
+{
+    vespalib::CountDownLatch latch(tasks.size());
+    for (auto &task : tasks) {
+        auto rejected = executor.execute(vespalib::makeLambdaTask([&task, &latch]() { task(); latch.countDown(); }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+}
+
+}
+
+void
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor, size_t min_parallel_sort_size)
+{
+    size_t size = loaded.size();
+    if (executor == nullptr || size < std::max(min_parallel_sort_size, parallel_sort_chunks)) {
+        if (size > 0) {
+            radix_sort_by_enum(&loaded[0], size);
+        }
+        return;
+    }
+    // Sort chunks in parallel, then merge pairs of adjacent sorted ranges level by level.
+    LoadedEnumAttribute *base = &loaded[0];
+    std::vector<size_t> bounds;
+    for (size_t chunk = 0; chunk < parallel_sort_chunks; ++chunk) {
+        bounds.push_back(size * chunk / parallel_sort_chunks);
+    }
+    bounds.push_back(size);
+    std::vector<std::function<void()>> tasks;
+    for (size_t chunk = 0; chunk + 1 < bounds.size(); ++chunk) {
+        size_t begin = bounds[chunk];
+        size_t end = bounds[chunk + 1];
+        tasks.emplace_back([base, begin, end]() { radix_sort_by_enum(base + begin, end - begin); });
+    }
+    run_and_wait(*executor, tasks);
+    while (bounds.size() > 2) {
+        tasks.clear();
+        std::vector<size_t> merged_bounds;
+        size_t i = 0;
+        for (; i + 2 < bounds.size(); i += 2) {
+            size_t begin = bounds[i];
+            size_t middle = bounds[i + 1];
+            size_t end = bounds[i + 2];
+            tasks.emplace_back([base, begin, middle, end]() {
+                std::inplace_merge(base + begin, base + middle, base + end, LoadedEnumAttribute::EnumCompare());
+            });
+            merged_bounds.push_back(begin);
+        }
+        if (i + 1 < bounds.size()) {
+            merged_bounds.push_back(bounds[i]);
+        }
+        merged_bounds.push_back(size);
+        run_and_wait(*executor, tasks);
+        bounds.swap(merged_bounds);
+    }
 }
 
 } // namespace attribute
 } // namespace search
-
@@ -8,6 +8,8 @@
 #include <cassert>
 #include <limits>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -144,8 +146,17 @@ public:
     }
 };
 
+// Below this size the loaded enum values are sorted by the calling thread.
+constexpr size_t default_min_parallel_sort_size = 1000000;
+
+/**
+ * Sorts the loaded enum values by enum and document id. Vectors with at least
+ * min_parallel_sort_size entries are sorted in chunks that are merged
+ * afterwards, using the executor if given.
+ */
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor,
+                 size_t min_parallel_sort_size = default_min_parallel_sort_size);
 
 } // namespace attribute
 
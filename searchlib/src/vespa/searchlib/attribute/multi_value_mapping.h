@@ -23,6 +23,9 @@ private:
     using ConstArrayRef = vespalib::ConstArrayRef<EntryT>;
 
     ArrayStore _store;
+    // Must be destroyed before _store, finishes compaction of the selected buffers
+    vespalib::datastore::ICompactionContext::UP _compactionContext;
+    uint32_t _compactNextLid;
 public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
@@ -45,6 +48,9 @@ public:
     void doneLoadFromMultiValue() { _store.setInitializing(false); }
 
     void compactWorst(bool compactMemory, bool compactAddressSpace) override;
+    void startCompactWorst(bool compactMemory, bool compactAddressSpace) override;
+    bool compactStep(uint32_t maxLids) override;
+    bool isCompacting() const override { return static_cast<bool>(_compactionContext); }
 
     vespalib::AddressSpace getAddressSpaceUsage() const override;
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
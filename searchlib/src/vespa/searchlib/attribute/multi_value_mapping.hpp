@@ -19,7 +19,9 @@ MultiValueMapping<EntryT,RefT>::MultiValueMapping(const vespalib::datastore::Arr
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
-      _store(storeCfg)
+      _store(storeCfg),
+      _compactionContext(),
+      _compactNextLid(0)
 {
 }
 
@@ -55,12 +57,47 @@ template <typename EntryT, typename RefT>
 void
 MultiValueMapping<EntryT,RefT>::compactWorst(bool compactMemory, bool compactAddressSpace)
 {
+    if (isCompacting()) {
+        compactStep(_indices.size());
+    }
     vespalib::datastore::ICompactionContext::UP compactionContext(_store.compactWorst(compactMemory, compactAddressSpace));
     if (compactionContext) {
         compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[0], _indices.size()));
     }
 }
 
+template <typename EntryT, typename RefT>
+void
+MultiValueMapping<EntryT,RefT>::startCompactWorst(bool compactMemory, bool compactAddressSpace)
+{
+    assert(!isCompacting());
+    _compactionContext = _store.compactWorst(compactMemory, compactAddressSpace);
+    _compactNextLid = 0;
+}
+
+template <typename EntryT, typename RefT>
+bool
+MultiValueMapping<EntryT,RefT>::compactStep(uint32_t maxLids)
+{
+    if (!isCompacting()) {
+        return true;
+    }
+    // New values are never added to the buffers being compacted, thus
+    // documents already visited cannot refer to them again.
+    uint32_t lidLimit = _indices.size();
+    if (_compactNextLid < lidLimit) {
+        uint32_t lids = (maxLids != 0) ? std::min(maxLids, lidLimit - _compactNextLid) : (lidLimit - _compactNextLid);
+        _compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[_compactNextLid], lids));
+        _compactNextLid += lids;
+    }
+    if (_compactNextLid < lidLimit) {
+        return false;
+    }
+    _compactionContext.reset();
+    _compactNextLid = 0;
+    return true;
+}
+
 template <typename EntryT, typename RefT>
 vespalib::MemoryUsage
 MultiValueMapping<EntryT,RefT>::getArrayStoreMemoryUsage() const
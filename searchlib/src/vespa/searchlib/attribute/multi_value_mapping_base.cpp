@@ -84,6 +84,10 @@ MultiValueMappingBase::updateStat()
 bool
 MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrategy)
 {
+    if (isCompacting()) {
+        compactStep(compactionStrategy.getMaxCompactLidsPerCommit());
+        return true;
+    }
     size_t usedBytes = _cachedArrayStoreMemoryUsage.usedBytes();
     size_t deadBytes = _cachedArrayStoreMemoryUsage.deadBytes();
     size_t usedArrays = _cachedArrayStoreAddressSpaceUsage.used();
@@ -93,7 +97,12 @@ MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrat
     bool compactAddressSpace = ((deadArrays >= DEAD_ARRAYS_SLACK) &&
                                 (usedArrays * compactionStrategy.getMaxDeadAddressSpaceRatio() < deadArrays));
     if (compactMemory || compactAddressSpace) {
-        compactWorst(compactMemory, compactAddressSpace);
+        if (compactionStrategy.incrementalCompaction()) {
+            startCompactWorst(compactMemory, compactAddressSpace);
+            compactStep(compactionStrategy.getMaxCompactLidsPerCommit());
+        } else {
+            compactWorst(compactMemory, compactAddressSpace);
+        }
         return true;
     }
     return false;
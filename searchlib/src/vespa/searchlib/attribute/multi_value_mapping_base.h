@@ -52,6 +52,17 @@ public:
     uint32_t getNumKeys() const { return _indices.size(); }
     uint32_t getCapacityKeys() const { return _indices.capacity(); }
     virtual void compactWorst(bool compatMemory, bool compactAddressSpace) = 0;
+
+    /*
+     * Incremental compaction. The worst buffers are selected by
+     * startCompactWorst() and entries referenced by at most maxLids
+     * documents (all when 0) are moved by each call to compactStep(). The selected
+     * buffers are put on hold when all documents have been visited,
+     * i.e. when compactStep() returns true.
+     */
+    virtual void startCompactWorst(bool compactMemory, bool compactAddressSpace) = 0;
+    virtual bool compactStep(uint32_t maxLids) = 0;
+    virtual bool isCompacting() const = 0;
     bool considerCompact(const CompactionStrategy &compactionStrategy);
 };
 
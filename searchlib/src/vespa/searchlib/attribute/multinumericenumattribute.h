@@ -154,9 +154,9 @@ protected:
 public:
     MultiValueNumericEnumAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & cfg);
 
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
-    bool onLoadEnumerated(ReaderBase &attrReader);
+    bool onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor);
 
     AttributeVector::SearchContext::UP
     getSearch(QueryTermSimpleUP term, const attribute::SearchContextParams & params) const override;
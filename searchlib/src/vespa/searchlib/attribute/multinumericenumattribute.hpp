@@ -51,7 +51,7 @@ MultiValueNumericEnumAttribute<B, M>::loadAllAtOnce(AttributeReader & attrReader
 
 template <typename B, typename M>
 bool
-MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
+MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -66,7 +66,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
     this->_mvMapping.reserve(numDocs);
 
     if (this->hasPostings()) {
-        auto loader = this->getEnumStore().make_enumerated_postings_loader();
+        auto loader = this->getEnumStore().make_enumerated_postings_loader(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         this->load_enumerated_data(attrReader, loader, numValues);
         if (numDocs > 0) {
@@ -84,7 +84,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoadEnumerated(ReaderBase &attrReader)
 
 template <typename B, typename M>
 bool
-MultiValueNumericEnumAttribute<B, M>::onLoad()
+MultiValueNumericEnumAttribute<B, M>::onLoad(vespalib::Executor *executor)
 {
     AttributeReader attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -96,7 +96,7 @@ MultiValueNumericEnumAttribute<B, M>::onLoad()
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
     if (attrReader.getEnumerated()) {
-        return onLoadEnumerated(attrReader);
+        return onLoadEnumerated(attrReader, executor);
     }
     
     size_t numDocs = attrReader.getNumIdx() - 1;
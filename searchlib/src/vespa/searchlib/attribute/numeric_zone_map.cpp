@@ -0,0 +1,58 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numeric_zone_map.h"
+#include <vespa/vespalib/util/rcuvector.hpp>
+
+namespace search::attribute {
+
+template <typename T>
+NumericZoneMap<T>::NumericZoneMap(vespalib::GenerationHolder &genHolder)
+    : _zones(16, 100, 0, genHolder)
+{
+}
+
+template <typename T>
+NumericZoneMap<T>::~NumericZoneMap() = default;
+
+template <typename T>
+void
+NumericZoneMap<T>::rebuild(const vespalib::RcuVectorBase<T> &values)
+{
+    uint32_t lid_limit = values.size();
+    _zones.reset();
+    _zones.unsafe_reserve(num_blocks(lid_limit));
+    for (uint32_t lid = 0; lid < lid_limit; ++lid) {
+        add_doc(lid, values[lid]);
+    }
+}
+
+template <typename T>
+void
+NumericZoneMap<T>::shrink(uint32_t lid_limit)
+{
+    _zones.shrink(num_blocks(lid_limit));
+}
+
+}
+
+namespace vespalib {
+
+template class RcuVectorBase<search::attribute::NumericZoneMap<int8_t>::Zone>;
+template class RcuVectorBase<search::attribute::NumericZoneMap<int16_t>::Zone>;
+template class RcuVectorBase<search::attribute::NumericZoneMap<int32_t>::Zone>;
+template class RcuVectorBase<search::attribute::NumericZoneMap<int64_t>::Zone>;
+template class RcuVectorBase<search::attribute::NumericZoneMap<float>::Zone>;
+template class RcuVectorBase<search::attribute::NumericZoneMap<double>::Zone>;
+
+}
+
+namespace search::attribute {
+
+template class NumericZoneMap<int8_t>;
+template class NumericZoneMap<int16_t>;
+template class NumericZoneMap<int32_t>;
+template class NumericZoneMap<int64_t>;
+template class NumericZoneMap<float>;
+template class NumericZoneMap<double>;
+
+}
@@ -0,0 +1,85 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcommon/common/undefinedvalues.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <limits>
+
+namespace search::attribute {
+
+/**
+ * Min and max value for each block of 4096 documents in a single value
+ * numeric attribute, used by range searches to skip blocks without
+ * matching values.
+ *
+ * Zones are only widened when values are updated, thus they are a
+ * superset of the values present in the block until rebuilt (e.g. on
+ * load). The writer must widen the zone before writing the new value.
+ * Undefined values are not tracked, searches that can match the
+ * undefined value cannot use the zones.
+ */
+template <typename T>
+class NumericZoneMap
+{
+public:
+    static constexpr uint32_t block_size_log2 = 12;
+    static constexpr uint32_t block_size = 1u << block_size_log2;
+
+    class Zone {
+        T _min;
+        T _max;
+    public:
+        Zone()
+            : _min(std::numeric_limits<T>::max()),
+              _max(std::numeric_limits<T>::lowest())
+        {
+        }
+        void widen(T value) {
+            // NaN values are ignored by the comparisons
+            if (value < _min) {
+                _min = value;
+            }
+            if (_max < value) {
+                _max = value;
+            }
+        }
+        T get_min() const { return _min; }
+        T get_max() const { return _max; }
+    };
+
+private:
+    vespalib::RcuVectorBase<Zone> _zones;
+
+public:
+    NumericZoneMap(vespalib::GenerationHolder &genHolder);
+    ~NumericZoneMap();
+
+    static uint32_t num_blocks(uint32_t lid_limit) { return (lid_limit + block_size - 1) >> block_size_log2; }
+
+    /*
+     * Returns true if adding the given document will expand the
+     * underlying vector.
+     */
+    bool is_full_for(uint32_t lid) const {
+        return (lid & (block_size - 1)) == 0 && _zones.isFull();
+    }
+    void add_doc(uint32_t lid, T value) {
+        if ((lid >> block_size_log2) >= _zones.size()) {
+            _zones.push_back(Zone());
+        }
+        update(lid, value);
+    }
+    void update(uint32_t lid, T value) {
+        if (!isUndefined(value)) {
+            _zones[lid >> block_size_log2].widen(value);
+        }
+    }
+    void rebuild(const vespalib::RcuVectorBase<T> &values);
+    void shrink(uint32_t lid_limit);
+    const Zone *get_zones() const { return &_zones[0]; }
+    uint32_t size() const { return _zones.size(); }
+    vespalib::MemoryUsage getMemoryUsage() const { return _zones.getMemoryUsage(); }
+};
+
+}
@@ -277,6 +277,7 @@ handle_load_posting_lists(LoadedVector& loaded)
                 loaded.write(similarValues[i]);
             }
         }
+        _postingList.scheduleCompression();
     }
 }
 
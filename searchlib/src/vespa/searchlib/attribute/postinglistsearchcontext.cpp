@@ -30,6 +30,7 @@ PostingListSearchContext(const Dictionary &dictionary,
       _useBitVector(useBitVector),
       _pidx(),
       _frozenRoot(),
+      _compressed(nullptr),
       _FSTC(0.0),
       _PLSTC(0.0),
       _esb(esb),
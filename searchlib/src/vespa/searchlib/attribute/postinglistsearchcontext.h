@@ -40,6 +40,7 @@ protected:
     bool                    _useBitVector;
     vespalib::datastore::EntryRef     _pidx;
     vespalib::datastore::EntryRef     _frozenRoot; // Posting list in tree form
+    const CompressedPostingList *_compressed; // Posting list in compressed form
     float _FSTC;  // Filtering Search Time Constant
     float _PLSTC; // Posting List Search Time Constant
     const IEnumStore       &_esb;
@@ -59,6 +59,8 @@ PostingListSearchContextT<DataT>::lookupSingle()
                     _gbv = bv; 
                 }
             }
+        } else if (_postingList.isCompressed(typeId)) {
+            _compressed = _postingList.getCompressedPostingList(_pidx);
         } else {
             auto frozenView = _postingList.getTreeEntry(_pidx)->getFrozenView(_postingList.getAllocator());
             _frozenRoot = frozenView.getRoot();
@@ -181,6 +183,14 @@ createPostingIterator(fef::TermFieldMatchData *matchData, bool strict)
             return std::make_unique<EmptySearch>();
         }
         const PostingList &postingList = _postingList;
+        if (_compressed != nullptr) {
+            using DocIt = CompressedDocIdIterator;
+            if (postingList._isFilter) {
+                return std::make_unique<FilterAttributePostingListIteratorT<DocIt>>(_baseSearchCtx, matchData, *_compressed);
+            } else {
+                return std::make_unique<AttributePostingListIteratorT<DocIt>>(_baseSearchCtx, _hasWeight, matchData, *_compressed);
+            }
+        }
         if (!_frozenRoot.valid()) {
             uint32_t clusterSize = _postingList.getClusterSize(_pidx);
             assert(clusterSize != 0);
@@ -219,6 +229,9 @@ PostingListSearchContextT<DataT>::singleHits() const
     if (!_pidx.valid()) {
         return 0u;
     }
+    if (_compressed != nullptr) {
+        return _compressed->size();
+    }
     if (!_frozenRoot.valid()) {
         return _postingList.getClusterSize(_pidx);
     }
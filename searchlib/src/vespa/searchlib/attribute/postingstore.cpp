@@ -23,6 +23,7 @@ PostingStoreBase2::PostingStoreBase2(EnumPostingTree &dict, Status &status, cons
 #endif
       _enableOnlyBitVector(config.getEnableOnlyBitVector()),
       _isFilter(config.getIsFilter()),
+      _enableCompressedPostingLists(config.getEnableCompressedPostingLists()),
       _bvSize(64u),
       _bvCapacity(128u),
       _minBvDocFreq(64),
@@ -30,7 +31,10 @@ PostingStoreBase2::PostingStoreBase2(EnumPostingTree &dict, Status &status, cons
       _bvs(),
       _dict(dict),
       _status(status),
-      _bvExtraBytes(0)
+      _bvExtraBytes(0),
+      _modifiedTrees(),
+      _commitsSinceCompression(0),
+      _compressedBytes(0)
 {
 }
 
@@ -60,15 +64,29 @@ PostingStoreBase2::resizeBitVectors(uint32_t newSize, uint32_t newCapacity)
 }
 
 
+void
+PostingStoreBase2::scheduleCompression()
+{
+    _modifiedTrees.clear();
+    _commitsSinceCompression = COMPRESSION_INTERVAL - 1;
+}
+
+
 template <typename DataT>
 PostingStore<DataT>::PostingStore(EnumPostingTree &dict, Status &status,
                                   const Config &config)
     : Parent(false),
       PostingStoreBase2(dict, status, config),
-      _bvType(1, 1024u, RefType::offsetSize())
+      _bvType(1, 1024u, RefType::offsetSize()),
+      _compressedType(1, 1u, RefType::offsetSize())
 {
+    if (!std::is_same_v<DataT, BTreeNoLeafData>) {
+        // Compressed posting lists have no weight information
+        _enableCompressedPostingLists = false;
+    }
     // TODO: Add type for bitvector
     _store.addType(&_bvType);
+    _store.addType(&_compressedType);
     _store.initActiveBuffers();
     _store.enableFreeLists();
 }
@@ -279,6 +297,76 @@ PostingStore<DataT>::makeBitVector(EntryRef &ref)
 }
 
     
+template <typename DataT>
+void
+PostingStore<DataT>::dropCompressed(EntryRef &ref)
+{
+    assert(ref.valid());
+    RefType iRef(ref);
+    assert(isCompressed(getTypeId(iRef)));
+    const CompressedPostingList *list = getCompressedPostingList(iRef);
+    BTreeTypeRefPair tPair(allocBTree());
+    BTreeType *tree = tPair.data;
+    Builder &builder = _builder;
+    builder.reuse();
+    list->foreach_key([&builder](uint32_t docId) { builder.insert(docId, bitVectorWeight()); });
+    tree->assign(builder, _allocator);
+    assert(tree->size(_allocator) == list->size());
+    _compressedBytes -= list->memory_usage();
+    _store.holdElem(iRef, 1);
+    ref = tPair.ref;
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::makeCompressed(EntryRef &ref)
+{
+    assert(ref.valid());
+    RefType iRef(ref);
+    assert(isBTree(iRef));
+    BTreeType *tree = getWTreeEntry(iRef);
+    std::vector<uint32_t> docIds;
+    docIds.reserve(tree->size(_allocator));
+    _allocator.getNodeStore().foreach_key(tree->getRoot(), [&docIds](uint32_t docId) { docIds.push_back(docId); });
+    auto list = std::make_shared<const CompressedPostingList>(docIds);
+    CompressedRefPair cPair(allocCompressed());
+    _compressedBytes += list->memory_usage();
+    cPair.data->_list = std::move(list);
+    tree->clear(_allocator);
+    _store.holdElem(ref, 1);
+    // barrier ?
+    ref = cPair.ref;
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::compress_unmodified_posting_lists()
+{
+    if (!_enableCompressedPostingLists || ++_commitsSinceCompression < COMPRESSION_INTERVAL) {
+        return;
+    }
+    _commitsSinceCompression = 0;
+    typedef EnumPostingTree::Iterator EnumIterator;
+    for (EnumIterator dictItr = _dict.begin(); dictItr.valid(); ++dictItr) {
+        EntryRef ref(dictItr.getData());
+        if (!ref.valid() || !isBTree(RefType(ref)) || _modifiedTrees.find(ref.ref()) != _modifiedTrees.end()) {
+            continue;
+        }
+        const BTreeType *tree = getTreeEntry(ref);
+        if (tree->size(_allocator) < MIN_COMPRESSED_DOC_FREQ || tree->begin(_allocator).getKey() == 0) {
+            // Document id 0 is reserved and cannot be encoded.
+            continue;
+        }
+        makeCompressed(ref);
+        _dict.thaw(dictItr);
+        dictItr.writeData(ref.ref());
+    }
+    _modifiedTrees.clear();
+}
+
+    
 template <typename DataT>
 void
 PostingStore<DataT>::applyNewBitVector(EntryRef &ref,
@@ -356,16 +444,24 @@ PostingStore<DataT>::apply(EntryRef &ref,
     if (!ref.valid()) {
         // No old data
         applyNew(ref, a, ae);
+        noteModifiedTree(ref);
         return;
     }
     RefType iRef(ref);
     bool wasArray = false;
     uint32_t typeId = getTypeId(iRef);
+    if (isCompressed(typeId)) {
+        dropCompressed(ref);
+        iRef = ref;
+        typeId = getTypeId(iRef);
+    }
     uint32_t clusterSize = getClusterSize(typeId);
     if (clusterSize != 0) {
         wasArray = true;
-        if (applyCluster(ref, clusterSize, a, ae, r, re, CompareT()))
+        if (applyCluster(ref, clusterSize, a, ae, r, re, CompareT())) {
+            noteModifiedTree(ref);
             return;
+        }
         iRef = ref;
         typeId = getTypeId(iRef);
     }
@@ -408,6 +504,7 @@ PostingStore<DataT>::apply(EntryRef &ref,
         }
         normalizeTree(ref, tree, wasArray);
     }
+    noteModifiedTree(ref);
 }
 
 
@@ -426,6 +523,8 @@ PostingStore<DataT>::internalSize(uint32_t typeId, const RefType & iRef) const
             const BitVector *bv = bve->_bv.get();
             return bv->countTrueBits();
         }
+    } else if (isCompressed(typeId)) {
+        return getCompressedPostingList(iRef)->size();
     } else {
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->size(_allocator);
@@ -448,6 +547,8 @@ PostingStore<DataT>::internalFrozenSize(uint32_t typeId, const RefType & iRef) c
             // Some inaccuracy is expected, data changes underfeet
             return bve->_bv->countTrueBits();
         }
+    } else if (isCompressed(typeId)) {
+        return getCompressedPostingList(iRef)->size();
     } else {
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->frozenSize(_allocator);
@@ -475,6 +576,7 @@ PostingStore<DataT>::begin(const EntryRef ref) const
             }
             return Iterator();
         }
+        assert(!isCompressed(typeId));
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->begin(_allocator);
     }
@@ -503,6 +605,7 @@ PostingStore<DataT>::beginFrozen(const EntryRef ref) const
             }
             return ConstIterator();
         }
+        assert(!isCompressed(typeId));
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->getFrozenView(_allocator).begin();
     }
@@ -536,6 +639,7 @@ PostingStore<DataT>::beginFrozen(const EntryRef ref,
             where.emplace_back();
             return;
         }
+        assert(!isCompressed(typeId));
         const BTreeType *tree = getTreeEntry(iRef);
         tree->getFrozenView(_allocator).begin(where);
         return;
@@ -565,6 +669,9 @@ PostingStore<DataT>::getAggregated(const EntryRef ref) const
             }
             return AggregatedType();
         }
+        if (isCompressed(typeId)) {
+            return AggregatedType();
+        }
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->getAggregated(_allocator);
     }
@@ -600,9 +707,13 @@ PostingStore<DataT>::clear(const EntryRef ref)
             _status.decBitVectors();
             _bvExtraBytes -= bve->_bv->extraByteSize();
             _store.holdElem(ref, 1);
+        } else if (isCompressed(typeId)) {
+            _compressedBytes -= getCompressedPostingList(iRef)->memory_usage();
+            _store.holdElem(ref, 1);
         } else {
             BTreeType *tree = getWTreeEntry(iRef);
             tree->clear(_allocator);
+            _modifiedTrees.erase(ref.ref());
             _store.holdElem(ref, 1);
         }
     } else {
@@ -621,6 +732,9 @@ PostingStore<DataT>::getMemoryUsage() const
     uint64_t bvExtraBytes = _bvExtraBytes;
     usage.incUsedBytes(bvExtraBytes);
     usage.incAllocatedBytes(bvExtraBytes);
+    uint64_t compressedBytes = _compressedBytes;
+    usage.incUsedBytes(compressedBytes);
+    usage.incAllocatedBytes(compressedBytes);
     return usage;
 }
 
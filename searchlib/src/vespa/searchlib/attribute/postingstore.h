@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "compressed_posting_list.h"
 #include "enum_store_dictionary.h"
 #include "postinglisttraits.h"
 #include <set>
@@ -29,6 +30,17 @@ public:
     { }
 };
 
+class CompressedPostingEntry
+{
+public:
+    std::shared_ptr<const CompressedPostingList> _list;
+
+public:
+    CompressedPostingEntry()
+        : _list()
+    { }
+};
+
 
 class PostingStoreBase2
 {
@@ -36,6 +48,7 @@ public:
     bool _enableBitVectors;
     bool _enableOnlyBitVector;
     bool _isFilter;
+    bool _enableCompressedPostingLists;
 protected:
     uint32_t _bvSize;
     uint32_t _bvCapacity;
@@ -47,14 +60,26 @@ protected:
     EnumPostingTree   &_dict;
     Status            &_status;
     uint64_t           _bvExtraBytes;
+    std::set<uint32_t> _modifiedTrees; // Trees modified since last compression pass
+    uint32_t           _commitsSinceCompression;
+    uint64_t           _compressedBytes;
 
     static constexpr uint32_t BUFFERTYPE_BITVECTOR = 9u;
+    static constexpr uint32_t BUFFERTYPE_COMPRESSED = 10u;
+    // Number of dictionary freezes between each pass converting unmodified trees to compressed posting lists.
+    static constexpr uint32_t COMPRESSION_INTERVAL = 256u;
+    static constexpr uint32_t MIN_COMPRESSED_DOC_FREQ = CompressedPostingList::block_size;
 
 public:
     PostingStoreBase2(EnumPostingTree &dict, Status &status, const Config &config);
     virtual ~PostingStoreBase2();
     bool resizeBitVectors(uint32_t newSize, uint32_t newCapacity);
     virtual bool removeSparseBitVectors() = 0;
+    /*
+     * Forget modifications to posting lists (e.g. after load) and
+     * perform a compression pass on the next commit.
+     */
+    void scheduleCompression();
 };
 
 template <typename DataT>
@@ -62,6 +87,7 @@ class PostingStore : public PostingListTraits<DataT>::PostingStoreBase,
     public PostingStoreBase2
 {
     vespalib::datastore::BufferType<BitVectorEntry> _bvType;
+    vespalib::datastore::BufferType<CompressedPostingEntry> _compressedType;
 public:
     typedef DataT DataType;
     typedef typename PostingListTraits<DataT>::PostingStoreBase Parent;
@@ -95,7 +121,8 @@ public:
     using Parent::_aggrCalc;
     using Parent::BUFFERTYPE_BTREE;
     typedef vespalib::datastore::Handle<BitVectorEntry> BitVectorRefPair;
-    
+    typedef vespalib::datastore::Handle<CompressedPostingEntry> CompressedRefPair;
+
 
     PostingStore(EnumPostingTree &dict, Status &status, const Config &config);
     ~PostingStore();
@@ -103,6 +130,7 @@ public:
     bool removeSparseBitVectors() override;
     static bool isBitVector(uint32_t typeId) { return typeId == BUFFERTYPE_BITVECTOR; }
     static bool isBTree(uint32_t typeId) { return typeId == BUFFERTYPE_BTREE; }
+    static bool isCompressed(uint32_t typeId) { return typeId == BUFFERTYPE_COMPRESSED; }
     bool isBTree(RefType ref) const { return isBTree(getTypeId(ref)); }
 
     void applyNew(EntryRef &ref, AddIter a, AddIter ae);
@@ -119,6 +147,26 @@ public:
     void dropBitVector(EntryRef &ref);
     void makeBitVector(EntryRef &ref);
 
+    CompressedRefPair allocCompressed() {
+        return _store.template freeListAllocator<CompressedPostingEntry,
+            vespalib::btree::DefaultReclaimer<CompressedPostingEntry> >(BUFFERTYPE_COMPRESSED).alloc();
+    }
+
+    /*
+     * Recreate btree from compressed posting list before it is modified.
+     */
+    void dropCompressed(EntryRef &ref);
+    void makeCompressed(EntryRef &ref);
+
+    /*
+     * Convert btree posting lists that have not been modified since the
+     * previous pass to compressed posting lists. A pass is performed every
+     * COMPRESSION_INTERVAL calls. Only posting lists without weight
+     * information are compressed. Called by the writer thread before the
+     * dictionary is frozen.
+     */
+    void compress_unmodified_posting_lists();
+
     void applyNewBitVector(EntryRef &ref, AddIter aOrg, AddIter ae);
     void apply(BitVector &bv, AddIter a, AddIter ae, RemoveIter r, RemoveIter re);
 
@@ -174,10 +222,19 @@ public:
         return _store.template getEntry<BitVectorEntry>(ref);
     }
 
+    const CompressedPostingList *getCompressedPostingList(RefType ref) const {
+        return _store.template getEntry<CompressedPostingEntry>(ref)->_list.get();
+    }
+
     static inline DataT bitVectorWeight();
     vespalib::MemoryUsage getMemoryUsage() const;
 
 private:
+    void noteModifiedTree(EntryRef ref) {
+        if (_enableCompressedPostingLists && ref.valid() && isBTree(RefType(ref))) {
+            _modifiedTrees.insert(ref.ref());
+        }
+    }
     size_t internalSize(uint32_t typeId, const RefType & iRef) const;
     size_t internalFrozenSize(uint32_t typeId, const RefType & iRef) const;
 };
@@ -42,6 +42,7 @@ public:
     bool getHasLoadData() const { return _hasLoadData; }
     uint32_t getVersion() const { return _version; }
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    uint32_t getDatHeaderLen() const { return _datHeaderLen; }
     const vespalib::GenericHeader &getDatHeader() const {
         return _datHeader;
     }
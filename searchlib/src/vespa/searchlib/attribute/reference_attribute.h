@@ -51,7 +51,7 @@ private:
     virtual void onCommit() override;
     virtual void onUpdateStat() override;
     virtual std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
-    virtual bool onLoad() override;
+    virtual bool onLoad(vespalib::Executor *executor) override;
     virtual uint64_t getUniqueValueCount() const override;
 
     bool considerCompact(const CompactionStrategy &compactionStrategy);
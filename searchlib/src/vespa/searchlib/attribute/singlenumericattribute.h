@@ -4,6 +4,7 @@
 
 #include "integerbase.h"
 #include "floatbase.h"
+#include "numeric_zone_map.h"
 #include <vespa/vespalib/util/rcuvector.h>
 #include <limits>
 
@@ -22,10 +23,37 @@ private:
     using WeightedInt = typename B::WeightedInt;
     using generation_t = typename B::generation_t;
     using largeint_t = typename B::largeint_t;
+    using ZoneMap = attribute::NumericZoneMap<T>;
+    using Change = typename B::Change;
+    static_assert((AttributeVector::inPlaceWriteLidAlignment % ZoneMap::block_size) == 0,
+                  "threads writing in place must not share zone map blocks");
 
     using B::getGenerationHolder;
 
     DataVector _data;
+    std::unique_ptr<ZoneMap> _zoneMap; // per block min/max values, if enabled
+    bool _mapped_data; // _data uses a private mapping of the save file
+
+    void setValue(DocId doc, T v) {
+        if (_zoneMap) {
+            _zoneMap->update(doc, v);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        _data[doc] = v;
+    }
+
+    void applyChange(const Change &change) {
+        if (change._type == ChangeBase::UPDATE) {
+            std::atomic_thread_fence(std::memory_order_release);
+            setValue(change._doc, change._data);
+        } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+            std::atomic_thread_fence(std::memory_order_release);
+            setValue(change._doc, this->applyArithmetic(_data[change._doc], change));
+        } else if (change._type == ChangeBase::CLEARDOC) {
+            std::atomic_thread_fence(std::memory_order_release);
+            setValue(change._doc, this->_defaultValue._data);
+        }
+    }
 
     T getFromEnum(EnumHandle e) const override {
         (void) e;
@@ -40,6 +68,13 @@ private:
     {
     private:
         const T * _data;
+        const typename ZoneMap::Zone * _zones;
+        uint32_t _docIdLimit;
+        std::unique_ptr<BitVector> _hits; // Result of scanning blocks with matching zones
+
+        bool zoneOverlaps(uint32_t block) const {
+            return M::overlaps(_zones[block].get_min(), _zones[block].get_max());
+        }
 
         int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
             return find(docId, elemId, weight);
@@ -66,7 +101,15 @@ private:
             return this->match(v) ? 0 : -1;
         }
 
+        /*
+         * Set bits for matching documents in [begin_lid, end_lid), used
+         * by attribute iterators to evaluate many documents at a time.
+         */
+        void find_batch(uint32_t begin_lid, uint32_t end_lid, BitVector &result) const;
+
         Int64Range getAsIntegerTerm() const override;
+        unsigned int approximateHits() const override;
+        void fetchPostings(const queryeval::ExecuteInfo &execInfo) override;
 
         std::unique_ptr<queryeval::SearchIterator>
         createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
@@ -78,6 +121,9 @@ protected:
         (void) value; (void) e;
         return false;
     }
+    void onApplyInPlace(const Change &change) override {
+        applyChange(change);
+    }
 
 public:
     SingleValueNumericAttribute(const vespalib::string & baseFileName,
@@ -96,20 +142,23 @@ public:
         return 1;
     }
     void onCommit() override;
+    bool supportsInPlaceWrites() const override { return true; }
     void onAddDocs(DocId lidLimit) override;
     void onUpdateStat() override;
     void removeOldGenerations(generation_t firstUsed) override;
     void onGenerationChange(generation_t generation) override;
     bool addDoc(DocId & doc) override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
+    bool mapData(uint32_t dataOffset, size_t numDocs);
+    void release_mapped_data();
 
     AttributeVector::SearchContext::UP
     getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
 
     void set(DocId doc, T v) {
-        _data[doc] = v;
+        setValue(doc, v);
     }
 
     T getFast(DocId doc) const {
@@ -7,8 +7,11 @@
 #include "primitivereader.h"
 #include "singlenumericattribute.h"
 #include "singlenumericattributesaver.h"
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search {
 
@@ -19,8 +22,14 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
-{ }
+          getGenerationHolder()),
+    _zoneMap(),
+    _mapped_data(false)
+{
+    if (c.getEnableZoneMaps()) {
+        _zoneMap = std::make_unique<ZoneMap>(getGenerationHolder());
+    }
+}
 
 template <typename B>
 SingleValueNumericAttribute<B>::~SingleValueNumericAttribute()
@@ -38,16 +47,7 @@ SingleValueNumericAttribute<B>::onCommit()
         // apply updates
         typename B::ValueModifier valueGuard(this->getValueModifier());
         for (const auto & change : this->_changes) {
-            if (change._type == ChangeBase::UPDATE) {
-                std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = change._data;
-            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
-                std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = this->applyArithmetic(_data[change._doc], change);
-            } else if (change._type == ChangeBase::CLEARDOC) {
-                std::atomic_thread_fence(std::memory_order_release);
-                _data[change._doc] = this->_defaultValue._data;
-            }
+            applyChange(change);
         }
     }
 
@@ -62,6 +62,9 @@ void
 SingleValueNumericAttribute<B>::onUpdateStat()
 {
     vespalib::MemoryUsage usage = _data.getMemoryUsage();
+    if (_zoneMap) {
+        usage.merge(_zoneMap->getMemoryUsage());
+    }
     usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
     usage.merge(this->getChangeVectorMemoryUsage());
     this->updateStatistics(_data.size(), _data.size(),
@@ -78,6 +81,10 @@ template <typename B>
 bool
 SingleValueNumericAttribute<B>::addDoc(DocId & doc) {
     bool incGen = _data.isFull();
+    if (_zoneMap) {
+        incGen = _zoneMap->is_full_for(_data.size()) || incGen;
+        _zoneMap->add_doc(_data.size(), attribute::getUndefined<T>());
+    }
     _data.push_back(attribute::getUndefined<T>());
     std::atomic_thread_fence(std::memory_order_release);
     B::incNumDocs();
@@ -120,13 +127,16 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, attribute::NoSaveLoadedEnum());
+    if (_zoneMap) {
+        _zoneMap->rebuild(_data);
+    }
     return true;
 }
 
 
 template <typename B>
 bool
-SingleValueNumericAttribute<B>::onLoad()
+SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -142,9 +152,16 @@ SingleValueNumericAttribute<B>::onLoad()
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().clearHoldLists();
     _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    _mapped_data = false;
+    if (!(this->getConfig().getEnableMemoryMappedLoad() && mapData(attrReader.getDatHeaderLen(), sz))) {
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
+    }
+
+    if (_zoneMap) {
+        _zoneMap->rebuild(_data);
     }
 
     B::setNumDocs(sz);
@@ -153,6 +170,42 @@ SingleValueNumericAttribute<B>::onLoad()
     return true;
 }
 
+/*
+ * The values in the data file are stored in host order right after the
+ * (page aligned) header, using the same layout as _data, so the file can
+ * be used directly. Pages are copied by the kernel on first write.
+ *
+ * The mapping keeps the save file allocated on disk, also after the flush
+ * snapshot containing it has been removed. It is therefore released when
+ * the attribute is saved again, see release_mapped_data().
+ */
+template <typename B>
+bool
+SingleValueNumericAttribute<B>::mapData(uint32_t dataOffset, size_t numDocs)
+{
+    auto buf = attribute::LoadUtils::mapDAT(*this, dataOffset, numDocs * sizeof(T));
+    if (buf.get() == nullptr) {
+        return false;
+    }
+    _data.replace_with_buffer(std::move(buf), numDocs);
+    _mapped_data = true;
+    return true;
+}
+
+template <typename B>
+void
+SingleValueNumericAttribute<B>::release_mapped_data()
+{
+    if (!_mapped_data) {
+        return;
+    }
+    // Copy the values to a regular allocation. The mapping is held until no readers can
+    // reference it, and is then unmapped, letting the file system release the old save file.
+    _data.copy_to_new_buffer();
+    _mapped_data = false;
+    this->incGeneration();
+}
+
 template <typename B>
 AttributeVector::SearchContext::UP
 SingleValueNumericAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
@@ -193,6 +246,9 @@ SingleValueNumericAttribute<B>::onShrinkLidSpace()
     uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
     assert(_data.size() >= committedDocIdLimit);
     _data.shrink(committedDocIdLimit);
+    if (_zoneMap) {
+        _zoneMap->shrink(committedDocIdLimit);
+    }
     this->setNumDocs(committedDocIdLimit);
 }
 
@@ -200,6 +256,7 @@ template <typename B>
 std::unique_ptr<AttributeSaver>
 SingleValueNumericAttribute<B>::onInitSave(vespalib::stringref fileName)
 {
+    release_mapped_data();
     const uint32_t numDocs(this->getCommittedDocIdLimit());
     assert(numDocs <= _data.size());
     return std::make_unique<SingleValueNumericAttributeSaver>
@@ -216,8 +273,18 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
-    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
-{ }
+    _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0]),
+    _zones(nullptr),
+    _docIdLimit(toBeSearched.getCommittedDocIdLimit()),
+    _hits()
+{
+    const auto &zoneMap = static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._zoneMap;
+    if (zoneMap && zoneMap->size() >= ZoneMap::num_blocks(_docIdLimit) &&
+        !M::match(attribute::getUndefined<T>()))
+    {
+        _zones = zoneMap->get_zones();
+    }
+}
 
 
 template <typename B>
@@ -227,6 +294,66 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::getAsIntegerTerm() const
     return M::getRange();
 }
 
+template <typename B>
+template <typename M>
+unsigned int
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::approximateHits() const
+{
+    if (_zones == nullptr) {
+        return AttributeVector::SearchContext::approximateHits();
+    }
+    unsigned int numHits = 0;
+    for (uint32_t block = 0; block < ZoneMap::num_blocks(_docIdLimit); ++block) {
+        if (zoneOverlaps(block)) {
+            numHits += std::min(ZoneMap::block_size, _docIdLimit - (block << ZoneMap::block_size_log2));
+        }
+    }
+    return numHits;
+}
+
+template <typename B>
+template <typename M>
+void
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::fetchPostings(const queryeval::ExecuteInfo &execInfo)
+{
+    if (_zones == nullptr || !execInfo.isStrict() || _hits || !valid()) {
+        return;
+    }
+    // Evaluate blocks with matching zones into a bitvector.
+    _hits = BitVector::create(_docIdLimit);
+    find_batch(1, _docIdLimit, *_hits);
+    _hits->invalidateCachedCount();
+}
+
+template <typename B>
+template <typename M>
+void
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::find_batch(uint32_t begin_lid, uint32_t end_lid, BitVector &result) const
+{
+    constexpr uint32_t chunk_size = ZoneMap::block_size;
+    const auto &accel = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+    auto *words = static_cast<BitWord::Word *>(result.getStart());
+    BitWord::Word chunk[chunk_size / BitWord::WordLen];
+    const uint32_t num_zones = (_zones != nullptr) ? ZoneMap::num_blocks(_docIdLimit) : 0u;
+    uint32_t lid = begin_lid & ~(BitWord::WordLen - 1);
+    while (lid < end_lid) {
+        uint32_t block = lid >> ZoneMap::block_size_log2;
+        uint32_t chunk_end = std::min((block + 1) << ZoneMap::block_size_log2, end_lid);
+        if (block >= num_zones || zoneOverlaps(block)) {
+            accel.findInRange(_data + lid, chunk_end - lid, M::getLow(), M::getHigh(), chunk);
+            if (lid < begin_lid) {
+                chunk[0] &= ~BitWord::Word(0) << (begin_lid - lid);
+            }
+            uint32_t num_words = (chunk_end - lid + BitWord::WordLen - 1) / BitWord::WordLen;
+            BitWord::Word *dst = words + lid / BitWord::WordLen;
+            for (uint32_t i = 0; i < num_words; ++i) {
+                dst[i] |= chunk[i];
+            }
+        }
+        lid = chunk_end;
+    }
+}
+
 template <typename B>
 template <typename M>
 std::unique_ptr<queryeval::SearchIterator>
@@ -236,6 +363,9 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
     if (!valid()) {
         return std::make_unique<queryeval::EmptySearch>();
     }
+    if (_hits) {
+        return BitVectorIterator::create(_hits.get(), _docIdLimit, *matchData, strict);
+    }
     if (getIsFilter()) {
         return strict
                  ? std::make_unique<FilterAttributeIteratorStrict<SingleSearchContext<M>>>(*this, matchData)
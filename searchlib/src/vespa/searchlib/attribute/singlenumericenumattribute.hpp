@@ -78,7 +78,7 @@ SingleValueNumericEnumAttribute<B>::onCommit()
 
 template <typename B>
 bool
-SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
+SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -88,7 +88,7 @@ SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
     this->setNumDocs(numDocs);
     this->setCommittedDocIdLimit(numDocs);
     if (this->hasPostings()) {
-        auto loader = this->getEnumStore().make_enumerated_postings_loader();
+        auto loader = this->getEnumStore().make_enumerated_postings_loader(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         this->load_enumerated_data(attrReader, loader, numValues);
         if (numDocs > 0) {
@@ -106,7 +106,7 @@ SingleValueNumericEnumAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
 
 template <typename B>
 bool
-SingleValueNumericEnumAttribute<B>::onLoad()
+SingleValueNumericEnumAttribute<B>::onLoad(vespalib::Executor *executor)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -118,7 +118,7 @@ SingleValueNumericEnumAttribute<B>::onLoad()
     this->setCreateSerialNum(attrReader.getCreateSerialNum());
 
     if (attrReader.getEnumerated()) {
-        return onLoadEnumerated(attrReader);
+        return onLoadEnumerated(attrReader, executor);
     }
 
     const uint32_t numDocs(attrReader.getDataCount());
@@ -29,6 +29,7 @@ template <typename B>
 void
 SingleValueNumericPostingAttribute<B>::freezeEnumDictionary()
 {
+    _postingList.compress_unmodified_posting_lists();
     this->getEnumStore().freeze_dictionary();
 }
 
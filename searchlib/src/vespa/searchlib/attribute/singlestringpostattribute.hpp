@@ -27,6 +27,7 @@ template <typename B>
 void
 SingleValueStringPostingAttributeT<B>::freezeEnumDictionary()
 {
+    _postingList.compress_unmodified_posting_lists();
     this->getEnumStore().freeze_dictionary();
 }
 
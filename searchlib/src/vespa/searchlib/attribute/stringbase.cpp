@@ -321,7 +321,7 @@ bool StringAttribute::apply(DocId, const ArithmeticValueUpdate & )
 }
 
 bool
-StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
+StringAttribute::onLoadEnumerated(ReaderBase &attrReader, vespalib::Executor *executor)
 {
     auto udatBuffer = attribute::LoadUtils::loadUDAT(*this);
 
@@ -343,7 +343,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
     setCommittedDocIdLimit(numDocs);
 
     if (hasPostings()) {
-        auto loader = this->getEnumStoreBase()->make_enumerated_postings_loader();
+        auto loader = this->getEnumStoreBase()->make_enumerated_postings_loader(executor);
         loader.load_unique_values(udatBuffer->buffer(), udatBuffer->size());
         load_enumerated_data(attrReader, loader, numValues);
         if (numDocs > 0) {
@@ -358,7 +358,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
     return true;
 }
 
-bool StringAttribute::onLoad()
+bool StringAttribute::onLoad(vespalib::Executor *executor)
 {
     ReaderBase attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -370,7 +370,7 @@ bool StringAttribute::onLoad()
     setCreateSerialNum(attrReader.getCreateSerialNum());
 
     assert(attrReader.getEnumerated());
-    return onLoadEnumerated(attrReader);
+    return onLoadEnumerated(attrReader, executor);
 }
 
 bool
@@ -0,0 +1,167 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_bit_packing.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace search::bitcompression {
+
+namespace {
+
+constexpr uint32_t lanes = BlockBitPacking::lanes;
+constexpr uint32_t rows = BlockBitPacking::block_size / lanes;
+
+using PackFunc = void (*)(const uint32_t *in, uint32_t *out);
+using UnpackFunc = void (*)(const uint32_t *in, uint32_t *out);
+
+template <uint32_t bits>
+constexpr uint32_t value_mask() { return (bits >= 32) ? ~0u : ((1u << bits) - 1); }
+
+/*
+ * The row loop is fully unrolled by the compiler since the bit width is
+ * known at compile time, leaving straight line code operating on 4 lanes.
+ */
+template <uint32_t bits>
+void
+pack_bits(const uint32_t *in, uint32_t *out)
+{
+    constexpr uint32_t mask = value_mask<bits>();
+    uint32_t acc[lanes] = { 0, 0, 0, 0 };
+    uint32_t shift = 0;
+    for (uint32_t row = 0; row < rows; ++row, in += lanes) {
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            acc[lane] |= (in[lane] & mask) << shift;
+        }
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                out[lane] = acc[lane];
+                acc[lane] = (shift != 0) ? ((in[lane] & mask) >> (bits - shift)) : 0;
+            }
+            out += lanes;
+        }
+    }
+}
+
+template <uint32_t bits>
+void
+unpack_bits(const uint32_t *in, uint32_t *out)
+{
+    constexpr uint32_t mask = value_mask<bits>();
+    if constexpr (bits == 0) {
+        for (uint32_t i = 0; i < BlockBitPacking::block_size; ++i) {
+            out[i] = 0;
+        }
+        return;
+    }
+    uint32_t shift = 0;
+    for (uint32_t row = 0; row < rows; ++row, out += lanes) {
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            uint32_t value = in[lane] >> shift;
+            if (shift + bits > 32) {
+                value |= in[lanes + lane] << (32 - shift);
+            }
+            out[lane] = value & mask;
+        }
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            in += lanes;
+        }
+    }
+}
+
+template <std::size_t... bits>
+constexpr std::array<PackFunc, sizeof...(bits)>
+make_pack_table(std::index_sequence<bits...>)
+{
+    return {{ &pack_bits<bits>... }};
+}
+
+template <std::size_t... bits>
+constexpr std::array<UnpackFunc, sizeof...(bits)>
+make_unpack_table(std::index_sequence<bits...>)
+{
+    return {{ &unpack_bits<bits>... }};
+}
+
+constexpr auto pack_table = make_pack_table(std::make_index_sequence<33>());
+constexpr auto unpack_table = make_unpack_table(std::make_index_sequence<33>());
+
+}
+
+uint32_t
+BlockBitPacking::max_bits(const uint32_t *values, uint32_t count)
+{
+    uint32_t all = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        all |= values[i];
+    }
+    return (all != 0) ? (32 - __builtin_clz(all)) : 0;
+}
+
+uint32_t *
+BlockBitPacking::pack(const uint32_t *in, uint32_t bits, uint32_t *out)
+{
+    assert(bits <= 32);
+    pack_table[bits](in, out);
+    return out + packed_words(bits);
+}
+
+const uint32_t *
+BlockBitPacking::unpack(const uint32_t *in, uint32_t bits, uint32_t *out)
+{
+    assert(bits <= 32);
+    unpack_table[bits](in, out);
+    return in + packed_words(bits);
+}
+
+uint32_t *
+BlockBitPacking::encode_doc_ids(const uint32_t *doc_ids, uint32_t count, uint32_t prev_doc_id, uint32_t *out)
+{
+    assert(count <= block_size);
+    uint32_t deltas[block_size];
+    for (uint32_t i = 0; i < count; ++i) {
+        assert(doc_ids[i] > prev_doc_id);
+        deltas[i] = doc_ids[i] - prev_doc_id - 1;
+        prev_doc_id = doc_ids[i];
+    }
+    for (uint32_t i = count; i < block_size; ++i) {
+        deltas[i] = 0;
+    }
+    uint32_t bits = max_bits(deltas, block_size);
+    out[0] = bits;
+    return pack(deltas, bits, out + 1);
+}
+
+uint32_t *
+BlockBitPacking::encode_values(const uint32_t *values, uint32_t count, uint32_t *out)
+{
+    assert(count <= block_size);
+    uint32_t padded[block_size];
+    for (uint32_t i = 0; i < count; ++i) {
+        padded[i] = values[i];
+    }
+    for (uint32_t i = count; i < block_size; ++i) {
+        padded[i] = 0;
+    }
+    uint32_t bits = max_bits(padded, block_size);
+    out[0] = bits;
+    return pack(padded, bits, out + 1);
+}
+
+const uint32_t *
+BlockBitPacking::decode_doc_ids(const uint32_t *in, uint32_t prev_doc_id, uint32_t *out)
+{
+    const uint32_t *next = unpack(in + 1, in[0], out);
+    for (uint32_t i = 0; i < block_size; ++i) {
+        prev_doc_id += out[i] + 1;
+        out[i] = prev_doc_id;
+    }
+    return next;
+}
+
+}
@@ -0,0 +1,84 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::bitcompression {
+
+/**
+ * Fixed width bit packing of blocks of 128 32-bit values, using the
+ * vertical (4-lane interleaved) layout of SIMD-BP128. Value i of a block
+ * is stored in lane (i % 4), and each lane packs its 32 values back to back.
+ * All lanes are processed in lock step, which lets the compiler use 128-bit
+ * vector instructions for both packing and unpacking.
+ *
+ * A packed block with bit width b occupies exactly 4 * b 32-bit words.
+ *
+ * Document id blocks are stored as a one word header holding the bit width,
+ * followed by the packed (delta - 1) values. A partial last block is padded
+ * with zero deltas.
+ */
+class BlockBitPacking
+{
+public:
+    static constexpr uint32_t block_size = 128;
+    static constexpr uint32_t lanes = 4;
+
+    static uint32_t packed_words(uint32_t bits) { return bits * lanes; }
+
+    /*
+     * Returns number of bits needed to represent the largest of the given values.
+     */
+    static uint32_t max_bits(const uint32_t *values, uint32_t count);
+
+    /*
+     * Pack a full block of values using the given bit width.
+     * Bits above the bit width in the input values are ignored.
+     * Returns pointer to the first word after the packed block.
+     */
+    static uint32_t *pack(const uint32_t *in, uint32_t bits, uint32_t *out);
+
+    /*
+     * Unpack a full block of values packed with the given bit width.
+     * Returns pointer to the first word after the packed block.
+     */
+    static const uint32_t *unpack(const uint32_t *in, uint32_t bits, uint32_t *out);
+
+    /*
+     * Encode up to block_size strictly increasing document ids, all
+     * larger than prev_doc_id. Returns pointer to the first word after
+     * the encoded block.
+     */
+    static uint32_t *encode_doc_ids(const uint32_t *doc_ids, uint32_t count, uint32_t prev_doc_id, uint32_t *out);
+
+    /*
+     * Decode a block of document ids encoded by encode_doc_ids. A full
+     * block of document ids is always written to out. Returns pointer to
+     * the first word after the encoded block.
+     */
+    static const uint32_t *decode_doc_ids(const uint32_t *in, uint32_t prev_doc_id, uint32_t *out);
+
+    /*
+     * Encode up to block_size arbitrary values, using the same header word
+     * and padding as encode_doc_ids. Returns pointer to the first word
+     * after the encoded block.
+     */
+    static uint32_t *encode_values(const uint32_t *values, uint32_t count, uint32_t *out);
+
+    /*
+     * Decode a block of values encoded by encode_values. A full block of
+     * values is always written to out. Returns pointer to the first word
+     * after the encoded block.
+     */
+    static const uint32_t *decode_values(const uint32_t *in, uint32_t *out) { return unpack(in + 1, in[0], out); }
+
+    /*
+     * Returns number of words used by an encoded document id or value block
+     * without decoding it. Used to skip blocks.
+     */
+    static uint32_t encoded_doc_ids_words(const uint32_t *in) { return 1 + packed_words(in[0]); }
+    static uint32_t encoded_values_words(const uint32_t *in) { return 1 + packed_words(in[0]); }
+};
+
+}
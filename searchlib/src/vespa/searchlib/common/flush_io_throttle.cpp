@@ -0,0 +1,156 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flush_io_throttle.h"
+#include <algorithm>
+
+namespace search::common {
+
+namespace {
+
+thread_local FlushIoThrottle::Priority _currentPriority = FlushIoThrottle::Priority::BACKGROUND;
+thread_local bool _inFlush = false;
+
+}
+
+FlushIoThrottle::PriorityGuard::PriorityGuard(Priority priority)
+    : _oldPriority(_currentPriority),
+      _oldInFlush(_inFlush)
+{
+    _currentPriority = priority;
+    _inFlush = true;
+}
+
+FlushIoThrottle::PriorityGuard::~PriorityGuard()
+{
+    _currentPriority = _oldPriority;
+    _inFlush = _oldInFlush;
+}
+
+FlushIoThrottle::Bucket::Bucket() noexcept
+    : config(),
+      limited(false),
+      bytes(0),
+      tokens(0.0),
+      lastRefill(vespalib::steady_clock::now()),
+      throttledWrites(0),
+      throttledTime(0.0)
+{
+}
+
+void
+FlushIoThrottle::Bucket::refill(vespalib::steady_time now)
+{
+    if (config.rate <= 0.0) {
+        tokens = config.burst;
+    } else if (now > lastRefill) {
+        tokens = std::min(tokens + config.rate * vespalib::to_s(now - lastRefill), static_cast<double>(config.burst));
+    }
+    lastRefill = now;
+}
+
+void
+FlushIoThrottle::Bucket::reconfigure(const BucketConfig &newConfig, vespalib::steady_time now)
+{
+    bool wasUnlimited = (config.rate <= 0.0);
+    refill(now);
+    config = newConfig;
+    // Start with a full bucket when going from unlimited to limited rate
+    tokens = wasUnlimited ? config.burst : std::min(tokens, static_cast<double>(config.burst));
+    limited.store(config.rate > 0.0, std::memory_order_relaxed);
+}
+
+FlushIoThrottle::BucketStats
+FlushIoThrottle::Bucket::getStats() const
+{
+    BucketStats result;
+    result.bytes = bytes.load(std::memory_order_relaxed);
+    result.throttledWrites = throttledWrites;
+    result.throttledTime = throttledTime;
+    return result;
+}
+
+FlushIoThrottle::FlushIoThrottle()
+    : _lock(),
+      _cond(),
+      _urgent(),
+      _background()
+{
+}
+
+FlushIoThrottle::~FlushIoThrottle() = default;
+
+void
+FlushIoThrottle::setConfig(const Config &config)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    _urgent.reconfigure(config.urgent, now);
+    _background.reconfigure(config.background, now);
+    _cond.notify_all();
+}
+
+FlushIoThrottle::Config
+FlushIoThrottle::getConfig() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return Config(_urgent.config, _background.config);
+}
+
+FlushIoThrottle::Stats
+FlushIoThrottle::getStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats;
+    stats.urgent = _urgent.getStats();
+    stats.background = _background.getStats();
+    return stats;
+}
+
+void
+FlushIoThrottle::acquire(size_t bytes, Priority priority)
+{
+    Bucket &bucket = getBucket(priority);
+    bucket.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (!bucket.limited.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::unique_lock<std::mutex> guard(_lock);
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    vespalib::steady_time now = start;
+    bucket.refill(now);
+    bool throttled = false;
+    while (bucket.config.rate > 0.0 && bucket.tokens < 0.0) {
+        throttled = true;
+        _cond.wait_for(guard, vespalib::from_s(-bucket.tokens / bucket.config.rate));
+        now = vespalib::steady_clock::now();
+        bucket.refill(now);
+    }
+    if (bucket.config.rate > 0.0) {
+        bucket.tokens -= bytes;
+    }
+    if (throttled) {
+        ++bucket.throttledWrites;
+        bucket.throttledTime += vespalib::to_s(now - start);
+    }
+}
+
+FlushIoThrottle::Priority
+FlushIoThrottle::currentPriority()
+{
+    return _currentPriority;
+}
+
+bool
+FlushIoThrottle::inFlush()
+{
+    return _inFlush;
+}
+
+FlushIoThrottle &
+FlushIoThrottle::instance()
+{
+    static FlushIoThrottle throttle;
+    return throttle;
+}
+
+}
@@ -0,0 +1,128 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace search::common {
+
+/**
+ * Rate limiting of disk writes done when flushing attributes, disk
+ * indexes and the document store, using one token bucket for urgent
+ * flushes and one for background flushes.
+ *
+ * The priority of writes is taken from the calling thread, set with
+ * PriorityGuard (e.g. by the flush engine while running a flush task).
+ * Writes from threads without a priority use the background bucket.
+ * A bucket may go into debt by a single large write, later writes then
+ * wait until the debt has been paid. A rate of 0 means unlimited, writes
+ * then only count bytes and never take the lock.
+ */
+class FlushIoThrottle
+{
+public:
+    enum class Priority : uint8_t { URGENT, BACKGROUND };
+
+    struct BucketConfig {
+        /// Bytes per second, 0 means unlimited.
+        double   rate;
+        /// Maximum number of bytes that can be written without waiting.
+        uint64_t burst;
+        BucketConfig() noexcept : rate(0.0), burst(0) { }
+        BucketConfig(double rate_in, uint64_t burst_in) noexcept : rate(rate_in), burst(burst_in) { }
+        bool operator==(const BucketConfig &rhs) const { return rate == rhs.rate && burst == rhs.burst; }
+    };
+
+    struct Config {
+        BucketConfig urgent;
+        BucketConfig background;
+        Config() noexcept : urgent(), background() { }
+        Config(const BucketConfig &urgent_in, const BucketConfig &background_in) noexcept
+            : urgent(urgent_in),
+              background(background_in)
+        { }
+        bool operator==(const Config &rhs) const { return urgent == rhs.urgent && background == rhs.background; }
+    };
+
+    struct BucketStats {
+        uint64_t bytes;
+        uint64_t throttledWrites;
+        double   throttledTime;
+        BucketStats() noexcept : bytes(0), throttledWrites(0), throttledTime(0.0) { }
+    };
+
+    struct Stats {
+        BucketStats urgent;
+        BucketStats background;
+    };
+
+    /**
+     * Sets the priority of writes done by the current thread while in scope,
+     * marking the thread as doing a flush.
+     */
+    class PriorityGuard {
+        Priority _oldPriority;
+        bool     _oldInFlush;
+    public:
+        explicit PriorityGuard(Priority priority);
+        PriorityGuard(const PriorityGuard &) = delete;
+        PriorityGuard &operator=(const PriorityGuard &) = delete;
+        ~PriorityGuard();
+    };
+
+private:
+    struct Bucket {
+        BucketConfig          config;
+        std::atomic<bool>     limited;
+        std::atomic<uint64_t> bytes;
+        double                tokens;
+        vespalib::steady_time lastRefill;
+        uint64_t              throttledWrites;
+        double                throttledTime;
+        Bucket() noexcept;
+        void refill(vespalib::steady_time now);
+        void reconfigure(const BucketConfig &newConfig, vespalib::steady_time now);
+        BucketStats getStats() const;
+    };
+
+    mutable std::mutex      _lock;
+    std::condition_variable _cond;
+    Bucket                  _urgent;
+    Bucket                  _background;
+
+    Bucket &getBucket(Priority priority) { return (priority == Priority::URGENT) ? _urgent : _background; }
+
+public:
+    FlushIoThrottle();
+    ~FlushIoThrottle();
+
+    void setConfig(const Config &config);
+    Config getConfig() const;
+    Stats getStats() const;
+
+    /**
+     * Called before writing the given number of bytes, blocks while the
+     * bucket for the priority of the current thread is in debt.
+     */
+    void acquire(size_t bytes) { acquire(bytes, currentPriority()); }
+    void acquire(size_t bytes, Priority priority);
+
+    static Priority currentPriority();
+
+    /**
+     * Returns true if the current thread is doing a flush, i.e. has a
+     * priority set with PriorityGuard.
+     */
+    static bool inFlush();
+
+    /**
+     * The throttle shared by all flush writers in this process.
+     */
+    static FlushIoThrottle &instance();
+};
+
+}
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/index/bitvectorkeys.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/vespalib/data/fileheader.h>
 
 namespace search::diskindex {
@@ -132,6 +133,7 @@ BitVectorFileWrite::addWordSingle(uint64_t wordNum,
     assert(bitVector.size() == _docIdLimit);
     bitVector.invalidateCachedCount();
     Parent::addWordSingle(wordNum, bitVector.countTrueBits());
+    search::common::FlushIoThrottle::instance().acquire(bitVector.getFileBytes());
     _datFile->WriteBuf(bitVector.getStart(),
                        bitVector.getFileBytes());
 }
@@ -0,0 +1,94 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "block_posting_reader.h"
+#include "block_posting_writer.h"
+#include <vespa/searchlib/index/postinglistfile.h>
+#include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <vespa/searchlib/bitcompression/posocc_fields_params.h>
+#include <vespa/fastos/file.h>
+
+namespace search::index {
+    class PostingListCountFileSeqRead;
+    class PostingListCountFileSeqWrite;
+}
+
+namespace search::diskindex {
+
+/*
+ * Sequential reader for posting list files of type "BlockPosOcc.1".
+ * Features use the same encoding as "Zc.4" posting list files.
+ */
+class BlockPosOccSeqRead : public index::PostingListFileSeqRead
+{
+    BlockPostingReader _reader;
+    FastOS_File _file;
+    uint64_t _numWords;     // Number of words in file
+    uint64_t _fileBitSize;
+    index::PostingListCountFileSeqRead *const _countFile;
+    uint64_t _headerBitLen;       // Size of file header in bits
+    bitcompression::PosOccFieldsParams _fieldsParams;
+    bitcompression::EG2PosOccDecodeContextCooked<true> _cookedDecodeContext;
+    bitcompression::EG2PosOccDecodeContext<true> _rawDecodeContext;
+
+    void readHeader();
+public:
+    using DocIdAndFeatures = index::DocIdAndFeatures;
+    using PostingListCounts = index::PostingListCounts;
+    using PostingListParams = index::PostingListParams;
+
+    BlockPosOccSeqRead(index::PostingListCountFileSeqRead *countFile);
+    ~BlockPosOccSeqRead();
+
+    void readDocIdAndFeatures(DocIdAndFeatures &features) override;
+    void readCounts(const PostingListCounts &counts) override; // Fill in for next word
+    bool open(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead) override;
+    bool close() override;
+    void getParams(PostingListParams &params) override;
+    void setFeatureParams(const PostingListParams &params) override;
+    void getFeatureParams(PostingListParams &params) override;
+    const index::FieldLengthInfo &get_field_length_info() const override;
+    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getSubIdentifier();
+};
+
+/*
+ * Sequential writer for posting list files of type "BlockPosOcc.1".
+ */
+class BlockPosOccSeqWrite : public index::PostingListFileSeqWrite
+{
+    using EncodeContext = bitcompression::FeatureEncodeContextBE;
+
+    BlockPostingWriter _writer;
+    FastOS_File _file;
+    uint64_t _fileBitSize;
+    index::PostingListCountFileSeqWrite *const _countFile;
+    bitcompression::PosOccFieldsParams _fieldsParams;
+    bitcompression::EG2PosOccEncodeContext<true> _realEncodeFeatures;
+
+    void makeHeader(const search::common::FileHeaderContext &fileHeaderContext);
+    void updateHeader();
+public:
+    using DocIdAndFeatures = index::DocIdAndFeatures;
+    using PostingListParams = index::PostingListParams;
+    using Schema = index::Schema;
+
+    BlockPosOccSeqWrite(const Schema &schema, uint32_t indexId,
+                        const index::FieldLengthInfo &field_length_info,
+                        index::PostingListCountFileSeqWrite *countFile);
+    ~BlockPosOccSeqWrite();
+
+    void writeDocIdAndFeatures(const DocIdAndFeatures &features) override;
+    void flushWord() override;
+    bool open(const vespalib::string &name,
+              const TuneFileSeqWrite &tuneFileWrite,
+              const search::common::FileHeaderContext &fileHeaderContext) override;
+    bool close() override;
+    void setParams(const PostingListParams &params) override;
+    void getParams(PostingListParams &params) override;
+    void setFeatureParams(const PostingListParams &params) override;
+    void getFeatureParams(PostingListParams &params) override;
+};
+
+}
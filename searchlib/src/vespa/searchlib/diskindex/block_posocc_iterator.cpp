@@ -0,0 +1,200 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_posocc_iterator.h"
+#include "block_posting_layout.h"
+#include "zc4_posting_params.h"
+#include <vespa/searchlib/bitcompression/posocc_fields_params.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+
+namespace search::diskindex {
+
+using bitcompression::BlockBitPacking;
+using bitcompression::FeatureEncodeContext;
+using bitcompression::PosOccFieldsParams;
+using fef::TermFieldMatchData;
+using fef::TermFieldMatchDataArray;
+
+BlockPosOccIterator::BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                                         bool decode_normal_features, bool decode_interleaved_features,
+                                         bool unpack_normal_features, bool unpack_interleaved_features,
+                                         const PosOccFieldsParams *fieldsParams,
+                                         const TermFieldMatchDataArray &matchData)
+    : ZcIteratorBase(matchData, start, docIdLimit),
+      _decodeContext(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams),
+      _area(nullptr),
+      _last_doc_ids(nullptr),
+      _next_block(nullptr),
+      _num_blocks(0),
+      _block(0),
+      _block_pos(0),
+      _featuresValI(nullptr),
+      _featuresBitOffset(0),
+      _featureSeekPos(0),
+      _pendingFeatureSeek(false),
+      _decode_normal_features(decode_normal_features),
+      _decode_interleaved_features(decode_interleaved_features),
+      _unpack_normal_features(unpack_normal_features),
+      _unpack_interleaved_features(unpack_interleaved_features)
+{
+    assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
+}
+
+BlockPosOccIterator::~BlockPosOccIterator() = default;
+
+const uint32_t *
+BlockPosOccIterator::skip_block(const uint32_t *in) const
+{
+    in += BlockBitPacking::encoded_doc_ids_words(in);
+    if (_decode_interleaved_features) {
+        in += BlockBitPacking::encoded_values_words(in);
+        in += BlockBitPacking::encoded_values_words(in);
+    }
+    return in;
+}
+
+void
+BlockPosOccIterator::decode_block(uint32_t block, const uint32_t *in)
+{
+    uint32_t prevDocId = (block > 0) ? _last_doc_ids[block - 1] : 0u;
+    in = BlockBitPacking::decode_doc_ids(in, prevDocId, _doc_ids);
+    if (_decode_interleaved_features) {
+        if (_unpack_interleaved_features) {
+            in = BlockBitPacking::decode_values(in, _field_lengths);
+            in = BlockBitPacking::decode_values(in, _num_occs);
+        } else {
+            in += BlockBitPacking::encoded_values_words(in);
+            in += BlockBitPacking::encoded_values_words(in);
+        }
+    }
+    _next_block = in;
+    _block = block;
+    _block_pos = 0;
+}
+
+void
+BlockPosOccIterator::readWordStart(uint32_t docIdLimit)
+{
+    (void) docIdLimit;
+    using EC = FeatureEncodeContext<true>;
+    DecodeContext &d = _decodeContext;
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+
+    UC64BE_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
+    uint32_t numDocs = static_cast<uint32_t>(val64) + 1;
+    UC64BE_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_DOCIDSSIZE, EC);
+    uint64_t areaSize = val64 + 1;
+
+    // Block area starts at 64-bit boundary
+    uint64_t pad = oPreRead & 63;
+    if (pad > 0) {
+        length = pad;
+        UC64BE_READBITS_NS(o, EC);
+    }
+    UC64_DECODECONTEXT_STORE(o, d._);
+    assert(d.getBitOffset() == 0);
+    const uint8_t *bcompr = d.getByteCompr();
+    _area = reinterpret_cast<const uint32_t *>(bcompr);
+    d.setByteCompr(bcompr + areaSize * sizeof(uint64_t));
+    // Save information about start of features
+    _featuresValI = d.getCompr();
+    _featuresBitOffset = d.getBitOffset();
+    _featureSeekPos = 0;
+    _pendingFeatureSeek = false;
+
+    BlockPostingLayout layout(numDocs, _decode_normal_features);
+    _num_blocks = layout.num_blocks();
+    _last_doc_ids = _area + layout.last_doc_ids_start();
+    decode_block(0, _area + layout.blocks_start());
+    setDocId(_doc_ids[0]);
+    clearUnpacked();
+}
+
+void
+BlockPosOccIterator::doSeekBlock(uint32_t docId)
+{
+    uint32_t block = _block + 1;
+    const uint32_t *in = _next_block;
+    while (block < _num_blocks && docId > _last_doc_ids[block]) {
+        in = skip_block(in);
+        ++block;
+    }
+    if (block >= _num_blocks) {
+        setAtEnd();
+        return;
+    }
+    decode_block(block, in);
+    if (_decode_normal_features) {
+        _featureSeekPos = BlockPostingLayout::get_feature_offset(_area, block);
+        _pendingFeatureSeek = true;
+    }
+    clearUnpacked();
+}
+
+void
+BlockPosOccIterator::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId > _last_doc_ids[_block], false)) {
+        doSeekBlock(docId);
+        if (isAtEnd()) {
+            return;
+        }
+    }
+    uint32_t pos = _block_pos;
+    while (_doc_ids[pos] < docId) {
+        ++pos;
+        incNeedUnpack();
+    }
+    _block_pos = pos;
+    setDocId(_doc_ids[pos]);
+}
+
+void
+BlockPosOccIterator::doUnpack(uint32_t docId)
+{
+    if (!_matchData.valid() || getUnpacked()) {
+        return;
+    }
+    assert(docId == getDocId());
+    if (_decode_normal_features && _unpack_normal_features) {
+        if (_pendingFeatureSeek) {
+            // Handle deferred feature position seek now.
+            featureSeek(_featureSeekPos);
+            _pendingFeatureSeek = false;
+        }
+        uint32_t needUnpack = getNeedUnpack();
+        if (needUnpack > 1) {
+            _decodeContext.skipFeatures(needUnpack - 1);
+        }
+        _decodeContext.unpackFeatures(_matchData, docId);
+    } else {
+        _matchData[0]->reset(docId);
+    }
+    if (_decode_interleaved_features && _unpack_interleaved_features) {
+        TermFieldMatchData *tfmd = _matchData[0];
+        tfmd->setFieldLength(_field_lengths[_block_pos] + 1);
+        tfmd->setNumOccs(_num_occs[_block_pos] + 1);
+    }
+    setUnpacked();
+}
+
+void
+BlockPosOccIterator::rewind(Position start)
+{
+    _decodeContext.setPosition(start);
+}
+
+std::unique_ptr<search::queryeval::SearchIterator>
+create_block_posocc_iterator(bitcompression::Position start, uint64_t bit_length, const Zc4PostingParams &posting_params, const PosOccFieldsParams &fields_params, const TermFieldMatchDataArray &match_data)
+{
+    bool unpack_normal_features = match_data.valid() ? match_data[0]->needs_normal_features() : false;
+    bool unpack_interleaved_features = match_data.valid() ? match_data[0]->needs_interleaved_features() : false;
+    return std::make_unique<BlockPosOccIterator>(start, bit_length, posting_params._doc_id_limit,
+                                                 posting_params._encode_features, posting_params._encode_interleaved_features,
+                                                 unpack_normal_features, unpack_interleaved_features,
+                                                 &fields_params, match_data);
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zcpostingiterators.h"
+#include <vespa/searchlib/bitcompression/block_bit_packing.h>
+#include <vespa/searchlib/bitcompression/posocccompression.h>
+
+namespace search::diskindex {
+
+struct Zc4PostingParams;
+
+/*
+ * Strict search iterator for posting lists of type "BlockPosOcc.1".
+ *
+ * Blocks are skipped by scanning the last document id of each block, and a
+ * block is only decoded when the seek target falls inside it. Features are
+ * located using the per block feature offsets and decoded lazily on unpack.
+ */
+class BlockPosOccIterator : public ZcIteratorBase
+{
+    static constexpr uint32_t block_size = bitcompression::BlockBitPacking::block_size;
+    using DecodeContext = bitcompression::EG2PosOccDecodeContextCooked<true>;
+
+    DecodeContext   _decodeContext;
+    const uint32_t *_area;            // Block area for word
+    const uint32_t *_last_doc_ids;
+    const uint32_t *_next_block;      // Encoded block after current block
+    uint32_t        _num_blocks;
+    uint32_t        _block;           // Current block
+    uint32_t        _block_pos;       // Position in current block
+    // Start of features for word, needed for seeks
+    const uint64_t *_featuresValI;
+    int             _featuresBitOffset;
+    uint64_t        _featureSeekPos;
+    bool            _pendingFeatureSeek;
+    bool            _decode_normal_features;
+    bool            _decode_interleaved_features;
+    bool            _unpack_normal_features;
+    bool            _unpack_interleaved_features;
+    uint32_t        _doc_ids[block_size];
+    uint32_t        _field_lengths[block_size];
+    uint32_t        _num_occs[block_size];
+
+    const uint32_t *skip_block(const uint32_t *in) const;
+    void decode_block(uint32_t block, const uint32_t *in);
+    void featureSeek(uint64_t offset) {
+        _decodeContext._valI = _featuresValI + (_featuresBitOffset + offset) / 64;
+        _decodeContext.setupBits((_featuresBitOffset + offset) & 63);
+    }
+    void doSeekBlock(uint32_t docId);
+public:
+    BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                        bool decode_normal_features, bool decode_interleaved_features,
+                        bool unpack_normal_features, bool unpack_interleaved_features,
+                        const bitcompression::PosOccFieldsParams *fieldsParams,
+                        const fef::TermFieldMatchDataArray &matchData);
+    ~BlockPosOccIterator();
+
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+    void readWordStart(uint32_t docIdLimit) override;
+    void rewind(Position start) override;
+};
+
+std::unique_ptr<search::queryeval::SearchIterator>
+create_block_posocc_iterator(bitcompression::Position start, uint64_t bit_length, const Zc4PostingParams &posting_params, const bitcompression::PosOccFieldsParams &fields_params, const fef::TermFieldMatchDataArray &match_data);
+
+}
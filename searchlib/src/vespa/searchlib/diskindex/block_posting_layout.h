@@ -0,0 +1,50 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/bitcompression/block_bit_packing.h>
+
+namespace search::diskindex {
+
+/*
+ * Layout of the block area of a word in a posting list of type
+ * "BlockPosOcc.1". The block area starts at a 64-bit boundary right after
+ * the Exp-Golomb coded word header and is an array of 32-bit words:
+ *
+ *   feature offsets  2 words (low, high) per block, bit offset of the first
+ *                    feature of the block relative to the start of the
+ *                    features for the word. Only present when features
+ *                    are encoded.
+ *   last doc ids     1 word per block.
+ *   blocks           per block the encoded document ids, followed by the
+ *                    encoded (field length - 1) and (num occs - 1) values
+ *                    when interleaved features are encoded.
+ *
+ * The block area is padded to a multiple of 64 bits and is followed by the
+ * features for all documents in the word.
+ */
+class BlockPostingLayout
+{
+    uint32_t _num_blocks;
+    bool     _features;
+public:
+    static constexpr uint32_t block_size = bitcompression::BlockBitPacking::block_size;
+
+    BlockPostingLayout(uint32_t num_docs, bool features)
+        : _num_blocks((num_docs + block_size - 1) / block_size),
+          _features(features)
+    {
+    }
+    uint32_t num_blocks() const { return _num_blocks; }
+    uint32_t last_doc_ids_start() const { return _features ? 2 * _num_blocks : 0; }
+    uint32_t blocks_start() const { return last_doc_ids_start() + _num_blocks; }
+    static uint64_t get_feature_offset(const uint32_t *area, uint32_t block) {
+        return area[2 * block] | (static_cast<uint64_t>(area[2 * block + 1]) << 32);
+    }
+    static void set_feature_offset(uint32_t *area, uint32_t block, uint64_t offset) {
+        area[2 * block] = static_cast<uint32_t>(offset);
+        area[2 * block + 1] = static_cast<uint32_t>(offset >> 32);
+    }
+};
+
+}
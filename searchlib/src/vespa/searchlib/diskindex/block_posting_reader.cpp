@@ -0,0 +1,103 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_posting_reader.h"
+#include "block_posting_layout.h"
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <cassert>
+
+namespace search::diskindex {
+
+using bitcompression::BlockBitPacking;
+using index::DocIdAndFeatures;
+using index::PostingListCounts;
+
+BlockPostingReader::BlockPostingReader()
+    : _decodeContext(nullptr),
+      _readContext(sizeof(uint64_t)),
+      _posting_params(64, 1 << 30, 10000000, false, true, false),
+      _counts(),
+      _residue(0),
+      _area(),
+      _next_block(nullptr),
+      _block_pos(block_size),
+      _prev_doc_id(0)
+{
+}
+
+BlockPostingReader::~BlockPostingReader() = default;
+
+void
+BlockPostingReader::decode_next_block()
+{
+    const uint32_t *in = BlockBitPacking::decode_doc_ids(_next_block, _prev_doc_id, _doc_ids);
+    if (_posting_params._encode_interleaved_features) {
+        in = BlockBitPacking::decode_values(in, _field_lengths);
+        in = BlockBitPacking::decode_values(in, _num_occs);
+    }
+    _next_block = in;
+    _prev_doc_id = _doc_ids[block_size - 1];
+    _block_pos = 0;
+}
+
+void
+BlockPostingReader::read_doc_id_and_features(DocIdAndFeatures &features)
+{
+    if (_residue == 0) {
+        // Don't read past end of posting list.
+        features.clear(static_cast<uint32_t>(-1));
+        return;
+    }
+    if (_block_pos == block_size) {
+        decode_next_block();
+    }
+    features.set_doc_id(_doc_ids[_block_pos]);
+    if (_posting_params._encode_features) {
+        if (_posting_params._encode_interleaved_features) {
+            features.set_field_length(_field_lengths[_block_pos] + 1);
+            features.set_num_occs(_num_occs[_block_pos] + 1);
+        }
+        _decodeContext->readFeatures(features);
+    }
+    ++_block_pos;
+    --_residue;
+}
+
+void
+BlockPostingReader::read_word_start()
+{
+    DecodeContext &d = *_decodeContext;
+    uint32_t numDocs = d.decode_exp_golomb(K_VALUE_ZCPOSTING_NUMDOCS) + 1;
+    assert(numDocs == _counts._numDocs);
+    uint32_t areaSize = d.decode_exp_golomb(K_VALUE_ZCPOSTING_DOCIDSSIZE) + 1;
+    d.align(64);
+    _area.resize(2 * areaSize);
+    d.readBytes(reinterpret_cast<uint8_t *>(_area.data()), 8 * areaSize);
+    // Decode context is now positioned at start of features
+    BlockPostingLayout layout(numDocs, _posting_params._encode_features);
+    _next_block = _area.data() + layout.blocks_start();
+    _block_pos = block_size;
+    _prev_doc_id = 0;
+    _residue = numDocs;
+}
+
+void
+BlockPostingReader::set_counts(const PostingListCounts &counts)
+{
+    assert(_residue == 0);  // Previous words must have been read.
+    _counts = counts;
+    assert((_counts._numDocs == 0) == (_counts._bitLength == 0));
+    assert(_counts._segments.empty());
+    if (_counts._numDocs > 0) {
+        read_word_start();
+    }
+}
+
+void
+BlockPostingReader::set_decode_features(DecodeContext *decode_features)
+{
+    _decodeContext = decode_features;
+    _decodeContext->setReadContext(&_readContext);
+    _readContext.setDecodeContext(_decodeContext);
+}
+
+}
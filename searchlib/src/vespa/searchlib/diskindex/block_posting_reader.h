@@ -0,0 +1,56 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zc4_posting_params.h"
+#include <vespa/searchlib/bitcompression/block_bit_packing.h>
+#include <vespa/searchlib/bitcompression/compression.h>
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <vector>
+
+namespace search::index { class DocIdAndFeatures; }
+
+namespace search::diskindex {
+
+/*
+ * Class used to read posting lists of type "BlockPosOcc.1" sequentially,
+ * e.g. during fusion. The block area for a word is read into memory when
+ * the word is started and blocks are decoded as they are reached. Features
+ * are read sequentially from the file.
+ */
+class BlockPostingReader
+{
+    using DecodeContext = bitcompression::FeatureDecodeContextBE;
+    static constexpr uint32_t block_size = bitcompression::BlockBitPacking::block_size;
+
+    DecodeContext *_decodeContext;
+    search::ComprFileReadContext _readContext;
+    Zc4PostingParams _posting_params;
+    index::PostingListCounts _counts;
+    uint32_t _residue;          // Number of unread documents in word
+    std::vector<uint32_t> _area;
+    const uint32_t *_next_block;
+    uint32_t _block_pos;        // Position in current block
+    uint32_t _prev_doc_id;
+    uint32_t _doc_ids[block_size];
+    uint32_t _field_lengths[block_size];
+    uint32_t _num_occs[block_size];
+
+    void read_word_start();
+    void decode_next_block();
+public:
+    BlockPostingReader();
+    BlockPostingReader(const BlockPostingReader &) = delete;
+    BlockPostingReader(BlockPostingReader &&) = delete;
+    BlockPostingReader &operator=(const BlockPostingReader &) = delete;
+    BlockPostingReader &operator=(BlockPostingReader &&) = delete;
+    ~BlockPostingReader();
+    void read_doc_id_and_features(index::DocIdAndFeatures &features);
+    void set_counts(const index::PostingListCounts &counts);
+    void set_decode_features(DecodeContext *decode_features);
+    DecodeContext &get_decode_features() const { return *_decodeContext; }
+    ComprFileReadContext &get_read_context() { return _readContext; }
+    Zc4PostingParams &get_posting_params() { return _posting_params; }
+};
+
+}
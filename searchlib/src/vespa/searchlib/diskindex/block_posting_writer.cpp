@@ -0,0 +1,176 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "block_posting_writer.h"
+#include "block_posting_layout.h"
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
+#include <cassert>
+
+using search::bitcompression::BlockBitPacking;
+using search::index::DocIdAndFeatures;
+using search::index::PostingListCounts;
+using search::index::PostingListParams;
+
+namespace search::diskindex {
+
+BlockPostingWriter::BlockPostingWriter(PostingListCounts &counts)
+    : _minChunkDocs(1 << 30),
+      _minSkipDocs(64),
+      _docIdLimit(10000000),
+      _encode_interleaved_features(false),
+      _docIds(),
+      _area(),
+      _featureOffset(0),
+      _writePos(0),
+      _numWords(0),
+      _counts(counts),
+      _writeContext(sizeof(uint64_t)),
+      _featureWriteContext(sizeof(uint64_t)),
+      _encode_context(),
+      _encode_features(nullptr)
+{
+    _featureWriteContext.allocComprBuf(64, 1);
+    _encode_context.setWriteContext(&_writeContext);
+    _writeContext.setEncodeContext(&_encode_context);
+}
+
+BlockPostingWriter::~BlockPostingWriter() = default;
+
+void
+BlockPostingWriter::make_area()
+{
+    constexpr uint32_t block_size = BlockPostingLayout::block_size;
+    uint32_t numDocs = _docIds.size();
+    BlockPostingLayout layout(numDocs, _encode_features != nullptr);
+    uint32_t numBlocks = layout.num_blocks();
+    uint32_t maxBlockWords = 1 + BlockBitPacking::packed_words(32);
+    if (_encode_interleaved_features) {
+        maxBlockWords *= 3;
+    }
+    _area.assign(layout.blocks_start() + numBlocks * maxBlockWords + 1, 0);
+    uint32_t *area = _area.data();
+    uint32_t *out = area + layout.blocks_start();
+    uint32_t docIds[block_size];
+    uint32_t fieldLengths[block_size];
+    uint32_t numOccs[block_size];
+    uint64_t featureOffset = 0;
+    uint32_t prevDocId = 0;
+    for (uint32_t block = 0; block < numBlocks; ++block) {
+        uint32_t first = block * block_size;
+        uint32_t count = std::min(block_size, numDocs - first);
+        if (_encode_features != nullptr) {
+            BlockPostingLayout::set_feature_offset(area, block, featureOffset);
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto &doc = _docIds[first + i];
+            docIds[i] = doc._doc_id;
+            if (_encode_interleaved_features) {
+                assert(doc._field_length > 0);
+                fieldLengths[i] = doc._field_length - 1;
+                assert(doc._num_occs > 0);
+                numOccs[i] = doc._num_occs - 1;
+            }
+            featureOffset += doc._features_size;
+        }
+        area[layout.last_doc_ids_start() + block] = docIds[count - 1];
+        out = BlockBitPacking::encode_doc_ids(docIds, count, prevDocId, out);
+        if (_encode_interleaved_features) {
+            out = BlockBitPacking::encode_values(fieldLengths, count, out);
+            out = BlockBitPacking::encode_values(numOccs, count, out);
+        }
+        prevDocId = docIds[count - 1];
+    }
+    size_t size = out - area;
+    size += (size & 1);     // Pad to 64 bits
+    _area.resize(size);
+}
+
+void
+BlockPostingWriter::write_docid_and_features(const DocIdAndFeatures &features)
+{
+    assert(_docIds.empty() || features.doc_id() > _docIds.back()._doc_id);
+    if (_encode_features != nullptr) {
+        _encode_features->writeFeatures(features);
+        uint64_t writeOffset = _encode_features->getWriteOffset();
+        uint64_t featureSize = writeOffset - _featureOffset;
+        assert(static_cast<uint32_t>(featureSize) == featureSize);
+        _docIds.emplace_back(features.doc_id(), features.field_length(), features.num_occs(),
+                             static_cast<uint32_t>(featureSize));
+        _featureOffset = writeOffset;
+    } else {
+        _docIds.emplace_back(features.doc_id(), features.field_length(), features.num_occs(), 0);
+    }
+}
+
+void
+BlockPostingWriter::flush_word()
+{
+    EncodeContext &e = _encode_context;
+    if (!_docIds.empty()) {
+        if (_encode_features != nullptr) {
+            _encode_features->flush();
+        }
+        uint32_t numDocs = _docIds.size();
+        make_area();
+        e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
+        e.encodeExpGolomb(_area.size() / 2 - 1, K_VALUE_ZCPOSTING_DOCIDSSIZE);
+        e.smallAlign(64);
+        e.writeBits(reinterpret_cast<const uint64_t *>(_area.data()), 0, _area.size() * 32);
+        if (_encode_features != nullptr) {
+            e.writeBits(_featureWriteContext.getComprBuf(), 0, _featureOffset);
+            _encode_features->setupWrite(_featureWriteContext);
+            _featureOffset = 0;
+        }
+        _counts._numDocs += numDocs;
+        _docIds.clear();
+        _numWords++;
+    }
+    uint64_t writePos = e.getWriteOffset();
+    _counts._bitLength = writePos - _writePos;
+    _writePos = writePos;
+}
+
+void
+BlockPostingWriter::set_encode_features(EncodeContext *encode_features)
+{
+    _encode_features = encode_features;
+    if (_encode_features != nullptr) {
+        _encode_features->setWriteContext(&_featureWriteContext);
+        _encode_features->setupWrite(_featureWriteContext);
+    }
+    _featureWriteContext.setEncodeContext(_encode_features);
+    _featureOffset = 0;
+}
+
+void
+BlockPostingWriter::set_posting_list_params(const PostingListParams &params)
+{
+    params.get("docIdLimit", _docIdLimit);
+    params.get("minChunkDocs", _minChunkDocs);
+    params.get("minSkipDocs", _minSkipDocs);
+    params.get("interleaved_features", _encode_interleaved_features);
+}
+
+void
+BlockPostingWriter::on_open()
+{
+    _numWords = 0;
+    _writePos = _encode_context.getWriteOffset(); // Position after file header
+}
+
+void
+BlockPostingWriter::on_close()
+{
+    // Pad to 64 bits alignment, then write 128 more bits to avoid
+    // decompression readahead going past memory mapped file during search.
+    _encode_context.smallAlign(64);
+    _encode_context.writeComprBufferIfNeeded();
+    _encode_context.padBits(128);
+    _encode_context.alignDirectIO();
+    _encode_context.flush();
+    _encode_context.writeComprBuffer();   // Also flushes slack
+}
+
+}
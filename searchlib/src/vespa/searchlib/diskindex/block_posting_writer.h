@@ -0,0 +1,72 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zc4_posting_writer_base.h"
+#include <vespa/searchlib/bitcompression/compression.h>
+#include <vector>
+
+namespace search::index {
+class DocIdAndFeatures;
+class PostingListCounts;
+class PostingListParams;
+}
+
+namespace search::diskindex {
+
+/*
+ * Class used to write posting lists of type "BlockPosOcc.1".
+ *
+ * Document ids are delta coded and bit packed in blocks of 128 documents,
+ * see BlockPostingLayout for the layout of a word. Features are buffered
+ * in memory until the word is flushed, since the per block feature offsets
+ * are written before the features. Words are never split into chunks.
+ */
+class BlockPostingWriter
+{
+    using DocIdAndFeatureSize = Zc4PostingWriterBase::DocIdAndFeatureSize;
+    using EncodeContext = bitcompression::FeatureEncodeContextBE;
+
+    uint32_t _minChunkDocs; // Only kept for file header compatibility
+    uint32_t _minSkipDocs;  // Only kept for file header compatibility
+    uint32_t _docIdLimit;   // Limit for document ids (docId < docIdLimit)
+    bool _encode_interleaved_features;
+    std::vector<DocIdAndFeatureSize> _docIds;
+    std::vector<uint32_t> _area;    // Block area for current word
+    uint64_t _featureOffset;        // Bit offset of next feature
+    uint64_t _writePos;             // Bit position for start of current word
+    uint64_t _numWords;             // Number of words in file
+    index::PostingListCounts &_counts;
+    search::ComprFileWriteContext _writeContext;
+    search::ComprFileWriteContext _featureWriteContext;
+    EncodeContext _encode_context;
+    // Buffer up features in memory
+    EncodeContext *_encode_features;
+
+    void make_area();
+public:
+    BlockPostingWriter(const BlockPostingWriter &) = delete;
+    BlockPostingWriter(BlockPostingWriter &&) = delete;
+    BlockPostingWriter &operator=(const BlockPostingWriter &) = delete;
+    BlockPostingWriter &operator=(BlockPostingWriter &&) = delete;
+    BlockPostingWriter(index::PostingListCounts &counts);
+    ~BlockPostingWriter();
+
+    void write_docid_and_features(const index::DocIdAndFeatures &features);
+    void flush_word();
+    void set_encode_features(EncodeContext *encode_features);
+    void set_posting_list_params(const index::PostingListParams &params);
+    void on_open();
+    void on_close();
+
+    EncodeContext &get_encode_features() { return *_encode_features; }
+    EncodeContext &get_encode_context() { return _encode_context; }
+    ComprFileWriteContext &get_write_context() { return _writeContext; }
+    uint32_t get_min_chunk_docs() const { return _minChunkDocs; }
+    uint32_t get_min_skip_docs() const { return _minSkipDocs; }
+    uint32_t get_docid_limit() const { return _docIdLimit; }
+    uint64_t get_num_words() const { return _numWords; }
+    bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+};
+
+}
@@ -0,0 +1,123 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dictionary_bloom_filter.h"
+#include <vespa/searchlib/common/fileheadercontext.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/fastos/file.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".diskindex.dictionary_bloom_filter");
+
+namespace search::diskindex {
+
+using common::FileHeaderContext;
+
+namespace {
+
+const size_t FILE_HEADERSIZE_ALIGNMENT = 4096;
+
+}
+
+DictionaryBloomFilter::DictionaryBloomFilter()
+    : _bits(),
+      _numBlocks(0),
+      _numWords(0)
+{
+}
+
+DictionaryBloomFilter::~DictionaryBloomFilter() = default;
+
+uint64_t
+DictionaryBloomFilter::hash_word(vespalib::stringref word)
+{
+    return vespalib::hashValue(word.data(), word.size());
+}
+
+void
+DictionaryBloomFilter::build(const std::vector<uint64_t> &hashes)
+{
+    _numWords = hashes.size();
+    _numBlocks = (_numWords * bits_per_word + block_bits - 1) / block_bits;
+    _bits.assign(static_cast<size_t>(_numBlocks) * block_words, 0);
+    for (uint64_t hash : hashes) {
+        uint64_t *block = const_cast<uint64_t *>(get_block(hash));
+        uint32_t h = static_cast<uint32_t>(hash);
+        uint32_t delta = ((h >> 17) | (h << 15)) | 1;
+        for (uint32_t i = 0; i < num_hashes; ++i, h += delta) {
+            uint32_t bit = h % block_bits;
+            block[bit / 64] |= (uint64_t(1) << (bit % 64));
+        }
+    }
+}
+
+bool
+DictionaryBloomFilter::save(const vespalib::string &name, const TuneFileSeqWrite &tuneFileWrite,
+                            const FileHeaderContext &fileHeaderContext) const
+{
+    FastOS_File file;
+    if (tuneFileWrite.getWantSyncWrites()) {
+        file.EnableSyncWrites();
+    }
+    if (!file.OpenWriteOnlyTruncate(name.c_str())) {
+        LOG(error, "Could not open dictionary bloom filter file '%s' for write", name.c_str());
+        return false;
+    }
+    vespalib::FileHeader h(FILE_HEADERSIZE_ALIGNMENT);
+    using Tag = vespalib::GenericHeader::Tag;
+    fileHeaderContext.addTags(h, name);
+    h.putTag(Tag("numWords", _numWords));
+    h.putTag(Tag("numBlocks", _numBlocks));
+    h.putTag(Tag("bitsPerWord", bits_per_word));
+    h.putTag(Tag("numHashes", num_hashes));
+    h.putTag(Tag("blockBits", block_bits));
+    h.putTag(Tag("bloom.hash", hash_function));
+    h.putTag(Tag("desc", "Dictionary bloom filter"));
+    FileHeaderContext::setFreezeTime(h);
+    h.writeFile(file);
+    size_t bytes = _bits.size() * sizeof(uint64_t);
+    if (bytes > 0) {
+        file.WriteBuf(_bits.data(), bytes);
+    }
+    if (!file.Sync() || !file.Close()) {
+        LOG(error, "Could not write dictionary bloom filter file '%s'", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+DictionaryBloomFilter::load(const vespalib::string &name)
+{
+    FastOS_File file;
+    if (!file.OpenReadOnly(name.c_str())) {
+        return false;
+    }
+    vespalib::FileHeader h;
+    uint32_t headerLen = h.readFile(file);
+    if (!h.hasTag("numWords") || !h.hasTag("numBlocks") ||
+        !h.hasTag("numHashes") || !h.hasTag("blockBits") || !h.hasTag("bloom.hash") ||
+        h.getTag("numHashes").asInteger() != num_hashes ||
+        h.getTag("blockBits").asInteger() != block_bits ||
+        h.getTag("bloom.hash").asString() != hash_function) {
+        LOG(warning, "Unsupported dictionary bloom filter file '%s', ignoring it", name.c_str());
+        return false;
+    }
+    uint64_t numWords = h.getTag("numWords").asInteger();
+    uint32_t numBlocks = h.getTag("numBlocks").asInteger();
+    size_t bytes = static_cast<size_t>(numBlocks) * block_words * sizeof(uint64_t);
+    if (file.GetSize() < static_cast<int64_t>(headerLen + bytes)) {
+        LOG(warning, "Truncated dictionary bloom filter file '%s', ignoring it", name.c_str());
+        return false;
+    }
+    std::vector<uint64_t> bits(static_cast<size_t>(numBlocks) * block_words);
+    if (bytes > 0) {
+        file.ReadBuf(bits.data(), bytes, headerLen);
+    }
+    _bits = std::move(bits);
+    _numBlocks = numBlocks;
+    _numWords = numWords;
+    return true;
+}
+
+}
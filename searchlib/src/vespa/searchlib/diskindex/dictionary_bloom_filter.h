@@ -0,0 +1,82 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace search::common { class FileHeaderContext; }
+
+namespace search::diskindex {
+
+/**
+ * Blocked bloom filter over the words in the dictionary of a disk index field.
+ *
+ * All bits for a word are set in the same 512-bit block, so a lookup touches
+ * a single cache line. Using 10 bits per word and 7 hash functions gives a
+ * false positive rate of about 1%. Lookups for words that are not present in
+ * the dictionary can then in most cases skip the dictionary lookup.
+ *
+ * The filter is built when writing the dictionary (see FieldWriter) and stored
+ * in a separate file next to the dictionary files.
+ */
+class DictionaryBloomFilter {
+public:
+    static constexpr uint32_t bits_per_word = 10;
+    static constexpr uint32_t num_hashes = 7;
+    static constexpr uint32_t block_bits = 512;
+    static constexpr uint32_t block_words = block_bits / 64;
+    // Stored in the file header, files built with another word hash are not loaded.
+    static constexpr const char *hash_function = "xxh64";
+
+private:
+    std::vector<uint64_t> _bits;
+    uint32_t              _numBlocks;
+    uint64_t              _numWords;
+
+    const uint64_t *get_block(uint64_t hash) const {
+        return &_bits[((hash >> 32) * _numBlocks >> 32) * block_words];
+    }
+
+public:
+    DictionaryBloomFilter();
+    ~DictionaryBloomFilter();
+
+    static uint64_t hash_word(vespalib::stringref word);
+
+    /**
+     * Build the filter from the hashes (see hash_word()) of all words in the dictionary.
+     */
+    void build(const std::vector<uint64_t> &hashes);
+
+    bool may_contain_hash(uint64_t hash) const {
+        if (_numBlocks == 0) {
+            return false;
+        }
+        const uint64_t *block = get_block(hash);
+        uint32_t h = static_cast<uint32_t>(hash);
+        uint32_t delta = ((h >> 17) | (h << 15)) | 1;
+        for (uint32_t i = 0; i < num_hashes; ++i, h += delta) {
+            uint32_t bit = h % block_bits;
+            if ((block[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Returns false if the word is surely not present in the dictionary.
+     */
+    bool may_contain(vespalib::stringref word) const { return may_contain_hash(hash_word(word)); }
+
+    uint64_t getNumWords() const { return _numWords; }
+    size_t getMemoryUsage() const { return _bits.size() * sizeof(uint64_t); }
+
+    bool save(const vespalib::string &name, const TuneFileSeqWrite &tuneFileWrite,
+              const common::FileHeaderContext &fileHeaderContext) const;
+    bool load(const vespalib::string &name);
+};
+
+}
@@ -53,9 +53,11 @@ DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
       _postingFiles(),
       _bitVectorDicts(),
       _dicts(),
+      _dictFilters(),
       _tuneFileSearch(),
       _cache(*this, cacheSize),
-      _size(0)
+      _size(0),
+      _skippedDictLookups(0)
 {
     calculateSize();
 }
@@ -87,9 +89,16 @@ DiskIndex::openDictionaries(const TuneFileSearch &tuneFileSearch)
         if (!dict->open(dictName, tuneFileSearch._read)) {
             LOG(warning, "Could not open disk dictionary '%s'", dictName.c_str());
             _dicts.clear();
+            _dictFilters.clear();
             return false;
         }
         _dicts.push_back(std::move(dict));
+        // Indexes written before the bloom filter was introduced have no filter file.
+        auto filter = std::make_unique<DictionaryBloomFilter>();
+        if (!filter->load(dictName + ".bloom")) {
+            filter.reset();
+        }
+        _dictFilters.push_back(std::move(filter));
     }
     return true;
 }
@@ -104,6 +113,7 @@ DiskIndex::openField(const vespalib::string &fieldDir,
     BitVectorDictionary::SP bDict;
     FileHeader fileHeader;
     bool dynamicK = false;
+    bool blockFormat = false;
     if (fileHeader.taste(postingName, tuneFileSearch._read)) {
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
@@ -121,15 +131,27 @@ DiskIndex::openField(const vespalib::string &fieldDir,
                    fileHeader.getFormats()[1] ==
                    DiskPostingFileReal::getSubIdentifier()) {
             dynamicK = false;
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   DiskPostingFileBlockReal::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   DiskPostingFileBlockReal::getSubIdentifier()) {
+            blockFormat = true;
         } else {
             LOG(warning,
                 "Could not detect format for posocc file read %s",
                 postingName.c_str());
         }
     }
-    pFile.reset(dynamicK ?
-                new DiskPostingFileDynamicKReal() :
-                new DiskPostingFileReal());
+    if (blockFormat) {
+        pFile.reset(new DiskPostingFileBlockReal());
+    } else {
+        pFile.reset(dynamicK ?
+                    new DiskPostingFileDynamicKReal() :
+                    new DiskPostingFileReal());
+    }
     if (!pFile->open(postingName, tuneFileSearch._read)) {
         LOG(warning,
             "Could not open posting list file '%s'",
@@ -284,7 +306,11 @@ DiskIndex::read(const Key & key, LookupResultVector & result)
         SchemaUtil::IndexIterator it(_schema, lr.indexId);
         uint32_t fieldId = it.getIndex();
         if (fieldId < _dicts.size()) {
-            (void) _dicts[fieldId]->lookup(key.getWord(), wordNum,offsetAndCounts);
+            if (may_contain(fieldId, key.getWord())) {
+                (void) _dicts[fieldId]->lookup(key.getWord(), wordNum,offsetAndCounts);
+            } else {
+                _skippedDictLookups.fetch_add(1, std::memory_order_relaxed);
+            }
         }
         lr.wordNum = wordNum;
         lr.counts.swap(offsetAndCounts._counts);
@@ -3,12 +3,14 @@
 #pragma once
 
 #include "bitvectordictionary.h"
+#include "dictionary_bloom_filter.h"
 #include "zcposoccrandread.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/field_length_info.h>
 #include <vespa/searchlib/queryeval/searchable.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.h>
+#include <atomic>
 
 namespace search::diskindex {
 
@@ -16,7 +18,9 @@ namespace search::diskindex {
  * This class represents a disk index that contains a set of field indexes that are independent of each other.
  *
  * Each field index has a dictionary, posting list files and bit vector files.
- * Parts of the disk dictionary and all bit vector dictionaries are loaded into memory during setup.
+ * Parts of the disk dictionary, the dictionary bloom filters and all bit vector dictionaries
+ * are loaded into memory during setup. The bloom filters are used to skip dictionary lookups
+ * for words that are not present.
  * All other files are just opened, ready for later access.
  */
 class DiskIndex : public queryeval::Searchable {
@@ -69,6 +73,7 @@ private:
     using DiskPostingFile = index::PostingListFileRandRead;
     using DiskPostingFileReal = Zc4PosOccRandRead;
     using DiskPostingFileDynamicKReal = ZcPosOccRandRead;
+    using DiskPostingFileBlockReal = BlockPosOccRandRead;
     using Cache = vespalib::cache<vespalib::CacheParam<vespalib::LruParam<Key, LookupResultVector>, DiskIndex>>;
 
     vespalib::string                       _indexDir;
@@ -77,9 +82,11 @@ private:
     std::vector<DiskPostingFile::SP>       _postingFiles;
     std::vector<BitVectorDictionary::SP>   _bitVectorDicts;
     std::vector<std::unique_ptr<index::DictionaryFileRandRead>> _dicts;
+    std::vector<std::unique_ptr<DictionaryBloomFilter>> _dictFilters; // nullptr if field has no filter
     TuneFileSearch                         _tuneFileSearch;
     Cache                                  _cache;
     uint64_t                               _size;
+    std::atomic<uint64_t>                  _skippedDictLookups;
 
     void calculateSize();
     bool loadSchema();
@@ -145,6 +152,19 @@ public:
      */
     uint64_t getSize() const { return _size; }
 
+    /**
+     * Returns false if the given word is surely not present in the dictionary for the given field.
+     */
+    bool may_contain(uint32_t fieldId, vespalib::stringref word) const {
+        const auto *filter = (fieldId < _dictFilters.size()) ? _dictFilters[fieldId].get() : nullptr;
+        return (filter == nullptr) || filter->may_contain(word);
+    }
+
+    /**
+     * Returns the number of dictionary lookups skipped because the bloom filter ruled out the word.
+     */
+    uint64_t getSkippedDictionaryLookups() const { return _skippedDictLookups.load(std::memory_order_relaxed); }
+
     const index::Schema &getSchema() const { return _schema; }
     const vespalib::string &getIndexDir() const { return _indexDir; }
 
@@ -2,6 +2,7 @@
 
 #include "extposocc.h"
 #include "zcposocc.h"
+#include "block_posocc.h"
 #include "fileheader.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
@@ -62,7 +63,9 @@ makePosOccWrite(PostingListCountFileSeqWrite *const posOccCountWrite,
 {
     std::unique_ptr<PostingListFileSeqWrite> posOccWrite;
 
-    if (dynamicK) {
+    if (schema.getIndexField(indexId).use_block_posting_format()) {
+        posOccWrite = std::make_unique<BlockPosOccSeqWrite>(schema, indexId, field_length_info, posOccCountWrite);
+    } else if (dynamicK) {
         posOccWrite = std::make_unique<ZcPosOccSeqWrite>(schema, indexId, field_length_info, posOccCountWrite);
     } else {
         posOccWrite = std::make_unique<Zc4PosOccSeqWrite>(schema, indexId, field_length_info, posOccCountWrite);
@@ -100,6 +103,14 @@ makePosOccRead(const vespalib::string &name,
                    fileHeader.getFormats()[1] ==
                    Zc4PosOccSeqRead::getSubIdentifier()) {
             posOccRead = std::make_unique<Zc4PosOccSeqRead>(posOccCountRead);
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   BlockPosOccSeqRead::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   BlockPosOccSeqRead::getSubIdentifier()) {
+            posOccRead = std::make_unique<BlockPosOccSeqRead>(posOccCountRead);
         } else {
             LOG(warning,
                 "Could not detect format for posocc file read %s",
@@ -27,7 +27,10 @@ FieldWriter::FieldWriter(uint32_t docIdLimit, uint64_t numWordIds)
       _numWordIds(numWordIds),
       _prefix(),
       _compactWordNum(0),
-      _word()
+      _word(),
+      _wordHashes(),
+      _tuneFileWrite(),
+      _fileHeaderContext(nullptr)
 {
 }
 
@@ -91,6 +94,9 @@ FieldWriter::open(const vespalib::string &prefix,
     _bmapfile.open(booloccbidxname.c_str(), _docIdLimit, tuneFileWrite,
                    fileHeaderContext);
 
+    _tuneFileWrite = tuneFileWrite;
+    _fileHeaderContext = &fileHeaderContext;
+
     return true;
 }
 
@@ -102,6 +108,7 @@ FieldWriter::flush()
     if (counts._numDocs != 0) {
         assert(_compactWordNum != 0);
         _dictFile->writeWord(_word, counts);
+        _wordHashes.push_back(DictionaryBloomFilter::hash_word(_word));
         // Write bitmap entries
         if (_bvc.getCrossedBitVectorLimit()) {
             _bmapfile.addWordSingle(_compactWordNum, _bvc.getBitVector());
@@ -158,6 +165,15 @@ FieldWriter::close()
     }
 
     _bmapfile.close();
+    if (_fileHeaderContext != nullptr) {
+        DictionaryBloomFilter filter;
+        filter.build(_wordHashes);
+        if (!filter.save(_prefix + "dictionary.bloom", _tuneFileWrite, *_fileHeaderContext)) {
+            ret = false;
+        }
+        _fileHeaderContext = nullptr;
+    }
+    std::vector<uint64_t>().swap(_wordHashes);
     return ret;
 }
 
@@ -185,6 +201,7 @@ static const char *termOccNames[] =
     "dictionary.spdat",
     "dictionary.ssdat",
     "dictionary.words",
+    "dictionary.bloom",
     nullptr,
 };
 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "bitvectorfile.h"
+#include "dictionary_bloom_filter.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
@@ -15,6 +16,8 @@ namespace search::diskindex {
  *
  * It is used by the fusion code to write the merged output for a field,
  * and by the memory index dump code to write a field to disk.
+ *
+ * A bloom filter over the words in the dictionary is written on close.
  */
 class FieldWriter {
 private:
@@ -43,6 +46,9 @@ private:
     vespalib::string _prefix;
     uint64_t _compactWordNum;
     vespalib::string _word;
+    std::vector<uint64_t> _wordHashes;
+    TuneFileSeqWrite _tuneFileWrite;
+    const search::common::FileHeaderContext *_fileHeaderContext;
 
     void flush();
 
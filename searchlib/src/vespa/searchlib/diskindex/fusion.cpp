@@ -11,11 +11,13 @@
 #include <vespa/searchlib/util/dirtraverse.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/vespalib/util/error.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/document/util/queue.h>
+#include <algorithm>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -171,17 +173,49 @@ Fusion::renumberFieldWordIds(const vespalib::string & dir, const SchemaUtil::Ind
 }
 
 
+uint64_t
+Fusion::estimateFieldInputSize(const SchemaUtil::IndexIterator &index) const
+{
+    uint64_t size = 0;
+    for (const auto &oi : _oldIndexes) {
+        if (!index.hasOldFields(oi.getSchema())) {
+            continue;
+        }
+        vespalib::string name = oi.getPath() + "/" + index.getName() + "/posocc.dat.compressed";
+        FastOS_StatInfo statInfo;
+        if (FastOS_File::Stat(name.c_str(), &statInfo)) {
+            size += statInfo._size;
+        }
+    }
+    return size;
+}
+
+
 bool
-Fusion::mergeFields(vespalib::ThreadExecutor & executor)
+Fusion::mergeFields(vespalib::ThreadExecutor & executor, uint32_t maxConcurrentFields)
 {
     const Schema &schema = getSchema();
+    // Start merging the largest fields first to avoid having one huge field
+    // merged alone on a single thread at the end of fusion.
+    std::vector<std::pair<uint64_t, uint32_t>> fields;
+    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+        fields.emplace_back(estimateFieldInputSize(iter), iter.getIndex());
+    }
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
     std::atomic<uint32_t> failed(0);
-    uint32_t maxConcurrentThreads = std::max(1ul, executor.getNumThreads()/2);
+    uint32_t maxConcurrentThreads = (maxConcurrentFields != 0)
+                                    ? maxConcurrentFields
+                                    : std::max(1ul, executor.getNumThreads()/2);
     document::Semaphore concurrent(maxConcurrentThreads);
-    vespalib::CountDownLatch  done(schema.getNumIndexFields());
-    for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+    vespalib::CountDownLatch  done(fields.size());
+    // Field writes are throttled with the priority of the flush running the fusion.
+    common::FlushIoThrottle::Priority ioPriority = common::FlushIoThrottle::currentPriority();
+    LOG(debug, "Merging %zu fields using up to %u concurrent threads", fields.size(), maxConcurrentThreads);
+    for (const auto &field : fields) {
         concurrent.wait();
-        executor.execute(vespalib::makeLambdaTask([this, index=iter.getIndex(), &failed, &done, &concurrent]() {
+        executor.execute(vespalib::makeLambdaTask([this, index=field.second, ioPriority, &failed, &done, &concurrent]() {
+            common::FlushIoThrottle::PriorityGuard priorityGuard(ioPriority);
             if (!mergeField(index)) {
                 failed++;
             }
@@ -189,9 +223,9 @@ Fusion::mergeFields(vespalib::ThreadExecutor & executor)
             done.countDown();
         }));
     }
-    LOG(debug, "Waiting for %u fields", schema.getNumIndexFields());
+    LOG(debug, "Waiting for %zu fields", fields.size());
     done.await();
-    LOG(debug, "Done waiting for %u fields", schema.getNumIndexFields());
+    LOG(debug, "Done waiting for %zu fields", fields.size());
     return (failed == 0u);
 }
 
@@ -510,7 +544,7 @@ bool
 Fusion::merge(const Schema &schema, const vespalib::string &dir, const std::vector<vespalib::string> &sources,
               const SelectorArray &selector, bool dynamicKPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing, const FileHeaderContext &fileHeaderContext,
-              vespalib::ThreadExecutor & executor)
+              vespalib::ThreadExecutor & executor, uint32_t maxConcurrentFields)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -550,7 +584,7 @@ Fusion::merge(const Schema &schema, const vespalib::string &dir, const std::vect
     try {
         auto fusion = std::make_unique<Fusion>(trimmedDocIdLimit, schema, dir, sources, selector,
                                                dynamicKPosOccFormat, tuneFileIndexing, fileHeaderContext);
-        return fusion->mergeFields(executor);
+        return fusion->mergeFields(executor, maxConcurrentFields);
     } catch (const std::exception & e) {
         LOG(error, "%s", e.what());
         return false;
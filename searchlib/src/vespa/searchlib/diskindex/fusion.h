@@ -48,8 +48,9 @@ private:
     using SchemaUtil = index::SchemaUtil;
     using WordNumMappingList = std::vector<WordNumMapping>;
 
-    bool mergeFields(vespalib::ThreadExecutor & executor);
+    bool mergeFields(vespalib::ThreadExecutor & executor, uint32_t maxConcurrentFields);
     bool mergeField(uint32_t id);
+    uint64_t estimateFieldInputSize(const SchemaUtil::IndexIterator &index) const;
     std::shared_ptr<FieldLengthScanner> allocate_field_length_scanner(const SchemaUtil::IndexIterator &index);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index, const WordNumMappingList & list,
                                std::vector<std::unique_ptr<FieldReader> > & readers);
@@ -90,10 +91,19 @@ public:
 
     ~Fusion();
 
+    /**
+     * Merge the given source indexes into a new disk index in dir.
+     *
+     * Index fields are merged concurrently in the executor, with the largest
+     * fields (by input posting file size) started first. At most
+     * maxConcurrentFields fields are merged at the same time, 0 means half
+     * the number of threads in the executor.
+     */
     static bool
     merge(const Schema &schema, const vespalib::string &dir, const std::vector<vespalib::string> &sources,
           const SelectorArray &docIdSelector, bool dynamicKPosOccFormat, const TuneFileIndexing &tuneFileIndexing,
-          const common::FileHeaderContext &fileHeaderContext, vespalib::ThreadExecutor & executor);
+          const common::FileHeaderContext &fileHeaderContext, vespalib::ThreadExecutor & executor,
+          uint32_t maxConcurrentFields);
 };
 
 }
@@ -132,6 +132,46 @@ FileHandle::close()
     (void) ret;
 }
 
+namespace {
+
+/**
+ * Builder for a single field, writing directly to the field writer for that field.
+ */
+class FieldBuilder : public index::FieldIndexBuilder {
+private:
+    IndexBuilder::FieldHandle &_field;
+    bool                       _inWord;
+
+public:
+    FieldBuilder(IndexBuilder::FieldHandle &field)
+        : _field(field),
+          _inWord(false)
+    {
+    }
+    ~FieldBuilder() override;
+
+    void startWord(vespalib::stringref word) override {
+        assert(!_inWord);
+        _inWord = true;
+        _field.new_word(word);
+    }
+    void endWord() override {
+        assert(_inWord);
+        _inWord = false;
+    }
+    void add_document(const DocIdAndFeatures &features) override {
+        assert(_inWord);
+        _field.add_document(features);
+    }
+};
+
+FieldBuilder::~FieldBuilder()
+{
+    assert(!_inWord);
+}
+
+}
+
 IndexBuilder::FieldHandle::FieldHandle(const Schema &schema,
                                        uint32_t fieldId,
                                        IndexBuilder *builder)
@@ -272,6 +312,14 @@ IndexBuilder::add_document(const index::DocIdAndFeatures &features)
     _currentField->add_document(features);
 }
 
+std::unique_ptr<index::FieldIndexBuilder>
+IndexBuilder::startFieldBuilder(uint32_t fieldId)
+{
+    assert(_currentField == nullptr);
+    assert(fieldId < _fields.size());
+    return std::make_unique<FieldBuilder>(_fields[fieldId]);
+}
+
 void
 IndexBuilder::setPrefix(vespalib::stringref prefix)
 {
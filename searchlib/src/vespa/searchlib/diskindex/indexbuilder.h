@@ -18,6 +18,8 @@ class BitVectorCandidate;
  * Class used to build a disk index for the set of index fields specified in a schema.
  *
  * The resulting disk index consists of field indexes that are independent of each other.
+ * Each field is written by a separate field writer, so fields can be built concurrently
+ * using the builders returned by startFieldBuilder().
  */
 class IndexBuilder : public index::IndexBuilder {
 public:
@@ -59,6 +61,7 @@ public:
     void startWord(vespalib::stringref word) override;
     void endWord() override;
     void add_document(const index::DocIdAndFeatures &features) override;
+    std::unique_ptr<index::FieldIndexBuilder> startFieldBuilder(uint32_t fieldId) override;
 
     void setPrefix(vespalib::stringref prefix);
 
@@ -2,6 +2,8 @@
 
 #include "zcposoccrandread.h"
 #include "zcposocciterators.h"
+#include "block_posocc.h"
+#include "block_posocc_iterator.h"
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
@@ -34,6 +36,24 @@ namespace search::diskindex {
 
 using vespalib::getLastErrorString;
 
+namespace {
+
+bitcompression::Position
+get_start_position(const PostingListHandle &handle)
+{
+    const char *cmem = static_cast<const char *>(handle._mem);
+    uint64_t memOffset = reinterpret_cast<unsigned long>(cmem) & 7;
+    const uint64_t *mem = reinterpret_cast<const uint64_t *>
+                          (cmem - memOffset) +
+                          (memOffset * 8 + handle._bitOffset -
+                           handle._bitOffsetMem) / 64;
+    int bitOffset = (memOffset * 8 + handle._bitOffset -
+                     handle._bitOffsetMem) & 63;
+    return Position(mem, bitOffset);
+}
+
+}
+
 ZcPosOccRandRead::ZcPosOccRandRead()
     : _file(std::make_unique<FastOS_File>()),
       _fileSize(0),
@@ -70,17 +90,7 @@ createIterator(const PostingListCounts &counts,
         return new search::queryeval::EmptySearch;
     }
 
-    const char *cmem = static_cast<const char *>(handle._mem);
-    uint64_t memOffset = reinterpret_cast<unsigned long>(cmem) & 7;
-    const uint64_t *mem = reinterpret_cast<const uint64_t *>
-                          (cmem - memOffset) +
-                          (memOffset * 8 + handle._bitOffset -
-                           handle._bitOffsetMem) / 64;
-    int bitOffset = (memOffset * 8 + handle._bitOffset -
-                     handle._bitOffsetMem) & 63;
-
-    Position start(mem, bitOffset);
-    return create_zc_posocc_iterator(true, counts, start, handle._bitLength, _posting_params, _fieldsParams, matchData).release();
+    return create_zc_posocc_iterator(true, counts, get_start_position(handle), handle._bitLength, _posting_params, _fieldsParams, matchData).release();
 }
 
 
@@ -281,4 +291,46 @@ Zc4PosOccRandRead::getSubIdentifier()
     return d.getIdentifier();
 }
 
+BlockPosOccRandRead::BlockPosOccRandRead()
+    : ZcPosOccRandRead()
+{
+    _posting_params._dynamic_k = false;
+}
+
+search::queryeval::SearchIterator *
+BlockPosOccRandRead::createIterator(const PostingListCounts &counts,
+                                    const PostingListHandle &handle,
+                                    const search::fef::TermFieldMatchDataArray &matchData,
+                                    bool usebitVector) const
+{
+    (void) usebitVector;
+
+    assert((handle._bitLength != 0) == (counts._bitLength != 0));
+    assert((counts._numDocs != 0) == (counts._bitLength != 0));
+    assert(handle._bitOffsetMem <= handle._bitOffset);
+
+    if (handle._bitLength == 0) {
+        return new search::queryeval::EmptySearch;
+    }
+    return create_block_posocc_iterator(get_start_position(handle), handle._bitLength, _posting_params, _fieldsParams, matchData).release();
+}
+
+void
+BlockPosOccRandRead::readHeader()
+{
+    readHeader<EG2PosOccDecodeContext<true> >(getIdentifier());
+}
+
+const vespalib::string &
+BlockPosOccRandRead::getIdentifier()
+{
+    return BlockPosOccSeqRead::getIdentifier();
+}
+
+const vespalib::string &
+BlockPosOccRandRead::getSubIdentifier()
+{
+    return BlockPosOccSeqRead::getSubIdentifier();
+}
+
 }
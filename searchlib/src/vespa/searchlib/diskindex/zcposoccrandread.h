@@ -65,5 +65,23 @@ public:
     static const vespalib::string &getSubIdentifier();
 };
 
+/*
+ * Random access reader for posting list files of type "BlockPosOcc.1".
+ * Posting lists are read the same way as for "Zc.4", only the iterator differs.
+ */
+class BlockPosOccRandRead : public ZcPosOccRandRead
+{
+    using ZcPosOccRandRead::readHeader;
+public:
+    BlockPosOccRandRead();
+
+    queryeval::SearchIterator *
+    createIterator(const PostingListCounts &counts, const PostingListHandle &handle,
+                   const fef::TermFieldMatchDataArray &matchData, bool usebitVector) const override;
+    void readHeader() override;
+
+    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getSubIdentifier();
+};
 
 }
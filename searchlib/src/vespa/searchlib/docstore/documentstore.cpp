@@ -7,8 +7,11 @@
 #include "value.h"
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <algorithm>
+#include <array>
 
 #include <vespa/log/log.h>
 
@@ -109,6 +112,133 @@ public:
     Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
 };
 
+/**
+ * Serialized documents written and removed in the document store, but not
+ * yet in the backing store. Keeps the last operation per lid, a remove is
+ * kept as an empty value (tombstone). Lids are spread over stripes with
+ * their own lock, so lookups by readers only contend with writes to lids
+ * in the same stripe.
+ */
+class PendingWrites {
+public:
+    using Entry = std::pair<DocumentIdT, Value>;
+    PendingWrites() : _stripes(), _bytes(0), _docIdLimit(0), _lastSyncToken(0) { }
+    void put(DocumentIdT lid, Value value);
+    /**
+     * Returns true if the lid has a pending operation. The value is empty
+     * if the pending operation is a remove.
+     */
+    bool get(DocumentIdT lid, Value &value) const;
+    bool contains(DocumentIdT lid) const;
+    void remove(DocumentIdT lid, uint64_t syncToken);
+    std::vector<Entry> getAll() const;
+    size_t bytes() const { return _bytes.load(std::memory_order_relaxed); }
+    bool empty() const { return bytes() == 0; }
+    uint32_t getDocIdLimit() const { return _docIdLimit.load(std::memory_order_relaxed); }
+    void resetDocIdLimit() { _docIdLimit.store(0, std::memory_order_relaxed); }
+    uint64_t getLastSyncToken() const { return _lastSyncToken.load(std::memory_order_relaxed); }
+private:
+    static constexpr size_t NUM_STRIPES = 64;
+    struct Stripe {
+        mutable std::mutex                     lock;
+        vespalib::hash_map<DocumentIdT, Value> writes;
+    };
+    static size_t entryBytes(const Value &value) { return sizeof(Entry) + value.size(); }
+    Stripe &getStripe(DocumentIdT lid) { return _stripes[lid % NUM_STRIPES]; }
+    const Stripe &getStripe(DocumentIdT lid) const { return _stripes[lid % NUM_STRIPES]; }
+
+    std::array<Stripe, NUM_STRIPES> _stripes;
+    std::atomic<size_t>             _bytes;
+    // Only increased by put(), which is called by the single writer thread.
+    std::atomic<uint32_t>           _docIdLimit;
+    std::atomic<uint64_t>           _lastSyncToken;
+};
+
+void
+PendingWrites::put(DocumentIdT lid, Value value)
+{
+    Stripe &stripe = getStripe(lid);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    size_t addedBytes = entryBytes(value);
+    uint64_t syncToken = value.getSyncToken();
+    auto itr = stripe.writes.find(lid);
+    if (itr != stripe.writes.end()) {
+        _bytes.fetch_sub(entryBytes(itr->second), std::memory_order_relaxed);
+        itr->second = std::move(value);
+    } else {
+        stripe.writes[lid] = std::move(value);
+    }
+    _bytes.fetch_add(addedBytes, std::memory_order_relaxed);
+    if (lid >= getDocIdLimit()) {
+        _docIdLimit.store(lid + 1, std::memory_order_relaxed);
+    }
+    if (syncToken > getLastSyncToken()) {
+        _lastSyncToken.store(syncToken, std::memory_order_relaxed);
+    }
+}
+
+bool
+PendingWrites::get(DocumentIdT lid, Value &value) const
+{
+    if (empty()) {
+        return false;
+    }
+    const Stripe &stripe = getStripe(lid);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    auto itr = stripe.writes.find(lid);
+    if (itr == stripe.writes.end()) {
+        return false;
+    }
+    value = Value(itr->second);
+    return true;
+}
+
+bool
+PendingWrites::contains(DocumentIdT lid) const
+{
+    if (empty()) {
+        return false;
+    }
+    const Stripe &stripe = getStripe(lid);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    return stripe.writes.find(lid) != stripe.writes.end();
+}
+
+void
+PendingWrites::remove(DocumentIdT lid, uint64_t syncToken)
+{
+    Stripe &stripe = getStripe(lid);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    auto itr = stripe.writes.find(lid);
+    if ((itr != stripe.writes.end()) && (itr->second.getSyncToken() == syncToken)) {
+        _bytes.fetch_sub(entryBytes(itr->second), std::memory_order_relaxed);
+        stripe.writes.erase(itr);
+    }
+}
+
+std::vector<PendingWrites::Entry>
+PendingWrites::getAll() const
+{
+    // All stripes are locked while copying, so the result is a consistent snapshot:
+    // if it contains a write it also contains all earlier writes of other lids.
+    std::vector<std::unique_lock<std::mutex>> guards;
+    guards.reserve(NUM_STRIPES);
+    for (const Stripe &stripe : _stripes) {
+        guards.emplace_back(stripe.lock);
+    }
+    std::vector<Entry> result;
+    for (const Stripe &stripe : _stripes) {
+        for (const auto & entry : stripe.writes) {
+            result.emplace_back(entry.first, entry.second);
+        }
+    }
+    // The backing store requires writes to arrive in sync token order
+    std::sort(result.begin(), result.end(), [](const Entry & a, const Entry & b) {
+        return a.second.getSyncToken() < b.second.getSyncToken();
+    });
+    return result;
+}
+
 }
 
 using VisitCache = docstore::VisitCache;
@@ -120,6 +250,7 @@ DocumentStore::Config::operator == (const Config &rhs) const {
             (_allowVisitCaching == rhs._allowVisitCaching) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
             (_updateStrategy == rhs._updateStrategy) &&
+            (_maxPendingWriteBytes == rhs._maxPendingWriteBytes) &&
             (_compression == rhs._compression);
 }
 
@@ -131,6 +262,8 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _store(std::make_unique<docstore::BackingStore>(_backingStore, config.getCompression())),
       _cache(std::make_unique<docstore::Cache>(*_store, config.getMaxCacheBytes())),
       _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression())),
+      _pendingWrites(std::make_unique<docstore::PendingWrites>()),
+      _backingWriteLock(),
       _uncached_lookups(0)
 {
     _cache->reserveElements(config.getInitialCacheEntries());
@@ -155,6 +288,33 @@ DocumentStore::useCache() const {
 void
 DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
 {
+    if ( ! _pendingWrites->empty()) {
+        LidVector storedLids;
+        DocumentVisitorAdapter adapter(repo, visitor);
+        for (DocumentIdT lid : lids) {
+            Value value;
+            if (_pendingWrites->get(lid, value)) {
+                if ( ! value.empty()) {
+                    Value::Result result = value.decompressed();
+                    assert(result.second);
+                    adapter.visit(lid, vespalib::ConstBufferRef(result.first.getData(), result.first.getDataLen()));
+                }
+            } else {
+                storedLids.push_back(lid);
+            }
+        }
+        visitStored(storedLids, repo, visitor);
+    } else {
+        visitStored(lids, repo, visitor);
+    }
+}
+
+void
+DocumentStore::visitStored(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    if (lids.empty()) {
+        return;
+    }
     if (useCache() && _config.allowVisitCaching() && visitor.allowVisitCaching()) {
         docstore::BlobSet blobSet = _visitCache->read(lids).getBlobSet();
         DocumentVisitorAdapter adapter(repo, visitor);
@@ -166,10 +326,24 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
     }
 }
 
+bool
+DocumentStore::isCached(DocumentIdT lid) const
+{
+    return _pendingWrites->contains(lid) || (useCache() && _cache->hasKey(lid));
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
     Value value;
+    if (_pendingWrites->get(lid, value)) {
+        if (value.empty()) {
+            return std::unique_ptr<document::Document>();
+        }
+        Value::Result result = value.decompressed();
+        assert(result.second);
+        return std::make_unique<document::Document>(repo, std::move(result.first));
+    }
     if (useCache()) {
         value = _cache->read(lid);
         if (value.empty()) {
@@ -203,6 +377,32 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Docume
 
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostream & stream) {
+    size_t maxPendingWriteBytes = _config.getMaxPendingWriteBytes();
+    if (maxPendingWriteBytes == 0) {
+        if ( ! _pendingWrites->empty()) {
+            std::lock_guard<std::mutex> guard(_backingWriteLock);
+            drainPendingWrites();
+        }
+        writeThrough(syncToken, lid, stream);
+        return;
+    }
+    vespalib::DataBuffer buf(stream.size());
+    buf.writeBytes(stream.peek(), stream.size());
+    Value value(syncToken);
+    value.set(std::move(buf), stream.size());
+    _pendingWrites->put(lid, std::move(value));
+    if (useCache()) {
+        _cache->invalidate(lid);
+        _visitCache->invalidate(lid);
+    }
+    if (_pendingWrites->bytes() > maxPendingWriteBytes) {
+        std::lock_guard<std::mutex> guard(_backingWriteLock);
+        drainPendingWrites();
+    }
+}
+
+void
+DocumentStore::writeThrough(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostream & stream) {
     if (useCache()) {
         switch (_config.updateStrategy()) {
             case Config::UpdateStrategy::INVALIDATE:
@@ -227,9 +427,54 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
     }
 }
 
+void
+DocumentStore::drainPendingWrites()
+{
+    if (_pendingWrites->empty()) {
+        return;
+    }
+    for (const auto & entry : _pendingWrites->getAll()) {
+        DocumentIdT lid = entry.first;
+        const Value & value = entry.second;
+        if (value.empty()) {
+            _backingStore.remove(value.getSyncToken(), lid);
+        } else {
+            Value::Result result = value.decompressed();
+            assert(result.second);
+            _backingStore.write(value.getSyncToken(), lid, result.first.getData(), result.first.getDataLen());
+        }
+        _pendingWrites->remove(lid, value.getSyncToken());
+        if (useCache()) {
+            _cache->invalidate(lid);
+            _visitCache->invalidate(lid);
+        }
+    }
+}
+
+size_t
+DocumentStore::getPendingWriteBytes() const
+{
+    return _pendingWrites->bytes();
+}
+
 void
 DocumentStore::remove(uint64_t syncToken, DocumentIdT lid)
 {
+    size_t maxPendingWriteBytes = _config.getMaxPendingWriteBytes();
+    if (maxPendingWriteBytes != 0) {
+        _pendingWrites->put(lid, Value(syncToken));
+        if (useCache()) {
+            _cache->invalidate(lid);
+            _visitCache->invalidate(lid);
+        }
+        if (_pendingWrites->bytes() > maxPendingWriteBytes) {
+            std::lock_guard<std::mutex> guard(_backingWriteLock);
+            drainPendingWrites();
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_backingWriteLock);
+    drainPendingWrites();
     _backingStore.remove(syncToken, lid);
     if (useCache()) {
         _cache->invalidate(lid);
@@ -241,6 +486,8 @@ void
 DocumentStore::compact(uint64_t syncToken)
 {
     (void) syncToken;
+    std::lock_guard<std::mutex> guard(_backingWriteLock);
+    drainPendingWrites();
     // Most implementations does not offer compact.
 }
 
@@ -253,6 +500,8 @@ DocumentStore::flush(uint64_t syncToken)
 uint64_t
 DocumentStore::initFlush(uint64_t syncToken)
 {
+    std::lock_guard<std::mutex> guard(_backingWriteLock);
+    drainPendingWrites();
     return _backingStore.initFlush(syncToken);
 }
 
@@ -265,7 +514,13 @@ DocumentStore::lastSyncToken() const
 uint64_t
 DocumentStore::tentativeLastSyncToken() const
 {
-    return _backingStore.tentativeLastSyncToken();
+    return std::max(_backingStore.tentativeLastSyncToken(), _pendingWrites->getLastSyncToken());
+}
+
+uint32_t
+DocumentStore::getDocIdLimit() const
+{
+    return std::max(_backingStore.getDocIdLimit(), _pendingWrites->getDocIdLimit());
 }
 
 vespalib::system_time
@@ -388,6 +643,10 @@ void
 DocumentStore::accept(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
                       const DocumentTypeRepo &repo)
 {
+    {
+        std::lock_guard<std::mutex> guard(_backingWriteLock);
+        drainPendingWrites();
+    }
     WrapVisitor<IDocumentStoreReadVisitor> wrap(visitor, repo, _store->getCompression(), *this,
                                                 _backingStore.tentativeLastSyncToken());
     WrapVisitorProgress wrapVisitorProgress(visitorProgress);
@@ -398,6 +657,10 @@ void
 DocumentStore::accept(IDocumentStoreRewriteVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
                       const DocumentTypeRepo &repo)
 {
+    {
+        std::lock_guard<std::mutex> guard(_backingWriteLock);
+        drainPendingWrites();
+    }
     WrapVisitor<IDocumentStoreRewriteVisitor> wrap(visitor, repo, _store->getCompression(), *this,
                                                    _backingStore.tentativeLastSyncToken());
     WrapVisitorProgress wrapVisitorProgress(visitorProgress);
@@ -416,10 +679,20 @@ DocumentStore::getStorageStats() const
     return _backingStore.getStorageStats();
 }
 
+size_t
+DocumentStore::memoryUsed() const
+{
+    return _backingStore.memoryUsed() + _pendingWrites->bytes();
+}
+
 vespalib::MemoryUsage
 DocumentStore::getMemoryUsage() const
 {
-    return _backingStore.getMemoryUsage();
+    vespalib::MemoryUsage usage = _backingStore.getMemoryUsage();
+    size_t pendingBytes = _pendingWrites->bytes();
+    usage.incAllocatedBytes(pendingBytes);
+    usage.incUsedBytes(pendingBytes);
+    return usage;
 }
 
 std::vector<DataStoreFileChunkStats>
@@ -439,6 +712,9 @@ CacheStats DocumentStore::getCacheStats() const {
 void
 DocumentStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
+    std::lock_guard<std::mutex> guard(_backingWriteLock);
+    drainPendingWrites();
+    _pendingWrites->resetDocIdLimit();
     _backingStore.compactLidSpace(wantedDocLidLimit);
 }
 
@@ -4,11 +4,13 @@
 
 #include "idocumentstore.h"
 #include <vespa/vespalib/util/compressionconfig.h>
+#include <mutex>
 
 namespace search::docstore {
     class VisitCache;
     class BackingStore;
     class Cache;
+    class PendingWrites;
 }
 
 namespace search {
@@ -17,6 +19,12 @@ namespace search {
  * Simple document store that contains serialized Document instances.
  * updates will be held in memory until flush() is called.
  * Uses a Local ID as key.
+ *
+ * If max pending write bytes is configured, writes and removes are kept in
+ * memory and later operations on the same lid replace earlier ones, so a
+ * document that is updated many times between flushes is only written once
+ * to the backing store. Pending operations are written to the backing store
+ * when they exceed the limit and when initFlush() or compact() is called.
  **/
 class DocumentStore : public IDocumentStore
 {
@@ -30,14 +38,16 @@ public:
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _maxPendingWriteBytes(0)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _maxPendingWriteBytes(0)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
@@ -46,6 +56,8 @@ public:
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
         Config & updateStrategy(UpdateStrategy strategy) { _updateStrategy = strategy; return *this; }
         UpdateStrategy updateStrategy() const { return _updateStrategy; }
+        Config & maxPendingWriteBytes(size_t maxBytes) { _maxPendingWriteBytes = maxBytes; return *this; }
+        size_t getMaxPendingWriteBytes() const { return _maxPendingWriteBytes; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
@@ -53,6 +65,7 @@ public:
         size_t _initialCacheEntries;
         UpdateStrategy _updateStrategy;
         bool   _allowVisitCaching;
+        size_t _maxPendingWriteBytes;
     };
 
     /**
@@ -67,6 +80,7 @@ public:
 
     DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
+    bool isCached(DocumentIdT lid) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
     void remove(uint64_t syncToken, DocumentIdT lid) override;
@@ -76,8 +90,8 @@ public:
     uint64_t lastSyncToken() const override;
     uint64_t tentativeLastSyncToken() const override;
     vespalib::system_time getLastFlushTime() const override;
-    uint32_t getDocIdLimit() const override { return _backingStore.getDocIdLimit(); }
-    size_t        memoryUsed() const override { return _backingStore.memoryUsed(); }
+    uint32_t getDocIdLimit() const override;
+    size_t        memoryUsed() const override;
     size_t  getDiskFootprint() const override { return _backingStore.getDiskFootprint(); }
     size_t      getDiskBloat() const override { return _backingStore.getDiskBloat(); }
     size_t getMaxCompactGain() const override { return _backingStore.getMaxCompactGain(); }
@@ -102,8 +116,19 @@ public:
     void shrinkLidSpace() override;
     void reconfigure(const Config & config);
 
+    size_t getPendingWriteBytes() const;
+
 private:
     bool useCache() const;
+    void writeThrough(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostream & os);
+    /**
+     * Writes pending operations to the backing store in sync token order.
+     * Must be called with _backingWriteLock held. The backing store requires
+     * increasing sync tokens, so this relies on pending operations only being
+     * added by the writer thread, in sync token order.
+     */
+    void drainPendingWrites();
+    void visitStored(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     template <class> class WrapVisitor;
     class WrapVisitorProgress;
@@ -112,6 +137,8 @@ private:
     std::unique_ptr<docstore::BackingStore>  _store;
     std::unique_ptr<docstore::Cache>         _cache;
     std::unique_ptr<docstore::VisitCache>    _visitCache;
+    std::unique_ptr<docstore::PendingWrites> _pendingWrites;
+    std::mutex                               _backingWriteLock;
     mutable std::atomic<uint64_t>            _uncached_lookups;
 };
 
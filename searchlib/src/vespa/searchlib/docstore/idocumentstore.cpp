@@ -15,4 +15,8 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+bool IDocumentStore::isCached(DocumentIdT) const {
+    return false;
+}
+
 } // namespace search
@@ -87,6 +87,12 @@ public:
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
+    /**
+     * Returns true if the document for the lid can be read without touching disk,
+     * i.e. it is in the summary cache or not yet written to the backing store.
+     **/
+    virtual bool isCached(DocumentIdT lid) const;
+
     /**
      * Serialize and store a document.
      * @param doc The document to store
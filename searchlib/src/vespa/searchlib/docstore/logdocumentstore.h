@@ -51,7 +51,10 @@ public:
     ~LogDocumentStore() override;
     void reconfigure(const Config & config);
 private:
-    void compact(uint64_t syncToken) override       { _backingStore.compact(syncToken); }
+    void compact(uint64_t syncToken) override {
+        DocumentStore::compact(syncToken);
+        _backingStore.compact(syncToken);
+    }
     LogDataStore _backingStore;
 };
 
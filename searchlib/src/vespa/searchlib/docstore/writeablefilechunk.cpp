@@ -57,19 +57,23 @@ public:
 class ProcessedChunk
 {
 public:
-    ProcessedChunk(uint32_t chunkId, uint32_t alignment)
+    ProcessedChunk(uint32_t chunkId, uint32_t alignment, std::optional<common::FlushIoThrottle::Priority> ioPriority)
             : _chunkId(chunkId),
               _payLoad(0),
+              _ioPriority(ioPriority),
               _buf(0ul, alignment)
     { }
     void setPayLoad() { _payLoad = _buf.getDataLen(); }
     uint32_t getPayLoad() const { return _payLoad; }
     uint32_t getChunkId() const { return _chunkId; }
+    // Set for chunks written by a flush, writes of these are throttled.
+    std::optional<common::FlushIoThrottle::Priority> getIoPriority() const { return _ioPriority; }
     const vespalib::DataBuffer & getBuf() const { return _buf; }
     vespalib::DataBuffer & getBuf() { return _buf; }
 private:
     uint32_t             _chunkId;
     uint32_t             _payLoad;
+    std::optional<common::FlushIoThrottle::Priority> _ioPriority;
     vespalib::DataBuffer _buf;
 };
 
@@ -278,7 +282,7 @@ WriteableFileChunk::read(uint32_t lid, SubChunkId chunkId, vespalib::DataBuffer
 }
 
 void
-WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
+WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum, std::optional<common::FlushIoThrottle::Priority> ioPriority)
 {
     Chunk * active(nullptr);
     {
@@ -286,7 +290,7 @@ WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
         active = _chunkMap[chunkId].get();
     }
 
-    auto tmp = std::make_unique<ProcessedChunk>(chunkId, _alignment);
+    auto tmp = std::make_unique<ProcessedChunk>(chunkId, _alignment, ioPriority);
     if (_alignment > 1) {
         tmp->getBuf().ensureFree(active->getMaxPackSize(_config.getCompression()) + _alignment - 1);
     }
@@ -462,12 +466,25 @@ WriteableFileChunk::computeChunkMeta(ProcessedChunkQ & chunks, size_t startPos,
 void
 WriteableFileChunk::writeData(const ProcessedChunkQ & chunks, size_t sz)
 {
+    using common::FlushIoThrottle;
     vespalib::DataBuffer buf(0ul, _alignment);
     buf.ensureFree(sz);
+    size_t urgentBytes(0);
+    size_t backgroundBytes(0);
     for (const auto & chunk : chunks) {
         buf.writeBytes(chunk->getBuf().getData(), chunk->getBuf().getDataLen());
+        auto ioPriority = chunk->getIoPriority();
+        if (ioPriority) {
+            ((*ioPriority == FlushIoThrottle::Priority::URGENT) ? urgentBytes : backgroundBytes) += chunk->getBuf().getDataLen();
+        }
     }
 
+    if (urgentBytes > 0) {
+        FlushIoThrottle::instance().acquire(urgentBytes, FlushIoThrottle::Priority::URGENT);
+    }
+    if (backgroundBytes > 0) {
+        FlushIoThrottle::instance().acquire(backgroundBytes, FlushIoThrottle::Priority::BACKGROUND);
+    }
     LockGuard guard(_writeLock);
     ssize_t wlen = _dataFile.Write2(buf.getData(), buf.getDataLen());
     if (wlen != static_cast<ssize_t>(buf.getDataLen())) {
@@ -653,7 +670,12 @@ WriteableFileChunk::flush(bool block, uint64_t syncToken)
     int32_t chunkId = flushLastIfNonEmpty(syncToken > _serialNum);
     if (chunkId >= 0) {
         setSerialNum(syncToken);
-        _executor.execute(makeLambdaTask([this, chunkId, serialNum=_serialNum] { internalFlush(chunkId, serialNum); }));
+        // Only chunks written by flushes are throttled, not the ones written when feeding fills a chunk.
+        std::optional<common::FlushIoThrottle::Priority> ioPriority;
+        if (common::FlushIoThrottle::inFlush()) {
+            ioPriority = common::FlushIoThrottle::currentPriority();
+        }
+        _executor.execute(makeLambdaTask([this, chunkId, serialNum=_serialNum, ioPriority] { internalFlush(chunkId, serialNum, ioPriority); }));
     } else {
         if (block) {
             MonitorGuard guard(_lock);
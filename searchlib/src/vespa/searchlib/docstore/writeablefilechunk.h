@@ -4,10 +4,12 @@
 
 #include "filechunk.h"
 #include <vespa/vespalib/util/executor.h>
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/searchlib/transactionlog/syncproxy.h>
 #include <vespa/fastos/file.h>
 #include <map>
 #include <deque>
+#include <optional>
 
 namespace search {
 
@@ -79,7 +81,7 @@ private:
     void waitForChunkFlushedToDisk(uint32_t chunkId) const;
     void waitForAllChunksFlushedToDisk() const;
     void fileWriter(const uint32_t firstChunkId);
-    void internalFlush(uint32_t, uint64_t serialNum);
+    void internalFlush(uint32_t, uint64_t serialNum, std::optional<common::FlushIoThrottle::Priority> ioPriority);
     void enque(ProcessedChunkUP);
     int32_t flushLastIfNonEmpty(bool force);
     // _writeMonitor should not be held when calling restart
@@ -0,0 +1,24 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search::index {
+
+class DocIdAndFeatures;
+
+/**
+ * Interface used to build the index for a single index field.
+ *
+ * For each unique word in sorted order, start the word, add the set of
+ * document ids in sorted order with position information, and end the word.
+ */
+class FieldIndexBuilder {
+public:
+    virtual ~FieldIndexBuilder();
+    virtual void startWord(vespalib::stringref word) = 0;
+    virtual void endWord() = 0;
+    virtual void add_document(const DocIdAndFeatures &features) = 0;
+};
+
+}
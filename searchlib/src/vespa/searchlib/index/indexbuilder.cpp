@@ -4,6 +4,8 @@
 
 namespace search::index {
 
+FieldIndexBuilder::~FieldIndexBuilder() = default;
+
 IndexBuilder::IndexBuilder(const Schema &schema)
     : _schema(schema)
 {
@@ -11,4 +13,10 @@ IndexBuilder::IndexBuilder(const Schema &schema)
 
 IndexBuilder::~IndexBuilder() = default;
 
+std::unique_ptr<FieldIndexBuilder>
+IndexBuilder::startFieldBuilder(uint32_t)
+{
+    return std::unique_ptr<FieldIndexBuilder>();
+}
+
 }
@@ -1,11 +1,11 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include <vespa/vespalib/stllike/string.h>
+#include "field_index_builder.h"
+#include <memory>
 
 namespace search::index {
 
-class DocIdAndFeatures;
 class Schema;
 class WordDocElementWordPosFeatures;
 
@@ -16,20 +16,29 @@ class WordDocElementWordPosFeatures;
  *   For each field add the set of unique words in sorted order.
  *   For each word add the set of document ids in sorted order.
  *   For each document id add the position information for that document.
+ *
+ * Words for the current field are added using the FieldIndexBuilder interface.
  */
-class IndexBuilder {
+class IndexBuilder : public FieldIndexBuilder {
 protected:
     const Schema &_schema;
 
 public:
     IndexBuilder(const Schema &schema);
 
-    virtual ~IndexBuilder();
+    ~IndexBuilder() override;
     virtual void startField(uint32_t fieldId) = 0;
     virtual void endField() = 0;
-    virtual void startWord(vespalib::stringref word) = 0;
-    virtual void endWord() = 0;
-    virtual void add_document(const DocIdAndFeatures &features) = 0;
+
+    /**
+     * Returns a builder for the given field that is independent of the builders
+     * for other fields, allowing the fields to be built concurrently by separate threads.
+     * The field is completed when the returned builder is destroyed.
+     *
+     * Returns an empty pointer if the fields must be built one at a time using
+     * startField() and endField(), which is the default.
+     */
+    virtual std::unique_ptr<FieldIndexBuilder> startFieldBuilder(uint32_t fieldId);
 };
 
 }
@@ -8,6 +8,7 @@
 #include <vespa/document/annotation/alternatespanlist.h>
 #include <vespa/document/datatype/urldatatype.h>
 #include <vespa/document/repo/fixedtyperepo.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 #include <vespa/searchlib/common/sort.h>
 #include <vespa/searchlib/util/url.h>
@@ -57,10 +58,16 @@ DocumentInverter::DocumentInverter(const Schema &schema,
 
     for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
          ++fieldId) {
-        auto &remover(fieldIndexes.get_remover(fieldId));
-        auto &inserter(fieldIndexes.get_inserter(fieldId));
+        uint32_t numShards = fieldIndexes.get_num_shards(fieldId);
+        std::vector<FieldIndexRemover *> removers;
+        std::vector<IOrderedFieldIndexInserter *> inserters;
+        for (uint32_t shard = 0; shard < numShards; ++shard) {
+            removers.push_back(&fieldIndexes.get_remover(fieldId, shard));
+            inserters.push_back(&fieldIndexes.get_inserter(fieldId, shard));
+        }
         auto &calculator(fieldIndexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId, remover, inserter, calculator));
+        _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId, std::move(removers),
+                                                             std::move(inserters), calculator));
     }
     for (auto &urlField : _schemaIndexFields._uriFields) {
         Schema::CollectionType collectionType =
@@ -180,14 +187,46 @@ DocumentInverter::pushDocuments(const std::shared_ptr<IDestructorCallback> &onWr
 {
     uint32_t fieldId = 0;
     for (auto &inverter : _inverters) {
-        _pushThreads.execute(fieldId,
-                             [inverter(inverter.get()),
-                              onWriteDone]()
-                             {   inverter->applyRemoves();
-                                 inverter->pushDocuments(); });
+        if (inverter->getNumShards() > 1) {
+            _pushThreads.execute(fieldId,
+                                 [this, fieldId, inverter(inverter.get()),
+                                  onWriteDone]()
+                                 {   inverter->applyRemoves();
+                                     pushShards(fieldId, *inverter); });
+        } else {
+            _pushThreads.execute(fieldId,
+                                 [inverter(inverter.get()),
+                                  onWriteDone]()
+                                 {   inverter->applyRemoves();
+                                     inverter->pushDocuments(); });
+        }
         ++fieldId;
     }
 }
 
+void
+DocumentInverter::pushShards(uint32_t fieldId, FieldInverter &inverter)
+{
+    if (inverter.preparePush()) {
+        /*
+         * The shards are pushed in parallel using the invert threads, which are
+         * never blocked waiting for the push threads.
+         */
+        uint32_t numShards = inverter.getNumShards();
+        uint32_t numExecutors = _invertThreads.getNumExecutors();
+        uint32_t firstExecutor = _invertThreads.getExecutorId(fieldId).getId();
+        vespalib::CountDownLatch latch(numShards);
+        for (uint32_t shard = 0; shard < numShards; ++shard) {
+            ISequencedTaskExecutor::ExecutorId executorId((firstExecutor + shard) % numExecutors);
+            _invertThreads.execute(executorId,
+                                   [&inverter, &latch, shard]()
+                                   {   inverter.pushShard(shard);
+                                       latch.countDown(); });
+        }
+        latch.await();
+    }
+    inverter.finishPush();
+}
+
 }
 
@@ -44,6 +44,7 @@ private:
     void buildFieldPath(const document::DocumentType & docType, const document::DataType *dataType);
     void invertNormalDocTextField(size_t fieldId, const document::FieldValue &field);
     void invertNormalDocUriField(const index::UriField &handle, const document::FieldValue &field);
+    void pushShards(uint32_t fieldId, FieldInverter &inverter);
 
     using FieldPath = document::Field;
     using IndexedFieldPaths = std::vector<std::unique_ptr<FieldPath>>;
@@ -84,6 +85,9 @@ public:
      * All tasks hold a reference to the 'onWriteDone' callback, so when the last task is completed,
      * the callback is destructed.
      *
+     * For fields with a sharded dictionary, the push task pushes the shards in parallel
+     * using the 'invert threads' executor, and waits for them to complete.
+     *
      * NOTE: The caller of this function should sync the 'invert threads' executor first,
      * to ensure that inverting is completed before pushing starts.
      */
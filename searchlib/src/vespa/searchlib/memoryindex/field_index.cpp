@@ -160,51 +160,58 @@ FieldIndex<interleaved_features>::compactFeatures()
 
 template <bool interleaved_features>
 void
-FieldIndex<interleaved_features>::dump(search::index::IndexBuilder & indexBuilder)
+FieldIndex<interleaved_features>::dump(search::index::FieldIndexBuilder & indexBuilder)
 {
-    vespalib::stringref word;
     FeatureStore::DecodeContextCooked decoder(nullptr);
     DocIdAndFeatures features;
-    vespalib::Array<uint32_t> wordMap(_numUniqueWords + 1, 0);
     _featureStore.setupForField(_fieldId, decoder);
     for (auto itr = _dict.begin(); itr.valid(); ++itr) {
         const WordKey & wk = itr.getKey();
-        typename PostingListStore::RefType plist(EntryRef(itr.getData()));
-        word = _wordStore.getWord(wk._wordRef);
-        if (!plist.valid()) {
-            continue;
+        dump_word(_wordStore.getWord(wk._wordRef), EntryRef(itr.getData()), indexBuilder, decoder, features);
+    }
+}
+
+template <bool interleaved_features>
+void
+FieldIndex<interleaved_features>::dump_word(vespalib::stringref word, EntryRef posting_list_ref,
+                                            search::index::FieldIndexBuilder & indexBuilder,
+                                            FeatureStore::DecodeContextCooked & decoder,
+                                            DocIdAndFeatures & features)
+{
+    typename PostingListStore::RefType plist(posting_list_ref);
+    if (!plist.valid()) {
+        return;
+    }
+    indexBuilder.startWord(word);
+    uint32_t clusterSize = _postingListStore.getClusterSize(plist);
+    if (clusterSize == 0) {
+        const PostingList *tree = _postingListStore.getTreeEntry(plist);
+        auto pitr = tree->begin(_postingListStore.getAllocator());
+        assert(pitr.valid());
+        for (; pitr.valid(); ++pitr) {
+            features.set_doc_id(pitr.getKey());
+            const PostingListEntryType &entry(pitr.getData());
+            features.set_num_occs(entry.get_num_occs());
+            features.set_field_length(entry.get_field_length());
+            _featureStore.setupForReadFeatures(entry.get_features(), decoder);
+            decoder.readFeatures(features);
+            indexBuilder.add_document(features);
         }
-        indexBuilder.startWord(word);
-        uint32_t clusterSize = _postingListStore.getClusterSize(plist);
-        if (clusterSize == 0) {
-            const PostingList *tree = _postingListStore.getTreeEntry(plist);
-            auto pitr = tree->begin(_postingListStore.getAllocator());
-            assert(pitr.valid());
-            for (; pitr.valid(); ++pitr) {
-                features.set_doc_id(pitr.getKey());
-                const PostingListEntryType &entry(pitr.getData());
-                features.set_num_occs(entry.get_num_occs());
-                features.set_field_length(entry.get_field_length());
-                _featureStore.setupForReadFeatures(entry.get_features(), decoder);
-                decoder.readFeatures(features);
-                indexBuilder.add_document(features);
-            }
-        } else {
-            const PostingListKeyDataType *kd =
-                _postingListStore.getKeyDataEntry(plist, clusterSize);
-            const PostingListKeyDataType *kde = kd + clusterSize;
-            for (; kd != kde; ++kd) {
-                features.set_doc_id(kd->_key);
-                const PostingListEntryType &entry(kd->getData());
-                features.set_num_occs(entry.get_num_occs());
-                features.set_field_length(entry.get_field_length());
-                _featureStore.setupForReadFeatures(entry.get_features(), decoder);
-                decoder.readFeatures(features);
-                indexBuilder.add_document(features);
-            }
+    } else {
+        const PostingListKeyDataType *kd =
+            _postingListStore.getKeyDataEntry(plist, clusterSize);
+        const PostingListKeyDataType *kde = kd + clusterSize;
+        for (; kd != kde; ++kd) {
+            features.set_doc_id(kd->_key);
+            const PostingListEntryType &entry(kd->getData());
+            features.set_num_occs(entry.get_num_occs());
+            features.set_field_length(entry.get_field_length());
+            _featureStore.setupForReadFeatures(entry.get_features(), decoder);
+            decoder.readFeatures(features);
+            indexBuilder.add_document(features);
         }
-        indexBuilder.endWord();
     }
+    indexBuilder.endWord();
 }
 
 template <bool interleaved_features>
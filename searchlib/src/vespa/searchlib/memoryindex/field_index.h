@@ -82,7 +82,17 @@ public:
 
     void compactFeatures() override;
 
-    void dump(search::index::IndexBuilder & indexBuilder) override;
+    void dump(search::index::FieldIndexBuilder & indexBuilder) override;
+
+    /**
+     * Dump the posting list for a single word in the dictionary.
+     *
+     * The decoder must be setup for this field using the feature store of this field index.
+     */
+    void dump_word(vespalib::stringref word, vespalib::datastore::EntryRef posting_list_ref,
+                   search::index::FieldIndexBuilder & indexBuilder,
+                   FeatureStore::DecodeContextCooked & decoder,
+                   index::DocIdAndFeatures & features);
 
     vespalib::MemoryUsage getMemoryUsage() const override;
     PostingListStore &getPostingListStore() { return _postingListStore; }
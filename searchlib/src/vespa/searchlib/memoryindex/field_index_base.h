@@ -13,6 +13,7 @@
 #include <vespa/vespalib/btree/btreeroot.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/memoryusage.h>
+#include <cassert>
 
 namespace search::memoryindex {
 
@@ -102,10 +103,17 @@ public:
     ~FieldIndexBase();
 
     uint64_t getNumUniqueWords() const override { return _numUniqueWords; }
+    uint32_t getFieldId() const { return _fieldId; }
     const FeatureStore& getFeatureStore() const override { return _featureStore; }
     const WordStore& getWordStore() const override { return _wordStore; }
     IOrderedFieldIndexInserter& getInserter() override { return *_inserter; }
     index::FieldLengthCalculator& get_calculator() override { return _calculator; }
+    uint32_t get_num_shards() const override { return 1; }
+    IFieldIndex& get_shard(uint32_t shard) override {
+        assert(shard == 0);
+        (void) shard;
+        return *this;
+    }
 
     GenerationHandler::Guard takeGenerationGuard() override {
         return _generationHandler.takeGuard();
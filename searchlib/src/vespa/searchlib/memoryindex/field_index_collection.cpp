@@ -3,8 +3,10 @@
 #include "field_index_collection.h"
 #include "field_inverter.h"
 #include "ordered_field_index_inserter.h"
+#include "sharded_field_index.h"
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/index/i_field_length_inspector.h>
+#include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/vespalib/btree/btree.hpp>
 #include <vespa/vespalib/btree/btreeiterator.hpp>
 #include <vespa/vespalib/btree/btreenode.hpp>
@@ -12,8 +14,12 @@
 #include <vespa/vespalib/btree/btreenodestore.hpp>
 #include <vespa/vespalib/btree/btreeroot.hpp>
 #include <vespa/vespalib/btree/btreestore.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.field_index_collection");
@@ -34,7 +40,18 @@ FieldIndexCollection::FieldIndexCollection(const Schema& schema, const IFieldLen
 {
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
         const auto& field = schema.getIndexField(fieldId);
-        if (field.use_interleaved_features()) {
+        uint32_t num_shards = field.get_memory_index_shards();
+        if (num_shards > 1) {
+            if (field.use_interleaved_features()) {
+                _fieldIndexes.push_back(std::make_unique<ShardedFieldIndex<true>>(schema, fieldId,
+                                                                                  inspector.get_field_length_info(field.getName()),
+                                                                                  num_shards));
+            } else {
+                _fieldIndexes.push_back(std::make_unique<ShardedFieldIndex<false>>(schema, fieldId,
+                                                                                   inspector.get_field_length_info(field.getName()),
+                                                                                   num_shards));
+            }
+        } else if (field.use_interleaved_features()) {
             _fieldIndexes.push_back(std::make_unique<FieldIndex<true>>(schema, fieldId,
                                                                        inspector.get_field_length_info(field.getName())));
         } else {
@@ -58,6 +75,35 @@ FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
     }
 }
 
+void
+FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder, vespalib::ThreadExecutor &executor)
+{
+    std::vector<std::unique_ptr<index::FieldIndexBuilder>> fieldBuilders;
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        fieldBuilders.push_back(indexBuilder.startFieldBuilder(fieldId));
+        if (!fieldBuilders.back()) {
+            dump(indexBuilder);
+            return;
+        }
+    }
+    // Largest fields first, same ordering as in diskindex::Fusion::mergeFields().
+    std::vector<std::pair<size_t, uint32_t>> fields;
+    for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
+        fields.emplace_back(_fieldIndexes[fieldId]->getMemoryUsage().usedBytes(), fieldId);
+    }
+    std::stable_sort(fields.begin(), fields.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+    vespalib::CountDownLatch done(fields.size());
+    for (const auto &field : fields) {
+        executor.execute(vespalib::makeLambdaTask([this, fieldId = field.second, &fieldBuilders, &done]() {
+            _fieldIndexes[fieldId]->dump(*fieldBuilders[fieldId]);
+            fieldBuilders[fieldId].reset();
+            done.countDown();
+        }));
+    }
+    done.await();
+}
+
 vespalib::MemoryUsage
 FieldIndexCollection::getMemoryUsage() const
 {
@@ -68,16 +114,22 @@ FieldIndexCollection::getMemoryUsage() const
     return usage;
 }
 
+uint32_t
+FieldIndexCollection::get_num_shards(uint32_t field_id) const
+{
+    return _fieldIndexes[field_id]->get_num_shards();
+}
+
 FieldIndexRemover &
-FieldIndexCollection::get_remover(uint32_t field_id)
+FieldIndexCollection::get_remover(uint32_t field_id, uint32_t shard)
 {
-    return _fieldIndexes[field_id]->getDocumentRemover();
+    return _fieldIndexes[field_id]->get_shard(shard).getDocumentRemover();
 }
 
 IOrderedFieldIndexInserter &
-FieldIndexCollection::get_inserter(uint32_t field_id)
+FieldIndexCollection::get_inserter(uint32_t field_id, uint32_t shard)
 {
-    return _fieldIndexes[field_id]->getInserter();
+    return _fieldIndexes[field_id]->get_shard(shard).getInserter();
 }
 
 index::FieldLengthCalculator &
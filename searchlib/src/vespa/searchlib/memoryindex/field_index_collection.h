@@ -9,9 +9,12 @@
 
 namespace search::index {
     class IFieldLengthInspector;
+    class IndexBuilder;
     class Schema;
 }
 
+namespace vespalib { class ThreadExecutor; }
+
 namespace search::memoryindex {
 
 class IFieldIndexRemoveListener;
@@ -44,6 +47,13 @@ public:
 
     void dump(search::index::IndexBuilder & indexBuilder);
 
+    /**
+     * Dump the field indexes concurrently using the given executor, largest field first,
+     * if the index builder supports building fields independently of each other.
+     * Otherwise the field indexes are dumped one at a time by the calling thread.
+     */
+    void dump(search::index::IndexBuilder & indexBuilder, vespalib::ThreadExecutor & executor);
+
     vespalib::MemoryUsage getMemoryUsage() const;
 
     IFieldIndex *getFieldIndex(uint32_t fieldId) const {
@@ -54,8 +64,9 @@ public:
 
     uint32_t getNumFields() const { return _numFields; }
 
-    FieldIndexRemover &get_remover(uint32_t field_id) override;
-    IOrderedFieldIndexInserter &get_inserter(uint32_t field_id) override;
+    uint32_t get_num_shards(uint32_t field_id) const override;
+    FieldIndexRemover &get_remover(uint32_t field_id, uint32_t shard) override;
+    IOrderedFieldIndexInserter &get_inserter(uint32_t field_id, uint32_t shard) override;
     index::FieldLengthCalculator &get_calculator(uint32_t field_id) override;
 };
 
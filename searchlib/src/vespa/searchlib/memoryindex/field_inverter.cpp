@@ -2,6 +2,7 @@
 
 #include "field_inverter.h"
 #include "ordered_field_index_inserter.h"
+#include "word_shard.h"
 #include <vespa/document/annotation/alternatespanlist.h>
 #include <vespa/document/annotation/annotation.h>
 #include <vespa/document/annotation/span.h>
@@ -345,6 +346,17 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
                              FieldIndexRemover &remover,
                              IOrderedFieldIndexInserter &inserter,
                              index::FieldLengthCalculator &calculator)
+    : FieldInverter(schema, fieldId,
+                    std::vector<FieldIndexRemover *>{&remover},
+                    std::vector<IOrderedFieldIndexInserter *>{&inserter},
+                    calculator)
+{
+}
+
+FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
+                             std::vector<FieldIndexRemover *> removers,
+                             std::vector<IOrderedFieldIndexInserter *> inserters,
+                             index::FieldLengthCalculator &calculator)
     : _fieldId(fieldId),
       _elem(0u),
       _wpos(0u),
@@ -354,17 +366,21 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _words(),
       _elems(),
       _positions(),
-      _features(),
+      _features(inserters.size()),
       _elementWordRefs(),
       _wordRefs(1),
+      _wordShards(),
+      _wordPosStart(),
       _terms(),
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
-      _remover(remover),
-      _inserter(inserter),
+      _removers(std::move(removers)),
+      _inserters(std::move(inserters)),
       _calculator(calculator)
 {
+    assert(!_inserters.empty());
+    assert(_removers.size() == _inserters.size());
 }
 
 void
@@ -494,19 +510,31 @@ void
 FieldInverter::applyRemoves()
 {
     for (auto docId : _removeDocs) {
-        _remover.remove(docId, *this);
+        for (auto remover : _removers) {
+            remover->remove(docId, *this);
+        }
     }
     _removeDocs.clear();
 }
 
 void
 FieldInverter::pushDocuments()
+{
+    if (preparePush()) {
+        for (uint32_t shard = 0; shard < _inserters.size(); ++shard) {
+            pushShard(shard);
+        }
+    }
+    finishPush();
+}
+
+bool
+FieldInverter::preparePush()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
-        reset();
-        return;             // All documents with words aborted
+        return false;       // All documents with words aborted
     }
 
     sortWords();
@@ -515,6 +543,27 @@ FieldInverter::pushDocuments()
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
 
+    // Find shard and range of positions for each word.
+    uint32_t numWordIds = _wordRefs.size() - 1;
+    uint32_t numShards = _inserters.size();
+    _wordShards.resize(numWordIds + 1);
+    for (uint32_t wordNum = 1; wordNum <= numWordIds; ++wordNum) {
+        _wordShards[wordNum] = get_word_shard(getWordFromNum(wordNum), numShards);
+    }
+    _wordPosStart.assign(numWordIds + 2, 0u);
+    for (const auto &pos : _positions) {
+        assert(pos._wordNum > 0 && pos._wordNum <= numWordIds);
+        ++_wordPosStart[pos._wordNum + 1];
+    }
+    for (uint32_t wordNum = 1; wordNum <= numWordIds + 1; ++wordNum) {
+        _wordPosStart[wordNum] += _wordPosStart[wordNum - 1];
+    }
+    return true;
+}
+
+void
+FieldInverter::pushShard(uint32_t shard)
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
     uint32_t lastWordNum = 0;
@@ -524,62 +573,68 @@ FieldInverter::pushDocuments()
     uint32_t lastDocId = 0;
     vespalib::stringref word;
     bool emptyFeatures = true;
+    IOrderedFieldIndexInserter &inserter = *_inserters[shard];
+    DocIdAndPosOccFeatures &features = _features[shard];
 
-    _inserter.rewind();
+    inserter.rewind();
 
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                _features.set_num_occs(_features.word_positions().size());
-                _inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                _inserter.setNextWord(word);
+    for (uint32_t wordNum = 1; wordNum <= numWordIds; ++wordNum) {
+        if (_wordShards[wordNum] != shard) {
+            continue;
+        }
+        auto ite = _positions.begin() + _wordPosStart[wordNum + 1];
+        for (auto itr = _positions.begin() + _wordPosStart[wordNum]; itr != ite; ++itr) {
+            const PosInfo &i = *itr;
+            if (lastWordNum != i._wordNum || lastDocId != i._docId) {
+                if (!emptyFeatures) {
+                    features.set_num_occs(features.word_positions().size());
+                    inserter.add(lastDocId, features);
+                    emptyFeatures = true;
+                }
+                if (lastWordNum != i._wordNum) {
+                    lastWordNum = i._wordNum;
+                    word = getWordFromNum(lastWordNum);
+                    inserter.setNextWord(word);
+                }
+                lastDocId = i._docId;
+                if (i.removed()) {
+                    inserter.remove(lastDocId);
+                    continue;
+                }
             }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                _inserter.remove(lastDocId);
-                continue;
+            if (emptyFeatures) {
+                if (!i.removed()) {
+                    emptyFeatures = false;
+                    features.clear(lastDocId);
+                    lastElemId = NO_ELEMENT_ID;
+                    lastWordPos = NO_WORD_POS;
+                    const ElemInfo &elem = _elems[i._elemRef];
+                    features.set_field_length(elem.get_field_length());
+                } else {
+                    continue; // ignore dup remove
+                }
+            } else {
+                // removes must come before non-removes
+                assert(!i.removed());
             }
-        }
-        if (emptyFeatures) {
-            if (!i.removed()) {
-                emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
-                const ElemInfo &elem = _elems[i._elemRef];
-                _features.set_field_length(elem.get_field_length());
+            const ElemInfo &elem = _elems[i._elemRef];
+            if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
+                features.addNextOcc(i._elemId, i._wordPos,
+                                    elem._weight, elem._len);
+                lastElemId = i._elemId;
+                lastWordPos = i._wordPos;
             } else {
-                continue; // ignore dup remove
+                // silently ignore duplicate annotations
             }
-        } else {
-            // removes must come before non-removes
-            assert(!i.removed());
-        }
-        const ElemInfo &elem = _elems[i._elemRef];
-        if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
-            _features.addNextOcc(i._elemId, i._wordPos,
-                                 elem._weight, elem._len);
-            lastElemId = i._elemId;
-            lastWordPos = i._wordPos;
-        } else {
-            // silently ignore duplicate annotations
         }
     }
 
     if (!emptyFeatures) {
-        _features.set_num_occs(_features.word_positions().size());
-        _inserter.add(lastDocId, _features);
+        features.set_num_occs(features.word_positions().size());
+        inserter.add(lastDocId, features);
     }
-    _inserter.flush();
-    _inserter.commit();
-    reset();
+    inserter.flush();
+    inserter.commit();
 }
 
 }
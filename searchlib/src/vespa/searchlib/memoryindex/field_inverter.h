@@ -174,9 +174,11 @@ private:
     WordBuffer                     _words;
     ElemInfoVec                    _elems;
     PosInfoVec                     _positions;
-    index::DocIdAndPosOccFeatures  _features;
+    std::vector<index::DocIdAndPosOccFeatures> _features; // one per shard
     UInt32Vector                   _elementWordRefs;
     UInt32Vector                   _wordRefs;
+    UInt32Vector                   _wordShards;    // word number -> shard
+    UInt32Vector                   _wordPosStart;  // word number -> first index in _positions
 
     using SpanTerm = std::pair<document::Span, const document::FieldValue *>;
     using SpanTermVector = std::vector<SpanTerm>;
@@ -187,8 +189,8 @@ private:
     std::map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                      _removeDocs;
 
-    FieldIndexRemover                &_remover;
-    IOrderedFieldIndexInserter       &_inserter;
+    std::vector<FieldIndexRemover *>          _removers;
+    std::vector<IOrderedFieldIndexInserter *> _inserters;
     index::FieldLengthCalculator     &_calculator;
 
     void invertNormalDocTextField(const document::FieldValue &val);
@@ -286,6 +288,18 @@ public:
                   IOrderedFieldIndexInserter &inserter,
                   index::FieldLengthCalculator &calculator);
 
+    /**
+     * Create a new field inverter for a field index with a sharded dictionary.
+     * There is one remover and one inserter per shard, and words are assigned
+     * to shards using get_word_shard().
+     */
+    FieldInverter(const index::Schema &schema, uint32_t fieldId,
+                  std::vector<FieldIndexRemover *> removers,
+                  std::vector<IOrderedFieldIndexInserter *> inserters,
+                  index::FieldLengthCalculator &calculator);
+
+    uint32_t getNumShards() const { return _inserters.size(); }
+
     /**
      * Apply pending removes using the given remover.
      *
@@ -299,6 +313,22 @@ public:
      */
     void pushDocuments();
 
+    /**
+     * Prepare for pushing the current batch of inverted documents, by sorting
+     * the words and positions. Returns false if there is nothing to push.
+     *
+     * pushShard() can then be called concurrently for different shards,
+     * followed by a call to finishPush() when all shards have been pushed.
+     */
+    bool preparePush();
+
+    /**
+     * Push the words belonging to the given shard, using the inserter for that shard.
+     */
+    void pushShard(uint32_t shard);
+
+    void finishPush() { reset(); }
+
     /**
      * Invert a normal text field, based on annotations.
      */
@@ -7,8 +7,8 @@
 #include <vespa/vespalib/util/memoryusage.h>
 
 namespace search::index {
+class FieldIndexBuilder;
 class FieldLengthCalculator;
-class IndexBuilder;
 }
 
 namespace search::memoryindex {
@@ -27,13 +27,24 @@ public:
 
     virtual uint64_t getNumUniqueWords() const = 0;
     virtual vespalib::MemoryUsage getMemoryUsage() const = 0;
+    /**
+     * The feature store, word store, document remover and generation handler are per shard.
+     * For a field index with multiple shards they must be accessed through get_shard().
+     */
     virtual const FeatureStore& getFeatureStore() const = 0;
     virtual const WordStore& getWordStore() const = 0;
     virtual IOrderedFieldIndexInserter& getInserter() = 0;
     virtual FieldIndexRemover& getDocumentRemover() = 0;
     virtual index::FieldLengthCalculator& get_calculator() = 0;
     virtual void compactFeatures() = 0;
-    virtual void dump(search::index::IndexBuilder& indexBuilder) = 0;
+    virtual void dump(search::index::FieldIndexBuilder& indexBuilder) = 0;
+
+    /**
+     * Returns the number of dictionary shards in this field index.
+     * Each shard has its own inserter, document remover, word store, feature store and generation handler.
+     */
+    virtual uint32_t get_num_shards() const = 0;
+    virtual IFieldIndex& get_shard(uint32_t shard) = 0;
 
     virtual std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const vespalib::string& term,
                                                                                 const queryeval::FieldSpecBase& field,
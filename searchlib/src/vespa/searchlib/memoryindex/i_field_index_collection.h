@@ -17,8 +17,13 @@ class IOrderedFieldIndexInserter;
  */
 class IFieldIndexCollection {
 public:
-    virtual FieldIndexRemover &get_remover(uint32_t field_id) = 0;
-    virtual IOrderedFieldIndexInserter &get_inserter(uint32_t field_id) = 0;
+    /**
+     * Returns the number of dictionary shards for the given field.
+     * There is a separate remover and inserter for each shard.
+     */
+    virtual uint32_t get_num_shards(uint32_t field_id) const = 0;
+    virtual FieldIndexRemover &get_remover(uint32_t field_id, uint32_t shard) = 0;
+    virtual IOrderedFieldIndexInserter &get_inserter(uint32_t field_id, uint32_t shard) = 0;
     virtual index::FieldLengthCalculator &get_calculator(uint32_t field_id) = 0;
     virtual ~IFieldIndexCollection() = default;
 };
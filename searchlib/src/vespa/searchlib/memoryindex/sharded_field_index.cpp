@@ -0,0 +1,222 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sharded_field_index.h"
+#include "word_shard.h"
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/util/exceptions.h>
+#include <cstring>
+
+using search::index::DocIdAndFeatures;
+using vespalib::datastore::EntryRef;
+
+namespace search::memoryindex {
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::ShardedInserter::ShardedInserter(std::vector<IOrderedFieldIndexInserter *> inserters)
+    : _inserters(std::move(inserters)),
+      _current(nullptr)
+{
+}
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::ShardedInserter::~ShardedInserter() = default;
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::setNextWord(const vespalib::stringref word)
+{
+    _current = _inserters[get_word_shard(word, _inserters.size())];
+    _current->setNextWord(word);
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::add(uint32_t docId, const DocIdAndFeatures &features)
+{
+    _current->add(docId, features);
+}
+
+template <bool interleaved_features>
+EntryRef
+ShardedFieldIndex<interleaved_features>::ShardedInserter::getWordRef() const
+{
+    return _current->getWordRef();
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::remove(uint32_t docId)
+{
+    _current->remove(docId);
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::flush()
+{
+    for (auto inserter : _inserters) {
+        inserter->flush();
+    }
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::commit()
+{
+    for (auto inserter : _inserters) {
+        inserter->commit();
+    }
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::ShardedInserter::rewind()
+{
+    for (auto inserter : _inserters) {
+        inserter->rewind();
+    }
+    _current = nullptr;
+}
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::ShardedFieldIndex(const index::Schema& schema, uint32_t fieldId,
+                                                           const index::FieldLengthInfo& info,
+                                                           uint32_t num_shards)
+    : IFieldIndex(),
+      _shards(),
+      _inserter(),
+      _calculator(info)
+{
+    assert(num_shards > 0);
+    std::vector<IOrderedFieldIndexInserter *> inserters;
+    for (uint32_t shard = 0; shard < num_shards; ++shard) {
+        _shards.push_back(std::make_unique<FieldIndexType>(schema, fieldId, info));
+        inserters.push_back(&_shards.back()->getInserter());
+    }
+    _inserter = std::make_unique<ShardedInserter>(std::move(inserters));
+}
+
+template <bool interleaved_features>
+ShardedFieldIndex<interleaved_features>::~ShardedFieldIndex() = default;
+
+template <bool interleaved_features>
+uint64_t
+ShardedFieldIndex<interleaved_features>::getNumUniqueWords() const
+{
+    uint64_t num_unique_words = 0;
+    for (const auto &shard : _shards) {
+        num_unique_words += shard->getNumUniqueWords();
+    }
+    return num_unique_words;
+}
+
+template <bool interleaved_features>
+vespalib::MemoryUsage
+ShardedFieldIndex<interleaved_features>::getMemoryUsage() const
+{
+    vespalib::MemoryUsage usage;
+    for (const auto &shard : _shards) {
+        usage.merge(shard->getMemoryUsage());
+    }
+    return usage;
+}
+
+template <bool interleaved_features>
+const FeatureStore&
+ShardedFieldIndex<interleaved_features>::getFeatureStore() const
+{
+    throw vespalib::IllegalStateException("Feature store is per shard in sharded field index, use get_shard()");
+}
+
+template <bool interleaved_features>
+const WordStore&
+ShardedFieldIndex<interleaved_features>::getWordStore() const
+{
+    throw vespalib::IllegalStateException("Word store is per shard in sharded field index, use get_shard()");
+}
+
+template <bool interleaved_features>
+FieldIndexRemover&
+ShardedFieldIndex<interleaved_features>::getDocumentRemover()
+{
+    throw vespalib::IllegalStateException("Document remover is per shard in sharded field index, use get_shard()");
+}
+
+template <bool interleaved_features>
+vespalib::GenerationHandler::Guard
+ShardedFieldIndex<interleaved_features>::takeGenerationGuard()
+{
+    throw vespalib::IllegalStateException("Generation handler is per shard in sharded field index, use get_shard()");
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::compactFeatures()
+{
+    for (auto &shard : _shards) {
+        shard->compactFeatures();
+    }
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::dump(search::index::FieldIndexBuilder& indexBuilder)
+{
+    using DictionaryIterator = typename FieldIndexType::DictionaryTree::Iterator;
+    std::vector<DictionaryIterator> itrs;
+    std::vector<std::unique_ptr<FeatureStore::DecodeContextCooked>> decoders;
+    DocIdAndFeatures features;
+    for (auto &shard : _shards) {
+        itrs.push_back(shard->getDictionaryTree().begin());
+        decoders.push_back(std::make_unique<FeatureStore::DecodeContextCooked>(nullptr));
+        shard->getFeatureStore().setupForField(shard->getFieldId(), *decoders.back());
+    }
+    // Merge the shard dictionaries, each word is present in a single shard only.
+    for (;;) {
+        const char *min_word = nullptr;
+        uint32_t min_shard = 0;
+        for (uint32_t shard = 0; shard < _shards.size(); ++shard) {
+            if (itrs[shard].valid()) {
+                const char *word = _shards[shard]->getWordStore().getWord(itrs[shard].getKey()._wordRef);
+                if (min_word == nullptr || strcmp(word, min_word) < 0) {
+                    min_word = word;
+                    min_shard = shard;
+                }
+            }
+        }
+        if (min_word == nullptr) {
+            break;
+        }
+        auto &itr = itrs[min_shard];
+        _shards[min_shard]->dump_word(min_word, EntryRef(itr.getData()), indexBuilder, *decoders[min_shard], features);
+        ++itr;
+    }
+}
+
+template <bool interleaved_features>
+std::unique_ptr<queryeval::SimpleLeafBlueprint>
+ShardedFieldIndex<interleaved_features>::make_term_blueprint(const vespalib::string& term,
+                                                             const queryeval::FieldSpecBase& field,
+                                                             uint32_t field_id)
+{
+    return _shards[get_word_shard(term, _shards.size())]->make_term_blueprint(term, field, field_id);
+}
+
+template <bool interleaved_features>
+void
+ShardedFieldIndex<interleaved_features>::commit()
+{
+    for (auto &shard : _shards) {
+        shard->commit();
+    }
+}
+
+template class ShardedFieldIndex<false>;
+template class ShardedFieldIndex<true>;
+
+}
@@ -0,0 +1,77 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "field_index.h"
+#include "i_ordered_field_index_inserter.h"
+#include <vespa/searchlib/index/field_length_calculator.h>
+
+namespace search::memoryindex {
+
+/**
+ * Implementation of memory index for a single field where the dictionary is
+ * split into a set of shards, each being a complete FieldIndex.
+ *
+ * Words are assigned to shards by hash (see get_word_shard()). Each shard has its own
+ * inserter and document remover, allowing the shards to be updated by separate threads.
+ * Term lookups are routed to the shard owning the word, and dumping merges the shard
+ * dictionaries to produce words in sorted order.
+ */
+template <bool interleaved_features>
+class ShardedFieldIndex : public IFieldIndex {
+public:
+    using FieldIndexType = FieldIndex<interleaved_features>;
+
+private:
+    /**
+     * Inserter routing each word to the inserter of the shard owning the word.
+     */
+    class ShardedInserter : public IOrderedFieldIndexInserter {
+        std::vector<IOrderedFieldIndexInserter *> _inserters;
+        IOrderedFieldIndexInserter *_current;
+    public:
+        ShardedInserter(std::vector<IOrderedFieldIndexInserter *> inserters);
+        ~ShardedInserter() override;
+        void setNextWord(const vespalib::stringref word) override;
+        void add(uint32_t docId, const index::DocIdAndFeatures &features) override;
+        vespalib::datastore::EntryRef getWordRef() const override;
+        void remove(uint32_t docId) override;
+        void flush() override;
+        void commit() override;
+        void rewind() override;
+    };
+
+    std::vector<std::unique_ptr<FieldIndexType>> _shards;
+    std::unique_ptr<ShardedInserter>             _inserter;
+    index::FieldLengthCalculator                 _calculator;
+
+public:
+    ShardedFieldIndex(const index::Schema& schema, uint32_t fieldId, const index::FieldLengthInfo& info,
+                      uint32_t num_shards);
+    ~ShardedFieldIndex() override;
+
+    FieldIndexType& get_field_index_shard(uint32_t shard) { return *_shards[shard]; }
+
+    uint64_t getNumUniqueWords() const override;
+    vespalib::MemoryUsage getMemoryUsage() const override;
+
+    // The components below are per shard and must be accessed through get_shard(), these throw.
+    const FeatureStore& getFeatureStore() const override;
+    const WordStore& getWordStore() const override;
+    FieldIndexRemover& getDocumentRemover() override;
+    vespalib::GenerationHandler::Guard takeGenerationGuard() override;
+
+    IOrderedFieldIndexInserter& getInserter() override { return *_inserter; }
+    index::FieldLengthCalculator& get_calculator() override { return _calculator; }
+    void compactFeatures() override;
+    void dump(search::index::FieldIndexBuilder& indexBuilder) override;
+    uint32_t get_num_shards() const override { return _shards.size(); }
+    IFieldIndex& get_shard(uint32_t shard) override { return *_shards[shard]; }
+
+    std::unique_ptr<queryeval::SimpleLeafBlueprint> make_term_blueprint(const vespalib::string& term,
+                                                                        const queryeval::FieldSpecBase& field,
+                                                                        uint32_t field_id) override;
+    void commit() override;
+};
+
+}
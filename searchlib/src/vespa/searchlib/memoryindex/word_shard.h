@@ -0,0 +1,25 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <vespa/vespalib/stllike/string.h>
+
+namespace search::memoryindex {
+
+/**
+ * Returns which dictionary shard the given word belongs to in a field index
+ * with the given number of shards.
+ *
+ * Used both when inserting and when looking up words, so the mapping must be stable.
+ */
+inline uint32_t
+get_word_shard(vespalib::stringref word, uint32_t num_shards)
+{
+    if (num_shards <= 1) {
+        return 0;
+    }
+    return vespalib::hashValue(word.data(), word.size()) % num_shards;
+}
+
+}
@@ -12,6 +12,10 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <deque>
+#include <future>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.dense_tensor_attribute");
@@ -30,6 +34,67 @@ namespace {
 constexpr uint32_t DENSE_TENSOR_ATTRIBUTE_VERSION = 1;
 const vespalib::string tensorTypeTag("tensortype");
 
+/**
+ * Used to build the nearest neighbor index when loading without a usable
+ * index save file. The costly prepare step of adding a document is run by
+ * executor threads while the complete step is run by the loading thread in
+ * document id order. The number of documents in flight is bounded, as a
+ * document being prepared cannot be linked to the other documents in flight.
+ */
+class ThreadedIndexBuilder
+{
+    struct PendingAdd {
+        uint32_t                                    docid;
+        std::future<std::unique_ptr<PrepareResult>> prepare_result;
+    };
+    static constexpr size_t max_pending = 128;
+
+    NearestNeighborIndex&  _index;
+    vespalib::Executor&    _executor;
+    std::deque<PendingAdd> _pending;
+
+    void complete_first() {
+        auto& first = _pending.front();
+        auto prepare_result = first.prepare_result.get();
+        if (prepare_result) {
+            _index.complete_add_document(first.docid, std::move(prepare_result));
+        } else {
+            // The index was too small for the two-phase add when the prepare step was run.
+            _index.add_document(first.docid);
+        }
+        _pending.pop_front();
+    }
+public:
+    ThreadedIndexBuilder(NearestNeighborIndex& index, vespalib::Executor& executor)
+        : _index(index),
+          _executor(executor),
+          _pending()
+    {
+    }
+    ~ThreadedIndexBuilder() {
+        drain();
+    }
+    void add_document(uint32_t docid, vespalib::tensor::TypedCells vector, vespalib::GenerationHandler::Guard read_guard) {
+        if (_pending.size() >= max_pending) {
+            complete_first();
+        }
+        std::promise<std::unique_ptr<PrepareResult>> promise;
+        _pending.push_back(PendingAdd{docid, promise.get_future()});
+        auto task = vespalib::makeLambdaTask([this, docid, vector, guard = std::move(read_guard), promise = std::move(promise)]() mutable {
+            promise.set_value(_index.prepare_add_document(docid, vector, std::move(guard)));
+        });
+        auto rejected = _executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    void drain() {
+        while (!_pending.empty()) {
+            complete_first();
+        }
+    }
+};
+
 class TensorReader : public ReaderBase
 {
 private:
@@ -188,7 +253,7 @@ DenseTensorAttribute::getTensor(DocId docId, MutableDenseTensorView &tensor) con
 }
 
 bool
-DenseTensorAttribute::onLoad()
+DenseTensorAttribute::onLoad(vespalib::Executor *executor)
 {
     TensorReader tensorReader(*this);
     if (!tensorReader.hasData()) {
@@ -204,6 +269,10 @@ DenseTensorAttribute::onLoad()
     uint32_t numDocs(tensorReader.getDocIdLimit());
     _refVector.reset();
     _refVector.unsafe_reserve(numDocs);
+    std::unique_ptr<ThreadedIndexBuilder> index_builder;
+    if (_index && !use_index_file && executor != nullptr) {
+        index_builder = std::make_unique<ThreadedIndexBuilder>(*_index, *executor);
+    }
     for (uint32_t lid = 0; lid < numDocs; ++lid) {
         if (tensorReader.is_present()) {
             auto raw = _denseTensorStore.allocRawBuffer();
@@ -212,12 +281,19 @@ DenseTensorAttribute::onLoad()
             if (_index && !use_index_file) {
                 // This ensures that get_vector() (via getTensor()) is able to find the newly added tensor.
                 setCommittedDocIdLimit(lid + 1);
-                _index->add_document(lid);
+                if (index_builder) {
+                    index_builder->add_document(lid, _denseTensorStore.get_typed_cells(raw.ref), getGenerationHandler().takeGuard());
+                } else {
+                    _index->add_document(lid);
+                }
             }
         } else {
             _refVector.push_back(EntryRef());
         }
     }
+    if (index_builder) {
+        index_builder->drain();
+    }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
     if (_index && use_index_file) {
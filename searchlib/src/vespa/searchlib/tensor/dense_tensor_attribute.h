@@ -38,7 +38,7 @@ public:
     void complete_set_tensor(DocId docid, const Tensor& tensor, std::unique_ptr<PrepareResult> prepare_result) override;
     std::unique_ptr<Tensor> getTensor(DocId docId) const override;
     void getTensor(DocId docId, vespalib::tensor::MutableDenseTensorView &tensor) const override;
-    bool onLoad() override;
+    bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(vespalib::stringref fileName) override;
     void compactWorst() override;
     uint32_t getVersion() const override;
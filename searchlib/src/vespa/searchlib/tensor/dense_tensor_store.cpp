@@ -74,6 +74,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type)
       _emptySpace()
 {
     _emptySpace.resize(getBufSize(), 0);
+    _store.setMMapPolicy(vespalib::alloc::MMapPolicy::forComponent("densetensorstore", "datastore"));
     _store.addType(&_bufferType);
     _store.initActiveBuffers();
     _store.enableFreeLists();
@@ -74,7 +74,7 @@ GenericTensorAttribute::getTensor(DocId, vespalib::tensor::MutableDenseTensorVie
 }
 
 bool
-GenericTensorAttribute::onLoad()
+GenericTensorAttribute::onLoad(vespalib::Executor *)
 {
     TensorReader tensorReader(*this);
     if (!tensorReader.hasData()) {
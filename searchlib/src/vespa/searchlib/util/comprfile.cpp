@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "comprfile.h"
+#include <vespa/searchlib/common/flush_io_throttle.h>
 #include <vespa/fastos/file.h>
 #include <cassert>
 #include <cstring>
@@ -256,6 +257,7 @@ WriteComprBuffer(ComprFileEncodeContext &encodeContext,
                  (flushSlack &&
                   static_cast<unsigned int>(chunksize) <= cbuf.getComprBufSize() +
                   ComprBuffer::minimumPadding()));
+    common::FlushIoThrottle::instance().acquire(cbuf.getUnitSize() * chunksize);
     file.WriteBuf(cbuf.getComprBuf(), cbuf.getUnitSize() * chunksize);
 
     int remainingUnits = chunkUsedUnits - chunksize;
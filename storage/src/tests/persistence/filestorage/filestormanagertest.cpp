@@ -426,6 +426,53 @@ TEST_F(FileStorManagerTest, handler_priority) {
     ASSERT_EQ(75, filestorHandler.getNextMessage(0, stripeId).second->getPriority());
 }
 
+TEST_F(FileStorManagerTest, handler_takes_queued_puts_to_same_bucket_until_other_operation) {
+    DummyStorageLink top;
+    DummyStorageLink *dummyManager;
+    top.push_back(std::unique_ptr<StorageLink>(
+                          dummyManager = new DummyStorageLink));
+    top.open();
+    ForwardingMessageSender messageSender(*dummyManager);
+
+    documentapi::LoadTypeSet loadTypes("raw:");
+    FileStorMetrics metrics(loadTypes.getMetricLoadTypes());
+    metrics.initDiskMetrics(_node->getPartitions().size(), loadTypes.getMetricLoadTypes(), 1, 1);
+
+    FileStorHandler filestorHandler(messageSender, metrics, _node->getPartitions(), _node->getComponentRegister());
+    filestorHandler.setGetNextMessageTimeout(50);
+    uint32_t stripeId = filestorHandler.getNextStripeId(0);
+
+    Document::SP doc(createDocument("content", "id:footype:testdoctype1:n=1234:bar").release());
+    document::BucketIdFactory factory;
+    document::Bucket bucket(makeDocumentBucket(document::BucketId(16, factory.getBucketId(doc->getId()).getRawId())));
+    auto address = std::make_shared<api::StorageMessageAddress>("storage", lib::NodeType::STORAGE, 3);
+
+    for (uint32_t i = 1; i < 5; i++) {
+        auto cmd = std::make_shared<api::PutCommand>(bucket, doc, 100 + i);
+        cmd->setAddress(*address);
+        filestorHandler.schedule(cmd, 0);
+    }
+    auto remove = std::make_shared<api::RemoveCommand>(bucket, doc->getId(), 200);
+    remove->setAddress(*address);
+    filestorHandler.schedule(remove, 0);
+    auto put = std::make_shared<api::PutCommand>(bucket, doc, 300);
+    put->setAddress(*address);
+    filestorHandler.schedule(put, 0);
+
+    auto lock = filestorHandler.getNextMessage(0, stripeId);
+    ASSERT_TRUE(lock.first);
+    EXPECT_EQ(101u, static_cast<api::PutCommand&>(*lock.second).getTimestamp());
+    auto puts = filestorHandler.getQueuedPuts(0, bucket, 2);
+    ASSERT_EQ(2u, puts.size());
+    EXPECT_EQ(102u, static_cast<api::PutCommand&>(*puts[0]).getTimestamp());
+    EXPECT_EQ(103u, static_cast<api::PutCommand&>(*puts[1]).getTimestamp());
+    puts = filestorHandler.getQueuedPuts(0, bucket, 10);
+    ASSERT_EQ(1u, puts.size());
+    EXPECT_EQ(104u, static_cast<api::PutCommand&>(*puts[0]).getTimestamp());
+    EXPECT_TRUE(filestorHandler.getQueuedPuts(0, bucket, 10).empty());
+    EXPECT_EQ(2u, filestorHandler.getQueueSize());
+}
+
 class MessagePusherThread : public document::Runnable {
 public:
     FileStorHandler& _handler;
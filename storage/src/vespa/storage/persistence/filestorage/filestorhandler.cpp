@@ -60,6 +60,12 @@ FileStorHandler::getNextMessage(uint16_t disk, uint32_t stripeId)
     return _impl->getNextMessage(disk, stripeId);
 }
 
+std::vector<std::shared_ptr<api::StorageMessage>>
+FileStorHandler::getQueuedPuts(uint16_t disk, const document::Bucket &bucket, uint32_t maxPuts)
+{
+    return _impl->getQueuedPuts(disk, bucket, maxPuts);
+}
+
 FileStorHandler::BucketLockInterface::SP
 FileStorHandler::lock(const document::Bucket& bucket, uint16_t disk, api::LockingRequirements lockReq)
 {
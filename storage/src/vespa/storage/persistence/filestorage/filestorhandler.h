@@ -120,6 +120,17 @@ public:
      */
     LockedMessage getNextMessage(uint16_t disk, uint32_t stripeId);
 
+    /**
+     * Used by file stor threads holding the lock for a bucket to take the puts
+     * queued for the same bucket, so that they can be handled as one batch.
+     * Puts with test and set conditions are not taken, and taking stops at the
+     * first queued message for the bucket that is not a put.
+     *
+     * @param maxPuts The max number of puts to take
+     */
+    std::vector<std::shared_ptr<api::StorageMessage>>
+    getQueuedPuts(uint16_t disk, const document::Bucket &bucket, uint32_t maxPuts);
+
     /**
      * Lock a bucket. By default, each file stor thread has the locks of all
      * buckets in their area of responsibility. If they need to access buckets
@@ -977,6 +977,45 @@ FileStorHandlerImpl::Stripe::getMessage(vespalib::MonitorGuard & guard, Priority
     }
 }
 
+namespace {
+
+bool
+isBatchablePut(const api::StorageMessage & msg)
+{
+    return (msg.getType().getId() == api::MessageType::PUT_ID) &&
+           !static_cast<const api::PutCommand &>(msg).getCondition().isPresent();
+}
+
+}
+
+std::vector<std::shared_ptr<api::StorageMessage>>
+FileStorHandlerImpl::Stripe::getQueuedPuts(const document::Bucket & bucket, uint32_t maxPuts)
+{
+    std::vector<std::shared_ptr<api::StorageMessage>> puts;
+    std::vector<std::shared_ptr<api::StorageReply>> timedOut;
+    {
+        vespalib::MonitorGuard guard(_lock);
+        BucketIdx & idx = bmi::get<2>(_queue);
+        auto range = idx.equal_range(bucket);
+        // Stop at the first message that is not a plain put to keep the order of operations to the bucket.
+        for (auto iter = range.first; (iter != range.second) && (puts.size() < maxPuts) && isBatchablePut(*iter->_command); ) {
+            api::StorageMessage & m(*iter->_command);
+            std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime[m.getLoadType()])));
+            std::shared_ptr<api::StorageMessage> msg = iter->_command;
+            iter = idx.erase(iter);
+            if (messageTimedOutInQueue(*msg, waitTime)) {
+                timedOut.emplace_back(makeQueueTimeoutReply(*msg));
+            } else {
+                puts.push_back(std::move(msg));
+            }
+        }
+    }
+    for (auto & reply : timedOut) {
+        _messageSender.sendReply(reply);
+    }
+    return puts;
+}
+
 void
 FileStorHandlerImpl::Disk::waitUntilNoLocks() const
 {
@@ -129,6 +129,7 @@ public:
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code);
 
         FileStorHandler::LockedMessage getNextMessage(uint32_t timeout, Disk & disk);
+        std::vector<std::shared_ptr<api::StorageMessage>> getQueuedPuts(const document::Bucket & bucket, uint32_t maxPuts);
         void dumpQueue(std::ostream & os) const;
         void dumpActiveHtml(std::ostream & os) const;
         void dumpQueueHtml(std::ostream & os) const;
@@ -184,6 +185,10 @@ public:
         FileStorHandler::LockedMessage getNextMessage(uint32_t stripeId, uint32_t timeout) {
             return _stripes[stripeId].getNextMessage(timeout, *this);
         }
+        std::vector<std::shared_ptr<api::StorageMessage>>
+        getQueuedPuts(const document::Bucket & bucket, uint32_t maxPuts) {
+            return stripe(bucket).getQueuedPuts(bucket, maxPuts);
+        }
         std::shared_ptr<FileStorHandler::BucketLockInterface>
         lock(const document::Bucket & bucket, api::LockingRequirements lockReq) {
             return stripe(bucket).lock(bucket, lockReq);
@@ -243,6 +248,10 @@ public:
     bool schedule(const std::shared_ptr<api::StorageMessage>&, uint16_t disk);
 
     FileStorHandler::LockedMessage getNextMessage(uint16_t disk, uint32_t stripeId);
+    std::vector<std::shared_ptr<api::StorageMessage>>
+    getQueuedPuts(uint16_t disk, const document::Bucket & bucket, uint32_t maxPuts) {
+        return _diskInfo[disk].getQueuedPuts(bucket, maxPuts);
+    }
 
     enum Operation { MOVE, SPLIT, JOIN };
     void remapQueue(const RemapInfo& source, RemapInfo& target, Operation op);
@@ -902,9 +902,69 @@ PersistenceThread::processMessage(api::StorageMessage& msg, MessageTracker::UP t
     return tracker;
 }
 
+bool
+PersistenceThread::tryBatchQueuedPuts(FileStorHandler::LockedMessage & lock)
+{
+    const api::StorageMessage & msg(*lock.second);
+    uint32_t maxBatchSize = _env._config.maxPutBatchSize;
+    if ((_sequencedExecutor == nullptr) || (maxBatchSize <= 1) ||
+        (msg.getType().getId() != api::MessageType::PUT_ID) ||
+        tasConditionExists(static_cast<const api::PutCommand &>(msg)))
+    {
+        return false;
+    }
+    auto msgs = _env._fileStorHandler.getQueuedPuts(_env._partition, lock.first->getBucket(), maxBatchSize - 1);
+    if (msgs.empty()) {
+        return false;
+    }
+    msgs.insert(msgs.begin(), std::move(lock.second));
+    handlePutBatch(lock.first, std::move(msgs));
+    return true;
+}
+
+void
+PersistenceThread::handlePutBatch(const FileStorHandler::BucketLockInterface::SP & lock, std::vector<api::StorageMessage::SP> msgs)
+{
+    const document::Bucket & lockedBucket = lock->getBucket();
+    std::vector<spi::PersistenceProvider::BatchedPut> puts;
+    puts.reserve(msgs.size());
+    for (auto & msg : msgs) {
+        MBUS_TRACE(msg->getTrace(), 5, "PersistenceThread: Processing message in persistence layer as part of put batch");
+        _env._metrics.operations.inc();
+        auto & cmd = static_cast<api::PutCommand &>(*msg);
+        auto tracker = std::make_unique<MessageTracker>(_env, _env._fileStorHandler, lock, msg);
+        auto & metrics = _env._metrics.put[cmd.getLoadType()];
+        tracker->setMetric(metrics);
+        metrics.request_size.addValue(cmd.getApproxByteSize());
+        try {
+            getBucket(cmd.getDocumentId(), lockedBucket);
+        } catch (std::exception & e) {
+            LOG(debug, "Caught exception for %s: %s", cmd.toString().c_str(), e.what());
+            tracker->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            tracker->sendReply();
+            continue;
+        }
+        auto task = makeResultTask([tracker = std::move(tracker)](spi::Result::UP response) {
+            tracker->checkForError(*response);
+            tracker->sendReply();
+        });
+        puts.push_back({spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getDocument()),
+                        std::make_unique<ResultTaskOperationDone>(*_sequencedExecutor, cmd.getBucketId(), std::move(task))});
+    }
+    if (puts.empty()) {
+        return;
+    }
+    const api::StorageMessage & first(*msgs.front());
+    spi::Context context(first.getLoadType(), first.getPriority(), first.getTrace().getLevel());
+    _spi.putBatchAsync(spi::Bucket(lockedBucket, spi::PartitionId(_env._partition)), std::move(puts), context);
+}
+
 void
 PersistenceThread::processLockedMessage(FileStorHandler::LockedMessage lock) {
     LOG(debug, "Partition %d, nodeIndex %d, ptr=%p", _env._partition, _env._nodeIndex, lock.second.get());
+    if (tryBatchQueuedPuts(lock)) {
+        return;
+    }
     api::StorageMessage & msg(*lock.second);
 
     // Important: we _copy_ the message shared_ptr instead of moving to ensure that `msg` remains
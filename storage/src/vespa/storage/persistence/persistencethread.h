@@ -74,6 +74,8 @@ private:
 
     MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker);
     void processLockedMessage(FileStorHandler::LockedMessage lock);
+    bool tryBatchQueuedPuts(FileStorHandler::LockedMessage & lock);
+    void handlePutBatch(const FileStorHandler::BucketLockInterface::SP & lock, std::vector<api::StorageMessage::SP> msgs);
 
     // Thread main loop
     void run(framework::ThreadHandle&) override;
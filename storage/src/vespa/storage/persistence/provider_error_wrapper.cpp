@@ -181,6 +181,15 @@ ProviderErrorWrapper::putAsync(const spi::Bucket &bucket, spi::Timestamp ts, spi
     _impl.putAsync(bucket, ts, std::move(doc), context, std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::putBatchAsync(const spi::Bucket &bucket, std::vector<BatchedPut> puts, spi::Context &context)
+{
+    for (auto & put : puts) {
+        put.onComplete->addResultHandler(this);
+    }
+    _impl.putBatchAsync(bucket, std::move(puts), context);
+}
+
 void
 ProviderErrorWrapper::removeAsync(const spi::Bucket &bucket, spi::Timestamp ts, const document::DocumentId &docId,
                                   spi::Context & context, spi::OperationComplete::UP onComplete)
@@ -3,7 +3,11 @@
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/mmap_policy.h>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -279,4 +283,101 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+namespace {
+
+const char *mapped_file_name = "alloc_test_mapped_file";
+
+void
+write_mapped_file(const std::vector<char> &content)
+{
+    FILE *file = fopen(mapped_file_name, "wb");
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQUAL(content.size(), fwrite(content.data(), 1, content.size(), file));
+    fclose(file);
+}
+
+std::vector<char>
+read_mapped_file(size_t size)
+{
+    std::vector<char> content(size);
+    FILE *file = fopen(mapped_file_name, "rb");
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_EQUAL(size, fread(content.data(), 1, size, file));
+    fclose(file);
+    return content;
+}
+
+}
+
+TEST("mmap file alloc maps file content and is copy on write") {
+    std::vector<char> content(4096 + 5000);
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i % 251);
+    }
+    write_mapped_file(content);
+    {
+        Alloc buf = Alloc::allocMMapFile(mapped_file_name, 4096, 5000);
+        ASSERT_TRUE(buf.get() != nullptr);
+        EXPECT_EQUAL(8192ul, buf.size());
+        const char *data = static_cast<const char *>(buf.get());
+        EXPECT_EQUAL(0, memcmp(data, content.data() + 4096, 5000));
+        EXPECT_EQUAL(0, data[5000]);
+        static_cast<char *>(buf.get())[0] = 42;
+        EXPECT_EQUAL(42, data[0]);
+        Alloc other = buf.create(100);
+        EXPECT_EQUAL(4096ul, other.size());
+    }
+    EXPECT_TRUE(content == read_mapped_file(content.size()));
+    remove(mapped_file_name);
+}
+
+TEST("mmap file alloc is empty when file can not be mapped") {
+    std::vector<char> content(8192);
+    write_mapped_file(content);
+    EXPECT_TRUE(Alloc::allocMMapFile(mapped_file_name, 100, 4096).get() == nullptr);
+    remove(mapped_file_name);
+    EXPECT_TRUE(Alloc::allocMMapFile(mapped_file_name, 0, 4096).get() == nullptr);
+}
+
+TEST("mmap policy can be parsed") {
+    EXPECT_TRUE(MMapPolicy::fromString("").isDefault());
+    MMapPolicy policy = MMapPolicy::fromString("hugepages=transparent,numa=interleave");
+    EXPECT_TRUE(policy.hugePages() == MMapPolicy::HugePages::TRANSPARENT);
+    EXPECT_TRUE(policy.numa() == MMapPolicy::Numa::INTERLEAVE);
+    EXPECT_EQUAL("hugepages=transparent,numa=interleave", policy.toString());
+    EXPECT_TRUE(MMapPolicy::fromString("numa=local").numa() == MMapPolicy::Numa::LOCAL);
+    EXPECT_TRUE(MMapPolicy::fromString("hugepages=explicit") == MMapPolicy(MMapPolicy::HugePages::EXPLICIT, MMapPolicy::Numa::DEFAULT));
+    EXPECT_EXCEPTION(MMapPolicy::fromString("hugepages=huge"), IllegalArgumentException, "Illegal value 'huge' for 'hugepages'");
+    EXPECT_EXCEPTION(MMapPolicy::fromString("pages=none"), IllegalArgumentException, "Unknown key 'pages'");
+}
+
+TEST("mmap policy is taken from component environment variable") {
+    unsetenv("VESPA_MMAP_POLICY");
+    setenv("VESPA_MMAP_POLICY_TESTPARENT", "numa=local", 1);
+    setenv("VESPA_MMAP_POLICY_TESTCOMPONENT", "hugepages=none", 1);
+    EXPECT_EQUAL("hugepages=none,numa=default", MMapPolicy::forComponent("testcomponent", "testparent").toString());
+    EXPECT_EQUAL("hugepages=default,numa=local", MMapPolicy::forComponent("othercomponent", "testparent").toString());
+    EXPECT_TRUE(MMapPolicy::forComponent("othercomponent").isDefault());
+    setenv("VESPA_MMAP_POLICY", "hugepages=bogus", 1);
+    EXPECT_TRUE(MMapPolicy::forComponent("othercomponent").isDefault());
+    unsetenv("VESPA_MMAP_POLICY");
+    unsetenv("VESPA_MMAP_POLICY_TESTPARENT");
+    unsetenv("VESPA_MMAP_POLICY_TESTCOMPONENT");
+}
+
+TEST("auto alloc with mmap policy applies policy to large buffers") {
+    MMapPolicy policy(MMapPolicy::HugePages::NONE, MMapPolicy::Numa::LOCAL);
+    MMapPolicyStats before = MMapPolicyStats::get();
+    Alloc buf = Alloc::alloc(0, MemoryAllocator::HUGEPAGE_SIZE, 0, policy);
+    Alloc small = buf.create(100);
+    Alloc large = buf.create(3 * MemoryAllocator::HUGEPAGE_SIZE);
+    EXPECT_EQUAL(100u, small.size());
+    EXPECT_EQUAL(3u * MemoryAllocator::HUGEPAGE_SIZE, large.size());
+    memset(large.get(), 1, large.size());
+    MMapPolicyStats after = MMapPolicyStats::get();
+    size_t applied = (after.noHugePagesAllocatedBytes - before.noHugePagesAllocatedBytes) + (after.numaLocalAllocatedBytes - before.numaLocalAllocatedBytes);
+    size_t failed = after.failedAdvices - before.failedAdvices;
+    EXPECT_TRUE(applied == 2 * large.size() || failed > 0);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 #include <vespa/log/log.h>
 LOG_SETUP("btree_test");
 #include <vespa/vespalib/testkit/testapp.h>
+#include <set>
 #include <string>
 #include <vespa/vespalib/btree/btreeroot.h>
 #include <vespa/vespalib/btree/btreebuilder.h>
@@ -260,6 +261,8 @@ private:
     requireThatIteratorDistanceWorks();
 
     void requireThatForeachKeyWorks();
+    void requireThatBulkBuilderWorks();
+    void requireThatVectorNodeSearchWorks();
 public:
     int Main() override;
 };
@@ -1566,6 +1569,71 @@ Test::requireThatForeachKeyWorks()
     }
 };
 
+void
+Test::requireThatBulkBuilderWorks()
+{
+    using Tree = BTree<uint32_t, uint32_t, btree::NoAggregated>;
+    using KeyData = Tree::Builder::KeyDataType;
+    for (size_t numEntries : { 0u, 1u, 15u, 16u, 17u, 31u, 33u, 1000u, 300000u }) {
+        std::vector<KeyData> input;
+        for (size_t i = 0; i < numEntries; ++i) {
+            input.emplace_back(i * 3 + 1, i * 7);
+        }
+        Tree tree;
+        Tree::Builder builder(tree.getAllocator());
+        // Entries inserted one by one before the bulk insert must be kept
+        size_t head = std::min(numEntries, size_t(5));
+        for (size_t i = 0; i < head; ++i) {
+            builder.insert(input[i]._key, input[i].getData());
+        }
+        builder.insert_bulk(input.data() + head, input.data() + numEntries);
+        tree.assign(builder);
+        EXPECT_EQUAL(numEntries, tree.size());
+        EXPECT_TRUE(tree.isValid());
+        auto itr = tree.begin();
+        for (const auto &kd : input) {
+            if (!EXPECT_TRUE(itr.valid())) {
+                break;
+            }
+            EXPECT_EQUAL(kd._key, itr.getKey());
+            EXPECT_EQUAL(kd.getData(), itr.getData());
+            ++itr;
+        }
+        EXPECT_FALSE(itr.valid());
+    }
+}
+
+void
+Test::requireThatVectorNodeSearchWorks()
+{
+    using Tree = BTree<int64_t, BTreeNoLeafData, btree::NoAggregated>;
+    Tree tree;
+    std::set<int64_t> exp;
+    vespalib::Rand48 rnd;
+    rnd.srand48(17);
+    for (size_t i = 0; i < 5000; ++i) {
+        int64_t key = (static_cast<int64_t>(rnd.lrand48() % 20000) - 10000) * 1000000007;
+        tree.insert(key, BTreeNoLeafData());
+        exp.insert(key);
+    }
+    EXPECT_EQUAL(exp.size(), tree.size());
+    for (int64_t probe = -10001; probe <= 10001; ++probe) {
+        int64_t key = probe * 1000000007;
+        auto lb = tree.lowerBound(key);
+        auto elb = exp.lower_bound(key);
+        EXPECT_EQUAL(elb != exp.end(), lb.valid());
+        if (lb.valid() && elb != exp.end()) {
+            EXPECT_EQUAL(*elb, lb.getKey());
+        }
+        auto ub = tree.upperBound(key);
+        auto eub = exp.upper_bound(key);
+        EXPECT_EQUAL(eub != exp.end(), ub.valid());
+        if (ub.valid() && eub != exp.end()) {
+            EXPECT_EQUAL(*eub, ub.getKey());
+        }
+    }
+}
+
 int
 Test::Main()
 {
@@ -1592,6 +1660,8 @@ Test::Main()
     requireThatApplyWorks();
     requireThatIteratorDistanceWorks();
     requireThatForeachKeyWorks();
+    requireThatBulkBuilderWorks();
+    requireThatVectorNodeSearchWorks();
 
     TEST_DONE();
 }
@@ -0,0 +1,161 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/btree/btreeroot.h>
+#include <vespa/vespalib/btree/btreebuilder.h>
+#include <vespa/vespalib/btree/btreenodeallocator.h>
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/time.h>
+
+#include <vespa/fastos/app.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("buildsearchspeed");
+
+namespace vespalib::btree {
+
+namespace {
+
+/*
+ * Same ordering as std::less<uint32_t>, but not recognized by the node
+ * search, which then falls back to binary search.
+ */
+struct PlainLess {
+    bool operator()(uint32_t lhs, uint32_t rhs) const { return lhs < rhs; }
+};
+
+}
+
+class BuildSearchSpeed : public FastOS_Application
+{
+    template <typename CompareT>
+    void searchLoop(int loops, const char *name);
+    void buildLoop(int loops, const char *name, bool bulk);
+    void usage();
+    int Main() override;
+};
+
+template <typename CompareT>
+void
+BuildSearchSpeed::searchLoop(int loops, const char *name)
+{
+    using Tree = BTree<uint32_t, uint32_t, btree::NoAggregated, CompareT>;
+    Tree tree;
+    typename Tree::Builder builder(tree.getAllocator());
+    size_t numEntries = 1000000;
+    size_t numLookups = 10000000;
+    for (size_t i = 0; i < numEntries; ++i) {
+        builder.insert(i * 2, i);
+    }
+    tree.assign(builder);
+    std::vector<uint32_t> keys;
+    vespalib::Rand48 rnd;
+    rnd.srand48(42);
+    for (size_t i = 0; i < numLookups; ++i) {
+        keys.push_back(rnd.lrand48() % (numEntries * 2));
+    }
+    for (int l = 0; l < loops; ++l) {
+        vespalib::Timer timer;
+        uint64_t sum = 0;
+        for (uint32_t key : keys) {
+            auto itr = tree.lowerBound(key);
+            sum += itr.valid() ? itr.getData() : 0;
+        }
+        double used = vespalib::to_s(timer.elapsed());
+        printf("Elapsed time for %zu lower bound lookups is %8.5f, search=%s, sum=%" PRIu64 "\n",
+               numLookups, used, name, sum);
+        fflush(stdout);
+    }
+}
+
+void
+BuildSearchSpeed::buildLoop(int loops, const char *name, bool bulk)
+{
+    using Tree = BTree<uint32_t, uint32_t, btree::NoAggregated>;
+    using KeyData = Tree::Builder::KeyDataType;
+    size_t numEntries = 10000000;
+    std::vector<KeyData> input;
+    input.reserve(numEntries);
+    for (size_t i = 0; i < numEntries; ++i) {
+        input.emplace_back(i, i);
+    }
+    for (int l = 0; l < loops; ++l) {
+        Tree tree;
+        vespalib::Timer timer;
+        typename Tree::Builder builder(tree.getAllocator());
+        if (bulk) {
+            builder.insert_bulk(&input[0], &input[0] + numEntries);
+        } else {
+            for (const auto &kd : input) {
+                builder.insert(kd._key, kd.getData());
+            }
+        }
+        tree.assign(builder);
+        double used = vespalib::to_s(timer.elapsed());
+        assert(tree.size() == numEntries);
+        printf("Elapsed time for building tree with %zu entries is %8.5f, builder=%s\n",
+               numEntries, used, name);
+        fflush(stdout);
+    }
+}
+
+void
+BuildSearchSpeed::usage()
+{
+    printf("buildsearchspeed "
+           "[-b] "
+           "[-c <numLoops>] "
+           "[-s]\n");
+}
+
+int
+BuildSearchSpeed::Main()
+{
+    int argi;
+    char c;
+    const char *optArg;
+    argi = 1;
+    int loops = 1;
+    bool build = false;
+    bool search = false;
+    while ((c = GetOpt("bc:s", optArg, argi)) != -1) {
+        switch (c) {
+        case 'b':
+            build = true;
+            break;
+        case 'c':
+            loops = atoi(optArg);
+            break;
+        case 's':
+            search = true;
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (!build && !search) {
+        build = true;
+        search = true;
+    }
+    if (search) {
+        searchLoop<PlainLess>(loops, "binary");
+        searchLoop<std::less<uint32_t>>(loops, "vector");
+    }
+    if (build) {
+        buildLoop(loops, "insert", false);
+        buildLoop(loops, "insert_bulk", true);
+    }
+    return 0;
+}
+
+}
+
+FASTOS_MAIN(vespalib::btree::BuildSearchSpeed);
@@ -0,0 +1,185 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/datastore/simple_hash_map.h>
+#include <vespa/vespalib/datastore/unique_store.hpp>
+#include <vespa/vespalib/datastore/unique_store_dictionary.hpp>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/time.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("simple_hash_map_test");
+
+using namespace vespalib::datastore;
+using vespalib::datastore::uniquestore::DefaultUniqueStoreDictionary;
+
+namespace {
+
+/*
+ * Entry refs are used as values, with invalid entry ref mapped to the value to find.
+ * Values are hashed by dividing by hash_divisor, a large divisor gives chains with
+ * multiple entries.
+ */
+class Comparator : public EntryComparator {
+    EntryRef _to_find;
+    uint32_t _hash_divisor;
+
+    EntryRef resolve(EntryRef ref) const {
+        return ref.valid() ? ref : _to_find;
+    }
+public:
+    Comparator(uint32_t to_find, uint32_t hash_divisor = 1000)
+        : _to_find(to_find),
+          _hash_divisor(hash_divisor)
+    {
+    }
+    bool operator()(const EntryRef lhs, const EntryRef rhs) const override {
+        return resolve(lhs).ref() < resolve(rhs).ref();
+    }
+    size_t hash(const EntryRef ref) const override {
+        return resolve(ref).ref() / _hash_divisor;
+    }
+};
+
+size_t hash_of(uint32_t value) { return Comparator(value).hash(EntryRef()); }
+
+}
+
+struct SimpleHashMapTest : public ::testing::Test {
+    SimpleHashMap map;
+    vespalib::GenerationHandler::generation_t generation;
+
+    SimpleHashMapTest()
+        : map(),
+          generation(1)
+    {
+    }
+    void add(uint32_t value) { map.add(hash_of(value), EntryRef(value)); }
+    void remove(uint32_t value) { map.remove(hash_of(value), EntryRef(value)); }
+    EntryRef find(uint32_t value) const { return map.find(Comparator(value), hash_of(value)); }
+    void commit() {
+        map.transfer_hold_lists(generation);
+        ++generation;
+        map.trim_hold_lists(generation);
+    }
+};
+
+TEST_F(SimpleHashMapTest, can_add_and_find_entries)
+{
+    add(1);
+    add(1001);
+    add(2500);
+    EXPECT_EQ(3u, map.size());
+    EXPECT_EQ(EntryRef(1), find(1));
+    EXPECT_EQ(EntryRef(1001), find(1001));
+    EXPECT_EQ(EntryRef(2500), find(2500));
+    EXPECT_FALSE(find(2).valid());
+    EXPECT_FALSE(find(1002).valid());
+}
+
+TEST_F(SimpleHashMapTest, can_remove_entries_sharing_chain)
+{
+    add(1);
+    add(2);
+    add(3);
+    remove(2);
+    EXPECT_EQ(2u, map.size());
+    EXPECT_EQ(EntryRef(1), find(1));
+    EXPECT_FALSE(find(2).valid());
+    EXPECT_EQ(EntryRef(3), find(3));
+    remove(3);
+    remove(1);
+    EXPECT_EQ(0u, map.size());
+    EXPECT_FALSE(find(1).valid());
+}
+
+TEST_F(SimpleHashMapTest, can_replace_entry_ref)
+{
+    add(5);
+    map.replace(hash_of(5), EntryRef(5), EntryRef(6));
+    // Entry ref 6 now represents the value, hashed as value 5 was.
+    EXPECT_EQ(EntryRef(6), map.find(Comparator(6), hash_of(5)));
+    EXPECT_FALSE(find(5).valid());
+}
+
+TEST_F(SimpleHashMapTest, map_grows_when_full)
+{
+    for (uint32_t value = 1; value <= 10000; ++value) {
+        add(value);
+    }
+    EXPECT_EQ(10000u, map.size());
+    for (uint32_t value = 1; value <= 10000; ++value) {
+        EXPECT_EQ(EntryRef(value), find(value));
+    }
+    auto usage = map.get_memory_usage();
+    EXPECT_LT(0u, usage.allocatedBytesOnHold());
+    commit();
+    usage = map.get_memory_usage();
+    EXPECT_EQ(0u, usage.allocatedBytesOnHold());
+}
+
+TEST_F(SimpleHashMapTest, removed_nodes_are_reused_after_hold)
+{
+    add(1);
+    add(2);
+    remove(1);
+    auto usage = map.get_memory_usage();
+    EXPECT_LT(0u, usage.allocatedBytesOnHold());
+    commit();
+    usage = map.get_memory_usage();
+    EXPECT_EQ(0u, usage.allocatedBytesOnHold());
+    EXPECT_LT(0u, usage.deadBytes());
+    add(3);
+    usage = map.get_memory_usage();
+    EXPECT_EQ(0u, usage.deadBytes());
+    EXPECT_EQ(EntryRef(2), find(2));
+    EXPECT_EQ(EntryRef(3), find(3));
+}
+
+TEST_F(SimpleHashMapTest, clear_removes_all_entries)
+{
+    add(1);
+    add(2);
+    map.clear();
+    EXPECT_EQ(0u, map.size());
+    EXPECT_FALSE(find(1).valid());
+    add(1);
+    EXPECT_EQ(EntryRef(1), find(1));
+}
+
+namespace {
+
+double
+measure_lookups(DefaultUniqueStoreDictionary& dict, uint32_t num_values, uint32_t loops)
+{
+    vespalib::steady_time start = vespalib::steady_clock::now();
+    uint32_t found = 0;
+    for (uint32_t loop = 0; loop < loops; ++loop) {
+        for (uint32_t value = 1; value <= num_values; ++value) {
+            if (dict.find(Comparator(value, 1)).valid()) {
+                ++found;
+            }
+        }
+    }
+    EXPECT_EQ(num_values * loops, found);
+    return vespalib::to_s(vespalib::steady_clock::now() - start);
+}
+
+}
+
+// Run with --gtest_also_run_disabled_tests to compare lookup times.
+TEST(SimpleHashMapBenchmark, DISABLED_benchmark_btree_and_hash_lookups)
+{
+    constexpr uint32_t num_values = 100000;
+    constexpr uint32_t loops = 10;
+    DefaultUniqueStoreDictionary btree_dict;
+    DefaultUniqueStoreDictionary hash_dict(std::make_unique<Comparator>(0, 1));
+    for (uint32_t value = 1; value <= num_values; ++value) {
+        btree_dict.add(Comparator(value, 1), [=]() { return EntryRef(value); });
+        hash_dict.add(Comparator(value, 1), [=]() { return EntryRef(value); });
+    }
+    double btree_time = measure_lookups(btree_dict, num_values, loops);
+    double hash_time = measure_lookups(hash_dict, num_values, loops);
+    LOG(info, "%u lookups: btree %8.5f s, btree and hash %8.5f s", num_values * loops, btree_time, hash_time);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -28,6 +28,9 @@ public:
     bool operator()(const EntryRef lhs, const EntryRef rhs) const override {
         return resolve(lhs).ref() < resolve(rhs).ref();
     }
+    size_t hash(const EntryRef ref) const override {
+        return resolve(ref).ref();
+    }
 };
 
 struct DictionaryReadTest : public ::testing::Test {
@@ -81,4 +84,46 @@ TEST_F(DictionaryReadTest, can_iterate_all_keys)
     EXPECT_EQ(EntryRefVector({EntryRef(3), EntryRef(5), EntryRef(7)}), refs);
 }
 
+struct DictionaryWithHashTest : public ::testing::Test {
+    DefaultUniqueStoreDictionary dict;
+
+    DictionaryWithHashTest()
+        : dict(std::make_unique<Comparator>(0))
+    {
+    }
+    DictionaryWithHashTest& add(uint32_t value) {
+        auto result = dict.add(Comparator(value), [=]() { return EntryRef(value); });
+        assert(result.inserted());
+        return *this;
+    }
+    EntryRef find(uint32_t value) { return dict.find(Comparator(value)); }
+};
+
+TEST_F(DictionaryWithHashTest, exact_lookups_use_hash_dictionary)
+{
+    EXPECT_TRUE(dict.has_hash_dictionary());
+    for (uint32_t value = 1; value < 100; value += 2) {
+        add(value);
+    }
+    EXPECT_EQ(50u, dict.get_num_uniques());
+    EXPECT_EQ(EntryRef(7), find(7));
+    EXPECT_FALSE(find(8).valid());
+    auto result = dict.add(Comparator(7), []() -> EntryRef { abort(); });
+    EXPECT_FALSE(result.inserted());
+    EXPECT_EQ(EntryRef(7), result.ref());
+    dict.remove(Comparator(7), EntryRef(7));
+    EXPECT_FALSE(find(7).valid());
+    EXPECT_EQ(EntryRef(9), find(9));
+}
+
+TEST_F(DictionaryWithHashTest, build_rebuilds_hash_dictionary)
+{
+    add(3).add(5);
+    std::vector<EntryRef> refs({EntryRef(4), EntryRef(6), EntryRef(8)});
+    dict.build(refs);
+    EXPECT_FALSE(find(3).valid());
+    EXPECT_EQ(EntryRef(6), find(6));
+    EXPECT_EQ(3u, dict.get_num_uniques());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
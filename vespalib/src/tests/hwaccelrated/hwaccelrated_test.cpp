@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <limits>
 
 using namespace vespalib;
 
@@ -37,4 +38,50 @@ TEST("test euclidean distance") {
     verifyEuclideanDistance<double >(genericAccelrator);
 }
 
+template<typename T>
+std::vector<uint64_t> findInRange(const hwaccelrated::IAccelrated & accel, const std::vector<T> & v, size_t offset, T low, T high) {
+    std::vector<uint64_t> bits((v.size() - offset + 63)/64, 0xdeadbeef);
+    accel.findInRange(&v[offset], v.size() - offset, low, high, &bits[0]);
+    return bits;
+}
+
+template<typename T>
+void verifyFindInRange(const hwaccelrated::IAccelrated & accel) {
+    const size_t testLength(1000);
+    srand(1);
+    std::vector<T> v = createAndFill<T>(testLength);
+    hwaccelrated::GenericAccelrator genericAccelrator;
+    for (size_t offset(0); offset < 0x41; offset++) {
+        auto bits = findInRange<T>(accel, v, offset, T(20), T(60));
+        EXPECT_TRUE(findInRange<T>(genericAccelrator, v, offset, T(20), T(60)) == bits);
+        for (size_t i(offset); i < testLength; i++) {
+            bool expected = (T(20) <= v[i]) && (v[i] <= T(60));
+            EXPECT_EQUAL(expected, ((bits[(i - offset)/64] >> ((i - offset) % 64)) & 1) != 0);
+        }
+        size_t used = (testLength - offset) % 64;
+        if (used != 0) {
+            EXPECT_EQUAL(0u, bits.back() >> used);
+        }
+    }
+}
+
+TEST("test find in range") {
+    const auto & accel = hwaccelrated::IAccelrated::getAccelerator();
+    verifyFindInRange<int8_t>(accel);
+    verifyFindInRange<int16_t>(accel);
+    verifyFindInRange<int32_t>(accel);
+    verifyFindInRange<int64_t>(accel);
+    verifyFindInRange<float>(accel);
+    verifyFindInRange<double>(accel);
+}
+
+TEST("test find in range does not match nan") {
+    const auto & accel = hwaccelrated::IAccelrated::getAccelerator();
+    std::vector<double> v(100, 1.0);
+    v[3] = std::numeric_limits<double>::quiet_NaN();
+    auto bits = findInRange<double>(accel, v, 0, 0.0, 2.0);
+    EXPECT_EQUAL(uint64_t(~(uint64_t(1) << 3)), bits[0]);
+    EXPECT_EQUAL((uint64_t(1) << 36) - 1, bits[1]);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,8 @@
 #include "noaggrcalc.h"
 #include "minmaxaggrcalc.h"
 #include "btreeaggregator.h"
+#include "btree_key_data.h"
+
 
 namespace vespalib::btree {
 
@@ -25,6 +27,7 @@ public:
     using InternalNodeType = typename NodeAllocatorType::InternalNodeType;
     using LeafNodeType = typename NodeAllocatorType::LeafNodeType;
     using Aggregator = BTreeAggregator<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>;
+    using KeyDataType = BTreeKeyData<KeyT, DataT>;
 private:
     using KeyType = KeyT;
     using DataType = DataT;
@@ -43,6 +46,8 @@ private:
 
     void normalize();
     void allocNewLeafNode();
+    void linkLeafNode(LeafNodeTypeRefPair lPair);
+    void fillLeafNode(LeafNodeType *leaf, const KeyDataType *src) const;
     InternalNodeType *createInternalNode();
 public:
     BTreeBuilder(NodeAllocatorType &allocator);
@@ -51,6 +56,12 @@ public:
 
     void recursiveDelete(NodeRef node);
     void insert(const KeyT &key, const DataT &data);
+    /*
+     * Insert sorted entries, all larger than previously inserted keys.
+     * Full leaf nodes are allocated up front and filled directly, before
+     * being linked into the tree bottom-up.
+     */
+    void insert_bulk(const KeyDataType *a, const KeyDataType *ae);
     NodeRef handover();
     void reuse();
     void clear();
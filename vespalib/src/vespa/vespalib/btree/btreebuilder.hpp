@@ -299,6 +299,16 @@ template <typename KeyT, typename DataT, typename AggrT,
 void
 BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>::
 allocNewLeafNode()
+{
+    linkLeafNode(_allocator.allocLeafNode());
+}
+
+
+template <typename KeyT, typename DataT, typename AggrT,
+          size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
+void
+BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>::
+linkLeafNode(LeafNodeTypeRefPair lPair)
 {
     InternalNodeType  *inode;
     NodeRef child;
@@ -306,7 +316,6 @@ allocNewLeafNode()
     if constexpr (AggrCalcT::hasAggregated()) {
         Aggregator::recalc(*_leaf.data, _aggrCalc);
     }
-    LeafNodeTypeRefPair lPair(_allocator.allocLeafNode());
     _numLeafNodes++;
 
     child = lPair.ref;
@@ -383,6 +392,56 @@ insert(const KeyT &key,
 }
 
 
+template <typename KeyT, typename DataT, typename AggrT,
+          size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
+void
+BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>::
+fillLeafNode(LeafNodeType *leaf, const KeyDataType *src) const
+{
+    leaf->setValidSlots(LEAF_SLOTS);
+    for (uint32_t idx = 0; idx < LEAF_SLOTS; ++idx, ++src) {
+        leaf->update(idx, src->_key, src->getData());
+    }
+    if constexpr (AggrCalcT::hasAggregated()) {
+        Aggregator::recalc(*leaf, _aggrCalc);
+    }
+}
+
+
+template <typename KeyT, typename DataT, typename AggrT,
+          size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
+void
+BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, AggrCalcT>::
+insert_bulk(const KeyDataType *a, const KeyDataType *ae)
+{
+    LeafNodeType *leaf = _leaf.data;
+    for (; a != ae && leaf->validSlots() < LeafNodeType::maxSlots(); ++a) {
+        leaf->insert(leaf->validSlots(), a->_key, a->getData());
+        ++_numInserts;
+    }
+    size_t numLeaves = (ae - a) / LEAF_SLOTS;
+    if (numLeaves > 0) {
+        // Nodes are allocated before filling, since allocation might move the node buffers
+        std::vector<LeafNodeTypeRefPair> leaves;
+        leaves.reserve(numLeaves);
+        for (size_t i = 0; i < numLeaves; ++i) {
+            leaves.push_back(_allocator.allocLeafNode());
+        }
+        for (size_t i = 0; i < numLeaves; ++i) {
+            fillLeafNode(leaves[i].data, a + i * LEAF_SLOTS);
+        }
+        for (const auto &lPair : leaves) {
+            linkLeafNode(lPair);
+        }
+        a += numLeaves * LEAF_SLOTS;
+        _numInserts += numLeaves * LEAF_SLOTS;
+    }
+    for (; a != ae; ++a) {
+        insert(a->_key, a->getData());
+    }
+}
+
+
 template <typename KeyT, typename DataT, typename AggrT,
           size_t INTERNAL_SLOTS, size_t LEAF_SLOTS, class AggrCalcT>
 typename BTreeBuilder<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS,
@@ -4,9 +4,55 @@
 
 #include "btreenode.h"
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
 
 namespace vespalib::btree {
 
+namespace nodesearch {
+
+/*
+ * Integral keys compared with std::less are searched by counting the
+ * keys below (or not above) the wanted key with vector compares, which
+ * avoids the unpredictable branches of a binary search in small nodes.
+ */
+template <typename KeyT, typename CompareT>
+constexpr bool use_vector_search = std::is_integral_v<KeyT> &&
+                                   (sizeof(KeyT) == 4 || sizeof(KeyT) == 8) &&
+                                   std::is_same_v<CompareT, std::less<KeyT>>;
+
+template <typename KeyT, bool inclusive>
+uint32_t
+count_below(const KeyT *keys, uint32_t sidx, uint32_t eidx, KeyT key)
+{
+    constexpr uint32_t lanes = 16 / sizeof(KeyT);
+    typedef KeyT KeyVec __attribute__((vector_size(16)));
+    using MaskVec = decltype(KeyVec() < KeyVec());
+    KeyVec keyv = KeyVec() + key;
+    MaskVec acc = MaskVec();
+    uint32_t idx = sidx;
+    for (; idx + lanes <= eidx; idx += lanes) {
+        KeyVec v;
+        memcpy(&v, keys + idx, sizeof(v));
+        if constexpr (inclusive) {
+            acc += (v <= keyv);
+        } else {
+            acc += (v < keyv);
+        }
+    }
+    uint32_t count = 0;
+    for (uint32_t lane = 0; lane < lanes; ++lane) {
+        count -= acc[lane]; // true lanes are -1
+    }
+    for (; idx < eidx; ++idx) {
+        count += (inclusive ? (keys[idx] <= key) : (keys[idx] < key)) ? 1 : 0;
+    }
+    return count;
+}
+
+}
+
 namespace {
 
 class SplitInsertHelper {
@@ -43,6 +89,10 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
+    if constexpr (nodesearch::use_vector_search<KeyT, CompareT>) {
+        (void) comp;
+        return sidx + nodesearch::count_below<KeyT, false>(_keys, sidx, validSlots(), key);
+    }
     const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
         (_keys + sidx, _keys + validSlots(), key, comp);
     return itr - _keys;
@@ -53,7 +103,10 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const
 {
-    
+    if constexpr (nodesearch::use_vector_search<KeyT, CompareT>) {
+        (void) comp;
+        return nodesearch::count_below<KeyT, false>(_keys, 0, validSlots(), key);
+    }
     const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
         (_keys, _keys + validSlots(), key, comp);
     return itr - _keys;
@@ -66,6 +119,10 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
+    if constexpr (nodesearch::use_vector_search<KeyT, CompareT>) {
+        (void) comp;
+        return sidx + nodesearch::count_below<KeyT, true>(_keys, sidx, validSlots(), key);
+    }
     const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
         (_keys + sidx, _keys + validSlots(), key, comp);
     return itr - _keys;
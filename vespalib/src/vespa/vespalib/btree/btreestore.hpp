@@ -644,7 +644,12 @@ applyNewTree(EntryRef &ref,
     size_t additionSize(ae - a);
     BTreeTypeRefPair tPair(allocBTree());
     BTreeType *tree = tPair.data;
-    applyBuildTree(tree, a, ae, nullptr, nullptr, comp);
+    (void) comp;
+    // Additions are sorted and there is no old tree to merge with
+    Builder &builder = _builder;
+    builder.reuse();
+    builder.insert_bulk(a, ae);
+    tree->assign(builder, _allocator);
     assert(tree->size(_allocator) == additionSize);
     (void) additionSize;
     ref = tPair.ref;
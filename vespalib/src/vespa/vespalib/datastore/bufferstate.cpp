@@ -159,7 +159,7 @@ BufferState::onFree(void *&buffer)
     assert(_deadElems <= _usedElems);
     assert(_holdElems == _usedElems - _deadElems);
     _typeHandler->destroyElements(buffer, _usedElems);
-    Alloc::alloc().swap(_buffer);
+    _buffer.create(0).swap(_buffer);
     _typeHandler->onFree(_usedElems);
     buffer = NULL;
     _usedElems = 0;
@@ -199,6 +199,14 @@ BufferState::dropBuffer(void *&buffer)
 }
 
 
+void
+BufferState::setMMapPolicy(const alloc::MMapPolicy &policy)
+{
+    assert(_state == FREE);
+    assert(_buffer.get() == nullptr);
+    _buffer = Alloc::alloc(0, MemoryAllocator::HUGEPAGE_SIZE, 0, policy);
+}
+
 void
 BufferState::setFreeListList(FreeListList *freeListList)
 {
@@ -8,6 +8,8 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/array.h>
 
+namespace vespalib::alloc { class MMapPolicy; }
+
 namespace vespalib::datastore {
 
 /**
@@ -99,6 +101,12 @@ public:
      */
     void onFree(void *&buffer);
 
+    /**
+     * Select how large buffers are mapped when the buffer is activated
+     * later. Must be called in FREE state.
+     */
+    void setMMapPolicy(const alloc::MMapPolicy &policy);
+
     /**
      * Set list of buffer states with nonempty free lists.
      *
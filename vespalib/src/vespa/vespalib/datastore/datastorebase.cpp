@@ -34,6 +34,13 @@ activeWriteBufferTooDead(const BufferState &state)
     return ((deadBytes >= TOODEAD_SLACK) && (deadElems * 2 >= state.size()));
 }
 
+const alloc::MMapPolicy &
+defaultMMapPolicy()
+{
+    static const alloc::MMapPolicy policy = alloc::MMapPolicy::forComponent("datastore");
+    return policy;
+}
+
 }
 
 DataStoreBase::FallbackHold::FallbackHold(size_t bytesSize,
@@ -85,6 +92,7 @@ DataStoreBase::DataStoreBase(uint32_t numBuffers, size_t maxArrays)
       _numBuffers(numBuffers),
       _maxArrays(maxArrays),
       _compaction_count(0u),
+      _mmapPolicy(defaultMMapPolicy()),
       _genHolder()
 {
 }
@@ -347,6 +355,7 @@ DataStoreBase::onActive(uint32_t bufferId, uint32_t typeId, size_t elemsNeeded)
     assert(bufferId < _numBuffers);
     _buffers[bufferId].setTypeId(typeId);
     BufferState &state = _states[bufferId];
+    state.setMMapPolicy(_mmapPolicy);
     state.onActive(bufferId, typeId,
                    _typeHandlers[typeId],
                    elemsNeeded,
@@ -6,6 +6,7 @@
 #include <vespa/vespalib/util/address_space.h>
 #include <vespa/vespalib/util/generationholder.h>
 #include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/mmap_policy.h>
 #include <vector>
 #include <deque>
 #include <atomic>
@@ -150,6 +151,7 @@ protected:
     const uint32_t _numBuffers;
     const size_t   _maxArrays;
     mutable std::atomic<uint64_t> _compaction_count;
+    alloc::MMapPolicy _mmapPolicy;
 
     vespalib::GenerationHolder _genHolder;
 
@@ -333,6 +335,13 @@ public:
      */
     void setInitializing(bool initializing) { _initializing = initializing; }
 
+    /*
+     * Select how large buffers activated from now on are mapped. The
+     * default is the "datastore" mmap policy.
+     */
+    void setMMapPolicy(const alloc::MMapPolicy &policy) { _mmapPolicy = policy; }
+    const alloc::MMapPolicy &getMMapPolicy() const { return _mmapPolicy; }
+
 private:
     /**
      * Switch buffer state to active.
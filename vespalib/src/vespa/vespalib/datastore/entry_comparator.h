@@ -3,6 +3,7 @@
 #pragma once
 
 #include "entryref.h"
+#include <cstddef>
 
 namespace vespalib::datastore {
 
@@ -20,6 +21,24 @@ public:
      * Returns true if the value represented by lhs ref is less than the value represented by rhs ref.
      */
     virtual bool operator()(const EntryRef lhs, const EntryRef rhs) const = 0;
+
+    /**
+     * Returns true if the values represented by lhs ref and rhs ref are equal.
+     */
+    virtual bool equal(const EntryRef lhs, const EntryRef rhs) const {
+        return !(*this)(lhs, rhs) && !(*this)(rhs, lhs);
+    }
+
+    /**
+     * Returns hash of the value represented by ref. Values that are equal
+     * according to this comparator must have the same hash. The default
+     * maps all values to the same hash, which is correct but makes hash
+     * based lookup degenerate into a linear scan.
+     */
+    virtual size_t hash(const EntryRef ref) const {
+        (void) ref;
+        return 0u;
+    }
 };
 
 }
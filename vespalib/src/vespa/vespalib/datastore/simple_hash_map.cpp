@@ -0,0 +1,242 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "simple_hash_map.h"
+#include "entry_comparator.h"
+#include <cassert>
+
+namespace vespalib::datastore {
+
+namespace {
+
+constexpr uint32_t initial_num_chains_log2 = 4;
+
+}
+
+SimpleHashMap::Table::Table(uint32_t num_chains_log2)
+    : GenerationHeldBase(table_size(num_chains_log2)),
+      _num_chains(1u << num_chains_log2),
+      _shift(64 - num_chains_log2),
+      _capacity(_num_chains),
+      _chain_heads(new std::atomic<uint32_t>[_num_chains]),
+      _nodes(new Node[_capacity]),
+      _used_nodes(0u),
+      _count(0u),
+      _free_list(),
+      _hold_1_list(),
+      _hold_2_list()
+{
+    for (uint32_t chain = 0; chain < _num_chains; ++chain) {
+        _chain_heads[chain].store(no_node_idx, std::memory_order_relaxed);
+    }
+}
+
+SimpleHashMap::Table::~Table() = default;
+
+size_t
+SimpleHashMap::Table::table_size(uint32_t num_chains_log2)
+{
+    size_t num_chains = 1u << num_chains_log2;
+    return num_chains * (sizeof(std::atomic<uint32_t>) + sizeof(Node));
+}
+
+EntryRef
+SimpleHashMap::Table::find(const EntryComparator& comp, size_t hash) const
+{
+    uint32_t node_idx = _chain_heads[get_chain(hash)].load(std::memory_order_acquire);
+    while (node_idx != no_node_idx) {
+        const Node &node = _nodes[node_idx];
+        if (node.get_hash() == hash) {
+            EntryRef ref = node.get_ref();
+            if (comp.equal(EntryRef(), ref)) {
+                return ref;
+            }
+        }
+        node_idx = node.get_next();
+    }
+    return EntryRef();
+}
+
+void
+SimpleHashMap::Table::add(size_t hash, EntryRef ref)
+{
+    uint32_t node_idx;
+    if (!_free_list.empty()) {
+        node_idx = _free_list.back();
+        _free_list.pop_back();
+    } else {
+        assert(_used_nodes < _capacity);
+        node_idx = _used_nodes++;
+    }
+    auto &head = _chain_heads[get_chain(hash)];
+    _nodes[node_idx].init(hash, ref, head.load(std::memory_order_relaxed));
+    head.store(node_idx, std::memory_order_release);
+    ++_count;
+}
+
+void
+SimpleHashMap::Table::remove(size_t hash, EntryRef ref)
+{
+    auto &head = _chain_heads[get_chain(hash)];
+    uint32_t prev_idx = no_node_idx;
+    uint32_t node_idx = head.load(std::memory_order_relaxed);
+    while (node_idx != no_node_idx) {
+        Node &node = _nodes[node_idx];
+        if (node.get_ref() == ref) {
+            if (prev_idx == no_node_idx) {
+                head.store(node.get_next(), std::memory_order_release);
+            } else {
+                _nodes[prev_idx].set_next(node.get_next());
+            }
+            // Readers might still be traversing the node, delay reuse.
+            _hold_1_list.push_back(node_idx);
+            --_count;
+            return;
+        }
+        prev_idx = node_idx;
+        node_idx = node.get_next();
+    }
+    assert(false && "entry ref not found in hash map");
+}
+
+void
+SimpleHashMap::Table::replace(size_t hash, EntryRef old_ref, EntryRef new_ref)
+{
+    uint32_t node_idx = _chain_heads[get_chain(hash)].load(std::memory_order_relaxed);
+    while (node_idx != no_node_idx) {
+        Node &node = _nodes[node_idx];
+        if (node.get_ref() == old_ref) {
+            node.set_ref(new_ref);
+            return;
+        }
+        node_idx = node.get_next();
+    }
+    assert(false && "entry ref not found in hash map");
+}
+
+void
+SimpleHashMap::Table::move_to(Table& new_table) const
+{
+    for (uint32_t chain = 0; chain < _num_chains; ++chain) {
+        uint32_t node_idx = _chain_heads[chain].load(std::memory_order_relaxed);
+        while (node_idx != no_node_idx) {
+            const Node &node = _nodes[node_idx];
+            new_table.add(node.get_hash(), node.get_ref());
+            node_idx = node.get_next();
+        }
+    }
+}
+
+void
+SimpleHashMap::Table::transfer_hold_lists(generation_t generation)
+{
+    for (uint32_t node_idx : _hold_1_list) {
+        _hold_2_list.emplace_back(generation, node_idx);
+    }
+    _hold_1_list.clear();
+}
+
+void
+SimpleHashMap::Table::trim_hold_lists(generation_t first_used)
+{
+    while (!_hold_2_list.empty() &&
+           static_cast<vespalib::GenerationHandler::sgeneration_t>(_hold_2_list.front().first - first_used) < 0) {
+        _free_list.push_back(_hold_2_list.front().second);
+        _hold_2_list.pop_front();
+    }
+}
+
+vespalib::MemoryUsage
+SimpleHashMap::Table::get_memory_usage() const
+{
+    size_t held_nodes = _hold_1_list.size() + _hold_2_list.size();
+    return vespalib::MemoryUsage(getSize(),
+                                 _num_chains * sizeof(std::atomic<uint32_t>) + _used_nodes * sizeof(Node),
+                                 _free_list.size() * sizeof(Node),
+                                 held_nodes * sizeof(Node));
+}
+
+SimpleHashMap::SimpleHashMap()
+    : _table(),
+      _owned_table(std::make_unique<Table>(initial_num_chains_log2)),
+      _gen_holder()
+{
+    _table.store(_owned_table.get(), std::memory_order_release);
+}
+
+SimpleHashMap::~SimpleHashMap()
+{
+    _gen_holder.clearHoldLists();
+}
+
+void
+SimpleHashMap::replace_table(std::unique_ptr<Table> new_table)
+{
+    _table.store(new_table.get(), std::memory_order_release);
+    std::swap(_owned_table, new_table);
+    _gen_holder.hold(std::move(new_table));
+}
+
+void
+SimpleHashMap::grow()
+{
+    // Nodes on hold make the table full before its capacity is used by live entries.
+    // Only double the size if the table is at least half full with live entries.
+    uint32_t num_chains_log2 = _owned_table->get_num_chains_log2();
+    if (_owned_table->size() * 2 > (1u << num_chains_log2)) {
+        ++num_chains_log2;
+    }
+    auto new_table = std::make_unique<Table>(num_chains_log2);
+    _owned_table->move_to(*new_table);
+    replace_table(std::move(new_table));
+}
+
+void
+SimpleHashMap::add(size_t hash, EntryRef ref)
+{
+    if (_owned_table->full()) {
+        grow();
+    }
+    _owned_table->add(hash, ref);
+}
+
+void
+SimpleHashMap::remove(size_t hash, EntryRef ref)
+{
+    _owned_table->remove(hash, ref);
+}
+
+void
+SimpleHashMap::replace(size_t hash, EntryRef old_ref, EntryRef new_ref)
+{
+    _owned_table->replace(hash, old_ref, new_ref);
+}
+
+void
+SimpleHashMap::clear()
+{
+    replace_table(std::make_unique<Table>(initial_num_chains_log2));
+}
+
+void
+SimpleHashMap::transfer_hold_lists(generation_t generation)
+{
+    _owned_table->transfer_hold_lists(generation);
+    _gen_holder.transferHoldLists(generation);
+}
+
+void
+SimpleHashMap::trim_hold_lists(generation_t first_used)
+{
+    _owned_table->trim_hold_lists(first_used);
+    _gen_holder.trimHoldLists(first_used);
+}
+
+vespalib::MemoryUsage
+SimpleHashMap::get_memory_usage() const
+{
+    auto usage = _owned_table->get_memory_usage();
+    usage.mergeGenerationHeldBytes(_gen_holder.getHeldBytes());
+    return usage;
+}
+
+}
@@ -0,0 +1,130 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "atomic_entry_ref.h"
+#include <vespa/vespalib/util/generationholder.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace vespalib::datastore {
+
+class EntryComparator;
+
+/**
+ * Hash map from value to entry ref, used as an exact match index on top
+ * of a unique store dictionary. The values are not stored in the map,
+ * they are accessed through the entry refs using an EntryComparator.
+ *
+ * The map uses separate chaining with nodes allocated from a fixed size
+ * table. There is a single writer thread, and reader threads can call
+ * find() concurrently without locking as long as they hold a generation
+ * guard. Removed nodes and tables replaced when growing are put on hold
+ * lists and not reused or freed until no readers can reference them.
+ */
+class SimpleHashMap {
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+private:
+    static constexpr uint32_t no_node_idx = std::numeric_limits<uint32_t>::max();
+
+    class Node {
+        AtomicEntryRef        _ref;
+        std::atomic<uint32_t> _next;
+        size_t                _hash;
+    public:
+        Node() noexcept : _ref(), _next(no_node_idx), _hash(0u) { }
+        void init(size_t hash, EntryRef ref, uint32_t next) {
+            _hash = hash;
+            _ref.store_release(ref);
+            _next.store(next, std::memory_order_relaxed);
+        }
+        size_t get_hash() const { return _hash; }
+        EntryRef get_ref() const { return _ref.load_acquire(); }
+        void set_ref(EntryRef ref) { _ref.store_release(ref); }
+        uint32_t get_next() const { return _next.load(std::memory_order_acquire); }
+        void set_next(uint32_t next) { _next.store(next, std::memory_order_release); }
+    };
+
+    class Table : public vespalib::GenerationHeldBase {
+        uint32_t                                 _num_chains;
+        uint32_t                                 _shift;
+        uint32_t                                 _capacity;
+        std::unique_ptr<std::atomic<uint32_t>[]> _chain_heads;
+        std::unique_ptr<Node[]>                  _nodes;
+        uint32_t                                 _used_nodes;
+        uint32_t                                 _count;
+        std::vector<uint32_t>                    _free_list;
+        std::vector<uint32_t>                    _hold_1_list;
+        std::deque<std::pair<generation_t, uint32_t>> _hold_2_list;
+
+        uint32_t get_chain(size_t hash) const {
+            // Fibonacci hashing, spreads weak hashes (e.g. identity hash of integers) over all chains.
+            return (static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ul) >> _shift;
+        }
+    public:
+        Table(uint32_t num_chains_log2);
+        ~Table() override;
+        static size_t table_size(uint32_t num_chains_log2);
+        uint32_t get_num_chains_log2() const { return 64 - _shift; }
+        bool full() const { return _free_list.empty() && _used_nodes == _capacity; }
+        uint32_t size() const { return _count; }
+        EntryRef find(const EntryComparator& comp, size_t hash) const;
+        void add(size_t hash, EntryRef ref);
+        void remove(size_t hash, EntryRef ref);
+        void replace(size_t hash, EntryRef old_ref, EntryRef new_ref);
+        void move_to(Table& new_table) const;
+        void transfer_hold_lists(generation_t generation);
+        void trim_hold_lists(generation_t first_used);
+        vespalib::MemoryUsage get_memory_usage() const;
+    };
+
+    std::atomic<Table*>          _table;
+    std::unique_ptr<Table>       _owned_table;
+    vespalib::GenerationHolder   _gen_holder;
+
+    void replace_table(std::unique_ptr<Table> new_table);
+    void grow();
+
+public:
+    SimpleHashMap();
+    ~SimpleHashMap();
+
+    /*
+     * Find the entry ref for the value given by the fallback value of the
+     * comparator. Safe to call from reader threads holding a generation guard.
+     */
+    EntryRef find(const EntryComparator& comp, size_t hash) const {
+        return _table.load(std::memory_order_acquire)->find(comp, hash);
+    }
+
+    /*
+     * Add entry ref with the given hash. The caller must ensure that
+     * no equal value is already present.
+     */
+    void add(size_t hash, EntryRef ref);
+
+    /*
+     * Remove the given entry ref, matched by identity.
+     */
+    void remove(size_t hash, EntryRef ref);
+
+    /*
+     * Replace the given entry ref with a new entry ref referencing an
+     * equal value, e.g. when a value has been moved during compaction.
+     */
+    void replace(size_t hash, EntryRef old_ref, EntryRef new_ref);
+
+    void clear();
+    uint32_t size() const { return _owned_table->size(); }
+    void transfer_hold_lists(generation_t generation);
+    void trim_hold_lists(generation_t first_used);
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
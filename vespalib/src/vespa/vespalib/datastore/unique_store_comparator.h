@@ -6,6 +6,8 @@
 #include "unique_store_entry.h"
 #include "datastore.h"
 #include <cmath>
+#include <functional>
+#include <type_traits>
 
 namespace vespalib::datastore {
 
@@ -18,6 +20,14 @@ public:
     static bool less(const EntryT& lhs, const EntryT& rhs) {
         return lhs < rhs;
     }
+    static size_t hash(const EntryT& value) {
+        if constexpr (std::is_integral_v<EntryT>) {
+            return std::hash<EntryT>()(value);
+        } else {
+            (void) value;
+            return 0u;
+        }
+    }
 };
 
 /**
@@ -37,6 +47,14 @@ public:
             return (lhs < rhs);
         }
     }
+    static size_t hash(EntryT value) {
+        if (std::isnan(value)) {
+            return 0u;
+        } else if (value == 0) {
+            value = 0; // -0.0 and 0.0 are equal
+        }
+        return std::hash<EntryT>()(value);
+    }
 };
 
 /**
@@ -98,6 +116,10 @@ public:
         const EntryType &rhsValue = get(rhs);
         return UniqueStoreComparatorHelper<EntryT>::less(lhsValue, rhsValue);
     }
+
+    size_t hash(const EntryRef ref) const override {
+        return UniqueStoreComparatorHelper<EntryT>::hash(get(ref));
+    }
 };
 
 }
@@ -1,7 +1,9 @@
 // Copyright 2019 Oath Inc. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vespalib/btree/btree.h>
+#include "entry_comparator.h"
 #include "i_unique_store_dictionary.h"
+#include "simple_hash_map.h"
 
 #pragma once
 
@@ -11,6 +13,13 @@ class EntryComparatorWrapper;
 
 /**
  * A dictionary for unique store. Mostly accessed via base class.
+ *
+ * The ordered dictionary (b-tree) is always present. If a hash comparator
+ * is given then a hash map from value to entry ref is maintained in
+ * addition, and is used for exact lookups (add, find) instead of searching
+ * the b-tree. The hash comparator must be able to hash stored values, and
+ * comparators passed to add and find must hash and compare values the
+ * same way.
  */
 template <typename DictionaryT, typename ParentT = IUniqueStoreDictionary>
 class UniqueStoreDictionary : public ParentT {
@@ -33,9 +42,16 @@ protected:
     };
 
     DictionaryType _dict;
+    std::unique_ptr<EntryComparator> _hash_compare;
+    std::unique_ptr<SimpleHashMap>   _hash_dict;
+
+    void hash_add(EntryRef ref);
+    void hash_remove(EntryRef ref);
+    EntryRef hash_find(const EntryComparator& comp) const;
+    void rebuild_hash_dictionary();
 
 public:
-    UniqueStoreDictionary();
+    explicit UniqueStoreDictionary(std::unique_ptr<EntryComparator> hash_compare = {});
     ~UniqueStoreDictionary() override;
     void freeze() override;
     void transfer_hold_lists(generation_t generation) override;
@@ -50,6 +66,7 @@ public:
     void build(vespalib::ConstArrayRef<EntryRef> refs) override;
     void build_with_payload(vespalib::ConstArrayRef<EntryRef>, vespalib::ConstArrayRef<uint32_t> payloads) override;
     std::unique_ptr<ReadSnapshot> get_read_snapshot() const override;
+    bool has_hash_dictionary() const { return static_cast<bool>(_hash_dict); }
 };
 
 }
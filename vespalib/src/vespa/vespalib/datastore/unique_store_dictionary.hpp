@@ -58,10 +58,52 @@ ReadSnapshotImpl::foreach_key(std::function<void(EntryRef)> callback) const
 }
 
 template <typename DictionaryT, typename ParentT>
-UniqueStoreDictionary<DictionaryT, ParentT>::UniqueStoreDictionary()
+void
+UniqueStoreDictionary<DictionaryT, ParentT>::hash_add(EntryRef ref)
+{
+    if (_hash_dict) {
+        _hash_dict->add(_hash_compare->hash(ref), ref);
+    }
+}
+
+template <typename DictionaryT, typename ParentT>
+void
+UniqueStoreDictionary<DictionaryT, ParentT>::hash_remove(EntryRef ref)
+{
+    if (_hash_dict) {
+        _hash_dict->remove(_hash_compare->hash(ref), ref);
+    }
+}
+
+template <typename DictionaryT, typename ParentT>
+EntryRef
+UniqueStoreDictionary<DictionaryT, ParentT>::hash_find(const EntryComparator& comp) const
+{
+    return _hash_dict->find(comp, comp.hash(EntryRef()));
+}
+
+template <typename DictionaryT, typename ParentT>
+void
+UniqueStoreDictionary<DictionaryT, ParentT>::rebuild_hash_dictionary()
+{
+    if (_hash_dict) {
+        _hash_dict->clear();
+        for (auto itr = _dict.begin(); itr.valid(); ++itr) {
+            hash_add(itr.getKey());
+        }
+    }
+}
+
+template <typename DictionaryT, typename ParentT>
+UniqueStoreDictionary<DictionaryT, ParentT>::UniqueStoreDictionary(std::unique_ptr<EntryComparator> hash_compare)
     : ParentT(),
-      _dict()
+      _dict(),
+      _hash_compare(std::move(hash_compare)),
+      _hash_dict()
 {
+    if (_hash_compare) {
+        _hash_dict = std::make_unique<SimpleHashMap>();
+    }
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -79,6 +121,9 @@ void
 UniqueStoreDictionary<DictionaryT, ParentT>::transfer_hold_lists(generation_t generation)
 {
     _dict.getAllocator().transferHoldLists(generation);
+    if (_hash_dict) {
+        _hash_dict->transfer_hold_lists(generation);
+    }
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -86,6 +131,9 @@ void
 UniqueStoreDictionary<DictionaryT, ParentT>::trim_hold_lists(generation_t firstUsed)
 {
     _dict.getAllocator().trimHoldLists(firstUsed);
+    if (_hash_dict) {
+        _hash_dict->trim_hold_lists(firstUsed);
+    }
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -93,6 +141,12 @@ UniqueStoreAddResult
 UniqueStoreDictionary<DictionaryT, ParentT>::add(const EntryComparator &comp,
                                                  std::function<EntryRef(void)> insertEntry)
 {
+    if (_hash_dict) {
+        EntryRef ref = hash_find(comp);
+        if (ref.valid()) {
+            return UniqueStoreAddResult(ref, false);
+        }
+    }
     auto itr = _dict.lowerBound(EntryRef(), comp);
     if (itr.valid() && !comp(EntryRef(), itr.getKey())) {
         return UniqueStoreAddResult(itr.getKey(), false);
@@ -100,6 +154,7 @@ UniqueStoreDictionary<DictionaryT, ParentT>::add(const EntryComparator &comp,
     } else {
         EntryRef newRef = insertEntry();
         _dict.insert(itr, newRef, DataType());
+        hash_add(newRef);
         return UniqueStoreAddResult(newRef, true);
     }
 }
@@ -108,6 +163,9 @@ template <typename DictionaryT, typename ParentT>
 EntryRef
 UniqueStoreDictionary<DictionaryT, ParentT>::find(const EntryComparator &comp)
 {
+    if (_hash_dict) {
+        return hash_find(comp);
+    }
     auto itr = _dict.lowerBound(EntryRef(), comp);
     if (itr.valid() && !comp(EntryRef(), itr.getKey())) {
         return itr.getKey();
@@ -124,6 +182,7 @@ UniqueStoreDictionary<DictionaryT, ParentT>::remove(const EntryComparator &comp,
     auto itr = _dict.lowerBound(ref, comp);
     assert(itr.valid() && itr.getKey() == ref);
     _dict.remove(itr);
+    hash_remove(ref);
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -137,6 +196,9 @@ UniqueStoreDictionary<DictionaryT, ParentT>::move_entries(ICompactable &compacta
         if (newRef != oldRef) {
             _dict.thaw(itr);
             itr.writeKey(newRef);
+            if (_hash_dict) {
+                _hash_dict->replace(_hash_compare->hash(newRef), oldRef, newRef);
+            }
         }
         ++itr;
     }
@@ -153,7 +215,11 @@ template <typename DictionaryT, typename ParentT>
 vespalib::MemoryUsage
 UniqueStoreDictionary<DictionaryT, ParentT>::get_memory_usage() const
 {
-    return _dict.getMemoryUsage();
+    auto usage = _dict.getMemoryUsage();
+    if (_hash_dict) {
+        usage.merge(_hash_dict->get_memory_usage());
+    }
+    return usage;
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -173,6 +239,7 @@ UniqueStoreDictionary<DictionaryT, ParentT>::build(vespalib::ConstArrayRef<Entry
         }
     }
     _dict.assign(builder);
+    rebuild_hash_dictionary();
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -184,6 +251,7 @@ UniqueStoreDictionary<DictionaryT, ParentT>::build(vespalib::ConstArrayRef<Entry
         builder.insert(ref, DataType());
     }
     _dict.assign(builder);
+    rebuild_hash_dictionary();
 }
 
 template <typename DictionaryT, typename ParentT>
@@ -201,6 +269,7 @@ UniqueStoreDictionary<DictionaryT, ParentT>::build_with_payload(vespalib::ConstA
         }
     }
     _dict.assign(builder);
+    rebuild_hash_dictionary();
 }
 
 template <typename DictionaryT, typename ParentT>
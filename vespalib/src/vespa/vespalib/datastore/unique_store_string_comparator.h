@@ -4,6 +4,7 @@
 
 #include "entry_comparator.h"
 #include "unique_store_string_allocator.h"
+#include <vespa/vespalib/stllike/hash_fun.h>
 
 namespace vespalib::datastore {
 
@@ -49,6 +50,10 @@ public:
         const char *rhs_value = get(rhs);
         return (strcmp(lhs_value, rhs_value) < 0);
     }
+
+    size_t hash(const EntryRef ref) const override {
+        return vespalib::hashValue(get(ref));
+    }
 };
 
 }
@@ -30,4 +30,34 @@ Avx2Accelrator::or64(size_t offset, const std::vector<std::pair<const void *, bo
     helper::orChunks<32u, 2u>(offset, src, dest);
 }
 
+void
+Avx2Accelrator::findInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx2Accelrator::findInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx2Accelrator::findInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx2Accelrator::findInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx2Accelrator::findInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx2Accelrator::findInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const {
+    helper::findInRange(a, sz, low, high, dest);
+}
+
 }
@@ -2,9 +2,107 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace avx512 {
+
+namespace {
+
+/*
+ * Range compare of one vector of values, returning a bit per value.
+ */
+template <typename T> struct RangeMatcher;
+
+template <>
+struct RangeMatcher<int8_t> {
+    static constexpr size_t lanes = 64;
+    __m512i low, high;
+    RangeMatcher(int8_t l, int8_t h) : low(_mm512_set1_epi8(l)), high(_mm512_set1_epi8(h)) {}
+    uint64_t match(const int8_t * a) const {
+        __m512i v = _mm512_loadu_si512(a);
+        return _mm512_mask_cmp_epi8_mask(_mm512_cmp_epi8_mask(low, v, _MM_CMPINT_LE), v, high, _MM_CMPINT_LE);
+    }
+};
+
+template <>
+struct RangeMatcher<int16_t> {
+    static constexpr size_t lanes = 32;
+    __m512i low, high;
+    RangeMatcher(int16_t l, int16_t h) : low(_mm512_set1_epi16(l)), high(_mm512_set1_epi16(h)) {}
+    uint64_t match(const int16_t * a) const {
+        __m512i v = _mm512_loadu_si512(a);
+        return _mm512_mask_cmp_epi16_mask(_mm512_cmp_epi16_mask(low, v, _MM_CMPINT_LE), v, high, _MM_CMPINT_LE);
+    }
+};
+
+template <>
+struct RangeMatcher<int32_t> {
+    static constexpr size_t lanes = 16;
+    __m512i low, high;
+    RangeMatcher(int32_t l, int32_t h) : low(_mm512_set1_epi32(l)), high(_mm512_set1_epi32(h)) {}
+    uint64_t match(const int32_t * a) const {
+        __m512i v = _mm512_loadu_si512(a);
+        return _mm512_mask_cmp_epi32_mask(_mm512_cmp_epi32_mask(low, v, _MM_CMPINT_LE), v, high, _MM_CMPINT_LE);
+    }
+};
+
+template <>
+struct RangeMatcher<int64_t> {
+    static constexpr size_t lanes = 8;
+    __m512i low, high;
+    RangeMatcher(int64_t l, int64_t h) : low(_mm512_set1_epi64(l)), high(_mm512_set1_epi64(h)) {}
+    uint64_t match(const int64_t * a) const {
+        __m512i v = _mm512_loadu_si512(a);
+        return _mm512_mask_cmp_epi64_mask(_mm512_cmp_epi64_mask(low, v, _MM_CMPINT_LE), v, high, _MM_CMPINT_LE);
+    }
+};
+
+// Ordered compares, NaN values never match
+template <>
+struct RangeMatcher<float> {
+    static constexpr size_t lanes = 16;
+    __m512 low, high;
+    RangeMatcher(float l, float h) : low(_mm512_set1_ps(l)), high(_mm512_set1_ps(h)) {}
+    uint64_t match(const float * a) const {
+        __m512 v = _mm512_loadu_ps(a);
+        return _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(low, v, _CMP_LE_OQ), v, high, _CMP_LE_OQ);
+    }
+};
+
+template <>
+struct RangeMatcher<double> {
+    static constexpr size_t lanes = 8;
+    __m512d low, high;
+    RangeMatcher(double l, double h) : low(_mm512_set1_pd(l)), high(_mm512_set1_pd(h)) {}
+    uint64_t match(const double * a) const {
+        __m512d v = _mm512_loadu_pd(a);
+        return _mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(low, v, _CMP_LE_OQ), v, high, _CMP_LE_OQ);
+    }
+};
+
+template <typename T>
+void
+findInRange(const T * a, size_t sz, T low, T high, uint64_t * dest) {
+    const RangeMatcher<T> matcher(low, high);
+    size_t i(0);
+    for (; i + 64 <= sz; i += 64) {
+        uint64_t word(0);
+        for (size_t j(0); j < 64; j += RangeMatcher<T>::lanes) {
+            word |= matcher.match(a + i + j) << j;
+        }
+        dest[i/64] = word;
+    }
+    if (i < sz) {
+        helper::findInRange(a + i, sz - i, low, high, dest + i/64);
+    }
+}
+
+}
+
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -42,4 +140,34 @@ Avx512Accelrator::or64(size_t offset, const std::vector<std::pair<const void *,
     helper::orChunks<64, 1>(offset, src, dest);
 }
 
+void
+Avx512Accelrator::findInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx512Accelrator::findInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx512Accelrator::findInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx512Accelrator::findInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx512Accelrator::findInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
+void
+Avx512Accelrator::findInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const {
+    avx512::findInRange(a, sz, low, high, dest);
+}
+
 }
@@ -27,6 +27,12 @@ public:
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
     void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
     void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const override;
+    void findInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const override;
+    void findInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const override;
+    void findInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const override;
+    void findInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const override;
+    void findInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const override;
+    void findInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const override;
 };
 
 }
@@ -5,6 +5,7 @@
 #include "avx2.h"
 #include "avx512.h"
 #include <vespa/vespalib/util/memory.h>
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 
@@ -216,6 +217,30 @@ verifyAnd64(const IAccelrated & accel) {
     }
 }
 
+template<typename T>
+void
+verifyFindInRange(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<uint64_t> expected((testLength + 63)/64);
+    std::vector<uint64_t> computed((testLength + 63)/64);
+    for (size_t j(0); j < 0x20; j++) {
+        std::fill(expected.begin(), expected.end(), 0);
+        for (size_t i(j); i < testLength; i++) {
+            if ((T(10) <= a[i]) && (a[i] <= T(j + 10))) {
+                expected[(i - j)/64] |= uint64_t(1) << ((i - j) % 64);
+            }
+        }
+        std::fill(computed.begin(), computed.end(), 0);
+        accel.findInRange(&a[j], testLength - j, T(10), T(j + 10), &computed[0]);
+        if (expected != computed) {
+            fprintf(stderr, "Accelrator is not computing findInRange correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -231,6 +256,12 @@ private:
         verifyPopulationCount(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
+        verifyFindInRange<int8_t>(accelrated);
+        verifyFindInRange<int16_t>(accelrated);
+        verifyFindInRange<int32_t>(accelrated);
+        verifyFindInRange<int64_t>(accelrated);
+        verifyFindInRange<float>(accelrated);
+        verifyFindInRange<double>(accelrated);
     }
 };
 
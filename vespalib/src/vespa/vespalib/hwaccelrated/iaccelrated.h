@@ -34,6 +34,13 @@ public:
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
     virtual void or64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
+    // Set bit i in dest when low <= a[i] <= high. Writes (sz + 63) / 64 words, unused high bits are cleared.
+    virtual void findInRange(const int8_t * a, size_t sz, int8_t low, int8_t high, uint64_t * dest) const = 0;
+    virtual void findInRange(const int16_t * a, size_t sz, int16_t low, int16_t high, uint64_t * dest) const = 0;
+    virtual void findInRange(const int32_t * a, size_t sz, int32_t low, int32_t high, uint64_t * dest) const = 0;
+    virtual void findInRange(const int64_t * a, size_t sz, int64_t low, int64_t high, uint64_t * dest) const = 0;
+    virtual void findInRange(const float * a, size_t sz, float low, float high, uint64_t * dest) const = 0;
+    virtual void findInRange(const double * a, size_t sz, double low, double high, uint64_t * dest) const = 0;
 
     static const IAccelrated & getAccelerator() __attribute__((noinline));
 };
@@ -24,6 +24,30 @@ populationCount(const uint64_t *a, size_t sz) {
     return count;
 }
 
+template <typename T>
+void
+findInRange(const T * a, size_t sz, T low, T high, uint64_t * dest) {
+    size_t i(0);
+    for (; i + 64 <= sz; i += 64) {
+        uint64_t word(0);
+        for (size_t j(0); j < 64; j += 8) {
+            uint64_t bits(0);
+            for (size_t k(0); k < 8; k++) {
+                bits |= uint64_t((low <= a[i + j + k]) & (a[i + j + k] <= high)) << k;
+            }
+            word |= bits << j;
+        }
+        dest[i/64] = word;
+    }
+    if (i < sz) {
+        uint64_t word(0);
+        for (size_t j(0); i + j < sz; j++) {
+            word |= uint64_t((low <= a[i + j]) & (a[i + j] <= high)) << j;
+        }
+        dest[i/64] = word;
+    }
+}
+
 template<typename T>
 T get(const void * base, bool invert) {
     T v;
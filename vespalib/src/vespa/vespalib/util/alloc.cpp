@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "alloc.h"
+#include "mmap_policy.h"
 #include <sys/mman.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/exceptions.h>
@@ -7,8 +8,10 @@
 #include <vespa/vespalib/util/sync.h>
 #include <map>
 #include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include <vespa/fastos/file.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include <vespa/log/log.h>
@@ -148,24 +151,28 @@ public:
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
-    static size_t sresize_inplace(PtrAndSize current, size_t newSize);
-    static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static size_t sresize_inplace(PtrAndSize current, size_t newSize, const MMapPolicy &policy = MMapPolicy());
+    static PtrAndSize salloc(size_t sz, void * wantedAddress, const MMapPolicy &policy = MMapPolicy());
+    static PtrAndSize smap_file(const char * fileName, size_t offset, size_t sz);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
-    static size_t extend_inplace(PtrAndSize current, size_t newSize);
+    static void register_mapping(void * buf, size_t sz, size_t mmapId, const string & stackTrace);
+    static size_t extend_inplace(PtrAndSize current, size_t newSize, const MMapPolicy &policy);
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
 };
 
 class AutoAllocator : public MemoryAllocator {
 public:
-    AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
+    AutoAllocator(size_t mmapLimit, size_t alignment, const MMapPolicy &policy = MMapPolicy())
+        : _mmapLimit(mmapLimit), _alignment(alignment), _policy(policy) { }
     PtrAndSize alloc(size_t sz) const override;
     void free(PtrAndSize alloc) const override;
     void free(void * ptr, size_t sz) const override;
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
     static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
+    static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment, const MMapPolicy &policy);
 private:
     size_t roundUpToHugePages(size_t sz) const {
         return (_mmapLimit >= MemoryAllocator::HUGEPAGE_SIZE)
@@ -180,6 +187,7 @@ private:
     }
     size_t _mmapLimit;
     size_t _alignment;
+    MMapPolicy _policy;
 };
 
 
@@ -235,6 +243,8 @@ createAutoAllocatorsWithDefault() {
 
 
 AutoAllocatorsMapWithDefault  _G_availableAutoAllocators = createAutoAllocatorsWithDefault();
+std::mutex _G_policyAllocatorsLock;
+std::unordered_map<uint64_t, AutoAllocator::UP> _G_policyAllocators;
 alloc::HeapAllocator _G_heapAllocatorDefault;
 alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
@@ -275,6 +285,23 @@ AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment) {
     return getAutoAllocator(_G_availableAutoAllocators.first, mmapLimit, alignment);
 }
 
+MemoryAllocator &
+AutoAllocator::getAllocator(size_t mmapLimit, size_t alignment, const MMapPolicy &policy) {
+    if (policy.isDefault()) {
+        return getAllocator(mmapLimit, alignment);
+    }
+    // Allocators with non-default policies are created on demand and never destroyed,
+    // since allocations refer to them.
+    MMapLimitAndAlignment limitAndAlignment(mmapLimit, alignment);
+    uint64_t key = (static_cast<uint64_t>(policy.key()) << 32) | limitAndAlignment.hash();
+    std::lock_guard<std::mutex> guard(_G_policyAllocatorsLock);
+    auto &allocator = _G_policyAllocators[key];
+    if (!allocator) {
+        allocator = std::make_unique<AutoAllocator>(mmapLimit, alignment, policy);
+    }
+    return *allocator;
+}
+
 MemoryAllocator::PtrAndSize
 HeapAllocator::alloc(size_t sz) const {
     return salloc(sz);
@@ -315,7 +342,7 @@ MMapAllocator::alloc(size_t sz) const {
 }
 
 MemoryAllocator::PtrAndSize
-MMapAllocator::salloc(size_t sz, void * wantedAddress)
+MMapAllocator::salloc(size_t sz, void * wantedAddress, const MMapPolicy &policy)
 {
     void * buf(nullptr);
     sz = roundUp2PageSize(sz);
@@ -328,7 +355,19 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
             stackTrace = getStackTrace(1);
             LOG(info, "mmap %ld of size %ld from %s", mmapId, sz, stackTrace.c_str());
         }
-        buf = mmap(wantedAddress, sz, prot, flags | _G_HugeFlags, -1, 0);
+        int hugeFlags = _G_HugeFlags;
+#ifdef __linux__
+        if (policy.hugePages() == MMapPolicy::HugePages::EXPLICIT) {
+            hugeFlags = MAP_HUGETLB;
+        } else if (policy.hugePages() != MMapPolicy::HugePages::DEFAULT) {
+            hugeFlags = 0;
+        }
+#endif
+        buf = mmap(wantedAddress, sz, prot, flags | hugeFlags, -1, 0);
+        bool gotExplicitHugePages = (buf != MAP_FAILED) && (hugeFlags != 0);
+        if (hugeFlags != 0) {
+            MMapPolicyStats::countExplicitHugePages(sz, gotExplicitHugePages);
+        }
         if (buf == MAP_FAILED) {
             if ( ! _G_hasHugePageFailureJustHappened ) {
                 _G_hasHugePageFailureJustHappened = true;
@@ -353,27 +392,64 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
                 _G_hasHugePageFailureJustHappened = false;
             }
         }
+        policy.advise(buf, sz, gotExplicitHugePages);
+        register_mapping(buf, sz, mmapId, stackTrace);
+    }
+    return PtrAndSize(buf, sz);
+}
+
+void
+MMapAllocator::register_mapping(void * buf, size_t sz, size_t mmapId, const string & stackTrace)
+{
 #ifdef __linux__
-        if (sz >= _G_MMapNoCoreLimit) {
-            if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
-                LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
-            }
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
         }
+    }
 #endif
-        if (sz >= _G_MMapLogLimit) {
-            LockGuard guard(_G_lock);
-            _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
-            LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
-        }
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+}
+
+MemoryAllocator::PtrAndSize
+MMapAllocator::smap_file(const char * fileName, size_t offset, size_t sz)
+{
+    sz = roundUp2PageSize(sz);
+    if ((sz == 0) || ((offset % _G_pageSize) != 0)) {
+        return PtrAndSize(nullptr, 0);
+    }
+    int fd = ::open(fileName, O_RDONLY);
+    if (fd < 0) {
+        LOG(warning, "Failed opening '%s' for mmap: %s", fileName, FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of size %ld from file '%s' at %s", mmapId, sz, fileName, stackTrace.c_str());
+    }
+    // A private mapping never writes back to the file, writes are copied on a per page basis.
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    ::close(fd);
+    if (buf == MAP_FAILED) {
+        LOG(warning, "Failed mmaping %ld bytes from '%s' at offset %ld: %s", sz, fileName, offset,
+            FastOS_FileInterface::getLastErrorString().c_str());
+        return PtrAndSize(nullptr, 0);
     }
+    register_mapping(buf, sz, mmapId, stackTrace);
     return PtrAndSize(buf, sz);
 }
 
 size_t
-MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
+MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize, const MMapPolicy &policy) {
     newSize = roundUp2PageSize(newSize);
     if (newSize > current.second) {
-        return extend_inplace(current, newSize);
+        return extend_inplace(current, newSize, policy);
     } else if (newSize < current.second) {
         return shrink_inplace(current, newSize);
     } else {
@@ -382,8 +458,8 @@ MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
 }
 
 size_t
-MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize) {
-    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second);
+MMapAllocator::extend_inplace(PtrAndSize current, size_t newSize, const MMapPolicy &policy) {
+    PtrAndSize got = MMapAllocator::salloc(newSize - current.second, static_cast<char *>(current.first)+current.second, policy);
     if ((static_cast<const char *>(current.first) + current.second) == static_cast<const char *>(got.first)) {
         return current.second + got.second;
     } else {
@@ -425,7 +501,7 @@ size_t
 AutoAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
     if (useMMap(current.second) && useMMap(newSize)) {
         newSize = roundUpToHugePages(newSize);
-        return MMapAllocator::sresize_inplace(current, newSize);
+        return MMapAllocator::sresize_inplace(current, newSize, _policy);
     } else {
         return 0;
     }
@@ -435,7 +511,7 @@ MMapAllocator::PtrAndSize
 AutoAllocator::alloc(size_t sz) const {
     if (useMMap(sz)) {
         sz = roundUpToHugePages(sz);
-        return MMapAllocator::salloc(sz, nullptr);
+        return MMapAllocator::salloc(sz, nullptr, _policy);
     } else {
         if (_alignment == 0) {
             return HeapAllocator::salloc(sz);
@@ -509,6 +585,16 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::allocMMapFile(const char *fileName, size_t offset, size_t sz)
+{
+    MemoryAllocator::PtrAndSize mapped = MMapAllocator::smap_file(fileName, offset, sz);
+    if (mapped.first == nullptr) {
+        return Alloc();
+    }
+    return Alloc(&MMapAllocator::getDefault(), mapped);
+}
+
 Alloc
 Alloc::alloc()
 {
@@ -521,6 +607,12 @@ Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
     return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment), sz);
 }
 
+Alloc
+Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment, const MMapPolicy &policy)
+{
+    return Alloc(&AutoAllocator::getAllocator(mmapLimit, alignment, policy), sz);
+}
+
 }
 
 }
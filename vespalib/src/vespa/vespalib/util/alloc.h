@@ -6,6 +6,8 @@
 
 namespace vespalib::alloc {
 
+class MMapPolicy;
+
 class MemoryAllocator {
 public:
     enum {HUGEPAGE_SIZE=0x200000u};
@@ -99,15 +101,30 @@ public:
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
     static Alloc allocMMap(size_t sz=0);
+    /**
+     * Maps sz bytes of the given file, starting at offset, as a private
+     * writable mapping. Pages are read from the file on first access and
+     * copied on first write, the file itself is never modified. The file
+     * must not be modified by others while mapped. Offset must be a
+     * multiple of the system page size. Returns an empty allocation if
+     * the file could not be mapped. Allocations created from the returned
+     * one are anonymous mmaps.
+     */
+    static Alloc allocMMapFile(const char *fileName, size_t offset, size_t sz);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
      */
     static Alloc alloc(size_t sz, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
+    /**
+     * As above, with large allocations mapped according to the given policy.
+     */
+    static Alloc alloc(size_t sz, size_t mmapLimit, size_t alignment, const MMapPolicy &policy);
     static Alloc alloc();
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     Alloc(const MemoryAllocator * allocator) : _alloc(nullptr, 0), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) : _alloc(alloc), _allocator(allocator) { }
     void clear() {
         _alloc.first = nullptr;
         _alloc.second = 0;
@@ -0,0 +1,255 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mmap_policy.h"
+#include <vespa/vespalib/text/stringtokenizer.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.mmap_policy");
+
+namespace vespalib::alloc {
+
+namespace {
+
+std::atomic<size_t> _G_explicitHugePagesAllocatedBytes(0);
+std::atomic<size_t> _G_explicitHugePagesFallbacks(0);
+std::atomic<size_t> _G_transparentHugePagesAllocatedBytes(0);
+std::atomic<size_t> _G_noHugePagesAllocatedBytes(0);
+std::atomic<size_t> _G_numaInterleavedAllocatedBytes(0);
+std::atomic<size_t> _G_numaLocalAllocatedBytes(0);
+std::atomic<size_t> _G_failedAdvices(0);
+
+const char * const hugePagesNames[] = { "default", "transparent", "explicit", "none" };
+const char * const numaNames[] = { "default", "interleave", "local" };
+
+#ifdef __linux__
+
+// Memory policy modes from linux/mempolicy.h, used through the raw
+// syscall to avoid depending on libnuma.
+constexpr int MPOL_PREFERRED_MODE = 1;
+constexpr int MPOL_INTERLEAVE_MODE = 3;
+
+/*
+ * Bit mask of online NUMA nodes (up to 64), parsed from a list of
+ * ranges on the form "0-1,3". Returns 0 if not available.
+ */
+unsigned long
+readOnlineNumaNodes()
+{
+    FILE *fp = fopen("/sys/devices/system/node/online", "r");
+    if (fp == nullptr) {
+        return 0;
+    }
+    char buf[256];
+    unsigned long mask = 0;
+    if (fgets(buf, sizeof(buf), fp) != nullptr) {
+        char *p = buf;
+        while (isdigit(static_cast<unsigned char>(*p))) {
+            unsigned long first = strtoul(p, &p, 10);
+            unsigned long last = first;
+            if (*p == '-') {
+                last = strtoul(p + 1, &p, 10);
+            }
+            for (unsigned long node = first; node <= last && node < 64; ++node) {
+                mask |= (1ul << node);
+            }
+            if (*p == ',') {
+                ++p;
+            }
+        }
+    }
+    fclose(fp);
+    return mask;
+}
+
+bool
+mbindRaw(void *buf, size_t sz, int mode, const unsigned long *nodeMask, unsigned long maxNode)
+{
+    return syscall(SYS_mbind, buf, sz, mode, nodeMask, maxNode, 0u) == 0;
+}
+
+#endif
+
+void
+adviseHugePages(void *buf, size_t sz, MMapPolicy::HugePages hugePages)
+{
+#ifdef __linux__
+    if (hugePages == MMapPolicy::HugePages::TRANSPARENT || hugePages == MMapPolicy::HugePages::NONE) {
+        bool transparent = (hugePages == MMapPolicy::HugePages::TRANSPARENT);
+        if (madvise(buf, sz, transparent ? MADV_HUGEPAGE : MADV_NOHUGEPAGE) == 0) {
+            (transparent ? _G_transparentHugePagesAllocatedBytes : _G_noHugePagesAllocatedBytes).fetch_add(sz, std::memory_order_relaxed);
+        } else {
+            _G_failedAdvices.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Failed madvise(%p, %zu, %s): %s", buf, sz, transparent ? "MADV_HUGEPAGE" : "MADV_NOHUGEPAGE", strerror(errno));
+        }
+    }
+#else
+    (void) buf;
+    (void) sz;
+    (void) hugePages;
+#endif
+}
+
+void
+adviseNuma(void *buf, size_t sz, MMapPolicy::Numa numa)
+{
+#ifdef __linux__
+    if (numa == MMapPolicy::Numa::INTERLEAVE) {
+        static const unsigned long onlineNodes = readOnlineNumaNodes();
+        if ((onlineNodes & (onlineNodes - 1)) == 0) {
+            return; // Zero or one node, nothing to interleave over
+        }
+        if (mbindRaw(buf, sz, MPOL_INTERLEAVE_MODE, &onlineNodes, 65)) {
+            _G_numaInterleavedAllocatedBytes.fetch_add(sz, std::memory_order_relaxed);
+        } else {
+            _G_failedAdvices.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Failed mbind(%p, %zu, MPOL_INTERLEAVE): %s", buf, sz, strerror(errno));
+        }
+    } else if (numa == MMapPolicy::Numa::LOCAL) {
+        // Preferred with an empty node mask means allocation on the node of the touching thread.
+        if (mbindRaw(buf, sz, MPOL_PREFERRED_MODE, nullptr, 0)) {
+            _G_numaLocalAllocatedBytes.fetch_add(sz, std::memory_order_relaxed);
+        } else {
+            _G_failedAdvices.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Failed mbind(%p, %zu, MPOL_PREFERRED): %s", buf, sz, strerror(errno));
+        }
+    }
+#else
+    (void) buf;
+    (void) sz;
+    (void) numa;
+#endif
+}
+
+template <typename EnumT, size_t N>
+EnumT
+parseValue(vespalib::stringref key, vespalib::stringref value, const char * const (&names)[N])
+{
+    for (size_t i = 0; i < N; ++i) {
+        if (value == names[i]) {
+            return static_cast<EnumT>(i);
+        }
+    }
+    throw IllegalArgumentException(make_string("Illegal value '%s' for '%s' in mmap policy",
+                                               vespalib::string(value).c_str(), vespalib::string(key).c_str()));
+}
+
+vespalib::string
+componentVariable(vespalib::stringref component)
+{
+    vespalib::string name("VESPA_MMAP_POLICY");
+    if (!component.empty()) {
+        name.push_back('_');
+        for (char c : component) {
+            name.push_back(toupper(static_cast<unsigned char>(c)));
+        }
+    }
+    return name;
+}
+
+}
+
+vespalib::string
+MMapPolicy::toString() const
+{
+    return make_string("hugepages=%s,numa=%s",
+                       hugePagesNames[static_cast<uint32_t>(_hugePages)],
+                       numaNames[static_cast<uint32_t>(_numa)]);
+}
+
+void
+MMapPolicy::advise(void *buf, size_t sz, bool gotExplicitHugePages) const
+{
+    if (!gotExplicitHugePages) {
+        // Fall back to transparent huge pages when the explicit huge page pool is exhausted
+        adviseHugePages(buf, sz, (_hugePages == HugePages::EXPLICIT) ? HugePages::TRANSPARENT : _hugePages);
+    }
+    adviseNuma(buf, sz, _numa);
+}
+
+MMapPolicy
+MMapPolicy::fromString(vespalib::stringref spec)
+{
+    MMapPolicy policy;
+    StringTokenizer tokens(spec, ",");
+    tokens.removeEmptyTokens();
+    for (const auto &token : tokens) {
+        auto pos = token.find('=');
+        if (pos == vespalib::stringref::npos) {
+            throw IllegalArgumentException(make_string("Expected key=value in mmap policy, got '%s'",
+                                                       vespalib::string(token).c_str()));
+        }
+        vespalib::stringref key = token.substr(0, pos);
+        vespalib::stringref value = token.substr(pos + 1);
+        if (key == "hugepages") {
+            policy._hugePages = parseValue<HugePages>(key, value, hugePagesNames);
+        } else if (key == "numa") {
+            policy._numa = parseValue<Numa>(key, value, numaNames);
+        } else {
+            throw IllegalArgumentException(make_string("Unknown key '%s' in mmap policy",
+                                                       vespalib::string(key).c_str()));
+        }
+    }
+    return policy;
+}
+
+MMapPolicy
+MMapPolicy::forComponent(vespalib::stringref component, vespalib::stringref parentComponent)
+{
+    vespalib::string name = componentVariable(component);
+    const char *spec = getenv(name.c_str());
+    if ((spec == nullptr) && !parentComponent.empty()) {
+        name = componentVariable(parentComponent);
+        spec = getenv(name.c_str());
+    }
+    if (spec == nullptr) {
+        name = componentVariable("");
+        spec = getenv(name.c_str());
+    }
+    if (spec != nullptr) {
+        try {
+            return fromString(spec);
+        } catch (const IllegalArgumentException &e) {
+            LOG(warning, "Ignoring %s='%s': %s", name.c_str(), spec, e.getMessage().c_str());
+        }
+    }
+    return MMapPolicy();
+}
+
+MMapPolicyStats
+MMapPolicyStats::get()
+{
+    MMapPolicyStats stats;
+    stats.explicitHugePagesAllocatedBytes = _G_explicitHugePagesAllocatedBytes.load(std::memory_order_relaxed);
+    stats.explicitHugePagesFallbacks = _G_explicitHugePagesFallbacks.load(std::memory_order_relaxed);
+    stats.transparentHugePagesAllocatedBytes = _G_transparentHugePagesAllocatedBytes.load(std::memory_order_relaxed);
+    stats.noHugePagesAllocatedBytes = _G_noHugePagesAllocatedBytes.load(std::memory_order_relaxed);
+    stats.numaInterleavedAllocatedBytes = _G_numaInterleavedAllocatedBytes.load(std::memory_order_relaxed);
+    stats.numaLocalAllocatedBytes = _G_numaLocalAllocatedBytes.load(std::memory_order_relaxed);
+    stats.failedAdvices = _G_failedAdvices.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void
+MMapPolicyStats::countExplicitHugePages(size_t sz, bool obtained)
+{
+    if (obtained) {
+        _G_explicitHugePagesAllocatedBytes.fetch_add(sz, std::memory_order_relaxed);
+    } else {
+        _G_explicitHugePagesFallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+// Copyright Verizon Media. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace vespalib::alloc {
+
+/**
+ * Policy for placement of large anonymous memory mappings, i.e. the
+ * buffers allocated by the mmap allocator. Controls the use of explicit
+ * (MAP_HUGETLB) or transparent huge pages and NUMA placement of the
+ * pages. The default policy keeps the old behavior, with explicit huge
+ * pages only used when VESPA_USE_HUGEPAGES is set in the environment.
+ *
+ * Explicit huge pages fall back to transparent huge pages when the huge
+ * page pool is exhausted. Advices that fail are ignored. What was actually
+ * obtained is accumulated in MMapPolicyStats.
+ */
+class MMapPolicy {
+public:
+    enum class HugePages : uint8_t { DEFAULT, TRANSPARENT, EXPLICIT, NONE };
+    enum class Numa : uint8_t { DEFAULT, INTERLEAVE, LOCAL };
+
+    MMapPolicy() noexcept : MMapPolicy(HugePages::DEFAULT, Numa::DEFAULT) { }
+    MMapPolicy(HugePages hugePages, Numa numa) noexcept
+        : _hugePages(hugePages),
+          _numa(numa)
+    { }
+    HugePages hugePages() const { return _hugePages; }
+    Numa numa() const { return _numa; }
+    bool isDefault() const { return (_hugePages == HugePages::DEFAULT) && (_numa == Numa::DEFAULT); }
+    uint32_t key() const { return (static_cast<uint32_t>(_hugePages) << 8) | static_cast<uint32_t>(_numa); }
+    bool operator==(const MMapPolicy &rhs) const { return key() == rhs.key(); }
+    bool operator!=(const MMapPolicy &rhs) const { return key() != rhs.key(); }
+    vespalib::string toString() const;
+
+    /*
+     * Apply madvise and mbind according to this policy on a newly
+     * mapped area that has not been touched yet.
+     */
+    void advise(void *buf, size_t sz, bool gotExplicitHugePages) const;
+
+    /*
+     * Parse a policy on the form "hugepages=transparent,numa=interleave".
+     * Valid huge page values are default, transparent, explicit and none.
+     * Valid numa values are default, interleave and local.
+     * Throws IllegalArgumentException on unknown keys or values.
+     */
+    static MMapPolicy fromString(vespalib::stringref spec);
+
+    /*
+     * Policy for the given component (e.g. "datastore"), taken from the
+     * environment variable VESPA_MMAP_POLICY_<COMPONENT> with the
+     * component name in upper case, falling back to the same variable for
+     * the parent component (if given), then VESPA_MMAP_POLICY and then
+     * the default policy. Invalid values are logged and ignored.
+     */
+    static MMapPolicy forComponent(vespalib::stringref component, vespalib::stringref parentComponent = "");
+private:
+    HugePages _hugePages;
+    Numa      _numa;
+};
+
+/**
+ * Accumulated number of bytes mapped with the different page sizes and
+ * placements, and the number of times the wanted policy could not be
+ * applied. The byte counts are never decreased when memory is unmapped,
+ * so they are totals since process start, not current usage.
+ */
+struct MMapPolicyStats {
+    size_t explicitHugePagesAllocatedBytes;
+    size_t explicitHugePagesFallbacks;
+    size_t transparentHugePagesAllocatedBytes;
+    size_t noHugePagesAllocatedBytes;
+    size_t numaInterleavedAllocatedBytes;
+    size_t numaLocalAllocatedBytes;
+    size_t failedAdvices;
+
+    static MMapPolicyStats get();
+    static void countExplicitHugePages(size_t sz, bool obtained);
+};
+
+}
@@ -1,9 +1,21 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "rcuvector.hpp"
+#include "mmap_policy.h"
 
 namespace vespalib {
 
+namespace rcuvector {
+
+alloc::Alloc
+defaultAlloc()
+{
+    static const alloc::MMapPolicy policy = alloc::MMapPolicy::forComponent("rcuvector");
+    return alloc::Alloc::alloc(0, alloc::MemoryAllocator::HUGEPAGE_SIZE, 0, policy);
+}
+
+}
+
 template class RcuVectorBase<uint8_t>;
 template class RcuVectorBase<uint16_t>;
 template class RcuVectorBase<uint32_t>;
@@ -10,6 +10,16 @@
 
 namespace vespalib {
 
+namespace rcuvector {
+
+/*
+ * Empty allocation used by default for the data of rcu vectors. Large
+ * buffers are mapped according to the "rcuvector" mmap policy.
+ */
+alloc::Alloc defaultAlloc();
+
+}
+
 template <typename T>
 class RcuVectorHeld : public GenerationHeldBase
 {
@@ -62,7 +72,7 @@ private:
 public:
     using ValueType = T;
     RcuVectorBase(GenerationHolderType &genHolder,
-                  const Alloc &initialAlloc = Alloc::alloc());
+                  const Alloc &initialAlloc = rcuvector::defaultAlloc());
 
     /**
      * Construct a new vector with the given initial capacity and grow
@@ -73,11 +83,11 @@ public:
      **/
     RcuVectorBase(size_t initialCapacity, size_t growPercent, size_t growDelta,
                   GenerationHolderType &genHolder,
-                  const Alloc &initialAlloc = Alloc::alloc());
+                  const Alloc &initialAlloc = rcuvector::defaultAlloc());
 
     RcuVectorBase(GrowStrategy growStrategy,
                   GenerationHolderType &genHolder,
-                  const Alloc &initialAlloc = Alloc::alloc());
+                  const Alloc &initialAlloc = rcuvector::defaultAlloc());
 
     virtual ~RcuVectorBase();
 
@@ -122,6 +132,18 @@ public:
     void reset();
     void shrink(size_t newSize) __attribute__((noinline));
     void replaceVector(std::unique_ptr<ArrayType> replacement);
+    /**
+     * Replace the underlying data with the first n elements of the given
+     * buffer (e.g. a memory mapped file). The old data is held as for
+     * any other reallocation.
+     **/
+    void replace_with_buffer(Alloc && buf, size_t n);
+    /**
+     * Copy the data to a newly allocated buffer with the same capacity,
+     * e.g. to stop using a memory mapped file. The old data is held as
+     * for any other reallocation.
+     **/
+    void copy_to_new_buffer() { expand(capacity()); }
 };
 
 template <typename T>
@@ -69,6 +69,13 @@ RcuVectorBase<T>::replaceVector(std::unique_ptr<ArrayType> replacement) {
     onReallocation();
 }
 
+template <typename T>
+void
+RcuVectorBase<T>::replace_with_buffer(Alloc && buf, size_t n) {
+    assert(n * sizeof(T) <= buf.size());
+    replaceVector(std::make_unique<ArrayType>(std::move(buf), n));
+}
+
 template <typename T>
 void
 RcuVectorBase<T>::expandAndInsert(const T & v)